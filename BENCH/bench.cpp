@@ -0,0 +1,672 @@
+// pa2d_bench: BUFFER API 微基准
+// 每个用例报告 ns/call（Google Benchmark 默认时间列）与吞吐量计数器 Mpix（单位 Mpix/s，JSON 中为同名字段）
+// 形状用例的像素数取图形包围盒面积，图像用例取输出像素数
+// 输出 JSON：pa2d_bench --benchmark_format=json 或 --benchmark_out=result.json
+#include"pa2d.h"
+#include<benchmark/benchmark.h>
+#include<cmath>
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    const int TargetWidth = 1920;
+    const int TargetHeight = 1080;
+    const float CX = TargetWidth * 0.5f;
+    const float CY = TargetHeight * 0.5f;
+
+    // 记录每次调用处理的像素数，框架按运行时间换算为 Mpix/s
+    void setPixels(benchmark::State& state, double pixelsPerCall) {
+        state.counters["Mpix"] = benchmark::Counter(
+            pixelsPerCall * static_cast<double>(state.iterations()) * 1e-6, benchmark::Counter::kIsRate);
+    }
+
+    // 带噪声的半透明源图，避免混合内核走全透明/全不透明的快速路径
+    Buffer makeSource(int width, int height) {
+        Buffer buffer(width, height);
+        uint32_t seed = 0x9E3779B9u;
+        for (int y = 0; y < buffer.height; ++y) {
+            Color* row = buffer.getRow(y);
+            for (int x = 0; x < buffer.width; ++x) {
+                seed = seed * 1664525u + 1013904223u;
+                row[x].data = (seed & 0x00FFFFFF) | ((0x40u + (seed >> 26)) << 24);
+            }
+        }
+        return buffer;
+    }
+
+    // 形状参数：size 为包围盒边长，stroke 为线宽（0 表示只填充），alpha 为填充与描边透明度
+    struct ShapeArgs {
+        float size, stroke;
+        Color fill, strokeColor;
+        explicit ShapeArgs(const benchmark::State& state)
+            : size(static_cast<float>(state.range(0))), stroke(static_cast<float>(state.range(1))),
+            fill(static_cast<uint8_t>(state.range(2)), Color(0xFF3080C0)),
+            strokeColor(state.range(1) > 0 ? Color(static_cast<uint8_t>(state.range(2)), Color(0xFFE04020)) : None) {}
+    };
+
+    void shapeArgs(benchmark::internal::Benchmark* b) {
+        b->ArgsProduct({ { 32, 256, 1024 }, { 0, 2, 16 }, { 255, 128 } })->ArgNames({ "size", "stroke", "alpha" });
+    }
+
+    void imageArgs(benchmark::internal::Benchmark* b) {
+        b->Arg(64)->Arg(256)->Arg(1024)->ArgName("size");
+    }
+
+    // ==================== 形状 ====================
+    void BM_Line(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        float width = a.stroke > 0 ? a.stroke : 1.0f;
+        for (auto _ : state) {
+            line(dest, CX - a.size * 0.5f, CY - a.size * 0.5f, CX + a.size * 0.5f, CY + a.size * 0.5f, a.fill, width);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Line)->Apply(shapeArgs);
+
+    void BM_Polyline(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        // 锯齿折线，16 段
+        std::vector<Point> points;
+        for (int i = 0; i <= 16; ++i)
+            points.push_back(Point(CX - a.size * 0.5f + a.size * i / 16.0f, CY + ((i & 1) ? a.size : -a.size) * 0.5f));
+        float width = a.stroke > 0 ? a.stroke : 1.0f;
+        for (auto _ : state) {
+            polyline(dest, points, a.fill, width, false);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Polyline)->Apply(shapeArgs);
+
+    void BM_Polygon(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        // 十角星
+        std::vector<Point> vertices;
+        for (int i = 0; i < 10; ++i) {
+            float r = (i & 1) ? a.size * 0.2f : a.size * 0.5f;
+            float t = 3.14159265f * i / 5.0f;
+            vertices.push_back(Point(CX + r * std::cos(t), CY + r * std::sin(t)));
+        }
+        for (auto _ : state) {
+            polygon(dest, vertices, a.fill, a.strokeColor, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Polygon)->Apply(shapeArgs);
+
+    void BM_Triangle(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        float h = a.size * 0.5f;
+        for (auto _ : state) {
+            triangle(dest, CX, CY - h, CX + h, CY + h, CX - h, CY + h, a.fill, a.strokeColor, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Triangle)->Apply(shapeArgs);
+
+    void BM_Rect(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            rect(dest, CX - a.size * 0.5f, CY - a.size * 0.5f, a.size, a.size, a.fill, a.strokeColor, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Rect)->Apply(shapeArgs);
+
+    void BM_RectRotated(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            rect(dest, CX, CY, a.size, a.size * 0.5f, 0.5f, a.fill, a.strokeColor, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_RectRotated)->Apply(shapeArgs);
+
+    void BM_RoundRect(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            roundRect(dest, CX - a.size * 0.5f, CY - a.size * 0.5f, a.size, a.size, a.fill, a.strokeColor, a.size * 0.2f, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_RoundRect)->Apply(shapeArgs);
+
+    void BM_RoundRectRotated(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            roundRect(dest, CX, CY, a.size, a.size * 0.5f, 0.5f, a.fill, a.strokeColor, a.size * 0.1f, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_RoundRectRotated)->Apply(shapeArgs);
+
+    void BM_Circle(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            circle(dest, CX, CY, a.size * 0.5f, a.fill, a.strokeColor, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Circle)->Apply(shapeArgs);
+
+    void BM_Ellipse(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            ellipse(dest, CX, CY, a.size, a.size * 0.5f, a.fill, a.strokeColor, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Ellipse)->Apply(shapeArgs);
+
+    void BM_EllipseRotated(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            ellipse(dest, CX, CY, a.size, a.size * 0.5f, 0.5f, a.fill, a.strokeColor, a.stroke);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_EllipseRotated)->Apply(shapeArgs);
+
+    void BM_Sector(benchmark::State& state) {
+        ShapeArgs a(state);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            sector(dest, CX, CY, a.size * 0.5f, 0.3f, 4.5f, a.fill, a.strokeColor, a.stroke, true, true);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, a.size * a.size);
+    }
+    BENCHMARK(BM_Sector)->Apply(shapeArgs);
+
+    // ==================== 混合与拷贝 ====================
+    typedef void (*BlendFunc)(const Buffer& src, Buffer& dest, int x, int y, int alpha);
+
+    template<BlendFunc Blend>
+    void BM_Blend(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        int opacity = static_cast<int>(state.range(1));
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight, Gray);
+        for (auto _ : state) {
+            Blend(src, dest, 0, 0, opacity);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+#define PA2D_BENCH_BLEND(func) \
+    BENCHMARK_TEMPLATE(BM_Blend, func)->ArgsProduct({ { 64, 256, 1024 }, { 255, 128 } })->ArgNames({ "size", "opacity" })
+    PA2D_BENCH_BLEND(alphaBlend);
+    PA2D_BENCH_BLEND(addBlend);
+    PA2D_BENCH_BLEND(multiplyBlend);
+    PA2D_BENCH_BLEND(screenBlend);
+    PA2D_BENCH_BLEND(overlayBlend);
+    PA2D_BENCH_BLEND(destAlphaBlend);
+#undef PA2D_BENCH_BLEND
+
+    // 通用混合引擎：按 BlendMode 序号，目标为不透明(0) 或半透明(1)
+    void BM_BlendMode(benchmark::State& state) {
+        Buffer src = makeSource(1024, 1024);
+        Buffer dest(TargetWidth, TargetHeight, state.range(1) ? Color(128, Gray) : Gray);
+        const BlendMode mode = static_cast<BlendMode>(state.range(0));
+        for (auto _ : state) {
+            blend(src, dest, 0, 0, mode, 200);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, 1024.0 * 1024);
+    }
+    BENCHMARK(BM_BlendMode)->ArgsProduct({ {
+        static_cast<int>(BlendMode::SrcIn), static_cast<int>(BlendMode::Xor), static_cast<int>(BlendMode::Darken),
+        static_cast<int>(BlendMode::ColorDodge), static_cast<int>(BlendMode::SoftLight), static_cast<int>(BlendMode::Difference)
+    }, { 0, 1 } })->ArgNames({ "mode", "translucent" });
+
+    // 源与目标同为直通(0) 或同为预乘(1) 格式的 alphaBlend
+    void BM_AlphaBlendFormat(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight, Gray);
+        if (state.range(1)) {
+            premultiply(src);
+            premultiply(dest);
+        }
+        for (auto _ : state) {
+            alphaBlend(src, dest, 0, 0, static_cast<int>(state.range(2)));
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+    BENCHMARK(BM_AlphaBlendFormat)->ArgsProduct({ { 256, 1024 }, { 0, 1 }, { 255, 128 } })->ArgNames({ "size", "premultiplied", "opacity" });
+
+    // 就地预乘后再反预乘一次
+    void BM_PremultiplyRoundTrip(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer buffer = makeSource(size, size);
+        for (auto _ : state) {
+            premultiply(buffer);
+            unpremultiply(buffer);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size * 2);
+    }
+    BENCHMARK(BM_PremultiplyRoundTrip)->Apply(imageArgs);
+
+    void BM_Blit(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight);
+        for (auto _ : state) {
+            blit(src, dest, 0, 0);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+    BENCHMARK(BM_Blit)->Apply(imageArgs);
+
+    // 源与目标按 64 字节行对齐分配，逐行走对齐内核
+    void BM_BlitRowAligned(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        setBufferRowAlignment(64);
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight);
+        setBufferRowAlignment(0);
+        for (auto _ : state) {
+            blit(src, dest, 0, 0);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+    BENCHMARK(BM_BlitRowAligned)->Apply(imageArgs);
+
+    void BM_Crop(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(TargetWidth, TargetHeight);
+        for (auto _ : state) {
+            // crop 返回视图，赋值给 Buffer 才复制像素
+            Buffer out = crop(src, 100, 100, size, size);
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+    BENCHMARK(BM_Crop)->Apply(imageArgs);
+
+    // ==================== 缩放与旋转 ====================
+    // size 为源图边长，scale 以百分比给出
+    void BM_Scaled(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        float scale = state.range(1) / 100.0f;
+        Buffer src = makeSource(size, size);
+        double outPixels = 0;
+        for (auto _ : state) {
+            Buffer out = scaled(src, scale);
+            outPixels = static_cast<double>(out.size());
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, outPixels);
+    }
+    BENCHMARK(BM_Scaled)->ArgsProduct({ { 64, 256, 1024 }, { 50, 150, 300 } })->ArgNames({ "size", "scale%" });
+
+    void BM_Resized(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        int outWidth = size * 3 / 2, outHeight = size / 2;
+        for (auto _ : state) {
+            Buffer out = resized(src, outWidth, outHeight);
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, static_cast<double>(outWidth) * outHeight);
+    }
+    BENCHMARK(BM_Resized)->Apply(imageArgs);
+
+    void BM_Rotated(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        double outPixels = 0;
+        for (auto _ : state) {
+            Buffer out = rotated(src, 0.6f);
+            outPixels = static_cast<double>(out.size());
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, outPixels);
+    }
+    BENCHMARK(BM_Rotated)->Apply(imageArgs);
+
+    void BM_Transformed(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        double outPixels = 0;
+        for (auto _ : state) {
+            Buffer out = transformed(src, 1.5f, 0.75f, 0.6f);
+            outPixels = static_cast<double>(out.size());
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, outPixels);
+    }
+    BENCHMARK(BM_Transformed)->Apply(imageArgs);
+
+    // 大比例缩小（1/16）：逐级 2:1 盒式滤波 + 双线性，对比每次从源图缩小与复用缓存的 MipChain
+    void BM_ResizedDownscale(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        double outPixels = 0;
+        for (auto _ : state) {
+            Buffer out = resized(src, size / 16, size / 16);
+            outPixels = static_cast<double>(out.size());
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, outPixels);
+    }
+    BENCHMARK(BM_ResizedDownscale)->Apply(imageArgs);
+
+    void BM_MipChainResized(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        MipChain chain(makeSource(size, size));
+        double outPixels = 0;
+        for (auto _ : state) {
+            Buffer out = chain.resized(size / 16, size / 16);
+            outPixels = static_cast<double>(out.size());
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, outPixels);
+    }
+    BENCHMARK(BM_MipChainResized)->Apply(imageArgs);
+
+    // 可分离重采样，缩小到 2/3：0 = Nearest、1 = Bilinear、2 = Bicubic、3 = Lanczos3
+    // 复用同一个 Resampler 和目标缓冲区，对应视频帧的逐帧缩放
+    void BM_Resampler(benchmark::State& state) {
+        const ResampleFilter filter = static_cast<ResampleFilter>(state.range(0));
+        Buffer src = makeSource(TargetWidth, TargetHeight);
+        Resampler resampler(TargetWidth, TargetHeight, TargetWidth * 2 / 3, TargetHeight * 2 / 3, filter);
+        Buffer out;
+        for (auto _ : state) {
+            resampler.apply(src, out);
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, static_cast<double>(out.size()));
+    }
+    BENCHMARK(BM_Resampler)->ArgName("filter")->DenseRange(0, 3);
+
+    // 像素画整数倍放大：range(0) 为倍数
+    void BM_Upscaled(benchmark::State& state) {
+        const int factor = static_cast<int>(state.range(0));
+        Buffer src = makeSource(TargetWidth / factor, TargetHeight / factor);
+        double outPixels = 0;
+        for (auto _ : state) {
+            Buffer out = upscaled(src, factor);
+            outPixels = static_cast<double>(out.size());
+            benchmark::DoNotOptimize(out.color);
+        }
+        setPixels(state, outPixels);
+    }
+    BENCHMARK(BM_Upscaled)->ArgName("factor")->DenseRange(2, 4);
+
+    // 直接绘制到目标缓冲区的版本
+    void BM_DrawResized(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        int outWidth = size * 3 / 2, outHeight = size / 2;
+        for (auto _ : state) {
+            drawResized(dest, src, CX, CY, outWidth, outHeight);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(outWidth) * outHeight);
+    }
+    BENCHMARK(BM_DrawResized)->Apply(imageArgs);
+
+    void BM_DrawScaled(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            drawScaled(dest, src, CX, CY, 1.5f, 0.75f);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, size * 1.5 * size * 0.75);
+    }
+    BENCHMARK(BM_DrawScaled)->Apply(imageArgs);
+
+    void BM_DrawRotated(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            drawRotated(dest, src, CX, CY, 0.6f);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+    BENCHMARK(BM_DrawRotated)->Apply(imageArgs);
+
+    void BM_DrawTransformed(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer src = makeSource(size, size);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        for (auto _ : state) {
+            drawTransformed(dest, src, CX, CY, 1.5f, 0.75f, 0.6f);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, size * 1.5 * size * 0.75);
+    }
+    BENCHMARK(BM_DrawTransformed)->Apply(imageArgs);
+
+    // ==================== 合成模式 ====================
+    // 不透明背景上的大面积半透明填充，对比 CompositeMode::Precise(0) 与 Fast(1)
+    void BM_FillScene(benchmark::State& state) {
+        CompositeMode previous = getCompositeMode();
+        setCompositeMode(state.range(0) ? CompositeMode::Fast : CompositeMode::Precise);
+        Buffer dest(TargetWidth, TargetHeight, White);
+        Color fill(160, Color(0xFF3080C0));
+        std::vector<Point> quad = { Point(100, 100), Point(1800, 150), Point(1700, 1000), Point(150, 900) };
+        for (auto _ : state) {
+            rect(dest, 100, 100, 1600, 900, fill, None, 0);
+            circle(dest, CX, CY, 500, fill, None, 0);
+            roundRect(dest, 100, 100, 1600, 900, fill, None, 50, 0);
+            polygon(dest, quad, fill, None, 0);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, 1600.0 * 900 * 2 + 3.14159265 * 500 * 500 + 1650.0 * 850);
+        setCompositeMode(previous);
+    }
+    BENCHMARK(BM_FillScene)->Arg(0)->Arg(1)->ArgName("fast");
+
+    // 半透明背景上的同一场景：直通目标(0) 每个像素按 OutA 做除法，预乘目标(1) 没有除法
+    void BM_FillSceneFormat(benchmark::State& state) {
+        Buffer dest(TargetWidth, TargetHeight, Color(128, Color(0xFF808080)));
+        if (state.range(0)) premultiply(dest);
+        Color fill(160, Color(0xFF3080C0));
+        std::vector<Point> quad = { Point(100, 100), Point(1800, 150), Point(1700, 1000), Point(150, 900) };
+        for (auto _ : state) {
+            rect(dest, 100, 100, 1600, 900, fill, None, 0);
+            circle(dest, CX, CY, 500, fill, None, 0);
+            roundRect(dest, 100, 100, 1600, 900, fill, None, 50, 0);
+            polygon(dest, quad, fill, None, 0);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, 1600.0 * 900 * 2 + 3.14159265 * 500 * 500 + 1650.0 * 850);
+    }
+    BENCHMARK(BM_FillSceneFormat)->Arg(0)->Arg(1)->ArgName("premultiplied");
+
+    // 加色发光粒子：临时画布绘制后 addBlend(0)，与 Style::blend 单次绘制(1) 对比
+    void BM_GlowParticles(benchmark::State& state) {
+        const bool singlePass = state.range(0) != 0;
+        Canvas canvas(TargetWidth, TargetHeight, Color(0xFF101820));
+        Canvas layer(TargetWidth, TargetHeight, None);
+        const Style glow = Style().fill(Color(160, Color(0xFFFF9030))).blend(singlePass ? BlendMode::Add : BlendMode::SrcOver);
+        std::vector<Point> centers;
+        uint32_t seed = 12345u;
+        for (int i = 0; i < 200; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            const float x = static_cast<float>(seed % TargetWidth);
+            seed = seed * 1664525u + 1013904223u;
+            centers.push_back(Point(x, static_cast<float>(seed % TargetHeight)));
+        }
+        for (auto _ : state) {
+            if (singlePass) {
+                for (const Point& c : centers) canvas.circle(c.x, c.y, 24, glow);
+            }
+            else {
+                layer.clear(None);
+                for (const Point& c : centers) layer.circle(c.x, c.y, 24, glow);
+                canvas.addBlend(layer, 0, 0);
+            }
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, 200.0 * 48 * 48);
+    }
+    BENCHMARK(BM_GlowParticles)->Arg(0)->Arg(1)->ArgName("singlePass");
+
+    // 1 万个 16x16 粒子（随机缩放与旋转）：逐个 drawTransformed(0) 与 SpriteBatch 一次提交(1)
+    void BM_Sprites(benchmark::State& state) {
+        const bool batched = state.range(0) != 0;
+        Buffer sprite = makeSource(16, 16);
+        Buffer dest(TargetWidth, TargetHeight, Gray);
+        struct Particle { float x, y, scale, rotation; };
+        std::vector<Particle> particles;
+        uint32_t seed = 2024u;
+        auto next = [&] { seed = seed * 1664525u + 1013904223u; return (seed >> 8) * (1.0f / 16777216.0f); };
+        for (int i = 0; i < 10000; ++i) {
+            const float x = next() * TargetWidth, y = next() * TargetHeight;
+            const float scale = 0.5f + next(), rotation = next() * 6.2831853f;
+            particles.push_back({ x, y, scale, rotation });
+        }
+        SpriteBatch batch;
+        batch.reserve(particles.size());
+        for (auto _ : state) {
+            if (batched) {
+                batch.clear();
+                for (const Particle& p : particles) batch.add(sprite, p.x, p.y, p.scale, p.rotation);
+                batch.render(dest);
+            }
+            else {
+                for (const Particle& p : particles) drawTransformed(dest, sprite, p.x, p.y, p.scale, p.rotation);
+            }
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, 10000.0 * 16 * 16);
+    }
+    BENCHMARK(BM_Sprites)->Arg(0)->Arg(1)->ArgName("batched");
+
+    // ==================== 纹理图集 ====================
+    // 500 个 12-40 像素的图标依次装入 1024x1024 图集
+    void BM_AtlasPack(benchmark::State& state) {
+        std::vector<Buffer> icons;
+        uint32_t seed = 99u;
+        auto next = [&](int range) { seed = seed * 1664525u + 1013904223u; return static_cast<int>((seed >> 8) % range); };
+        for (int i = 0; i < 500; ++i) icons.push_back(makeSource(12 + next(29), 12 + next(29)));
+        std::vector<const Buffer*> images;
+        for (const Buffer& icon : icons) images.push_back(&icon);
+        Atlas atlas(1024, 1024);
+        for (auto _ : state) {
+            atlas.clear();
+            benchmark::DoNotOptimize(atlas.insert(images));
+        }
+        state.counters["occupancy"] = atlas.occupancy();
+    }
+    BENCHMARK(BM_AtlasPack);
+
+    // 每帧绘制 2000 个 32x32 图标：各自独立的 Buffer (0) 与同一图集中的区域 (1)
+    void BM_AtlasDraw(benchmark::State& state) {
+        const bool useAtlas = state.range(0) != 0;
+        std::vector<Buffer> icons;
+        for (int i = 0; i < 256; ++i) icons.push_back(makeSource(32, 32));
+        Atlas atlas(1024, 1024);
+        std::vector<AtlasRegion> regions;
+        for (const Buffer& icon : icons) regions.push_back(atlas.insert(icon));
+        Buffer dest(TargetWidth, TargetHeight, Gray);
+        uint32_t seed = 7u;
+        auto next = [&] { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+        struct Item { int icon, x, y; };
+        std::vector<Item> items;
+        for (int i = 0; i < 2000; ++i) {
+            items.push_back({ static_cast<int>(next() % icons.size()),
+                static_cast<int>(next() % TargetWidth), static_cast<int>(next() % TargetHeight) });
+        }
+        for (auto _ : state) {
+            for (const Item& item : items) {
+                const int x = item.x - 16, y = item.y - 16;
+                if (useAtlas) alphaBlend(atlas.view(regions[item.icon]), dest, x, y, 255);
+                else alphaBlend(icons[item.icon], dest, x, y, 255);
+            }
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, 2000.0 * 32 * 32);
+    }
+    BENCHMARK(BM_AtlasDraw)->Arg(0)->Arg(1)->ArgName("atlas");
+
+    // ==================== 缓冲区管理 ====================
+    void BM_Clear(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer buffer(size, size);
+        for (auto _ : state) {
+            buffer.clear(Gray);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+    BENCHMARK(BM_Clear)->Apply(imageArgs);
+
+    void BM_ClearStreaming(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer buffer(size, size);
+        for (auto _ : state) {
+            buffer.clearStreaming(Gray);
+            benchmark::ClobberMemory();
+        }
+        setPixels(state, static_cast<double>(size) * size);
+    }
+    BENCHMARK(BM_ClearStreaming)->Apply(imageArgs);
+
+    // 在两种尺寸间来回切换，每次调用都会重新分配、清空并拷贝
+    void BM_Resize(benchmark::State& state) {
+        int size = static_cast<int>(state.range(0));
+        Buffer buffer = makeSource(size, size);
+        bool grow = true;
+        for (auto _ : state) {
+            int side = grow ? size + size / 4 : size;
+            buffer.resize(side, side, Gray);
+            grow = !grow;
+            benchmark::DoNotOptimize(buffer.color);
+        }
+        setPixels(state, static_cast<double>(size + size / 4) * (size + size / 4));
+    }
+    BENCHMARK(BM_Resize)->Apply(imageArgs);
+
+    const char* simdLevelName(SimdLevel level) {
+        switch (level) {
+        case SimdLevel::AVX512: return "AVX-512";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "SSE4.1";
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    // 写入 JSON 的 context 字段，方便对比不同版本的结果
+    benchmark::AddCustomContext("pa2d_version", getVersion());
+    benchmark::AddCustomContext("pa2d_simd", simdLevelName(getSimdLevel()));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include "color.h"
+#include <cstddef>
+
+namespace pa2d {
+    // Buffer 像素存储的对齐字节数
+    const size_t BUFFER_ALIGNMENT = 64;
+
+    // Buffer 像素存储分配器
+    // allocate 返回 BUFFER_ALIGNMENT 对齐、内容未初始化的内存，失败返回 nullptr；deallocate 收到的 count 与分配时相同
+    // Buffer 记录分配它的分配器并由其释放，分配器的生命周期必须长于它分配出去的 Buffer
+    class BufferAllocator {
+    public:
+        virtual ~BufferAllocator() = default;
+        virtual Color* allocate(size_t count) = 0;
+        virtual void deallocate(Color* pixels, size_t count) = 0;
+    };
+
+    // 默认分配器：对齐的系统堆分配
+    BufferAllocator& heapAllocator();
+
+    // 分级内存池：请求大小向上取整到分级（每翻一倍分 4 级，浪费不超过 25%），释放的块按级缓存，同级分配直接复用
+    // 缓存总量超过 maxCachedBytes 时多出的块归还 upstream；线程安全
+    class PoolAllocator : public BufferAllocator {
+    public:
+        explicit PoolAllocator(size_t maxCachedBytes = size_t(256) << 20, BufferAllocator& upstream = heapAllocator());
+        ~PoolAllocator() override;
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+        Color* allocate(size_t count) override;
+        void deallocate(Color* pixels, size_t count) override;
+        // 归还全部缓存块
+        void trim();
+        size_t cachedBytes() const;
+    private:
+        struct Impl; Impl* impl_;
+    };
+
+    // 帧内存区：从一整块预留内存顺序切分，容量不足时转交 upstream；线程安全
+    // 释放最后分配的块会立即退回，全部块释放后自动回到起点；reset() 强制回到起点，调用前必须销毁由它分配的 Buffer
+    // 适合每帧的临时 Buffer（rotated()、scaled() 等的结果）
+    class FrameArena : public BufferAllocator {
+    public:
+        explicit FrameArena(size_t capacityBytes, BufferAllocator& upstream = heapAllocator());
+        ~FrameArena() override;
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        Color* allocate(size_t count) override;
+        void deallocate(Color* pixels, size_t count) override;
+        void reset();
+        size_t usedBytes() const;
+        size_t capacity() const;
+    private:
+        struct Impl; Impl* impl_;
+    };
+
+    // 新分配 Buffer 的行对齐字节数（默认 0：行紧密排列，stride == width）
+    // 32 / 64：行跨度向上取整到 8 / 16 像素的倍数，每行起点按该字节数对齐，整行清屏、拷贝、blit 走对齐且无尾部的路径
+    // 其他取值向上取到 32 或 64；只影响此后分配的 Buffer
+    void setBufferRowAlignment(size_t bytes);
+    size_t getBufferRowAlignment();
+
+    // 全局分配器（默认 heapAllocator()），nullptr 恢复默认
+    void setBufferAllocator(BufferAllocator* allocator);
+    // 当前线程使用的分配器：BufferAllocatorScope 指定的优先，否则为全局分配器
+    BufferAllocator& getBufferAllocator();
+
+    // 在作用域内为当前线程替换分配器，析构时恢复
+    class BufferAllocatorScope {
+    public:
+        explicit BufferAllocatorScope(BufferAllocator& allocator);
+        ~BufferAllocatorScope();
+        BufferAllocatorScope(const BufferAllocatorScope&) = delete;
+        BufferAllocatorScope& operator=(const BufferAllocatorScope&) = delete;
+    private:
+        BufferAllocator* previous_;
+    };
+}
\ No newline at end of file
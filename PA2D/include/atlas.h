@@ -0,0 +1,71 @@
+#pragma once
+#include "buffer.h"
+#include <vector>
+namespace pa2d {
+    // 图集中的一块区域：页面内的像素矩形，以及归一化纹理坐标 [u0, u1] x [v0, v1]
+    // 插入失败（图集已满或尺寸无效）时宽高为 0
+    struct AtlasRegion {
+        int x = 0, y = 0, width = 0, height = 0;
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+        bool isValid() const { return width > 0 && height > 0; }
+        explicit operator bool() const { return isValid(); }
+    };
+
+    // 纹理图集：把大量小图打包进一张大 Buffer，共用一次分配，绘制时访问更集中
+    // 天际线（skyline）装箱：每次选择放下后顶边最低的位置，支持随时增量插入，字形与图标缓存可共用一张图集
+    // 区域分配后位置不再变化；放不下时返回无效区域，已有区域不受影响
+    // view(region) 返回不复制像素的 BufferView，可直接作为任何绘制、混合、变换函数的源
+    class Atlas {
+    public:
+        static const int DEFAULT_SIZE = 1024;
+
+        Atlas() = default;
+        // padding 为相邻区域之间保留的透明间隔（像素）；页面按 format 存储，插入的图按需转换
+        explicit Atlas(int width, int height = DEFAULT_SIZE, int padding = 1, PixelFormat format = PixelFormat::Straight);
+        // 重新分配页面并清空全部区域
+        void reset(int width, int height, int padding = 1, PixelFormat format = PixelFormat::Straight);
+        // 清空全部区域与页面像素，保留页面存储
+        void clear();
+
+        // 分配与 image 同尺寸的区域并拷贝像素
+        AtlasRegion insert(const Buffer& image);
+        // 批量插入：按高度从大到小装箱（同样的图比逐个插入排得更紧），结果按输入顺序返回
+        std::vector<AtlasRegion> insert(const std::vector<const Buffer*>& images);
+#ifndef PA2D_HEADLESS
+        // 加载图片文件并插入，加载失败时返回无效区域
+        AtlasRegion insert(const char* filePath);
+#endif
+        // 只分配不拷贝，区域内为透明像素；调用方随后经 view(region) 写入（例如光栅化字形）
+        AtlasRegion allocate(int width, int height);
+
+        // 区域对应的页面视图；写入经视图直接修改页面
+        BufferView view(const AtlasRegion& region);
+
+        bool isValid() const { return page_.isValid(); }
+        int width() const { return page_.width; }
+        int height() const { return page_.height; }
+        int padding() const { return padding_; }
+        int regionCount() const { return regionCount_; }
+        // 已分配像素（不含间隔）占页面的比例
+        float occupancy() const;
+        const Buffer& buffer() const { return page_; }
+        Buffer& buffer() { return page_; }
+
+    private:
+        // 天际线的一段：[x, x + width) 列已占用到 y 行（不含）
+        struct Segment {
+            int x, y, width;
+        };
+
+        Buffer page_;
+        int padding_ = 1;
+        int regionCount_ = 0;
+        long long usedArea_ = 0;
+        std::vector<Segment> skyline_;
+
+        // 从第 index 段左端放入 width x height 时的顶边，放不下返回 -1
+        int fitAt(size_t index, int width, int height) const;
+        void placeAt(size_t index, int x, int y, int width, int height);
+        AtlasRegion makeRegion(int x, int y, int width, int height) const;
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+namespace pa2d {
+    // 混合模式（W3C Compositing and Blending Level 1），As / Ad 为源 / 目标 alpha，Cs / Cd 为直通颜色
+    // Porter-Duff 合成：按 Fa / Fb 加权源与目标，Out = Src * As * Fa + Dst * Ad * Fb
+    //   SrcOver（默认，Fa = 1, Fb = 1 - As）  DstOver（1 - Ad, 1）  Clear（0, 0）  Src（1, 0）  Dst（0, 1）
+    //   SrcIn（Ad, 0）  DstIn（0, As）  SrcOut（1 - Ad, 0）  DstOut（0, 1 - As）
+    //   SrcAtop（Ad, 1 - As）  DstAtop（1 - Ad, As）  Xor（1 - Ad, 1 - As）
+    // 可分离混合：以 SrcOver 合成，源与目标重叠部分的颜色为 B(Cs, Cd)
+    //   Add / Subtract（线性减淡 / 相减）  Multiply  Screen  Overlay  Darken  Lighten
+    //   ColorDodge  ColorBurn  HardLight  SoftLight  Difference  Exclusion
+    // DestAlpha：源 alpha 乘以目标 alpha 后覆盖，只画在目标已有内容上（destAlphaBlend）
+    // 不透明度乘在 As 上；抗锯齿覆盖率对 Clear、Src、SrcIn、DstIn、SrcOut、DstAtop 按 lerp(目标, 结果, 覆盖率) 插值，
+    // 其余模式在 As 为 0 时保留目标，覆盖率同样乘在 As 上
+    enum class BlendMode {
+        SrcOver, Clear, Src, Dst, DstOver, SrcIn, DstIn, SrcOut, DstOut, SrcAtop, DstAtop, Xor,
+        Add, Subtract, Multiply, Screen, Overlay, Darken, Lighten,
+        ColorDodge, ColorBurn, HardLight, SoftLight, Difference, Exclusion,
+        DestAlpha
+    };
+}
\ No newline at end of file
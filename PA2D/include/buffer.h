@@ -1,36 +1,84 @@
 #pragma once
 #include "color.h"
+#include "allocator.h"
+#include <cstddef>
+#include <cstdint>
 namespace pa2d {
+    // 像素格式：Straight 为直通 alpha ARGB32（默认），Premultiplied 为预乘 alpha ARGB32（RGB 已乘以 A/255）
+    // 光栅化合成、alphaBlend 与 drawScaled / drawResized 按格式选择公式；预乘格式的源覆盖合成没有除法，滤波不会在透明边缘带出暗边
+    enum class PixelFormat { Straight, Premultiplied };
+
+    struct BufferView;
     struct Buffer {
         Color* color;
         int width, height;
+        int stride = 0;                       // 行跨度（像素数），第 y 行起始于 color + y * stride；自有存储按 setBufferRowAlignment 填充
+        BufferAllocator* allocator = nullptr; // 分配 color 的分配器，由 Buffer 维护；为 nullptr 时不拥有像素（视图）
+        PixelFormat format = PixelFormat::Straight; // 只是标记，修改它不会转换像素；转换使用 premultiply / unpremultiply
         explicit Buffer(int width = 0, int height = 0, const Color& init_color = 0x0);
         Buffer(const Buffer& other);
         Buffer(Buffer&& other) noexcept;
         Buffer& operator=(const Buffer& other);
         Buffer& operator=(Buffer&& other) noexcept;
+        // 视图的临时对象不能移动成 Buffer（否则得到的是指向原存储的视图）；需要副本时用 crop 或以左值拷贝
+        Buffer(BufferView&& other) = delete;
+        Buffer& operator=(BufferView&& other) = delete;
         ~Buffer();
         size_t size() const { return static_cast<size_t>(width) * height; }
         bool isValid() const { return color && width > 0 && height > 0; }
+        bool isContiguous() const { return stride == width; }
+        bool isPremultiplied() const { return format == PixelFormat::Premultiplied; }
+        // 行跨度为 8 像素的倍数且首行按 32 字节对齐：每行起点都可用对齐的 AVX 读写
+        bool isRowAligned() const { return stride % 8 == 0 && (reinterpret_cast<uintptr_t>(color) & 31) == 0; }
         Color& at(int x, int y);
         const Color& at(int x, int y) const;
         Color* getRow(int y);
         const Color* getRow(int y) const;
         void resize(int newWidth, int newHeight, const Color& clear_color = 0x0);
         void clear(const Color& clear_color = 0x0);
+        // 使用非临时存储清屏（不受 StoreMode 影响），整帧写入不挤占缓存
+        void clearStreaming(const Color& clear_color = 0x0);
+        // 区域 (x, y, w, h) 的视图，裁剪到缓冲区内，不复制像素
+        BufferView view(int x, int y, int w, int h);
         explicit operator bool() const { return isValid(); }
     };
-    void copy(Buffer& dest, const Buffer& src);
+
+    // 不拥有像素的缓冲区视图：指向另一块存储中的矩形区域，行跨度沿用原存储
+    // 以 Buffer& 传给任意绘制、混合、变换函数即可直接读写该区域；被引用的存储必须比视图存活更久
+    // 视图之间的拷贝只复制指针；拷贝给 Buffer 时复制像素，得到独立的缓冲区
+    // 以 Buffer& 赋值给视图（copy）时写入视图区域，尺寸必须相同
+    struct BufferView : Buffer {
+        BufferView() = default;
+        BufferView(Color* pixels, int width, int height, int stride);
+        BufferView(const BufferView& other);
+        BufferView& operator=(const BufferView& other);
+    };
+    // 把 src 的像素与格式复制到 dest，尺寸不同时 dest 重新分配存储；
+    // dest 为视图时只能写入同尺寸的区域，尺寸不同（或 src 无效）时不做任何修改并返回 false
+    bool copy(Buffer& dest, const Buffer& src);
+    // 就地转换像素格式并更新标记，已是目标格式时不做任何事；逐行 SIMD，并行分条带
+    // 预乘：RGB = RGB * A / 255（四舍五入）；反预乘：RGB = min(255, RGB * 255 / A)，A 为 0 的像素变为全 0
+    void premultiply(Buffer& buffer);
+    void unpremultiply(Buffer& buffer);
+    void convertFormat(Buffer& buffer, PixelFormat format);
+    // 复制 src 内的区域 (x, y, w, h)，裁剪到 src 内，返回独立的缓冲区
     Buffer crop(const Buffer& src, int x, int y, int w, int h);
+    // 返回 src 内区域的视图（O(1)，不复制）；视图经 src 的存储读写，src 必须比视图存活更久
+    BufferView cropView(Buffer& src, int x, int y, int w, int h);
+    // drawScaled / drawResized 在预乘源上直接插值预乘值，以 Out = Src + Dst * (1 - SrcA) 合成；drawRotated / drawTransformed 按直通 alpha 合成
     void drawScaled(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY);
     void drawScaled(Buffer& dest, const Buffer& src, float centerX, float centerY, float scale);
     void drawResized(Buffer& dest, const Buffer& src, float centerX, float centerY , int width, int height);
     void drawRotated(Buffer& dest, const Buffer& src, float centerX, float centerY, float rotation);
     void drawTransformed(Buffer& dest, const Buffer& src, float centerX, float centerY, float scale, float rotation);
     void drawTransformed(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY, float rotation);
+    // 以下变换返回的 Buffer 沿用 src 的像素格式
     Buffer scaled(const Buffer& src, float scaleX, float scaleY);
     Buffer scaled(const Buffer& src, float factor);
+    // 缩小到一半以下的方向先逐级 2:1 盒式滤波，再双线性
     Buffer resized(const Buffer& src, int width, int height); 
+    // 2:1 盒式滤波缩小（宽高各减半，奇数边向上取整）
+    Buffer halved(const Buffer& src);
     Buffer rotated(const Buffer& src, float rotation);
     Buffer transformed(const Buffer& src, float scale,float rotation);
     Buffer transformed(const Buffer& src, float scaleX, float scaleY, float rotation );
@@ -1,8 +1,14 @@
 #pragma once
+#include "blend_mode.h"
 namespace pa2d {
     struct Buffer;
     void blit(const Buffer& src, Buffer& dst, int dstX = 0, int dstY = 0);
+    // 按 src / dst 的像素格式选择直通或预乘公式
     void alphaBlend(const Buffer& src, Buffer& dst, int dstX = 0, int dstY = 0, int opacity = 255);
+    // 任意混合模式，按 src / dst 的像素格式解释与写回像素；只改写 src 覆盖的区域
+    // SrcOver 等同 alphaBlend，其余模式由通用混合引擎处理
+    void blend(const Buffer& src, Buffer& dst, int dstX = 0, int dstY = 0, BlendMode mode = BlendMode::SrcOver, int opacity = 255);
+    // 以下分别等同 blend 的 Add / Multiply / Screen / Overlay / DestAlpha
     void addBlend(const Buffer& src, Buffer& dst, int dstX = 0, int dstY = 0, int opacity = 255);
     void multiplyBlend(const Buffer& src, Buffer& dst, int dstX = 0, int dstY = 0, int opacity = 255);
     void screenBlend(const Buffer& src, Buffer& dst, int dstX = 0, int dstY = 0, int opacity = 255);
@@ -4,25 +4,30 @@
 #include "style.h"
 #include "draw.h"
 #include "buffer_blender.h"
+#ifndef PA2D_HEADLESS
 #include "image_loader.h"
 #include "draw_text.h"
+#endif
 #include "geometry.h"
+#include "parallel.h"
+#include "command_list.h"
+#include "tile_renderer.h"
+#include "atlas.h"
+#include "sprite_batch.h"
+#include "dirty_region.h"
+#include "dispatch.h"
+#include "composite.h"
+#include "store_mode.h"
+#include "mip_chain.h"
+#include "resample.h"
 #include <vector>
 namespace pa2d {
     class Canvas {
     private:
         Buffer buffer_;
-        Canvas& drawImpl(const Line& line, const Style& style);
-        Canvas& drawImpl(const Ray& ray, const Style& style);
-        Canvas& drawImpl(const Triangle& triangle, const Style& style);
-        Canvas& drawImpl(const Rect& rect, const Style& style);
-        Canvas& drawImpl(const Circle& circle, const Style& style);
-        Canvas& drawImpl(const Elliptic& ellipse, const Style& style);
-        Canvas& drawImpl(const Sector& sector, const Style& style);
-        Canvas& drawImpl(const Points& points, const Style& style);
-        Canvas& drawImpl(const Polygon& polygon, const Style& style);
+        DirtyRegion dirty_;
     public:
-        // 캯
+        // 构造函数
         Canvas();
         Canvas(int width, int height, Color background = 0xFFFFFFFF);
         Canvas(const Buffer& rhs);
@@ -31,36 +36,59 @@ namespace pa2d {
         Canvas(Canvas&& other) noexcept;
         Canvas& operator=(Canvas&& rhs) noexcept;
         Canvas& operator=(Buffer&& rhs) noexcept;
+        // 与 Buffer 相同，视图的临时对象不能移动进画布
+        Canvas(BufferView&& rhs) = delete;
+        Canvas& operator=(BufferView&& rhs) = delete;
+#ifndef PA2D_HEADLESS
         Canvas(const char* filePath);
         Canvas(int resourceID);
+#endif
         Canvas& operator=(const Canvas& rhs);
         Canvas& operator=(const Buffer& rhs);
-        // Է
+        // 基础属性访问
         int width() const;
         int height() const;
         bool isValid() const;
         const Buffer& getBuffer() const;
         Buffer& getBuffer();
-        // ط
+        // 区域视图：不复制像素，可作为绘制、混合、变换的目标或源
+        // 取得视图时即把（裁剪后的）区域标记为脏；clearDirty 之后再经同一视图写入时需自行调用 markDirty
+        BufferView view(int x, int y, int width, int height);
+        // 像素访问
         Color& at(int x, int y);
         const Color& at(int x, int y) const;
-        // ͼ
+        // 脏区域：记录自上次 clearDirty 以来被修改的矩形，供 Window::renderDirty 局部提交
+        // 通过 getBuffer()/at() 直接写像素时需自行调用 markDirty
+        const DirtyRegion& getDirtyRegion() const;
+        bool isDirty() const;
+        Canvas& markDirty();
+        Canvas& markDirty(int x, int y, int width, int height);
+        Canvas& clearDirty();
+        // 图像操作
+#ifndef PA2D_HEADLESS
         bool loadImage(const char* filePath, int width = -1, int height = -1);
         bool loadImage(int resourceID, int width = -1, int height = -1);
+#endif
         Canvas& clear(Color color = 0xFFFFFFFF);
         Canvas& blit(const Canvas& src, int DstX = 0, int DstY = 0);
         Canvas& crop(int x, int y, int width, int height);
         Canvas& resize(int width, int height);
         Canvas& resizeBuffer(int width, int height, uint32_t clearColor = 0xFFFFFFFF);
-        // ϲ
+        // 像素格式：premultiply / unpremultiply 就地转换并标记整块为脏
+        PixelFormat format() const;
+        Canvas& premultiply();
+        Canvas& unpremultiply();
+        // 混合操作
+        // Mode：0 alpha，1 add，2 multiply，3 screen，4 overlay，5 destAlpha
         Canvas& blend(const Canvas& src, int x = 0, int y = 0, int alpha = 255, int Mode = 0);
+        Canvas& blend(const Canvas& src, int x, int y, int alpha, BlendMode mode);
         Canvas& alphaBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
         Canvas& addBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
         Canvas& multiplyBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
         Canvas& screenBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
         Canvas& overlayBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
         Canvas& destAlphaBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
-        // 任
+        // 变换操作
         Canvas& draw(const Canvas& src, float centerX, float centerY, int alpha = 255);
         Canvas& drawRotated(const Canvas& src, float centerX, float centerY, float rotation);
         Canvas& drawScaled(const Canvas& src, float centerX, float centerY, float scaleX, float scaleY);
@@ -68,15 +96,24 @@ namespace pa2d {
         Canvas& drawScaled(const Canvas& src, float centerX, float centerY, float scale);
         Canvas& drawTransformed(const Canvas& src, float centerX, float centerY, float scale, float rotation);
         Canvas& drawTransformed(const Canvas& src, float centerX, float centerY, float scaleX, float scaleY, float rotation);
-        // 任ĸ
+        // 图集区域：以图集页面中的视图为源，不复制像素；摆放与对应的 Canvas 版本相同
+        Canvas& blit(Atlas& atlas, const AtlasRegion& region, int dstX = 0, int dstY = 0);
+        Canvas& draw(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, int alpha = 255);
+        Canvas& drawScaled(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scaleX, float scaleY);
+        Canvas& drawScaled(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scale);
+        Canvas& drawTransformed(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scale, float rotation);
+        // 创建变换后的副本
         Canvas cropped(int x, int y, int width, int height) const;
         Canvas scaled(float scaleX, float scaleY) const;
         Canvas resized(int width, int height) const;
         Canvas scaled(float scale) const;
+        Canvas resized(int width, int height, ResampleFilter filter) const;
+        Canvas scaled(float scaleX, float scaleY, ResampleFilter filter) const;
+        Canvas upscaled(int factor) const;
         Canvas rotated(float rotation) const;
         Canvas transformed(float scale, float rotation) const;
         Canvas transformed(float scaleX, float scaleY, float rotation) const;
-        // Ʒ
+        // 基础绘制方法
         Canvas& rect(float x, float y, float width, float height, const Style& style);
         Canvas& rect(float centerX, float centerY, float width, float height, float angle, const Style& style);
         Canvas& circle(float centerX, float centerY, float radius, const Style& style);
@@ -87,9 +124,14 @@ namespace pa2d {
         Canvas& line(float x0, float y0, float x1, float y1, const Style& style);
         Canvas& polyline(const std::vector<Point>& points, const Style& style, bool closed = false);
         Canvas& polygon(const std::vector<Point>& vertices, const Style& style);
-        // ܻƺ
+        // 智能绘制函数
         Canvas& draw(const Shape& shape, const Style& style);
-        // ıƷ
+        // 回放命令列表
+        Canvas& replay(const CommandList& commands);
+        // 批量绘制精灵
+        Canvas& drawSprites(SpriteBatch& batch);
+#ifndef PA2D_HEADLESS
+        // 文本绘制方法
         Canvas& text(int x, int y, const std::wstring& text, int fontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::wstring& fontName = L"Microsoft YaHei");
         Canvas& text(int x, int y, const std::string& text, int fontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::string& fontName = "Microsoft YaHei");
         Canvas& textCentered(int centerX, int centerY, const std::wstring& text, int fontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::wstring& fontName = L"Microsoft YaHei");
@@ -98,5 +140,6 @@ namespace pa2d {
         Canvas& textInRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::string& text, int fontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::string& fontName = "Microsoft YaHei");
         Canvas& textFitRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::wstring& text, int preferredFontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::wstring& fontName = L"Microsoft YaHei");
         Canvas& textFitRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::string& text, int preferredFontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::string& fontName = "Microsoft YaHei");
+#endif
     };
 } // namespace pa2d
\ No newline at end of file
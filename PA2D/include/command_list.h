@@ -0,0 +1,77 @@
+#pragma once
+#include "buffer.h"
+#include "style.h"
+#include "geometry.h"
+#include <cstdint>
+#include <vector>
+namespace pa2d {
+    // 绘制命令列表（显示列表）：先录制绘制调用，之后回放到任意 Buffer
+    // clear() 保留已分配的容量，逐帧重新录制同一场景时不再分配内存
+    class CommandList {
+    public:
+        enum class Op : uint8_t {
+            Rect,               // p = left, top, width, height
+            RectRotated,        // p = centerX, centerY, width, height, angle
+            Circle,             // p = centerX, centerY, radius
+            Ellipse,            // p = cx, cy, width, height
+            EllipseRotated,     // p = cx, cy, width, height, angle
+            Triangle,           // p = ax, ay, bx, by, cx, cy
+            Sector,             // p = cx, cy, radius, startAngleDeg, endAngleDeg
+            Line,               // p = x0, y0, x1, y1
+            Polyline,           // 顶点位于 points(cmd)
+            Polygon             // 顶点位于 points(cmd)
+        };
+
+        struct Command {
+            Op op;
+            bool closed;            // 仅 Polyline 使用
+            uint32_t styleIndex;    // 样式池下标，连续相同的样式只存一份
+            uint32_t pointOffset;   // Polyline/Polygon 顶点在顶点池中的起始位置
+            uint32_t pointCount;
+            float p[6];             // 几何参数，含义由 op 决定
+            // 保守包围盒（已包含描边与抗锯齿余量），用于回放时剔除
+            float minX, minY, maxX, maxY;
+        };
+
+    private:
+        std::vector<Command> commands_;
+        std::vector<Style> styles_;
+        std::vector<Point> points_;     // 所有折线与多边形的顶点依次排列
+
+        Command& push(Op op, const Style& style);
+        Command& pushPath(Op op, const std::vector<Point>& points, const Style& style);
+        void setBounds(Command& cmd, float minX, float minY, float maxX, float maxY) const;
+
+    public:
+        CommandList() = default;
+
+        // 清空命令（保留容量）
+        CommandList& clear();
+        CommandList& reserve(size_t count);
+        size_t size() const { return commands_.size(); }
+        bool empty() const { return commands_.empty(); }
+
+        // 已录制的命令，按录制顺序排列
+        const std::vector<Command>& commands() const { return commands_; }
+        const Style& style(const Command& cmd) const { return styles_[cmd.styleIndex]; }
+        const Point* points(const Command& cmd) const { return points_.data() + cmd.pointOffset; }
+
+        // 录制方法（参数与 Canvas 同名方法一致）
+        CommandList& rect(float x, float y, float width, float height, const Style& style);
+        CommandList& rect(float centerX, float centerY, float width, float height, float angle, const Style& style);
+        CommandList& circle(float centerX, float centerY, float radius, const Style& style);
+        CommandList& ellipse(float cx, float cy, float width, float height, const Style& style);
+        CommandList& ellipse(float cx, float cy, float width, float height, float angle, const Style& style);
+        CommandList& triangle(float ax, float ay, float bx, float by, float cx, float cy, const Style& style);
+        CommandList& sector(float cx, float cy, float radius, float startAngleDeg, float endAngleDeg, const Style& style);
+        CommandList& line(float x0, float y0, float x1, float y1, const Style& style);
+        CommandList& polyline(const std::vector<Point>& points, const Style& style, bool closed = false);
+        CommandList& polygon(const std::vector<Point>& vertices, const Style& style);
+        CommandList& draw(const Shape& shape, const Style& style);
+
+        // 按录制顺序回放到目标缓冲区，包围盒完全位于缓冲区外的命令被跳过
+        void replay(Buffer& target) const;
+        // 回放单条命令（不做剔除）
+        void execute(Buffer& target, const Command& cmd) const;
+    };
+}
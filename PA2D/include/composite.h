@@ -0,0 +1,9 @@
+#pragma once
+namespace pa2d {
+    // 图形合成模式（默认 Precise）
+    // Precise：浮点合成，按输出 alpha 做除法
+    // Fast：目标像素不透明时改用 16 位定点合成，与 Precise 相差不超过 1；半透明目标仍走浮点路径
+    enum class CompositeMode { Precise, Fast };
+    void setCompositeMode(CompositeMode mode);
+    CompositeMode getCompositeMode();
+}
\ No newline at end of file
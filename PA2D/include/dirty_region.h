@@ -0,0 +1,26 @@
+#pragma once
+#include "geometry/point.h"
+#include <vector>
+
+namespace pa2d {
+    // 脏区域：记录自上次重置以来被修改过的像素矩形集合
+    // 重叠或相邻的矩形在加入时合并；数量超过上限时合并浪费面积最小的一对
+    // 整块标记（markAll）只记录一个标志与尺寸，不分配内存，可在 noexcept 的移动操作中使用；首次读取 rects() 或再次 add 时才展开为矩形
+    class DirtyRegion {
+    private:
+        mutable std::vector<RectInt> rects_;
+        mutable bool all_ = false;
+        RectInt allRect_ = { 0, 0, 0, 0 };
+        void expandAll() const;
+    public:
+        static const int MAX_RECTS = 16;
+        void add(const RectInt& rect);
+        void add(int x, int y, int width, int height);
+        // 以 (0, 0, width, height) 整块替换现有内容，宽高不为正时等同 clear()
+        void markAll(int width, int height) noexcept;
+        void clear() noexcept { rects_.clear(); all_ = false; }
+        bool empty() const { return !all_ && rects_.empty(); }
+        const std::vector<RectInt>& rects() const;
+        RectInt bounds() const;
+    };
+}
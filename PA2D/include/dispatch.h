@@ -0,0 +1,12 @@
+#pragma once
+namespace pa2d {
+    // SIMD 指令集等级，启动时按 CPU 选择对应的像素内核（清屏、拷贝、blit、混合模式）
+    // 所有内核（行操作、图形光栅化、图像采样与重采样）都有 SSE4.1 版本，不支持 AVX2 的处理器同样可用
+    enum class SimdLevel { SSE41, AVX2, AVX512 };
+    // CPU 与操作系统共同支持的最高等级
+    SimdLevel getCpuSimdLevel();
+    // 当前使用的内核等级
+    SimdLevel getSimdLevel();
+    // 指定内核等级（用于对比测试），不会超过 getCpuSimdLevel()
+    void setSimdLevel(SimdLevel level);
+}
\ No newline at end of file
@@ -9,6 +9,9 @@ namespace pa2d {
     void line(Buffer& buffer, float startX, float startY, float endX, float endY, const Color& color, float width);
     void polyline(Buffer& buffer, const std::vector<Point>& points, const Color& color, float width, bool closed);
     void polygon(Buffer& buffer, const std::vector<Point>& vertices, const Color& fillColor, const Color& strokeColor, float strokeWidth);
+    // 顶点以指针与个数给出（如连续存放的顶点池），与上面两个函数相同
+    void polyline(Buffer& buffer, const Point* points, size_t count, const Color& color, float width, bool closed);
+    void polygon(Buffer& buffer, const Point* vertices, size_t count, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void triangle(Buffer& buffer, float x0, float y0, float x1, float y1, float x2, float y2, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void rect(Buffer& buffer, float left, float top, float width, float height, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void rect(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, const Color& fillColor, const Color& strokeColor, float strokeWidth);
@@ -14,21 +14,21 @@ namespace pa2d {
         Circle(float centerX, float centerY, float radius);
         Circle(const Point& center, float radius);
 
-        // 
+        // 属性设置
         Circle& x(float x);
         Circle& y(float y);
         Circle& center(const Point& center);
         Circle& center(float x, float y);
         Circle& radius(float radius);
 
-        // Իȡ
+        // 属性获取
         float x() const;
         float y() const;
         Point center() const;
         Point& center();
         float radius() const;
 
-        // 任
+        // 变换方法
         virtual Circle& translate(float dx, float dy) override;
         virtual Circle& translate(Point delta) override;
         virtual Circle& scale(float factor) override;
@@ -40,12 +40,12 @@ namespace pa2d {
         virtual Circle& rotate(float angleDegrees) override;
         virtual Circle& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator Point() const;
     };
 }
@@ -15,7 +15,7 @@ namespace pa2d {
         Elliptic();
         Elliptic(float centerX, float centerY, float width, float height, float rotation = 0.0f);
 
-        // 
+        // 属性设置
         Elliptic& x(float x);
         Elliptic& y(float y);
         Elliptic& center(const Point& center);
@@ -24,7 +24,7 @@ namespace pa2d {
         Elliptic& height(float height);
         Elliptic& rotation(float rotation);
 
-        // Իȡ
+        // 属性获取
         float x() const;
         float y() const;
         Point center() const;
@@ -33,7 +33,7 @@ namespace pa2d {
         float height() const;
         float rotation() const;
 
-        // 任
+        // 变换方法
         virtual Elliptic& translate(float dx, float dy) override;
         virtual Elliptic& translate(Point delta) override;
         virtual Elliptic& scale(float factor) override;
@@ -45,12 +45,12 @@ namespace pa2d {
         virtual Elliptic& rotate(float angleDegrees) override;
         virtual Elliptic& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator Point() const;
     };
 }
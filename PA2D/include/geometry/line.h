@@ -13,7 +13,7 @@ namespace pa2d {
         Line(float x0, float y0, float x1, float y1);
         Line(const Point& start, const Point& end);
 
-        // ˵
+        // 端点操作
         Line& start(float x, float y);
         Line& start(const Point& start);
         Line& end(float x, float y);
@@ -23,7 +23,7 @@ namespace pa2d {
         Point start() const;
         Point end() const;
 
-        // 任
+        // 变换方法
         virtual Line& translate(float dx, float dy) override;
         virtual Line& translate(Point delta) override;
         virtual Line& scale(float factor) override;
@@ -35,12 +35,12 @@ namespace pa2d {
         virtual Line& rotate(float angleDegrees) override;
         virtual Line& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator std::vector<Point>() const;
     };
 }
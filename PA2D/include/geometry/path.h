@@ -15,7 +15,7 @@ namespace pa2d {
             Builder(Builder&&) = default;
             Builder& operator=(Builder&&) = default;
 
-            // 
+            // 构建方法
             Builder move(float dx, float dy) &&;
             Builder moveTo(float x, float y) &&;
             Builder translate(float dx, float dy) &&;
@@ -27,7 +27,7 @@ namespace pa2d {
             Builder rotate(float angleDegrees, float centerX, float centerY) &&;
             Builder rotateOnSelf(float angleDegrees) &&;
 
-            // תΪ״
+            // 转换为具体形状
             template<typename T>
             T to() && {
                 return T(std::move(points_));
@@ -9,7 +9,7 @@ namespace pa2d {
         Point() = default;
         Point(float x, float y);
 
-        // 
+        // 运算符重载
         Point operator+(const Point&) const;
         Point& operator+=(const Point&);
         Point operator-(const Point&) const;
@@ -29,7 +29,7 @@ namespace pa2d {
 
         friend Point operator*(float, const Point&);
 
-        // 任
+        // 变换方法
         Point& translate(float dx, float dy);
         Point& scale(float factorX, float factorY);
         Point& scale(float factor);
@@ -43,5 +43,9 @@ namespace pa2d {
     struct Size {
         int width, height;
     };
+
+    struct RectInt {
+        int x, y, width, height;
+    };
 }
 #endif // !POINT_H
\ No newline at end of file
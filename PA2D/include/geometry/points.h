@@ -14,7 +14,7 @@ namespace pa2d {
 
         Points& operator=(const std::vector<Point>& points);
 
-        // 任
+        // 变换方法
         virtual Points& translate(float dx, float dy) override;
         virtual Points& translate(Point delta) override;
         virtual Points& scale(float factor) override;
@@ -26,12 +26,12 @@ namespace pa2d {
         virtual Points& rotate(float angleDegrees) override;
         virtual Points& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator std::vector<Point>() const;
         operator const std::vector<Point>&() const;
     };
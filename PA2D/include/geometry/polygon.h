@@ -20,7 +20,7 @@ namespace pa2d {
         std::vector<Point>& getPoints();
         const std::vector<Point>& getPoints() const;
 
-        // 任
+        // 变换方法
         virtual Polygon& translate(float dx, float dy) override;
         virtual Polygon& translate(Point delta) override;
         virtual Polygon& scale(float factor) override;
@@ -32,12 +32,12 @@ namespace pa2d {
         virtual Polygon& rotate(float angleDegrees) override;
         virtual Polygon& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator std::vector<Point>() const;
         operator const std::vector<Point>&() const;
     };
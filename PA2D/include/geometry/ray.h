@@ -15,7 +15,7 @@ namespace pa2d {
         Ray(const Point& start, const Point& end);
         Ray(const Point& start, float length = 0.0f, float angle = 0.0f);
 
-        // ˵
+        // 端点操作
         Ray& start(float x, float y);
         Ray& start(const Point& start);
         Ray& end(float x, float y);
@@ -23,7 +23,7 @@ namespace pa2d {
         Point start() const;
         Point end() const;
 
-        // в
+        // 射线特有操作
         Ray& angle(float angle);
         float angle() const;
         Ray& length(float length);
@@ -32,7 +32,7 @@ namespace pa2d {
         Ray& stretch(float factor);
         Ray& spin(float angle);
 
-        // 任
+        // 变换方法
         virtual Ray& translate(float dx, float dy) override;
         virtual Ray& translate(Point delta) override;
         virtual Ray& scale(float factor) override;
@@ -44,12 +44,12 @@ namespace pa2d {
         virtual Ray& rotate(float angleDegrees) override;
         virtual Ray& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator std::vector<Point>() const;
     };
 }
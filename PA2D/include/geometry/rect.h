@@ -23,20 +23,20 @@ namespace pa2d {
         Rect(const std::vector<Point>& points);
         Rect& operator=(const std::vector<Point>& points);
 
-        // 
+        // 属性设置
         Rect& center(const Point& center);
         Rect& center(float x, float y);
         Rect& width(float width);
         Rect& height(float height);
         Rect& rotation(float rotation);
 
-        // Իȡ
+        // 属性获取
         Point center() const;
         float width() const;
         float height() const;
         float rotation() const;
 
-        // ֧
+        // 迭代器支持
         auto begin();
         auto end();
         auto begin() const;
@@ -44,7 +44,7 @@ namespace pa2d {
         Point& operator[](size_t index);
         const Point& operator[](size_t index) const;
 
-        // 任
+        // 变换方法
         virtual Rect& translate(float dx, float dy) override;
         virtual Rect& translate(Point delta) override;
         virtual Rect& scale(float factor) override;
@@ -56,12 +56,12 @@ namespace pa2d {
         virtual Rect& rotate(float angleDegrees) override;
         virtual Rect& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator std::vector<Point>() const;
     };
 }
@@ -19,7 +19,7 @@ namespace pa2d {
         Sector(Point center, float radius, float startAngle = 0.0f, float endAngle = 360.0f);
         Sector(float centerX, float centerY, float radius, float startAngle = 0.0f, float endAngle = 360.0f);
 
-        // 
+        // 属性设置
         Sector& x(float x);
         Sector& y(float y);
         Sector& center(const Point& center);
@@ -28,7 +28,7 @@ namespace pa2d {
         Sector& startAngle(float startAngle);
         Sector& endAngle(float endAngle);
 
-        // Իȡ
+        // 属性获取
         float x() const;
         float y() const;
         Point center() const;
@@ -37,7 +37,7 @@ namespace pa2d {
         float startAngle() const;
         float endAngle() const;
 
-        // 任
+        // 变换方法
         virtual Sector& translate(float dx, float dy) override;
         virtual Sector& translate(Point delta) override;
         virtual Sector& scale(float factor) override;
@@ -49,12 +49,12 @@ namespace pa2d {
         virtual Sector& rotate(float angleDegrees) override;
         virtual Sector& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator Point() const;
     };
 }
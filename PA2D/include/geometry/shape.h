@@ -4,7 +4,7 @@
 #ifndef SHAPE_H
 #define SHAPE_H
 namespace pa2d {
-    class Rect;  // ǰ
+    class Rect;  // 前向声明
     class Shape {
     public:
         enum class GeometryType {
@@ -20,23 +20,23 @@ namespace pa2d {
         };
         GeometryType getType() const { return type_; }
 
-        // ƽ
+        // 平移
         virtual Shape& translate(float dx, float dy) = 0;
         virtual Shape& translate(Point delta) = 0;
 
-        // 
+        // 缩放
         virtual Shape& scale(float factor) = 0;
         virtual Shape& scale(float factorX, float factorY) = 0;
         virtual Shape& scaleOnSelf(float factorX, float factorY) = 0;
         virtual Shape& scaleOnSelf(float factor) = 0;
 
-        // ת
+        // 旋转
         virtual Shape& rotate(float angleDegrees, float centerX, float centerY) = 0;
         virtual Shape& rotate(float angleDegrees, Point center) = 0;
         virtual Shape& rotate(float angleDegrees) = 0;
         virtual Shape& rotateOnSelf(float angleDegrees) = 0;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const = 0;
         virtual Rect getBoundingBox() const = 0;
         virtual Point getCenter() const = 0;
@@ -17,7 +17,7 @@ namespace pa2d {
         Triangle(const std::vector<Point>& points);
         Triangle& operator=(const std::vector<Point>& points);
 
-        // ֧
+        // 迭代器支持
         auto begin();
         auto end();
         auto begin() const;
@@ -25,7 +25,7 @@ namespace pa2d {
         Point& operator[](size_t index);
         const Point& operator[](size_t index) const;
 
-        // 任
+        // 变换方法
         virtual Triangle& translate(float dx, float dy) override;
         virtual Triangle& translate(Point delta) override;
         virtual Triangle& scale(float factor) override;
@@ -37,12 +37,12 @@ namespace pa2d {
         virtual Triangle& rotate(float angleDegrees) override;
         virtual Triangle& rotateOnSelf(float angleDegrees) override;
 
-        // μ
+        // 几何计算
         virtual bool contains(Point point) const override;
         virtual Rect getBoundingBox() const override;
         virtual Point getCenter() const override;
 
-        // ת
+        // 转换运算符
         operator std::vector<Point>() const;
     };
 }
@@ -0,0 +1,30 @@
+#pragma once
+#include "buffer.h"
+#include <vector>
+namespace pa2d {
+    // 图像金字塔：第 0 级为源图副本，之后每级由上一级 halved() 得到，直到 1x1（或 maxLevels 级）
+    // 同一张图反复以不同比例缩小绘制时（缩略图、地图缩放）构建一次，之后每次只需从最接近的一级做一次双线性
+    class MipChain {
+    public:
+        MipChain() = default;
+        explicit MipChain(const Buffer& src, int maxLevels = 0);
+        // 重新构建；maxLevels <= 0 表示不限
+        void build(const Buffer& src, int maxLevels = 0);
+        void clear() { levels_.clear(); }
+        bool isValid() const { return !levels_.empty(); }
+        int levels() const { return static_cast<int>(levels_.size()); }
+        const Buffer& level(int index) const { return levels_[index]; }
+        // 宽高都不小于目标尺寸的最小一级
+        int levelFor(int width, int height) const;
+        // 与 pa2d::resized / scaled 结果一致，但省去从源图逐级减半
+        Buffer resized(int width, int height) const;
+        Buffer scaled(float scaleX, float scaleY) const;
+        Buffer scaled(float factor) const;
+        // 与 pa2d::drawScaled / drawResized 相同的摆放，采样取自最接近的一级
+        void drawScaled(Buffer& dest, float centerX, float centerY, float scaleX, float scaleY) const;
+        void drawScaled(Buffer& dest, float centerX, float centerY, float scale) const;
+        void drawResized(Buffer& dest, float centerX, float centerY, int width, int height) const;
+    private:
+        std::vector<Buffer> levels_;
+    };
+}
\ No newline at end of file
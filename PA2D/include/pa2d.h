@@ -13,9 +13,9 @@
 //   - Multi-window support
 //
 // Requirements:
-//   - Windows 7+
-//   - C++11 compiler (VS2015+ recommended)
-//   - AVX2 CPU for best performance
+//   - Windows 7+ (define PA2D_HEADLESS for the window-less Linux/GCC/Clang build)
+//   - C++14 compiler (VS2017+ recommended)
+//   - SSE4.1 CPU (AVX2 for best performance)
 #include <vector>
 #include <array> 
 #include <cstdint>
@@ -25,8 +25,8 @@ namespace pa2d {
     // ==================== VERSION ====================
     const char* getVersion();
     // ==================== CPU REQUIREMENT ====================
-    // AVX2 hardware requirement check - executes at program startup
-    // If CPU lacks AVX2 support, displays error message and terminates
+    // Baseline CPU check (SSE4.1) - executes at program startup
+    // AVX2/AVX-512 kernels are enabled at runtime when available; the name is kept for compatibility
     static const struct AVX2_Verifier {
         AVX2_Verifier();
     }AVX2_CHECK_INSTANCE;
@@ -45,26 +45,130 @@ namespace pa2d {
         operator uint32_t() const { return data; }
     };
     extern const Color White, Black, None, Red, Green, Blue, Cyan, Magenta, Yellow, Gray, LightGray, DarkGray;
+    // ==================== BUFFER ALLOCATOR ====================
+    // Every Buffer allocates its pixels from the current allocator and frees them through the one that allocated them
+    // allocate() returns BUFFER_ALIGNMENT-aligned, uninitialized memory; an allocator must outlive its Buffers
+    const size_t BUFFER_ALIGNMENT = 64;
+    class BufferAllocator {
+    public:
+        virtual ~BufferAllocator() = default;
+        virtual Color* allocate(size_t count) = 0;
+        virtual void deallocate(Color* pixels, size_t count) = 0;
+    };
+    BufferAllocator& heapAllocator();      // Default: aligned system heap
+    // Size-class pool: requests round up to 4 classes per power of two (<= 25% waste)
+    // Freed blocks are cached per class and reused; cache above maxCachedBytes goes back upstream. Thread-safe
+    class PoolAllocator : public BufferAllocator {
+    public:
+        explicit PoolAllocator(size_t maxCachedBytes = size_t(256) << 20, BufferAllocator& upstream = heapAllocator());
+        ~PoolAllocator() override;
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+        Color* allocate(size_t count) override;
+        void deallocate(Color* pixels, size_t count) override;
+        void trim();                       // Release every cached block
+        size_t cachedBytes() const;
+    private:
+        struct Impl; Impl* impl_;
+    };
+    // Per-frame arena: bump allocation from one reserved block, overflow goes upstream. Thread-safe
+    // Freeing the newest block rewinds immediately; the arena rewinds fully once every block is freed
+    // reset() rewinds unconditionally - destroy the arena's Buffers first
+    class FrameArena : public BufferAllocator {
+    public:
+        explicit FrameArena(size_t capacityBytes, BufferAllocator& upstream = heapAllocator());
+        ~FrameArena() override;
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        Color* allocate(size_t count) override;
+        void deallocate(Color* pixels, size_t count) override;
+        void reset();
+        size_t usedBytes() const;
+        size_t capacity() const;
+    private:
+        struct Impl; Impl* impl_;
+    };
+    // Row alignment of newly allocated Buffers in bytes (default 0 = tightly packed, stride == width)
+    // 32 / 64 pad the stride to a multiple of 8 / 16 pixels so every row starts aligned;
+    // clear, copy and blit then use aligned, tail-free kernels on whole rows
+    void setBufferRowAlignment(size_t bytes);
+    size_t getBufferRowAlignment();
+    void setBufferAllocator(BufferAllocator* allocator);  // Process-wide allocator, nullptr = heapAllocator()
+    BufferAllocator& getBufferAllocator();                // Scoped allocator of this thread, else the process-wide one
+    // Overrides the allocator for the current thread until destroyed, e.g. a FrameArena for one frame
+    class BufferAllocatorScope {
+    public:
+        explicit BufferAllocatorScope(BufferAllocator& allocator);
+        ~BufferAllocatorScope();
+        BufferAllocatorScope(const BufferAllocatorScope&) = delete;
+        BufferAllocatorScope& operator=(const BufferAllocatorScope&) = delete;
+    private:
+        BufferAllocator* previous_;
+    };
     // ==================== BUFFER ====================
     // Pixel buffer container with SIMD-optimized operations
     // Note: For best performance, access color pointer directly instead of using at()
+    // Rows are stride pixels apart: row y starts at color + y * stride
     // All rendering is off-screen to Buffers - Window renders Buffer to display
+    // Pixel format tag: straight (default) or premultiplied ARGB32. Rasterizer compositing, alphaBlend, blend,
+    // drawScaled and drawResized pick their formula from it; premultiplied source-over needs no division
+    enum class PixelFormat { Straight, Premultiplied };
+    struct BufferView;
     struct Buffer {
         Color* color;        // Direct pixel data access (row-major layout)
         int width, height;
+        int stride = 0;      // Row pitch in pixels (>= width; padded per setBufferRowAlignment)
+        BufferAllocator* allocator = nullptr; // Allocator owning color, maintained by Buffer; nullptr for views
+        PixelFormat format = PixelFormat::Straight; // Tag only - use premultiply()/unpremultiply() to convert pixels
         Buffer(int width = 0, int height = 0, const Color& color = None);
         Buffer(const Buffer& rhs);
         Buffer(Buffer&& rhs) noexcept;
         ~Buffer();
         size_t size() const { return (size_t)width * height; }
+        bool isContiguous() const { return stride == width; }
+        bool isPremultiplied() const { return format == PixelFormat::Premultiplied; }
+        bool isRowAligned() const { return stride % 8 == 0 && ((uintptr_t)color & 31) == 0; } // Every row 32-byte aligned
         Color& at(int x, int y);
         const Color& at(int x, int y) const;
+        Color* getRow(int y);
+        const Color* getRow(int y) const;
         void resize(int width, int height, const Color& color = None);
         void clear(const Color& color = None);
+        void clearStreaming(const Color& color = None); // Always non-temporal stores, regardless of StoreMode
+        BufferView view(int x, int y, int width, int height); // O(1) sub-rectangle, clipped to the buffer
         Buffer& operator=(const Buffer& rhs);
-        Buffer& operator=(Buffer&& rhs) noexcept;
+        Buffer& operator=(Buffer&& rhs) noexcept; // Moves never allocate; a moved view stays a view
+        Buffer(BufferView&& rhs) = delete;            // Use crop() or copy from an lvalue for an owned copy
+        Buffer& operator=(BufferView&& rhs) = delete;
         explicit operator bool() const { return color && width > 0 && height > 0; }
     };
+    // Non-owning window into another buffer's pixels (keeps the parent's stride)
+    // Pass it wherever a Buffer& is taken to draw, blend or transform into that region
+    // Copying a view copies the pointer; copying a view into a Buffer copies the pixels
+    // Assigning pixels into a view through Buffer& writes the viewed region and requires the same size
+    // The viewed storage must outlive the view
+    struct BufferView : Buffer {
+        BufferView() = default;
+        BufferView(Color* pixels, int width, int height, int stride);
+        BufferView(const BufferView& rhs);
+        BufferView& operator=(const BufferView& rhs);
+    };
+    // ==================== BLEND MODES ====================
+    // W3C Compositing and Blending Level 1; As/Ad are source/destination alpha, Cs/Cd straight colors
+    // Porter-Duff operators weight source and destination by Fa/Fb: Out = Src*As*Fa + Dst*Ad*Fb
+    //   SrcOver (default, Fa=1, Fb=1-As), DstOver, Clear, Src, Dst, SrcIn, DstIn, SrcOut, DstOut, SrcAtop, DstAtop, Xor
+    // Separable modes composite as SrcOver with B(Cs, Cd) where source and destination overlap
+    // DestAlpha scales the source by the destination alpha (destAlphaBlend); opacity scales As
+    // Antialiasing coverage scales As too, except for Clear/Src/SrcIn/DstIn/SrcOut/DstAtop, which rewrite
+    // the destination even where As = 0: those blend at full coverage and interpolate lerp(dst, result, coverage)
+    // All modes read and write both pixel formats
+    enum class BlendMode {
+        SrcOver, Clear, Src, Dst, DstOver, SrcIn, DstIn, SrcOut, DstOut, SrcAtop, DstAtop, Xor,
+        Add, Subtract, Multiply, Screen, Overlay, Darken, Lighten,
+        ColorDodge, ColorBurn, HardLight, SoftLight, Difference, Exclusion,
+        DestAlpha
+    };
+#ifndef PA2D_HEADLESS
     // ==================== TEXT STYLES ====================
     // Windows GDI text rendering (anti-aliasing optional)
     void setTextAntialias(bool enable);
@@ -83,10 +187,15 @@ namespace pa2d {
         bool operator&(const FontStyle& rhs) const;
         bool operator==(const FontStyle& rhs) const;
     };
+#endif
     // ==================== GEOMETRY STYLE ====================
     // Fluent-style drawing configuration with user-defined literals
     // Use: Style().fill(Red).stroke(Black).width(2.0f) 
     // Or:  0xffff0000_fill + 0xff000000_stroke + 2.0_w + 5.0_r
+    // blend/opacity apply in each rasterizer's composite step (no temporary canvas):
+    //      Style().fill(glow).blend(BlendMode::Add).opacity(0.5f)
+    // Only pixels the shape covers are touched; opacity scales the source alpha and edge coverage
+    // interpolates between the destination and the blended result (see BlendMode).
     struct Style {
         Color fill_;        Style& fill(Color);
         Color stroke_;      Style& stroke(Color);
@@ -94,7 +203,10 @@ namespace pa2d {
         float radius_ ;     Style& radius(float);
         bool arc_;          Style& arc(bool);
         bool edges_;        Style& edges(bool);
-        Style(Color fill_ = 0, Color stroke_ = 0, float width_ = 1.0f, float radius_ = 0.0f, bool arc_ = true, bool edges_ = true);
+        BlendMode blend_;   Style& blend(BlendMode);    // default SrcOver
+        float opacity_;     Style& opacity(float);      // layer opacity 0..1, default 1
+        Style(Color fill_ = 0, Color stroke_ = 0, float width_ = 1.0f, float radius_ = 0.0f, bool arc_ = true, bool edges_ = true,
+              BlendMode blend_ = BlendMode::SrcOver, float opacity_ = 1.0f);
         Style operator+(const Style& rhs) const;
         Style& operator+=(const Style& rhs);
     };
@@ -121,6 +233,7 @@ namespace pa2d {
     };
     struct PointInt { int x, y; };
     struct Size { int width, height; };
+    struct RectInt { int x, y, width, height; };
     class Rect;
     // ==================== SHAPE SYSTEM MACROS ====================
     // Helper macros for uniform shape interface declaration
@@ -317,12 +430,233 @@ namespace pa2d {
         static Builder from(float x, float y);
         static Builder from(const Point& start);
     };
+    // ==================== COMMAND LIST ====================
+    // Display list: record draw calls once, replay them onto any Buffer later
+    // clear() keeps allocated capacity, so re-recording a scene every frame does not allocate
+    // Each command stores a conservative bounding box; replay skips commands outside the target
+    class CommandList {
+    public:
+        enum class Op : uint8_t { Rect, RectRotated, Circle, Ellipse, EllipseRotated, Triangle, Sector, Line, Polyline, Polygon };
+        // Styles and polyline/polygon vertices live in shared pools; commands refer to them by index
+        struct Command {
+            Op op;
+            bool closed;
+            uint32_t styleIndex;
+            uint32_t pointOffset;
+            uint32_t pointCount;
+            float p[6];
+            float minX, minY, maxX, maxY;
+        };
+    private:
+        std::vector<Command> commands_;
+        std::vector<Style> styles_;
+        std::vector<Point> points_;
+        Command& push(Op op, const Style& style);
+        Command& pushPath(Op op, const std::vector<Point>& points, const Style& style);
+        void setBounds(Command& cmd, float minX, float minY, float maxX, float maxY) const;
+    public:
+        CommandList() = default;
+        CommandList& clear();
+        CommandList& reserve(size_t count);
+        size_t size() const { return commands_.size(); }
+        bool empty() const { return commands_.empty(); }
+        const std::vector<Command>& commands() const { return commands_; }
+        const Style& style(const Command& cmd) const { return styles_[cmd.styleIndex]; }
+        const Point* points(const Command& cmd) const { return points_.data() + cmd.pointOffset; }
+        CommandList& rect(float left, float top, float width, float height, const Style& style);
+        CommandList& rect(float centerX, float centerY, float width, float height, float angle, const Style& style);
+        CommandList& circle(float centerX, float centerY, float radius, const Style& style);
+        CommandList& ellipse(float centerX, float centerY, float width, float height, const Style& style);
+        CommandList& ellipse(float centerX, float centerY, float width, float height, float angle, const Style& style);
+        CommandList& triangle(float x0, float y0, float x1, float y1, float x2, float y2, const Style& style);
+        CommandList& sector(float centerX, float centerY, float radius, float startAngle, float endAngle, const Style& style);
+        CommandList& line(float startX, float startY, float endX, float endY, const Style& style);
+        CommandList& polyline(const std::vector<Point>& points, const Style& style, bool closed = false);
+        CommandList& polygon(const std::vector<Point>& vertices, const Style& style);
+        CommandList& draw(const Shape& shape, const Style& style);
+        void replay(Buffer& target) const;
+        void execute(Buffer& target, const Command& cmd) const;
+    };
+    // ==================== TILE RENDERER ====================
+    // Bins CommandList entries into fixed-size screen tiles by bounding box, then rasterizes
+    // each tile with only the commands touching it so the tile stays resident in L1/L2
+    // Tiles are rendered in parallel when setRenderThreads() enables the worker pool
+    // Output is bit-identical to replay(); tile size is rounded up to a multiple of 8 so tile edges
+    // fall on the rasterizers' 8-pixel groups
+    class TileRenderer {
+        int tileSize_;
+        int tilesX_ = 0, tilesY_ = 0;
+        std::vector<uint32_t> binStart_;
+        std::vector<uint32_t> binItems_;
+        std::vector<uint32_t> binCursor_;
+        void bin(const CommandList& commands, int width, int height);
+    public:
+        static const int DEFAULT_TILE_SIZE = 64;
+        explicit TileRenderer(int tileSize = DEFAULT_TILE_SIZE);
+        int tileSize() const { return tileSize_; }
+        void render(const CommandList& commands, Buffer& target);
+    };
+    // ==================== TEXTURE ATLAS ====================
+    // Packs many small images into one large Buffer: one allocation, better locality when drawing
+    // Skyline packing (lowest resulting top edge first) with incremental insertion, so glyph and
+    // icon caches can share one atlas. Regions never move; a full atlas returns an invalid region
+    // view(region) is a zero-copy BufferView usable as the source of any draw, blend or transform
+    struct AtlasRegion {
+        int x = 0, y = 0, width = 0, height = 0;       // Pixel rect inside the page
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f; // Normalized texture coordinates
+        bool isValid() const { return width > 0 && height > 0; }
+        explicit operator bool() const { return isValid(); }
+    };
+    class Atlas {
+    public:
+        static const int DEFAULT_SIZE = 1024;
+        Atlas() = default;
+        // padding: transparent gap kept between regions; inserted images are converted to the page format
+        explicit Atlas(int width, int height = DEFAULT_SIZE, int padding = 1, PixelFormat format = PixelFormat::Straight);
+        void reset(int width, int height, int padding = 1, PixelFormat format = PixelFormat::Straight);
+        void clear(); // Drops all regions, keeps the page storage
+        AtlasRegion insert(const Buffer& image);
+        // Packs tallest first for a tighter fit; results come back in input order
+        std::vector<AtlasRegion> insert(const std::vector<const Buffer*>& images);
+#ifndef PA2D_HEADLESS
+        AtlasRegion insert(const char* filePath);
+#endif
+        AtlasRegion allocate(int width, int height); // Reserve transparent space, fill it through view()
+        BufferView view(const AtlasRegion& region);
+        bool isValid() const { return static_cast<bool>(page_); }
+        int width() const { return page_.width; }
+        int height() const { return page_.height; }
+        int padding() const { return padding_; }
+        int regionCount() const { return regionCount_; }
+        float occupancy() const; // Allocated pixels / page pixels
+        const Buffer& buffer() const { return page_; }
+        Buffer& buffer() { return page_; }
+    private:
+        struct Segment {
+            int x, y, width;
+        };
+        Buffer page_;
+        int padding_ = 1;
+        int regionCount_ = 0;
+        long long usedArea_ = 0;
+        std::vector<Segment> skyline_;
+        int fitAt(size_t index, int width, int height) const;
+        void placeAt(size_t index, int x, int y, int width, int height);
+        AtlasRegion makeRegion(int x, int y, int width, int height) const;
+    };
+    // ==================== SPRITE BATCH ====================
+    // Batched sprite/particle renderer: record many small image instances per frame, submit once
+    // A sprite is a source rect (whole Buffer when srcWidth/srcHeight are 0, or an atlas sub-rect)
+    // centred at (x, y), scaled then rotated (radians, same direction as drawTransformed),
+    // with its own opacity and blend mode. The source Buffer must outlive render()
+    // render() computes each inverse transform once, bins instances into screen tiles and
+    // rasterizes tile by tile in recording order; rows only visit the span overlapping the sprite
+    // Tiles are rendered in parallel when setRenderThreads() enables the worker pool
+    // Samples the same positions as drawTransformed; scale 1, no rotation and x = integer + width / 2
+    // copy texels exactly
+    struct Sprite {
+        const Buffer* source = nullptr;
+        int srcX = 0, srcY = 0, srcWidth = 0, srcHeight = 0;
+        float x = 0.0f, y = 0.0f;
+        float scaleX = 1.0f, scaleY = 1.0f;
+        float rotation = 0.0f;
+        float opacity = 1.0f;
+        BlendMode blend = BlendMode::SrcOver;
+    };
+    class SpriteBatch {
+    public:
+        static const int DEFAULT_TILE_SIZE = 64;
+        explicit SpriteBatch(int tileSize = DEFAULT_TILE_SIZE);
+        SpriteBatch& clear(); // keeps capacity
+        SpriteBatch& reserve(size_t count);
+        size_t size() const { return sprites_.size(); }
+        bool empty() const { return sprites_.empty(); }
+        const std::vector<Sprite>& sprites() const { return sprites_; }
+        int tileSize() const { return tileSize_; }
+        SpriteBatch& add(const Sprite& sprite);
+        SpriteBatch& add(const Buffer& source, float x, float y, float scale = 1.0f, float rotation = 0.0f,
+                         float opacity = 1.0f, BlendMode blend = BlendMode::SrcOver);
+        SpriteBatch& add(const Buffer& source, int srcX, int srcY, int srcWidth, int srcHeight,
+                         float x, float y, float scale = 1.0f, float rotation = 0.0f,
+                         float opacity = 1.0f, BlendMode blend = BlendMode::SrcOver);
+        // Atlas region as the source rect; invalid regions are ignored
+        SpriteBatch& add(const Atlas& atlas, const AtlasRegion& region, float x, float y, float scale = 1.0f,
+                         float rotation = 0.0f, float opacity = 1.0f, BlendMode blend = BlendMode::SrcOver);
+        void render(Buffer& target);
+    private:
+        struct Instance {
+            const Color* pixels;
+            int stride, width, height;
+            bool premultiplied;
+            float u0, dudx, dudy, v0, dvdx, dvdy;
+            float opacity;
+            BlendMode blend;
+            int minX, minY, maxX, maxY;
+        };
+        int tileSize_;
+        int tilesX_ = 0, tilesY_ = 0;
+        std::vector<Sprite> sprites_;
+        std::vector<Instance> instances_;
+        std::vector<uint32_t> binStart_;
+        std::vector<uint32_t> binItems_;
+        std::vector<uint32_t> binCursor_;
+        void prepare(const Buffer& target);
+        void bin(int width, int height);
+        static void drawInstance(const Instance& inst, Buffer& target, int minX, int minY, int maxX, int maxY);
+    };
+    // ==================== DIRTY REGION ====================
+    // Set of pixel rectangles modified since the last clear()
+    // Overlapping or touching rectangles are merged on insert; past MAX_RECTS the pair
+    // wasting the least area is merged
+    // markAll() only sets a flag (no allocation, safe in noexcept moves); it expands to one rect on first rects()/add()
+    class DirtyRegion {
+        mutable std::vector<RectInt> rects_;
+        mutable bool all_ = false;
+        RectInt allRect_ = { 0, 0, 0, 0 };
+        void expandAll() const;
+    public:
+        static const int MAX_RECTS = 16;
+        void add(const RectInt& rect);
+        void add(int x, int y, int width, int height);
+        void markAll(int width, int height) noexcept; // Replace contents with (0, 0, width, height)
+        void clear() noexcept { rects_.clear(); all_ = false; }
+        bool empty() const { return !all_ && rects_.empty(); }
+        const std::vector<RectInt>& rects() const;
+        RectInt bounds() const;
+    };
+    // ==================== RESAMPLING ====================
+    // Separable two-pass resampling (horizontal, then vertical) with contiguous loads instead of gathers
+    // Nearest; Bilinear (triangle, radius 1); Bicubic (Keys, a = -0.5, radius 2); Lanczos3 (radius 3)
+    // Filters widen by the reduction factor when downscaling, so every covered source pixel contributes
+    enum class ResampleFilter { Nearest, Bilinear, Bicubic, Lanczos3 };
+    // Precomputes per-column/per-row source offsets and 14-bit fixed-point weights for one size pair
+    // Reuse one Resampler for a stream of same-size frames; apply() is const and thread-safe
+    class Resampler {
+    public:
+        Resampler() = default;
+        Resampler(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ResampleFilter filter = ResampleFilter::Bicubic);
+        bool isValid() const { return dstWidth_ > 0 && dstHeight_ > 0; }
+        bool matches(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ResampleFilter filter) const;
+        bool apply(const Buffer& src, Buffer& dest) const; // src must match the source size; dest is reallocated if needed (views must match)
+        Buffer apply(const Buffer& src) const;
+    private:
+        struct Table {
+            int taps = 0;
+            std::vector<int> start;
+            std::vector<int16_t> coeffs;
+        };
+        static Table buildTable(int srcSize, int dstSize, ResampleFilter filter);
+        int srcWidth_ = 0, srcHeight_ = 0, dstWidth_ = 0, dstHeight_ = 0;
+        ResampleFilter filter_ = ResampleFilter::Bicubic;
+        Table horizontal_, vertical_;
+    };
     // ==================== CANVAS ====================
     // High-level drawing interface (proxy for Buffer API)
     // Each Canvas contains an internal Buffer with automatic management
     // All drawing operations are anti-aliased by default
     class Canvas {
         Buffer buffer_;
+        DirtyRegion dirty_;
     public:
         Canvas();
         Canvas(int width, int height, Color background = White);
@@ -334,22 +668,41 @@ namespace pa2d {
         Canvas& operator=(Canvas&& rhs) noexcept;
         Canvas& operator=(const Buffer& rhs);
         Canvas& operator=(Buffer&& rhs) noexcept;
+        Canvas(BufferView&& rhs) = delete;            // As with Buffer, view temporaries cannot be moved in
+        Canvas& operator=(BufferView&& rhs) = delete;
+#ifndef PA2D_HEADLESS
         Canvas(const char* filePath);
         Canvas(int resourceID);
+#endif
         int width() const;
         int height() const;
         Color& at(int x, int y);
         const Color& at(int x, int y) const;
         Buffer& getBuffer();
         const Buffer& getBuffer() const; 
+        BufferView view(int x, int y, int width, int height); // Zero-copy region; marked dirty when taken
+        // ==================== DIRTY TRACKING ====================
+        // Every draw, blend, blit and replay call records the pixels it touched
+        // clear/resize/crop/loadImage/assignment and text calls mark the whole canvas
+        // Writes through getBuffer() or at() are not tracked: call markDirty() yourself
+        const DirtyRegion& getDirtyRegion() const;
+        bool isDirty() const;
+        Canvas& markDirty();
+        Canvas& markDirty(int x, int y, int width, int height);
+        Canvas& clearDirty();
         // ==================== IMAGE OPERATIONS ====================
+#ifndef PA2D_HEADLESS
         bool loadImage(const char* filePath, int width = -1, int height = -1);
         bool loadImage(int resourceID, int width = -1, int height = -1);
+#endif
         Canvas& clear(Color color = White);
         Canvas& crop(int left, int top, int width, int height);
         Canvas& blit(const Canvas& src, int DstX = 0, int DstY = 0);
         Canvas& resize(int width, int height);
         Canvas& resizeBuffer(int newWidth, int newHeight, uint32_t color = White);
+        PixelFormat format() const;
+        Canvas& premultiply();   // In-place SIMD conversion, marks the whole canvas dirty
+        Canvas& unpremultiply();
         // ==================== BASIC SHAPES ====================
         Canvas& line(float startX, float startY, float endX, float endY, const Style& style);
         Canvas& polyline(const std::vector<Point>& points, const Style& style, bool closed = false);
@@ -363,8 +716,14 @@ namespace pa2d {
         Canvas& sector(float centerX, float centerY, float radius, float startAngle, float endAngle, const Style& style);
         // ==================== OBJECT-ORIENTED DRAWING ====================
         Canvas& draw(const Shape& shape, const Style& style);
+        // ==================== COMMAND LIST REPLAY ====================
+        Canvas& replay(const CommandList& commands);
+        // ==================== SPRITE BATCH ====================
+        Canvas& drawSprites(SpriteBatch& batch);
         // ==================== IMAGE BLENDING ====================
+        // mode: 0 alpha, 1 add, 2 multiply, 3 screen, 4 overlay, 5 destAlpha
         Canvas& blend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255, int mode = 0);
+        Canvas& blend(const Canvas& src, int dstX, int dstY, int alpha, BlendMode mode);
         Canvas& alphaBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
         Canvas& addBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
         Canvas& multiplyBlend(const Canvas& src, int dstX = 0, int dstY = 0, int alpha = 255);
@@ -379,14 +738,25 @@ namespace pa2d {
         Canvas& drawRotated(const Canvas& src, float centerX, float centerY, float rotation);
         Canvas& drawTransformed(const Canvas& src, float centerX, float centerY, float scale, float rotation);
         Canvas& drawTransformed(const Canvas& src, float centerX, float centerY, float scaleX, float scaleY, float rotation);
+        // ==================== ATLAS DRAWING ====================
+        // Same placement as the Canvas overloads, reading straight from the atlas page (no copy)
+        Canvas& blit(Atlas& atlas, const AtlasRegion& region, int dstX = 0, int dstY = 0);
+        Canvas& draw(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, int alpha = 255);
+        Canvas& drawScaled(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scaleX, float scaleY);
+        Canvas& drawScaled(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scale);
+        Canvas& drawTransformed(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scale, float rotation);
         // ==================== IMAGE TRANSFORM COPIES ====================
         Canvas cropped(int left, int top, int width, int height) const;
         Canvas resized(int width, int height) const;
         Canvas scaled(float scaleX, float scaleY) const;
         Canvas scaled(float scale) const;
+        Canvas resized(int width, int height, ResampleFilter filter) const;
+        Canvas scaled(float scaleX, float scaleY, ResampleFilter filter) const;
+        Canvas upscaled(int factor) const; // Integer nearest-neighbour upscale (pixel art)
         Canvas rotated(float rotation) const;
         Canvas transformed(float scale, float rotation) const;
         Canvas transformed(float scaleX, float scaleY, float rotation) const;
+#ifndef PA2D_HEADLESS
         // ==================== TEXT RENDERING ====================
         Canvas& text(int x, int y, const std::wstring& text, int fontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::wstring& fontName = L"Microsoft YaHei");
         Canvas& text(int x, int y, const std::string& text, int fontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::string& fontName = "Microsoft YaHei");
@@ -396,7 +766,9 @@ namespace pa2d {
         Canvas& textInRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::string& text, int fontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::string& fontName = "Microsoft YaHei");
         Canvas& textFitRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::wstring& text, int preferredFontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::wstring& fontName = L"Microsoft YaHei");
         Canvas& textFitRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::string& text, int preferredFontSize = 16, const Color& color = 0xFF000000, FontStyle style = FontStyle::Regular, const std::string& fontName = "Microsoft YaHei");
+#endif
     };
+#ifndef PA2D_HEADLESS
     // ==================== WINDOW ====================
     // Thread-per-window architecture (background message loops)
     // Multiple windows supported - avoid concurrent Canvas access across threads
@@ -471,6 +843,10 @@ namespace pa2d {
         Window& render(const Buffer& buffer, int destX = 0, int destY = 0, int srcX = 0, int srcY = 0, int width = -1, int height = -1, bool clearBackground = true, COLORREF bgColor = 0);
         Window& renderCentered(const Canvas& canvas, bool clearBackground = true, COLORREF bgColor = 0);
         Window& renderCentered(const Buffer& buffer, bool clearBackground = true, COLORREF bgColor = 0);
+        // Presents only the canvas dirty rectangles; falls back to a full render on the first
+        // call or when the window size, canvas size, canvas or destination changed
+        // Call canvas.clearDirty() after presenting
+        Window& renderDirty(const Canvas& canvas, int destX = 0, int destY = 0);
         // ==================== EVENT CALLBACKS ====================
         Window& onKey(KeyCallback cb);
         Window& onMouse(MouseCallback cb);
@@ -546,12 +922,73 @@ namespace pa2d {
     Point getScreenSize();
     Point getWorkAreaSize();
     double getDpiScale();
+#endif
+    // ==================== PARALLEL RENDERING ====================
+    // Opt-in multi-threaded rasterization (serial by default)
+    // Large shapes are split into horizontal row bands drawn on a shared worker pool
+    // Image resampling (scaled/resized/rotated/transformed and the draw* variants) uses the same row bands
+    // Output is bit-identical to serial rendering
+    // threads: 1 = serial, 0 = all hardware threads, n = n threads including the caller
+    void setRenderThreads(int threads);
+    int getRenderThreads();
+    // ==================== SIMD DISPATCH ====================
+    // Pixel kernels (clear, copy, blit, blend modes) are picked at startup from the best level the CPU supports
+    // Every kernel (pixel rows, shape rasterization, image sampling, resampling) has an SSE4.1 version
+    enum class SimdLevel { SSE41, AVX2, AVX512 };
+    SimdLevel getCpuSimdLevel();
+    SimdLevel getSimdLevel();
+    // Force a lower level, e.g. for comparison tests; clamped to getCpuSimdLevel()
+    void setSimdLevel(SimdLevel level);
+    // ==================== COMPOSITE MODE ====================
+    // Precise (default): floating-point shape compositing
+    // Fast: 16-bit fixed-point compositing over opaque destination pixels, within 1 LSB of Precise
+    // Translucent destination pixels always use the floating-point path
+    enum class CompositeMode { Precise, Fast };
+    void setCompositeMode(CompositeMode mode);
+    CompositeMode getCompositeMode();
+    // ==================== STORE MODE ====================
+    // How clear, copy and blit write whole blocks of pixels
+    // Auto (default): non-temporal (cache-bypassing) stores once a single write reaches the threshold
+    // Cached: always regular stores; Streaming: always non-temporal stores
+    // Streaming keeps a full-frame clear/copy from evicting the data later draw calls need,
+    // but the written pixels are not cached afterwards
+    enum class StoreMode { Auto, Cached, Streaming };
+    void setStoreMode(StoreMode mode);
+    StoreMode getStoreMode();
+    void setStreamingThreshold(size_t bytes); // Auto threshold in bytes (default 4 MB)
+    size_t getStreamingThreshold();
+    // ==================== MIP CHAIN ====================
+    // Cached image pyramid: level 0 is a copy of the source, each further level is halved() from the previous one
+    // Build once for an image drawn at many reduced sizes (thumbnails, map zoom); each draw then
+    // resamples from the closest level instead of box-filtering the full source again
+    class MipChain {
+    public:
+        MipChain() = default;
+        explicit MipChain(const Buffer& src, int maxLevels = 0); // maxLevels <= 0: down to 1x1
+        void build(const Buffer& src, int maxLevels = 0);
+        void clear() { levels_.clear(); }
+        bool isValid() const { return !levels_.empty(); }
+        int levels() const { return static_cast<int>(levels_.size()); }
+        const Buffer& level(int index) const { return levels_[index]; }
+        int levelFor(int width, int height) const; // Smallest level still at least width x height
+        Buffer resized(int width, int height) const;
+        Buffer scaled(float scaleX, float scaleY) const;
+        Buffer scaled(float factor) const;
+        void drawScaled(Buffer& dest, float centerX, float centerY, float scaleX, float scaleY) const;
+        void drawScaled(Buffer& dest, float centerX, float centerY, float scale) const;
+        void drawResized(Buffer& dest, float centerX, float centerY, int width, int height) const;
+    private:
+        std::vector<Buffer> levels_;
+    };
     // ==================== BUFFER API ====================
     // Direct buffer manipulation
     // Canvas acts as a proxy layer over these functions - each Canvas contains an internal Buffer
     void line(Buffer& buffer, float startX, float startY, float endX, float endY, const Color& color, float width);
     void polyline(Buffer& buffer, const std::vector<Point>& points, const Color& color, float width, bool closed);
     void polygon(Buffer& buffer, const std::vector<Point>& vertices, const Color& fillColor, const Color& strokeColor, float strokeWidth);
+    // Pointer + count overloads for vertices stored contiguously (e.g. a shared vertex pool)
+    void polyline(Buffer& buffer, const Point* points, size_t count, const Color& color, float width, bool closed);
+    void polygon(Buffer& buffer, const Point* vertices, size_t count, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void triangle(Buffer& buffer, float x0, float y0, float x1, float y1, float x2, float y2, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void rect(Buffer& buffer, float left, float top, float width, float height, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void rect(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, const Color& fillColor, const Color& strokeColor, float strokeWidth);
@@ -561,9 +998,11 @@ namespace pa2d {
     void ellipse(Buffer& buffer, float centerX, float centerY, float width, float height, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void ellipse(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, const Color& fillColor, const Color& strokeColor, float strokeWidth);
     void sector(Buffer& buffer, float centerX, float centerY, float radius, float startAngle, float endAngle, const Color& fillColor, const Color& strokeColor, float strokeWidth, bool arc, bool edges);
+#ifndef PA2D_HEADLESS
     bool loadImage(Buffer& buffer, const char* filePath);
     bool loadImage(Buffer& buffer, int resourceID);
     bool loadImage(Buffer& buffer, void* data, int size);
+#endif
     void drawResized(Buffer& dest, const Buffer& src, float centerX, float centerY, int width, int height);
     void drawScaled(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY);
     void drawScaled(Buffer& dest, const Buffer& src, float centerX, float centerY, float scale);
@@ -571,19 +1010,31 @@ namespace pa2d {
     void drawTransformed(Buffer& dest, const Buffer& src, float centerX, float centerY, float scale, float rotation);
     void drawTransformed(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY, float rotation);
     Buffer crop(const Buffer& src, int left, int top, int width, int height);
-    Buffer resized(const Buffer& src, int width, int height);
+    bool copy(Buffer& dest, const Buffer& src); // Reallocates dest to src's size; a view only accepts the same size (false otherwise)
+    BufferView cropView(Buffer& src, int left, int top, int width, int height); // Zero-copy; src must outlive the view
+    void premultiply(Buffer& buffer);   // In-place SIMD RGB * A / 255; no-op if already premultiplied
+    void unpremultiply(Buffer& buffer); // In-place SIMD RGB * 255 / A; pixels with A == 0 become 0
+    void convertFormat(Buffer& buffer, PixelFormat format);
+    Buffer resized(const Buffer& src, int width, int height); // Axes shrunk 2x or more are box-filtered in 2:1 steps first
     Buffer scaled(const Buffer& src, float scaleX, float scaleY);
     Buffer scaled(const Buffer& src, float scale);
+    Buffer halved(const Buffer& src); // 2:1 box filter, odd sizes round up
+    Buffer resized(const Buffer& src, int width, int height, ResampleFilter filter); // Separable resampler, weight tables cached per thread
+    Buffer scaled(const Buffer& src, float scaleX, float scaleY, ResampleFilter filter);
+    Buffer upscaled(const Buffer& src, int factor); // Integer nearest-neighbour upscale: each pixel becomes a factor x factor block
     Buffer rotated(const Buffer& src, float rotation);
     Buffer transformed(const Buffer& src, float scale, float rotation);
     Buffer transformed(const Buffer& src, float scaleX, float scaleY, float rotation);
-    void alphaBlend(const Buffer& src, Buffer& dest, int x, int y, int alpha);
+    void alphaBlend(const Buffer& src, Buffer& dest, int x, int y, int alpha); // Honours both pixel formats
+    // Any BlendMode over the overlapping rectangle; SrcOver is alphaBlend, the named blends below are Add/Multiply/Screen/Overlay/DestAlpha
+    void blend(const Buffer& src, Buffer& dest, int x = 0, int y = 0, BlendMode mode = BlendMode::SrcOver, int alpha = 255);
     void blit(const Buffer& src, Buffer& dst, int dstX = 0, int dstY = 0);
     void addBlend(const Buffer& src, Buffer& dest, int x, int y, int alpha);
     void multiplyBlend(const Buffer& src, Buffer& dest, int x, int y, int alpha);
     void screenBlend(const Buffer& src, Buffer& dest, int x, int y, int alpha);
     void overlayBlend(const Buffer& src, Buffer& dest, int x, int y, int alpha);
     void destAlphaBlend(const Buffer& src, Buffer& dest, int x, int y, int alpha);
+#ifndef PA2D_HEADLESS
     bool text(Buffer& buffer, float x, float y, const std::wstring& text, int fontSize, const Color& color, const FontStyle& style, const std::wstring& fontName);
     bool text(Buffer& buffer, float x, float y, const std::string& text, int fontSize, const Color& color, const FontStyle& style, const std::string& fontName);
     bool textCentered(Buffer& buffer, float centerX, float centerY, const std::wstring& text, int fontSize, const Color& color, const FontStyle& style, const std::wstring& fontName);
@@ -592,8 +1043,9 @@ namespace pa2d {
     bool textInRect(Buffer& buffer, float rectX, float rectY, float rectWidth, float rectHeight, const std::string& text, int fontSize, const Color& color, const FontStyle& style, const std::string& fontName);
     bool textFitRect(Buffer& buffer, float rectX, float rectY, float rectWidth, float rectHeight, const std::wstring& text, int preferredFontSize, const Color& color, const FontStyle& style, const std::wstring& fontName);
     bool textFitRect(Buffer& buffer, float rectX, float rectY, float rectWidth, float rectHeight, const std::string& text, int preferredFontSize, const Color& color, const FontStyle& style, const std::string& fontName);
+#endif
      }
-    // String 汾
+    // String 版本
 #ifndef PA2D_DISABLE_LITERALS
 inline pa2d::Style operator"" _fill(unsigned long long hex) { return pa2d::Style().fill((uint32_t)hex); }
 inline pa2d::Style operator"" _stroke(unsigned long long hex) { return pa2d::Style().stroke((uint32_t)hex); }
@@ -623,7 +1075,7 @@ inline pa2d::Style operator"" _fill(const char* str, size_t len) { return pa2d::
 inline pa2d::Style operator"" _stroke(const char* str, size_t len) { return pa2d::Style().stroke(pa2d::parseColorString(str, len)); }
 #endif
 
-#ifdef _WIN32
+#if defined(_MSC_VER) && !defined(PA2D_HEADLESS)
 #pragma comment(lib, "ole32.lib")
 #pragma comment(lib, "WindowsCodecs.lib")
 #pragma comment(lib, "gdiplus.lib")
@@ -632,8 +1084,10 @@ inline pa2d::Style operator"" _stroke(const char* str, size_t len) { return pa2d
 #pragma comment(lib, "shell32.lib")
 #endif
 
+#ifdef _MSC_VER
 #ifdef _DEBUG
 #pragma comment(lib, "pa2dd.lib")
 #else
 #pragma comment(lib, "pa2d.lib")
+#endif
 #endif
\ No newline at end of file
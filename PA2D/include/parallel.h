@@ -0,0 +1,8 @@
+#pragma once
+namespace pa2d {
+    // 渲染线程数（默认 1 = 串行）
+    // 0 = 使用全部硬件线程，n = 共 n 个线程（含调用线程）
+    // 大尺寸图形按水平条带拆分并行光栅化，图像缩放、旋转、变换同样按行条带并行，输出与串行逐位一致
+    void setRenderThreads(int threads);
+    int getRenderThreads();
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "buffer.h"
+#include <cstdint>
+#include <vector>
+namespace pa2d {
+    // 可分离重采样滤波器
+    // Nearest：最近邻；Bilinear：三角滤波（半径 1）；Bicubic：Keys 三次卷积（a = -0.5，半径 2）；Lanczos3：半径 3
+    // 缩小时滤波器按缩小倍数展宽，所有被覆盖的源像素都参与加权（Nearest 除外）
+    enum class ResampleFilter { Nearest, Bilinear, Bicubic, Lanczos3 };
+
+    // 两遍可分离重采样：先横向（每行连续读取），再纵向（按行整组读取），不使用 gather
+    // 构造时为每个输出列/行预先计算起始下标与 14 位定点权重，之后同尺寸的 apply 只做乘加
+    // apply 是 const 的，可在多个线程中共用同一对象
+    class Resampler {
+    public:
+        Resampler() = default;
+        Resampler(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ResampleFilter filter = ResampleFilter::Bicubic);
+        bool isValid() const { return dstWidth_ > 0 && dstHeight_ > 0; }
+        bool matches(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ResampleFilter filter) const;
+        // src 尺寸须与构造时一致；dest 尺寸不符时重新分配（视图尺寸不符则失败）
+        bool apply(const Buffer& src, Buffer& dest) const;
+        Buffer apply(const Buffer& src) const;
+    private:
+        // 输出第 i 个像素 = sum(coeffs[i * taps + k] * 源[start[i] + k])，k < taps，权重和为 1 << 14
+        struct Table {
+            int taps = 0;
+            std::vector<int> start;
+            std::vector<int16_t> coeffs;
+        };
+        static Table buildTable(int srcSize, int dstSize, ResampleFilter filter);
+        int srcWidth_ = 0, srcHeight_ = 0, dstWidth_ = 0, dstHeight_ = 0;
+        ResampleFilter filter_ = ResampleFilter::Bicubic;
+        Table horizontal_, vertical_;
+    };
+
+    // 使用指定滤波器的 resized / scaled；每个线程缓存最近一次的 Resampler，同尺寸反复调用（视频帧）不再重建权重表
+    Buffer resized(const Buffer& src, int width, int height, ResampleFilter filter);
+    Buffer scaled(const Buffer& src, float scaleX, float scaleY, ResampleFilter filter);
+    // 整数倍最近邻放大（像素画 2x / 3x），每个源像素变成 factor x factor 的色块
+    Buffer upscaled(const Buffer& src, int factor);
+}
\ No newline at end of file
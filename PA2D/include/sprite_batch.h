@@ -0,0 +1,79 @@
+#pragma once
+#include "atlas.h"
+#include "blend_mode.h"
+#include "buffer.h"
+#include <cstdint>
+#include <vector>
+namespace pa2d {
+    // 精灵实例：源图中的一个矩形（图集子图，宽高为 0 时取整张源图）以 (x, y) 为中心先缩放后旋转
+    // rotation 与 drawTransformed 一样按弧度传给 sin/cos，方向相同；opacity 乘到源 alpha 上，blend 为合成模式
+    // 源 Buffer 由调用方持有，需在 render 结束前保持有效
+    struct Sprite {
+        const Buffer* source = nullptr;
+        int srcX = 0, srcY = 0, srcWidth = 0, srcHeight = 0;
+        float x = 0.0f, y = 0.0f;
+        float scaleX = 1.0f, scaleY = 1.0f;
+        float rotation = 0.0f;
+        float opacity = 1.0f;
+        BlendMode blend = BlendMode::SrcOver;
+    };
+
+    // 精灵批量渲染：逐帧录制大量小精灵（粒子），一次提交
+    // render 先为每个实例求出逆变换与包围盒，再按图块分箱，逐图块按录制顺序光栅化
+    // 每个精灵只遍历与源矩形相交的行区间，双线性采样后直接在目标上合成，不经过 drawTransformed 的逐次准备
+    // 图块之间互不重叠，开启 setRenderThreads 后按图块并行
+    // 采样位置与 drawTransformed 相同：缩放 1、无旋转、中心落在整数 + 源尺寸一半时与源图逐像素一致
+    class SpriteBatch {
+    public:
+        static const int DEFAULT_TILE_SIZE = 64;
+
+        explicit SpriteBatch(int tileSize = DEFAULT_TILE_SIZE);
+
+        // clear() 保留已分配的容量，逐帧重新录制时不再分配内存
+        SpriteBatch& clear();
+        SpriteBatch& reserve(size_t count);
+        size_t size() const { return sprites_.size(); }
+        bool empty() const { return sprites_.empty(); }
+        const std::vector<Sprite>& sprites() const { return sprites_; }
+        int tileSize() const { return tileSize_; }
+
+        SpriteBatch& add(const Sprite& sprite);
+        SpriteBatch& add(const Buffer& source, float x, float y, float scale = 1.0f, float rotation = 0.0f,
+                         float opacity = 1.0f, BlendMode blend = BlendMode::SrcOver);
+        SpriteBatch& add(const Buffer& source, int srcX, int srcY, int srcWidth, int srcHeight,
+                         float x, float y, float scale = 1.0f, float rotation = 0.0f,
+                         float opacity = 1.0f, BlendMode blend = BlendMode::SrcOver);
+        // 图集区域：源为图集页面，无效区域被忽略
+        SpriteBatch& add(const Atlas& atlas, const AtlasRegion& region, float x, float y, float scale = 1.0f,
+                         float rotation = 0.0f, float opacity = 1.0f, BlendMode blend = BlendMode::SrcOver);
+
+        // 按录制顺序合成到目标缓冲区
+        void render(Buffer& target);
+
+    private:
+        // 目标像素 (px, py) 映射到源矩形内坐标：u = u0 + dudx * px + dudy * py，v 同理
+        // 源像素 i 位于坐标 i，u 在 (-1, width) 之间时双线性采样至少有一个有效像素
+        struct Instance {
+            const Color* pixels;                // 源矩形左上角
+            int stride, width, height;
+            bool premultiplied;
+            float u0, dudx, dudy, v0, dvdx, dvdy;
+            float opacity;
+            BlendMode blend;
+            int minX, minY, maxX, maxY;         // 已裁剪的目标包围盒（闭区间）
+        };
+
+        int tileSize_;
+        int tilesX_ = 0, tilesY_ = 0;
+        std::vector<Sprite> sprites_;
+        std::vector<Instance> instances_;
+        std::vector<uint32_t> binStart_;
+        std::vector<uint32_t> binItems_;
+        std::vector<uint32_t> binCursor_;
+
+        void prepare(const Buffer& target);
+        void bin(int width, int height);
+        // 在闭区间 [minX, maxX] x [minY, maxY] 内光栅化一个实例
+        static void drawInstance(const Instance& inst, Buffer& target, int minX, int minY, int maxX, int maxY);
+    };
+}
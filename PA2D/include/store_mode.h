@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+namespace pa2d {
+    // 整块写入（clear、copy、blit）的存储方式（默认 Auto）
+    // Auto：单次写入不小于 getStreamingThreshold() 字节时使用非临时存储，其余使用普通存储
+    // Cached：始终使用普通存储
+    // Streaming：始终使用非临时存储，写入绕过缓存，不挤占后续绘制所需的 L2/L3
+    // 非临时存储写完后数据不在缓存中，紧接着读取同一块区域会更慢
+    enum class StoreMode { Auto, Cached, Streaming };
+    void setStoreMode(StoreMode mode);
+    StoreMode getStoreMode();
+    // Auto 模式的阈值（默认 4MB，约 1024x1024 像素）
+    void setStreamingThreshold(size_t bytes);
+    size_t getStreamingThreshold();
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
+#include "blend_mode.h"
 #include "color.h"
+#include <cstddef>
 namespace pa2d {
     struct Style {
         Color fill_;    Style& fill(Color);
@@ -8,7 +10,10 @@ namespace pa2d {
         float radius_; Style& radius(float);
         bool arc_;      Style& arc(bool);
         bool edges_;    Style& edges(bool);
-        Style(Color fill_ = 0, Color stroke_ = 0, float width_ = 1.0f, float radius_ = 0.0f, bool arc_ = true, bool edges_ = true);
+        BlendMode blend_; Style& blend(BlendMode);  // 形状合成步骤的混合模式
+        float opacity_; Style& opacity(float);      // 图层不透明度 0-1，乘到源 alpha 上
+        Style(Color fill_ = 0, Color stroke_ = 0, float width_ = 1.0f, float radius_ = 0.0f, bool arc_ = true, bool edges_ = true,
+              BlendMode blend_ = BlendMode::SrcOver, float opacity_ = 1.0f);
         Style operator+(const Style& other) const;
         Style& operator+=(const Style& other);
     };
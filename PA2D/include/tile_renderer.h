@@ -0,0 +1,31 @@
+#pragma once
+#include "buffer.h"
+#include "command_list.h"
+#include <cstdint>
+#include <vector>
+namespace pa2d {
+    // 分块渲染器：按包围盒将命令分箱到固定尺寸的屏幕图块，再逐图块光栅化
+    // 每个图块只执行与其相交的命令，图块在所有图形合成期间保持在 L1/L2 缓存中
+    // 图块之间互不重叠，开启 setRenderThreads 后按图块并行
+    class TileRenderer {
+    private:
+        int tileSize_;
+        int tilesX_ = 0, tilesY_ = 0;
+        std::vector<uint32_t> binStart_;    // 每个图块在 binItems_ 中的起始位置（前缀和）
+        std::vector<uint32_t> binItems_;    // 按图块排列的命令下标，保持录制顺序
+        std::vector<uint32_t> binCursor_;
+
+        void bin(const CommandList& commands, int width, int height);
+
+    public:
+        static const int DEFAULT_TILE_SIZE = 64;
+
+        // 图块边长不小于 16，并向上取整到 8 的倍数，使图块边界与光栅化的 8 像素分组对齐
+        explicit TileRenderer(int tileSize = DEFAULT_TILE_SIZE);
+
+        int tileSize() const { return tileSize_; }
+
+        // 分箱并回放到目标缓冲区，输出与 CommandList::replay 逐位一致
+        void render(const CommandList& commands, Buffer& target);
+    };
+}
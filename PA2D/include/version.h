@@ -1,9 +1,9 @@
 namespace pa2d {
-    // ==================== 汾Ϣ ====================
+    // ==================== 版本信息 ====================
     extern const char* VERSION_STRING;
-    // ȡ汾Ϣ
+    // 获取完整版本信息
     extern const char* getVersion();
-    // Ӳּ֧
+    // 硬件支持检测：基线指令集为 SSE4.1，AVX2/AVX-512 由运行时分派按需启用（名称沿用以保持兼容）
     struct AVX2_Verifier {
         AVX2_Verifier();
     private:
@@ -1,7 +1,7 @@
 #pragma once
 #define WIN32_LEAN_AND_MEAN
 #ifdef _WIN32
-#define NOMINMAX  // max,minͻ
+#define NOMINMAX  // 避免max,min宏冲突
 #include <windows.h>
 #endif
 #include <future>
@@ -17,11 +17,11 @@ namespace pa2d {
 
     struct MouseEvent {
         int x, y;
-        int button;       // 0=, 1=Ҽ, 2=м, -1=, -2=ƶ, -3=뿪
-        bool pressed;     // ڰ/ͷ
-        int wheelDelta;  // 
+        int button;       // 0=左键, 1=右键, 2=中键, -1=滚轮, -2=移动, -3=离开
+        bool pressed;     // 对于按键按下/释放
+        int wheelDelta;  // 滚轮增量
     };
-    // ¼ص
+    // 事件回调
     using KeyCallback = std::function<void(const KeyEvent&)>;
     using MouseCallback = std::function<void(const MouseEvent&)>;
     using ResizeCallback = std::function<void(int, int)>;
@@ -38,8 +38,8 @@ namespace pa2d {
         using HICON = void*;
         using HCURSOR = void*;
         using COLORREF = unsigned long;
-        // ==================== ù ====================
-        // /
+        // ==================== 常用功能 ====================
+        // 构造/析构
         Window(int width = -1, int height = -1, const char* title ="PA2D Window");
         Window(const Window& other);
         Window(Window&& other) noexcept;
@@ -49,7 +49,7 @@ namespace pa2d {
 
 
         HWND getHandle() const;
-        // ״̬ѯ
+        // 窗口状态查询
         int width() const;
         int height() const;
         bool isOpen() const;
@@ -59,17 +59,17 @@ namespace pa2d {
         bool isMinimized() const;
         bool isFullscreen() const;
 
-        // ڲ
+        // 窗口操作
         Window& show();
         Window& hide();
         Window& close();
         Window& setVisible(bool visible);
         Window& focus();
 
-        // ȴ
+        // 堵塞等待
         void waitForClose();
 
-        // ڴСλ
+        // 窗口大小和位置
         Window& setPosition(int x, int y);
         Window& setClientSize(int width, int height);
         Window& setWindowSize(int width, int height);
@@ -77,13 +77,16 @@ namespace pa2d {
         Size getClientSize() const;
         Size getWindowSize() const;
 
-        // Ⱦ
+        // 渲染功能
         Window& render(const Canvas& canvas, int destX = 0, int destY = 0, int srcX = 0, int srcY = 0, int width = -1, int height = -1, bool clearBackground = true, COLORREF bgColor = 0);
         Window& renderCentered(const Canvas& canvas, bool clearBackground = true, COLORREF bgColor = 0);
         Window& render(const Buffer& buffer, int destX = 0, int destY = 0, int srcX = 0, int srcY = 0, int width = -1, int height = -1, bool clearBackground = true, COLORREF bgColor = 0);
         Window& renderCentered(const Buffer& buffer, bool clearBackground = true, COLORREF bgColor = 0);
+        // 只提交画布的脏区域；首次调用或窗口、画布尺寸、目标位置变化时整帧提交
+        // 调用方在提交后自行 canvas.clearDirty()
+        Window& renderDirty(const Canvas& canvas, int destX = 0, int destY = 0);
 
-        // ==================== ¼ص ====================
+        // ==================== 事件回调 ====================
         Window& onKey(KeyCallback cb);
         Window& onMouse(MouseCallback cb);
         Window& onResize(ResizeCallback cb);
@@ -95,7 +98,7 @@ namespace pa2d {
         Window& onClipboardFiles(FileListCallback cb);
         Window& disableClipboardFiles();
 
-        // ==================== ״̬ ====================
+        // ==================== 输入状态 ====================
         Point getMousePosition() const;
         bool isMouseInWindow() const;
         bool isMouseButtonPressed(int button) const;
@@ -104,7 +107,7 @@ namespace pa2d {
         bool isCtrlPressed() const;
         bool isAltPressed() const;
 
-        // ==================== ߼ڿ ====================
+        // ==================== 高级窗口控制 ====================
         Window& maximize();
         Window& minimize();
         Window& restore();
@@ -120,7 +123,7 @@ namespace pa2d {
         Window& setMaximizeButton(bool show);
         Window& setCloseButton(bool show);
 
-        // ====================  ====================
+        // ==================== 外观设置 ====================
         Window& setTitle(const char* title);
         Window& setTitle(const wchar_t* title);
         std::string getTitle() const;
@@ -135,10 +138,10 @@ namespace pa2d {
         Window& setIcon(HICON icon);
         Window& setIconFromResource(int resourceId);
 
-        // ====================  ====================
+        // ==================== 输入控制 ====================
         Window& setMouseCapture(bool capture);
 
-        // ==================== ļ ====================
+        // ==================== 剪贴板和文件 ====================
         bool setClipboardText(const std::string& text);
         std::string getClipboardText();
         bool setClipboardText(const std::wstring& text);
@@ -148,7 +151,7 @@ namespace pa2d {
         bool hasClipboardFiles() const;
         Window& enableFileDrop(bool enable = true);
 
-        // ==================== ˵ ====================
+        // ==================== 菜单功能 ====================
         Window& setMenu(HMENU menu);
         HMENU createMenu();
         HMENU createPopupMenu();
@@ -156,22 +159,22 @@ namespace pa2d {
         Window& appendMenuSeparator(HMENU menu);
         Window& appendMenuPopup(HMENU menu, const char* text, HMENU popupMenu);
         Window& destroyMenu(HMENU menu);
-        // ̬Window Proc
+        // 静态Window Proc
         static LRESULT CALLBACK windowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
     private:
         struct Impl;
         Impl* pImpl_;
-        // ڲ
+        // 内部方法
         void startMessageThread(int width, int height, const std::string& title);
         void stopMessageThread();
         void handleMouse(UINT msg, WPARAM wparam, LPARAM lparam);
         void initializeRender();
         void updateWindowStyles();
 
-        // ̬עắ
+        // 静态注册函数
         static void registerWindowClassOnce();
 };
-// ==================== ϵͳϢ ====================
+// ==================== 系统信息 ====================
 Point getGlobalMousePosition();
 Point getScreenSize();
 Point getWorkAreaSize();
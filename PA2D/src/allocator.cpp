@@ -0,0 +1,246 @@
+// allocator.cpp
+#include "../include/allocator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace pa2d {
+    // ============================================================================
+    // 系统堆分配
+    // ============================================================================
+
+    namespace {
+        class HeapAllocator : public BufferAllocator {
+        public:
+            Color* allocate(size_t count) override {
+                if (count == 0) return nullptr;
+                const size_t bytes = count * sizeof(Color);
+#ifdef _WIN32
+                return static_cast<Color*>(_aligned_malloc(bytes, BUFFER_ALIGNMENT));
+#else
+                void* ptr = nullptr;
+                if (posix_memalign(&ptr, BUFFER_ALIGNMENT, bytes) != 0) return nullptr;
+                return static_cast<Color*>(ptr);
+#endif
+            }
+
+            void deallocate(Color* pixels, size_t) override {
+#ifdef _WIN32
+                _aligned_free(pixels);
+#else
+                std::free(pixels);
+#endif
+            }
+        };
+
+        std::atomic<BufferAllocator*> globalAllocator{ nullptr };
+        std::atomic<size_t> rowAlignment{ 0 };
+        thread_local BufferAllocator* scopedAllocator = nullptr;
+
+        // 分级：不超过 16 像素为一级，其后 (2^k, 2^(k+1)] 区间按 2^(k-2) 步长分 4 级
+        size_t sizeClass(size_t count) {
+            if (count <= 16) return 16;
+            size_t high = 16;
+            while (high * 2 < count) high <<= 1;
+            const size_t step = high >> 2;
+            return (count + step - 1) / step * step;
+        }
+
+        size_t alignUp(size_t bytes) {
+            return (bytes + BUFFER_ALIGNMENT - 1) & ~(BUFFER_ALIGNMENT - 1);
+        }
+    }
+
+    BufferAllocator& heapAllocator() {
+        static HeapAllocator instance;
+        return instance;
+    }
+
+    void setBufferAllocator(BufferAllocator* allocator) {
+        globalAllocator.store(allocator, std::memory_order_release);
+    }
+
+    BufferAllocator& getBufferAllocator() {
+        if (scopedAllocator) return *scopedAllocator;
+        BufferAllocator* allocator = globalAllocator.load(std::memory_order_acquire);
+        return allocator ? *allocator : heapAllocator();
+    }
+
+    void setBufferRowAlignment(size_t bytes) {
+        const size_t aligned = bytes == 0 ? 0 : (bytes <= 32 ? 32 : BUFFER_ALIGNMENT);
+        rowAlignment.store(aligned, std::memory_order_relaxed);
+    }
+
+    size_t getBufferRowAlignment() {
+        return rowAlignment.load(std::memory_order_relaxed);
+    }
+
+    BufferAllocatorScope::BufferAllocatorScope(BufferAllocator& allocator) : previous_(scopedAllocator) {
+        scopedAllocator = &allocator;
+    }
+
+    BufferAllocatorScope::~BufferAllocatorScope() {
+        scopedAllocator = previous_;
+    }
+
+    // ============================================================================
+    // 分级内存池
+    // ============================================================================
+
+    struct PoolAllocator::Impl {
+        BufferAllocator& upstream;
+        size_t maxCachedBytes;
+        size_t cachedBytes = 0;
+        std::unordered_map<size_t, std::vector<Color*>> freeLists; // 分级像素数 -> 空闲块
+        mutable std::mutex mutex;
+
+        Impl(size_t maxCached, BufferAllocator& up) : upstream(up), maxCachedBytes(maxCached) {}
+    };
+
+    PoolAllocator::PoolAllocator(size_t maxCachedBytes, BufferAllocator& upstream)
+        : impl_(new Impl(maxCachedBytes, upstream)) {
+    }
+
+    PoolAllocator::~PoolAllocator() {
+        trim();
+        delete impl_;
+    }
+
+    Color* PoolAllocator::allocate(size_t count) {
+        if (count == 0) return nullptr;
+        const size_t classCount = sizeClass(count);
+        {
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            auto it = impl_->freeLists.find(classCount);
+            if (it != impl_->freeLists.end() && !it->second.empty()) {
+                Color* pixels = it->second.back();
+                it->second.pop_back();
+                impl_->cachedBytes -= classCount * sizeof(Color);
+                return pixels;
+            }
+        }
+        return impl_->upstream.allocate(classCount);
+    }
+
+    void PoolAllocator::deallocate(Color* pixels, size_t count) {
+        if (!pixels) return;
+        const size_t classCount = sizeClass(count);
+        const size_t bytes = classCount * sizeof(Color);
+        {
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            if (impl_->cachedBytes + bytes <= impl_->maxCachedBytes) {
+                impl_->freeLists[classCount].push_back(pixels);
+                impl_->cachedBytes += bytes;
+                return;
+            }
+        }
+        impl_->upstream.deallocate(pixels, classCount);
+    }
+
+    void PoolAllocator::trim() {
+        std::unordered_map<size_t, std::vector<Color*>> lists;
+        {
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            lists.swap(impl_->freeLists);
+            impl_->cachedBytes = 0;
+        }
+        for (auto& entry : lists) {
+            for (Color* pixels : entry.second) impl_->upstream.deallocate(pixels, entry.first);
+        }
+    }
+
+    size_t PoolAllocator::cachedBytes() const {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        return impl_->cachedBytes;
+    }
+
+    // ============================================================================
+    // 帧内存区
+    // ============================================================================
+
+    struct FrameArena::Impl {
+        BufferAllocator& upstream;
+        size_t capacity;
+        Color* block = nullptr;         // 首次分配时向 upstream 申请
+        size_t offset = 0;              // 已切分字节数
+        size_t lastOffset = 0;          // 最后一次分配的起点，用于立即退回
+        size_t live = 0;                // 尚未释放的块数
+        std::mutex mutex;
+
+        Impl(size_t cap, BufferAllocator& up) : upstream(up), capacity(alignUp(cap)) {}
+
+        bool owns(const Color* pixels) const {
+            const char* base = reinterpret_cast<const char*>(block);
+            const char* ptr = reinterpret_cast<const char*>(pixels);
+            return block && ptr >= base && ptr < base + capacity;
+        }
+    };
+
+    FrameArena::FrameArena(size_t capacityBytes, BufferAllocator& upstream)
+        : impl_(new Impl(capacityBytes, upstream)) {
+    }
+
+    FrameArena::~FrameArena() {
+        if (impl_->block) impl_->upstream.deallocate(impl_->block, impl_->capacity / sizeof(Color));
+        delete impl_;
+    }
+
+    Color* FrameArena::allocate(size_t count) {
+        if (count == 0) return nullptr;
+        const size_t bytes = alignUp(count * sizeof(Color));
+        {
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            if (!impl_->block && impl_->capacity > 0) {
+                impl_->block = impl_->upstream.allocate(impl_->capacity / sizeof(Color));
+            }
+            if (impl_->block && bytes <= impl_->capacity - impl_->offset) {
+                Color* pixels = reinterpret_cast<Color*>(reinterpret_cast<char*>(impl_->block) + impl_->offset);
+                impl_->lastOffset = impl_->offset;
+                impl_->offset += bytes;
+                ++impl_->live;
+                return pixels;
+            }
+        }
+        return impl_->upstream.allocate(count);
+    }
+
+    void FrameArena::deallocate(Color* pixels, size_t count) {
+        if (!pixels) return;
+        {
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            if (impl_->owns(pixels)) {
+                const size_t start = static_cast<size_t>(reinterpret_cast<char*>(pixels) - reinterpret_cast<char*>(impl_->block));
+                if (impl_->live > 0) --impl_->live;
+                if (impl_->live == 0) {
+                    impl_->offset = impl_->lastOffset = 0;
+                }
+                else if (start == impl_->lastOffset && start + alignUp(count * sizeof(Color)) == impl_->offset) {
+                    impl_->offset = start;
+                }
+                return;
+            }
+        }
+        impl_->upstream.deallocate(pixels, count);
+    }
+
+    void FrameArena::reset() {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->offset = impl_->lastOffset = 0;
+        impl_->live = 0;
+    }
+
+    size_t FrameArena::usedBytes() const {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        return impl_->offset;
+    }
+
+    size_t FrameArena::capacity() const {
+        return impl_->capacity;
+    }
+}
@@ -0,0 +1,158 @@
+// atlas.cpp
+#include "../include/atlas.h"
+#ifndef PA2D_HEADLESS
+#include "../include/image_loader.h"
+#endif
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+namespace pa2d {
+    Atlas::Atlas(int width, int height, int padding, PixelFormat format) {
+        reset(width, height, padding, format);
+    }
+
+    void Atlas::reset(int width, int height, int padding, PixelFormat format) {
+        page_ = width > 0 && height > 0 ? Buffer(width, height, Color(0)) : Buffer();
+        page_.format = format;
+        padding_ = std::max(0, padding);
+        clear();
+    }
+
+    void Atlas::clear() {
+        skyline_.clear();
+        regionCount_ = 0;
+        usedArea_ = 0;
+        if (!page_.isValid()) return;
+        page_.clear(Color(0));
+        skyline_.push_back({ 0, 0, page_.width });
+    }
+
+    int Atlas::fitAt(size_t index, int width, int height) const {
+        const int x = skyline_[index].x;
+        if (x + width > page_.width) return -1;
+        // 间隔只需留在区域之间，贴着页面右边、下边时可以省去
+        int remaining = std::min(width + padding_, page_.width - x);
+        int y = 0;
+        for (size_t i = index; remaining > 0 && i < skyline_.size(); ++i) {
+            y = std::max(y, skyline_[i].y);
+            remaining -= skyline_[i].width;
+        }
+        return y + height <= page_.height ? y : -1;
+    }
+
+    void Atlas::placeAt(size_t index, int x, int y, int width, int height) {
+        const int span = std::min(width + padding_, page_.width - x);
+        skyline_.insert(skyline_.begin() + index, Segment{ x, y + height + padding_, span });
+
+        // 新段覆盖的旧段整体删除，部分覆盖的截去左边
+        const int right = x + span;
+        size_t next = index + 1;
+        while (next < skyline_.size() && skyline_[next].x < right) {
+            Segment& segment = skyline_[next];
+            const int overlap = right - segment.x;
+            if (overlap < segment.width) {
+                segment.x += overlap;
+                segment.width -= overlap;
+                break;
+            }
+            skyline_.erase(skyline_.begin() + next);
+        }
+
+        // 合并高度相同的相邻段，保持段数少
+        for (size_t i = 0; i + 1 < skyline_.size();) {
+            if (skyline_[i].y == skyline_[i + 1].y) {
+                skyline_[i].width += skyline_[i + 1].width;
+                skyline_.erase(skyline_.begin() + i + 1);
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    AtlasRegion Atlas::makeRegion(int x, int y, int width, int height) const {
+        AtlasRegion region;
+        region.x = x;
+        region.y = y;
+        region.width = width;
+        region.height = height;
+        const float invW = 1.0f / page_.width, invH = 1.0f / page_.height;
+        region.u0 = x * invW;
+        region.v0 = y * invH;
+        region.u1 = (x + width) * invW;
+        region.v1 = (y + height) * invH;
+        return region;
+    }
+
+    AtlasRegion Atlas::allocate(int width, int height) {
+        if (!page_.isValid() || width <= 0 || height <= 0) return AtlasRegion();
+
+        // 顶边最低者优先，同高时选较窄的段，把宽段留给之后更宽的图
+        size_t bestIndex = skyline_.size();
+        int bestTop = INT_MAX, bestWidth = INT_MAX, bestY = 0;
+        for (size_t i = 0; i < skyline_.size(); ++i) {
+            const int y = fitAt(i, width, height);
+            if (y < 0) continue;
+            const int top = y + height;
+            if (top < bestTop || (top == bestTop && skyline_[i].width < bestWidth)) {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = skyline_[i].width;
+                bestY = y;
+            }
+        }
+        if (bestIndex == skyline_.size()) return AtlasRegion();
+
+        const int x = skyline_[bestIndex].x;
+        placeAt(bestIndex, x, bestY, width, height);
+        ++regionCount_;
+        usedArea_ += static_cast<long long>(width) * height;
+        return makeRegion(x, bestY, width, height);
+    }
+
+    AtlasRegion Atlas::insert(const Buffer& image) {
+        if (!image.isValid()) return AtlasRegion();
+        const AtlasRegion region = allocate(image.width, image.height);
+        if (!region) return region;
+        // 同尺寸的 copy 直接写入视图引用的页面区域，随后转换为页面的像素格式
+        BufferView target = view(region);
+        copy(target, image);
+        convertFormat(target, page_.format);
+        return region;
+    }
+
+    std::vector<AtlasRegion> Atlas::insert(const std::vector<const Buffer*>& images) {
+        std::vector<size_t> order(images.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        auto height = [&](size_t i) { return images[i] ? images[i]->height : 0; };
+        auto width = [&](size_t i) { return images[i] ? images[i]->width : 0; };
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return height(a) != height(b) ? height(a) > height(b) : width(a) > width(b);
+        });
+
+        std::vector<AtlasRegion> regions(images.size());
+        for (size_t i : order) {
+            if (images[i]) regions[i] = insert(*images[i]);
+        }
+        return regions;
+    }
+
+#ifndef PA2D_HEADLESS
+    AtlasRegion Atlas::insert(const char* filePath) {
+        Buffer image;
+        if (!loadImage(image, filePath)) return AtlasRegion();
+        return insert(image);
+    }
+#endif
+
+    BufferView Atlas::view(const AtlasRegion& region) {
+        if (!region) return BufferView();
+        return cropView(page_, region.x, region.y, region.width, region.height);
+    }
+
+    float Atlas::occupancy() const {
+        if (!page_.isValid()) return 0.0f;
+        return static_cast<float>(static_cast<double>(usedArea_) / (static_cast<double>(page_.width) * page_.height));
+    }
+}
@@ -1,32 +1,39 @@
 #include "../include/canvas.h"
+#include "internal/blend_utils.h"
+#include "internal/clip.h"
+#include "internal/shape_dispatch.h"
 #include <algorithm>
-#include <cassert>
 
 namespace pa2d {
     Canvas::Canvas() : buffer_(0, 0, Color(0x00000000)) {}
 
     Canvas::Canvas(int width, int height, Color background)
         : buffer_(width, height, Color(background)) {
+        markDirty();
     }
 
-    Canvas::Canvas(const Buffer& rhs) : buffer_(rhs) {}
+    Canvas::Canvas(const Buffer& rhs) : buffer_(rhs) { markDirty(); }
 
-    Canvas::Canvas(Buffer&& rhs) noexcept : buffer_(std::move(rhs)) {}
+    // 移动操作为 noexcept：脏区域只置整块标志（markAll 不分配内存）
+    Canvas::Canvas(Buffer&& rhs) noexcept : buffer_(std::move(rhs)) { dirty_.markAll(buffer_.width, buffer_.height); }
 
-    Canvas::Canvas(const Canvas& rhs) : buffer_(rhs.buffer_) {}
+    Canvas::Canvas(const Canvas& rhs) : buffer_(rhs.buffer_) { markDirty(); }
 
-    Canvas::Canvas(Canvas&& rhs) noexcept : buffer_(std::move(rhs.buffer_)) {}
+    Canvas::Canvas(Canvas&& rhs) noexcept : buffer_(std::move(rhs.buffer_)) { dirty_.markAll(buffer_.width, buffer_.height); }
 
     Canvas& Canvas::operator=(Canvas&& rhs) noexcept {
         buffer_ = std::move(rhs.buffer_);
+        dirty_.markAll(buffer_.width, buffer_.height);
         return *this;
     }
 
     Canvas& Canvas::operator=(Buffer&& rhs) noexcept {
         buffer_ = std::move(rhs);
+        dirty_.markAll(buffer_.width, buffer_.height);
         return *this;
     }
 
+#ifndef PA2D_HEADLESS
     Canvas::Canvas(const char* filePath) : buffer_(0, 0, Color(0x00000000)) {
         loadImage(filePath);
     }
@@ -34,15 +41,16 @@ namespace pa2d {
     Canvas::Canvas(int resourceID) : buffer_(0, 0, Color(0x00000000)) {
         loadImage(resourceID);
     }
+#endif
 
     Canvas& Canvas::operator=(const Canvas& rhs) {
         buffer_ = rhs.buffer_;
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::operator=(const Buffer& rhs) {
         this->buffer_ = rhs;
-        return *this;
+        return markDirty();
     }
 
     int Canvas::width() const { return buffer_.width; }
@@ -55,13 +63,49 @@ namespace pa2d {
 
     Buffer& Canvas::getBuffer() { return buffer_; }
 
+    BufferView Canvas::view(int x, int y, int width, int height) {
+        BufferView region = buffer_.view(x, y, width, height);
+        if (region.isValid()) {
+            const ptrdiff_t offset = region.color - buffer_.color;
+            dirty_.add(static_cast<int>(offset % buffer_.stride), static_cast<int>(offset / buffer_.stride), region.width, region.height);
+        }
+        return region;
+    }
+
     Color& Canvas::at(int x, int y) { return buffer_.at(x, y); }
 
     const Color& Canvas::at(int x, int y) const { return buffer_.at(x, y); }
 
+    const DirtyRegion& Canvas::getDirtyRegion() const { return dirty_; }
+
+    bool Canvas::isDirty() const { return !dirty_.empty(); }
+
+    Canvas& Canvas::markDirty() {
+        dirty_.markAll(buffer_.width, buffer_.height);
+        return *this;
+    }
+
+    Canvas& Canvas::markDirty(int x, int y, int width, int height) {
+        const int minX = std::max(0, x);
+        const int minY = std::max(0, y);
+        const int maxX = std::min(buffer_.width, x + width);
+        const int maxY = std::min(buffer_.height, y + height);
+        if (minX < maxX && minY < maxY) dirty_.add(minX, minY, maxX - minX, maxY - minY);
+        return *this;
+    }
+
+    Canvas& Canvas::clearDirty() {
+        dirty_.clear();
+        return *this;
+    }
+
+#ifndef PA2D_HEADLESS
     bool Canvas::loadImage(const char* filePath, int width, int height) {
-        if (width < 0 || height < 0)
-            return pa2d::loadImage(buffer_, filePath);
+        if (width < 0 || height < 0) {
+            const bool loaded = pa2d::loadImage(buffer_, filePath);
+            markDirty();
+            return loaded;
+        }
         else {
             if (pa2d::loadImage(buffer_, filePath)) {
                 *this = resized(width, height);
@@ -74,8 +118,11 @@ namespace pa2d {
     }
 
     bool Canvas::loadImage(int resourceID, int width, int height) {
-        if (width < 0 || height < 0)
-            return pa2d::loadImage(buffer_, resourceID);
+        if (width < 0 || height < 0) {
+            const bool loaded = pa2d::loadImage(buffer_, resourceID);
+            markDirty();
+            return loaded;
+        }
         else {
             if (pa2d::loadImage(buffer_, resourceID)) {
                 *this = resized(width, height);
@@ -86,20 +133,38 @@ namespace pa2d {
             }
         }
     }
+#endif
 
     Canvas& Canvas::clear(Color color) {
         buffer_.clear(Color(color));
-        return *this;
+        return markDirty();
+    }
+
+    PixelFormat Canvas::format() const {
+        return buffer_.format;
+    }
+
+    Canvas& Canvas::premultiply() {
+        if (buffer_.isPremultiplied()) return *this;
+        pa2d::premultiply(buffer_);
+        return markDirty();
+    }
+
+    Canvas& Canvas::unpremultiply() {
+        if (!buffer_.isPremultiplied()) return *this;
+        pa2d::unpremultiply(buffer_);
+        return markDirty();
     }
 
     Canvas& Canvas::blit(const Canvas& src, int DstX, int DstY) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::blit(src.buffer_, buffer_, DstX, DstY);
         return *this;
     }
 
     Canvas& Canvas::resizeBuffer(int newWidth, int newHeight, uint32_t clearColor) {
         buffer_.resize(newWidth, newHeight, Color(clearColor));
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::resize(int width, int height) {
@@ -108,51 +173,59 @@ namespace pa2d {
     }
 
     Canvas& Canvas::blend(const Canvas& src, int x, int y, int alpha, int Mode) {
-        switch (Mode) {
-        case 0: return alphaBlend(src, x, y, alpha);
-        case 1: return addBlend(src, x, y, alpha);
-        case 2: return multiplyBlend(src, x, y, alpha);
-        case 3: return screenBlend(src, x, y, alpha);
-        case 4: return overlayBlend(src, x, y, alpha);
-        case 5: return destAlphaBlend(src, x, y, alpha);
-        default:
-            break;
-        }
+        static const BlendMode modes[] = {
+            BlendMode::SrcOver, BlendMode::Add, BlendMode::Multiply,
+            BlendMode::Screen, BlendMode::Overlay, BlendMode::DestAlpha
+        };
+        if (Mode < 0 || Mode >= static_cast<int>(sizeof(modes) / sizeof(modes[0]))) return *this;
+        return blend(src, x, y, alpha, modes[Mode]);
+    }
+
+    Canvas& Canvas::blend(const Canvas& src, int x, int y, int alpha, BlendMode mode) {
+        utils::ScopedDirtyRegion track(dirty_);
+        pa2d::blend(src.buffer_, buffer_, x, y, mode, alpha);
+        return *this;
     }
 
     Canvas& Canvas::alphaBlend(const Canvas& src, int dstX, int dstY, int alpha) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::alphaBlend(src.buffer_, buffer_, dstX, dstY, alpha);
         return *this;
     }
 
     Canvas& Canvas::addBlend(const Canvas& src, int dstX, int dstY, int alpha) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::addBlend(src.buffer_, buffer_, dstX, dstY, alpha);
         return *this;
     }
 
     Canvas& Canvas::multiplyBlend(const Canvas& src, int dstX, int dstY, int alpha) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::multiplyBlend(src.buffer_, buffer_, dstX, dstY, alpha);
         return *this;
     }
 
     Canvas& Canvas::screenBlend(const Canvas& src, int dstX, int dstY, int alpha) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::screenBlend(src.buffer_, buffer_, dstX, dstY, alpha);
         return *this;
     }
 
     Canvas& Canvas::overlayBlend(const Canvas& src, int dstX, int dstY, int alpha) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::overlayBlend(src.buffer_, buffer_, dstX, dstY, alpha);
         return *this;
     }
 
     Canvas& Canvas::destAlphaBlend(const Canvas& src, int dstX, int dstY, int alpha) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::destAlphaBlend(src.buffer_, buffer_, dstX, dstY, alpha);
         return *this;
     }
 
     Canvas& Canvas::crop(int x, int y, int width, int height) {
         buffer_ = pa2d::crop(buffer_, x, y, width, height);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::draw(const Canvas& src, float centerX, float centerY, int alpha) {
@@ -160,35 +233,69 @@ namespace pa2d {
     }
 
     Canvas& Canvas::drawRotated(const Canvas& src, float centerX, float centerY, float rotation) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::drawRotated(buffer_, src.buffer_, centerX, centerY, rotation);
         return *this;
     }
 
     Canvas& Canvas::drawScaled(const Canvas& src, float centerX, float centerY, float scaleX, float scaleY) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::drawScaled(buffer_, src.buffer_, centerX, centerY, scaleX, scaleY);
         return *this;
     }
 
     Canvas& Canvas::drawResized(const Canvas& src, float centerX, float centerY, int width, int height) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::drawResized(buffer_, src.buffer_, centerX, centerY, width, height);
         return *this;
     }
 
     Canvas& Canvas::drawScaled(const Canvas& src, float centerX, float centerY, float scale) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::drawScaled(buffer_, src.buffer_, centerX, centerY, scale);
         return *this;
     }
 
     Canvas& Canvas::drawTransformed(const Canvas& src, float centerX, float centerY, float scale, float rotation) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::drawTransformed(buffer_, src.buffer_, centerX, centerY, scale, rotation);
         return *this;
     }
 
     Canvas& Canvas::drawTransformed(const Canvas& src, float centerX, float centerY, float scaleX, float scaleY, float rotation) {
+        utils::ScopedDirtyRegion track(dirty_);
         pa2d::drawTransformed(buffer_, src.buffer_, centerX, centerY, scaleX, scaleY, rotation);
         return *this;
     }
 
+    Canvas& Canvas::blit(Atlas& atlas, const AtlasRegion& region, int dstX, int dstY) {
+        utils::ScopedDirtyRegion track(dirty_);
+        pa2d::blit(atlas.view(region), buffer_, dstX, dstY);
+        return *this;
+    }
+
+    Canvas& Canvas::draw(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, int alpha) {
+        utils::ScopedDirtyRegion track(dirty_);
+        pa2d::alphaBlend(atlas.view(region), buffer_, centerX - region.width / 2, centerY - region.height / 2, alpha);
+        return *this;
+    }
+
+    Canvas& Canvas::drawScaled(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scaleX, float scaleY) {
+        utils::ScopedDirtyRegion track(dirty_);
+        pa2d::drawScaled(buffer_, atlas.view(region), centerX, centerY, scaleX, scaleY);
+        return *this;
+    }
+
+    Canvas& Canvas::drawScaled(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scale) {
+        return drawScaled(atlas, region, centerX, centerY, scale, scale);
+    }
+
+    Canvas& Canvas::drawTransformed(Atlas& atlas, const AtlasRegion& region, float centerX, float centerY, float scale, float rotation) {
+        utils::ScopedDirtyRegion track(dirty_);
+        pa2d::drawTransformed(buffer_, atlas.view(region), centerX, centerY, scale, rotation);
+        return *this;
+    }
+
     Canvas Canvas::cropped(int x, int y, int width, int height) const {
         if (!buffer_.isValid()) {
             return Canvas();
@@ -228,6 +335,30 @@ namespace pa2d {
         return Canvas(std::move(scaledBuffer));
     }
 
+    Canvas Canvas::resized(int width, int height, ResampleFilter filter) const {
+        if (!buffer_.isValid() || width <= 0 || height <= 0) {
+            return Canvas();
+        }
+        Buffer scaledBuffer = pa2d::resized(buffer_, width, height, filter);
+        return Canvas(std::move(scaledBuffer));
+    }
+
+    Canvas Canvas::scaled(float scaleX, float scaleY, ResampleFilter filter) const {
+        if (!buffer_.isValid() || scaleX <= 0.0f || scaleY <= 0.0f) {
+            return Canvas();
+        }
+        Buffer scaledBuffer = pa2d::scaled(buffer_, scaleX, scaleY, filter);
+        return Canvas(std::move(scaledBuffer));
+    }
+
+    Canvas Canvas::upscaled(int factor) const {
+        if (!buffer_.isValid() || factor <= 0) {
+            return Canvas();
+        }
+        Buffer scaledBuffer = pa2d::upscaled(buffer_, factor);
+        return Canvas(std::move(scaledBuffer));
+    }
+
     Canvas Canvas::rotated(float rotation) const {
         if (!buffer_.isValid()) {
             return Canvas();
@@ -256,6 +387,8 @@ namespace pa2d {
     }
 
     Canvas& Canvas::rect(float x, float y, float width, float height, const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::roundRect(buffer_, x, y, width, height,
             style.fill_, style.stroke_, style.radius_, style.width_);
         return *this;
@@ -263,6 +396,8 @@ namespace pa2d {
 
     Canvas& Canvas::rect(float centerX, float centerY, float width, float height,
         float angle, const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::roundRect(buffer_, centerX, centerY, width, height, angle,
             style.fill_, style.stroke_, style.radius_, style.width_);
         return *this;
@@ -270,6 +405,8 @@ namespace pa2d {
 
     Canvas& Canvas::circle(float centerX, float centerY, float radius,
         const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::circle(buffer_, centerX, centerY, radius,
             style.fill_, style.stroke_, style.width_);
         return *this;
@@ -277,6 +414,8 @@ namespace pa2d {
 
     Canvas& Canvas::ellipse(float cx, float cy, float width, float height,
         const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::ellipse(buffer_, cx, cy, width, height,
             style.fill_, style.stroke_, style.width_);
         return *this;
@@ -284,6 +423,8 @@ namespace pa2d {
 
     Canvas& Canvas::ellipse(float cx, float cy, float width, float height,
         float angle, const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::ellipse(buffer_, cx, cy, width, height, angle,
             style.fill_, style.stroke_, style.width_);
         return *this;
@@ -291,6 +432,8 @@ namespace pa2d {
 
     Canvas& Canvas::triangle(float ax, float ay, float bx, float by,
         float cx, float cy, const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::triangle(buffer_, ax, ay, bx, by, cx, cy,
             style.fill_, style.stroke_, style.width_);
         return *this;
@@ -299,6 +442,8 @@ namespace pa2d {
     Canvas& Canvas::sector(float cx, float cy, float radius,
         float startAngleDeg, float endAngleDeg,
         const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::sector(buffer_, cx, cy, radius, startAngleDeg, endAngleDeg,
             style.fill_, style.stroke_, style.width_,
             style.arc_, style.edges_);
@@ -307,6 +452,8 @@ namespace pa2d {
 
     Canvas& Canvas::line(float x0, float y0, float x1, float y1,
         const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::line(buffer_, x0, y0, x1, y1,
             style.stroke_, style.width_);
         return *this;
@@ -314,6 +461,8 @@ namespace pa2d {
 
     Canvas& Canvas::polyline(const std::vector<Point>& points,
         const Style& style, bool closed) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::polyline(buffer_, points, style.stroke_,
             style.width_, closed);
         return *this;
@@ -321,155 +470,68 @@ namespace pa2d {
 
     Canvas& Canvas::polygon(const std::vector<Point>& vertices,
         const Style& style) {
+        utils::ScopedDirtyRegion track(dirty_);
+        const utils::ScopedCompositeOp op(style.blend_, style.opacity_);
         pa2d::polygon(buffer_, vertices,
             style.fill_, style.stroke_, style.width_);
         return *this;
     }
 
     Canvas& Canvas::draw(const Shape& shape, const Style& style) {
-        switch (shape.getType()) {
-        case Shape::GeometryType::POINTS: {
-            const Points& points = static_cast<const Points&>(shape);
-            return drawImpl(points, style);
-        }
-        case Shape::GeometryType::LINE: {
-            const Line& line = static_cast<const Line&>(shape);
-            return drawImpl(line, style);
-        }
-        case Shape::GeometryType::POLYGON: {
-            const Polygon& polygon = static_cast<const Polygon&>(shape);
-            return drawImpl(polygon, style);
-        }
-        case Shape::GeometryType::RECT: {
-            const Rect& rect = static_cast<const Rect&>(shape);
-            return drawImpl(rect, style);
-        }
-        case Shape::GeometryType::TRIANGLE: {
-            const Triangle& triangle = static_cast<const Triangle&>(shape);
-            return drawImpl(triangle, style);
-        }
-        case Shape::GeometryType::CIRCLE: {
-            const Circle& circle = static_cast<const Circle&>(shape);
-            return drawImpl(circle, style);
-        }
-        case Shape::GeometryType::ELLIPTIC: {
-            const Elliptic& ellipse = static_cast<const Elliptic&>(shape);
-            return drawImpl(ellipse, style);
-        }
-        case Shape::GeometryType::SECTOR: {
-            const Sector& sector = static_cast<const Sector&>(shape);
-            return drawImpl(sector, style);
-        }
-        case Shape::GeometryType::RAY: {
-            const Ray& ray = static_cast<const Ray&>(shape);
-            return drawImpl(ray, style);
-        }
-        default: {
-#ifdef _DEBUG
-            assert(false && "Unknown shape type in Canvas::draw");
-#endif
-            return *this;
-        }
-        }
-    }
-
-    Canvas& Canvas::drawImpl(const Line& line, const Style& style) {
-        return this->line(line.start().x, line.start().y,
-            line.end().x, line.end().y, style);
+        return utils::drawShape(*this, shape, style);
     }
 
-    Canvas& Canvas::drawImpl(const Ray& ray, const Style& style) {
-        return line(ray.start().x, ray.start().y,
-            ray.end().x, ray.end().y, style);
-    }
-
-    Canvas& Canvas::drawImpl(const Triangle& triangle, const Style& style) {
-        return this->triangle(triangle[0].x, triangle[0].y,
-            triangle[1].x, triangle[1].y,
-            triangle[2].x, triangle[2].y, style);
-    }
-
-    Canvas& Canvas::drawImpl(const Rect& rect, const Style& style) {
-        return this->rect(rect.center().x, rect.center().y,
-            rect.width(), rect.height(),
-            rect.rotation(), style);
-    }
-
-    Canvas& Canvas::drawImpl(const Circle& circle, const Style& style) {
-        return this->circle(circle.x(), circle.y(), circle.radius(), style);
-    }
-
-    Canvas& Canvas::drawImpl(const Elliptic& ellipse, const Style& style) {
-        return this->ellipse(ellipse.x(), ellipse.y(),
-            ellipse.width(), ellipse.height(),
-            ellipse.rotation(), style);
-    }
-
-    Canvas& Canvas::drawImpl(const Sector& sector, const Style& style) {
-        return this->sector(sector.x(), sector.y(), sector.radius(),
-            sector.startAngle(), sector.endAngle(), style);
-    }
-
-    Canvas& Canvas::drawImpl(const Points& points, const Style& style) {
-        if (points.points.size() >= 3) {
-            std::vector<Point> pointVec(points.points.begin(), points.points.end());
-            return polyline(pointVec, style, false);
-        }
-        else if (points.points.size() == 2) {
-            return line(points.points[0].x, points.points[0].y,
-                points.points[1].x, points.points[1].y, style);
-        }
-        else if (points.points.size() == 1) {
-            Style pointStyle = style;
-            if (style.fill_ == None && style.stroke_ != None) {
-                pointStyle.fill(style.stroke_);
-            }
-            return circle(points.points[0].x, points.points[0].y, 1.0f, pointStyle);
-        }
+    Canvas& Canvas::replay(const CommandList& commands) {
+        utils::ScopedDirtyRegion track(dirty_);
+        commands.replay(buffer_);
         return *this;
     }
 
-    Canvas& Canvas::drawImpl(const Polygon& polygon, const Style& style) {
-        return this->polygon(polygon, style);
+    Canvas& Canvas::drawSprites(SpriteBatch& batch) {
+        utils::ScopedDirtyRegion track(dirty_);
+        batch.render(buffer_);
+        return *this;
     }
 
+#ifndef PA2D_HEADLESS
     Canvas& Canvas::text(int x, int y, const std::wstring& text, int fontSize, const Color& color, FontStyle style, const std::wstring& fontName) {
         pa2d::text(buffer_, (float)x, (float)y, text, fontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::textCentered(int centerX, int centerY, const std::wstring& text, int fontSize, const Color& color, FontStyle style, const std::wstring& fontName) {
         pa2d::textCentered(buffer_, (float)centerX, (float)centerY, text, fontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::textInRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::wstring& text, int fontSize, const Color& color, FontStyle style, const std::wstring& fontName) {
         pa2d::textInRect(buffer_, (float)rectX, (float)rectY, (float)rectWidth, (float)rectHeight, text, fontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::textFitRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::wstring& text, int preferredFontSize, const Color& color, FontStyle style, const std::wstring& fontName) {
         pa2d::textFitRect(buffer_, (float)rectX, (float)rectY, (float)rectWidth, (float)rectHeight, text, preferredFontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::text(int x, int y, const std::string& text, int fontSize, const Color& color, FontStyle style, const std::string& fontName) {
         pa2d::text(buffer_, (float)x, (float)y, text, fontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::textCentered(int centerX, int centerY, const std::string& text, int fontSize, const Color& color, FontStyle style, const std::string& fontName) {
         pa2d::textCentered(buffer_, (float)centerX, (float)centerY, text, fontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::textInRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::string& text, int fontSize, const Color& color, FontStyle style, const std::string& fontName) {
         pa2d::textInRect(buffer_, (float)rectX, (float)rectY, (float)rectWidth, (float)rectHeight, text, fontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
 
     Canvas& Canvas::textFitRect(int rectX, int rectY, int rectWidth, int rectHeight, const std::string& text, int preferredFontSize, const Color& color, FontStyle style, const std::string& fontName) {
         pa2d::textFitRect(buffer_, (float)rectX, (float)rectY, (float)rectWidth, (float)rectHeight, text, preferredFontSize, color, style, fontName);
-        return *this;
+        return markDirty();
     }
+#endif
 } // namespace pa2d
\ No newline at end of file
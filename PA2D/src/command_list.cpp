@@ -0,0 +1,207 @@
+// command_list.cpp
+#include "../include/command_list.h"
+#include "../include/draw.h"
+#include "internal/blend_utils.h"
+#include "internal/shape_dispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pa2d {
+    namespace {
+        constexpr float COMMAND_PI = 3.14159265358979323846f;
+
+        // 描边半宽 + 抗锯齿过渡带，与各光栅化函数的包围盒扩展保持一致（额外留 1 像素余量）
+        inline float boundsMargin(const Style& style) {
+            return (style.width_ + 1.0f) * 0.5f + 2.0f;
+        }
+
+        // 旋转矩形/椭圆在世界坐标下的半宽高
+        inline void rotatedHalfExtents(float width, float height, float angleDeg, float& extX, float& extY) {
+            const float a = angleDeg * (COMMAND_PI / 180.0f);
+            const float c = std::fabs(std::cos(a));
+            const float s = std::fabs(std::sin(a));
+            extX = (c * width + s * height) * 0.5f;
+            extY = (s * width + c * height) * 0.5f;
+        }
+
+        inline bool sameStyle(const Style& a, const Style& b) {
+            return a.fill_ == b.fill_ && a.stroke_ == b.stroke_ && a.width_ == b.width_ && a.radius_ == b.radius_ &&
+                a.arc_ == b.arc_ && a.edges_ == b.edges_ && a.blend_ == b.blend_ && a.opacity_ == b.opacity_;
+        }
+    }
+
+    CommandList::Command& CommandList::push(Op op, const Style& style) {
+        commands_.emplace_back();
+        Command& cmd = commands_.back();
+        cmd.op = op;
+        cmd.closed = false;
+        cmd.pointOffset = 0;
+        cmd.pointCount = 0;
+        std::fill(cmd.p, cmd.p + 6, 0.0f);
+        // 相邻命令多半沿用同一样式，只在样式变化时追加
+        if (styles_.empty() || !sameStyle(styles_.back(), style)) styles_.push_back(style);
+        cmd.styleIndex = static_cast<uint32_t>(styles_.size() - 1);
+        return cmd;
+    }
+
+    CommandList::Command& CommandList::pushPath(Op op, const std::vector<Point>& points, const Style& style) {
+        Command& cmd = push(op, style);
+        cmd.pointOffset = static_cast<uint32_t>(points_.size());
+        cmd.pointCount = static_cast<uint32_t>(points.size());
+        points_.insert(points_.end(), points.begin(), points.end());
+
+        Point minPt = points[0], maxPt = points[0];
+        for (const Point& pt : points) {
+            minPt.x = std::min(minPt.x, pt.x); minPt.y = std::min(minPt.y, pt.y);
+            maxPt.x = std::max(maxPt.x, pt.x); maxPt.y = std::max(maxPt.y, pt.y);
+        }
+        setBounds(cmd, minPt.x, minPt.y, maxPt.x, maxPt.y);
+        return cmd;
+    }
+
+    void CommandList::setBounds(Command& cmd, float minX, float minY, float maxX, float maxY) const {
+        const float m = boundsMargin(styles_[cmd.styleIndex]);
+        cmd.minX = minX - m;
+        cmd.minY = minY - m;
+        cmd.maxX = maxX + m;
+        cmd.maxY = maxY + m;
+    }
+
+    CommandList& CommandList::clear() {
+        commands_.clear();
+        styles_.clear();
+        points_.clear();
+        return *this;
+    }
+
+    CommandList& CommandList::reserve(size_t count) {
+        commands_.reserve(count);
+        return *this;
+    }
+
+    CommandList& CommandList::rect(float x, float y, float width, float height, const Style& style) {
+        Command& cmd = push(Op::Rect, style);
+        cmd.p[0] = x; cmd.p[1] = y; cmd.p[2] = width; cmd.p[3] = height;
+        setBounds(cmd, x, y, x + width, y + height);
+        return *this;
+    }
+
+    CommandList& CommandList::rect(float centerX, float centerY, float width, float height, float angle, const Style& style) {
+        Command& cmd = push(Op::RectRotated, style);
+        cmd.p[0] = centerX; cmd.p[1] = centerY; cmd.p[2] = width; cmd.p[3] = height; cmd.p[4] = angle;
+        float extX, extY;
+        rotatedHalfExtents(width, height, angle, extX, extY);
+        setBounds(cmd, centerX - extX, centerY - extY, centerX + extX, centerY + extY);
+        return *this;
+    }
+
+    CommandList& CommandList::circle(float centerX, float centerY, float radius, const Style& style) {
+        Command& cmd = push(Op::Circle, style);
+        cmd.p[0] = centerX; cmd.p[1] = centerY; cmd.p[2] = radius;
+        setBounds(cmd, centerX - radius, centerY - radius, centerX + radius, centerY + radius);
+        return *this;
+    }
+
+    CommandList& CommandList::ellipse(float cx, float cy, float width, float height, const Style& style) {
+        Command& cmd = push(Op::Ellipse, style);
+        cmd.p[0] = cx; cmd.p[1] = cy; cmd.p[2] = width; cmd.p[3] = height;
+        setBounds(cmd, cx - width * 0.5f, cy - height * 0.5f, cx + width * 0.5f, cy + height * 0.5f);
+        return *this;
+    }
+
+    CommandList& CommandList::ellipse(float cx, float cy, float width, float height, float angle, const Style& style) {
+        Command& cmd = push(Op::EllipseRotated, style);
+        cmd.p[0] = cx; cmd.p[1] = cy; cmd.p[2] = width; cmd.p[3] = height; cmd.p[4] = angle;
+        float extX, extY;
+        rotatedHalfExtents(width, height, angle, extX, extY);
+        setBounds(cmd, cx - extX, cy - extY, cx + extX, cy + extY);
+        return *this;
+    }
+
+    CommandList& CommandList::triangle(float ax, float ay, float bx, float by, float cx, float cy, const Style& style) {
+        Command& cmd = push(Op::Triangle, style);
+        cmd.p[0] = ax; cmd.p[1] = ay; cmd.p[2] = bx; cmd.p[3] = by; cmd.p[4] = cx; cmd.p[5] = cy;
+        setBounds(cmd, std::min({ ax, bx, cx }), std::min({ ay, by, cy }),
+            std::max({ ax, bx, cx }), std::max({ ay, by, cy }));
+        return *this;
+    }
+
+    CommandList& CommandList::sector(float cx, float cy, float radius, float startAngleDeg, float endAngleDeg, const Style& style) {
+        Command& cmd = push(Op::Sector, style);
+        cmd.p[0] = cx; cmd.p[1] = cy; cmd.p[2] = radius; cmd.p[3] = startAngleDeg; cmd.p[4] = endAngleDeg;
+        setBounds(cmd, cx - radius, cy - radius, cx + radius, cy + radius);
+        return *this;
+    }
+
+    CommandList& CommandList::line(float x0, float y0, float x1, float y1, const Style& style) {
+        Command& cmd = push(Op::Line, style);
+        cmd.p[0] = x0; cmd.p[1] = y0; cmd.p[2] = x1; cmd.p[3] = y1;
+        setBounds(cmd, std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1));
+        return *this;
+    }
+
+    CommandList& CommandList::polyline(const std::vector<Point>& points, const Style& style, bool closed) {
+        if (points.size() < 2) return *this;
+        pushPath(Op::Polyline, points, style).closed = closed;
+        return *this;
+    }
+
+    CommandList& CommandList::polygon(const std::vector<Point>& vertices, const Style& style) {
+        if (vertices.size() < 3) return *this;
+        pushPath(Op::Polygon, vertices, style);
+        return *this;
+    }
+
+    CommandList& CommandList::draw(const Shape& shape, const Style& style) {
+        return utils::drawShape(*this, shape, style);
+    }
+
+    void CommandList::execute(Buffer& target, const Command& cmd) const {
+        const Style& s = style(cmd);
+        const float* p = cmd.p;
+        const utils::ScopedCompositeOp op(s.blend_, s.opacity_);
+        switch (cmd.op) {
+        case Op::Rect:
+            pa2d::roundRect(target, p[0], p[1], p[2], p[3], s.fill_, s.stroke_, s.radius_, s.width_);
+            break;
+        case Op::RectRotated:
+            pa2d::roundRect(target, p[0], p[1], p[2], p[3], p[4], s.fill_, s.stroke_, s.radius_, s.width_);
+            break;
+        case Op::Circle:
+            pa2d::circle(target, p[0], p[1], p[2], s.fill_, s.stroke_, s.width_);
+            break;
+        case Op::Ellipse:
+            pa2d::ellipse(target, p[0], p[1], p[2], p[3], s.fill_, s.stroke_, s.width_);
+            break;
+        case Op::EllipseRotated:
+            pa2d::ellipse(target, p[0], p[1], p[2], p[3], p[4], s.fill_, s.stroke_, s.width_);
+            break;
+        case Op::Triangle:
+            pa2d::triangle(target, p[0], p[1], p[2], p[3], p[4], p[5], s.fill_, s.stroke_, s.width_);
+            break;
+        case Op::Sector:
+            pa2d::sector(target, p[0], p[1], p[2], p[3], p[4], s.fill_, s.stroke_, s.width_, s.arc_, s.edges_);
+            break;
+        case Op::Line:
+            pa2d::line(target, p[0], p[1], p[2], p[3], s.stroke_, s.width_);
+            break;
+        case Op::Polyline:
+            pa2d::polyline(target, points(cmd), cmd.pointCount, s.stroke_, s.width_, cmd.closed);
+            break;
+        case Op::Polygon:
+            pa2d::polygon(target, points(cmd), cmd.pointCount, s.fill_, s.stroke_, s.width_);
+            break;
+        }
+    }
+
+    void CommandList::replay(Buffer& target) const {
+        if (!target.isValid()) return;
+        const float w = static_cast<float>(target.width);
+        const float h = static_cast<float>(target.height);
+        for (const Command& cmd : commands_) {
+            // 剔除完全位于目标之外的命令
+            if (cmd.maxX < 0.0f || cmd.maxY < 0.0f || cmd.minX >= w || cmd.minY >= h) continue;
+            execute(target, cmd);
+        }
+    }
+}
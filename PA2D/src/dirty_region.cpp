@@ -0,0 +1,94 @@
+// dirty_region.cpp
+#include "../include/dirty_region.h"
+#include <algorithm>
+
+namespace pa2d {
+    static inline bool touches(const RectInt& a, const RectInt& b) {
+        return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+            a.y <= b.y + b.height && b.y <= a.y + a.height;
+    }
+
+    static inline RectInt unite(const RectInt& a, const RectInt& b) {
+        const int left = std::min(a.x, b.x);
+        const int top = std::min(a.y, b.y);
+        const int right = std::max(a.x + a.width, b.x + b.width);
+        const int bottom = std::max(a.y + a.height, b.y + b.height);
+        return { left, top, right - left, bottom - top };
+    }
+
+    static inline long long area(const RectInt& r) {
+        return static_cast<long long>(r.width) * r.height;
+    }
+
+    void DirtyRegion::add(int x, int y, int width, int height) {
+        add(RectInt{ x, y, width, height });
+    }
+
+    void DirtyRegion::markAll(int width, int height) noexcept {
+        rects_.clear();
+        all_ = width > 0 && height > 0;
+        allRect_ = { 0, 0, width, height };
+    }
+
+    void DirtyRegion::expandAll() const {
+        if (!all_) return;
+        rects_.assign(1, allRect_);
+        all_ = false;
+    }
+
+    const std::vector<RectInt>& DirtyRegion::rects() const {
+        expandAll();
+        return rects_;
+    }
+
+    void DirtyRegion::add(const RectInt& rect) {
+        if (rect.width <= 0 || rect.height <= 0) return;
+        if (all_) {
+            // 已整块标记：落在整块之内时无需记录
+            if (rect.x >= 0 && rect.y >= 0 &&
+                rect.x + rect.width <= allRect_.width && rect.y + rect.height <= allRect_.height) return;
+            expandAll();
+        }
+
+        // 吸收所有与之重叠或相邻的矩形，合并后可能接触到新的矩形，因此重新扫描
+        RectInt merged = rect;
+        for (size_t i = 0; i < rects_.size();) {
+            if (touches(rects_[i], merged)) {
+                merged = unite(rects_[i], merged);
+                rects_[i] = rects_.back();
+                rects_.pop_back();
+                i = 0;
+            }
+            else {
+                ++i;
+            }
+        }
+        rects_.push_back(merged);
+        if (rects_.size() <= static_cast<size_t>(MAX_RECTS)) return;
+
+        // 超出上限：合并额外面积最小的一对
+        size_t bestI = 0, bestJ = 1;
+        long long bestWaste = -1;
+        for (size_t i = 0; i < rects_.size(); ++i) {
+            for (size_t j = i + 1; j < rects_.size(); ++j) {
+                const long long waste = area(unite(rects_[i], rects_[j])) - area(rects_[i]) - area(rects_[j]);
+                if (bestWaste < 0 || waste < bestWaste) {
+                    bestWaste = waste;
+                    bestI = i; bestJ = j;
+                }
+            }
+        }
+        const RectInt combined = unite(rects_[bestI], rects_[bestJ]);
+        rects_.erase(rects_.begin() + bestJ);
+        rects_.erase(rects_.begin() + bestI);
+        add(combined);
+    }
+
+    RectInt DirtyRegion::bounds() const {
+        if (all_) return allRect_;
+        if (rects_.empty()) return { 0, 0, 0, 0 };
+        RectInt result = rects_[0];
+        for (size_t i = 1; i < rects_.size(); ++i) result = unite(result, rects_[i]);
+        return result;
+    }
+}
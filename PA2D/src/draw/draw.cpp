@@ -0,0 +1,69 @@
+// draw.cpp
+// 图形光栅化入口：按当前 SIMD 等级转发到 kernels_draw_sse41.cpp / kernels_draw_avx2.cpp 中的实现
+// 折线与多边形的线段网格、边表与指令集无关，在这里构建一次再交给内核
+#include"../include/draw.h"
+#include"internal/kernels.h"
+
+namespace pa2d {
+    void line(Buffer& buffer, float startX, float startY, float endX, float endY, const Color& color, float width) {
+        utils::kernels().line(buffer, startX, startY, endX, endY, color, width);
+    }
+
+    void polyline(Buffer& buffer, const std::vector<Point>& points, const Color& color, float width, bool closed) {
+        polyline(buffer, points.data(), points.size(), color, width, closed);
+    }
+
+    void polygon(Buffer& buffer, const std::vector<Point>& vertices, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        polygon(buffer, vertices.data(), vertices.size(), fillColor, strokeColor, strokeWidth);
+    }
+
+    void polyline(Buffer& buffer, const Point* points, size_t count, const Color& color, float width, bool closed) {
+        if (!buffer.isValid() || color.a == 0 || width <= 0 || count < 2) return;
+        utils::PolylineSegments path;
+        path.build(points, count, closed, width, { 0, 0, buffer.width - 1, buffer.height - 1 });
+        utils::kernels().polyline(buffer, path, color, width);
+    }
+
+    void polygon(Buffer& buffer, const Point* vertices, size_t count, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        if (!buffer.isValid() || count < 3) return;
+        utils::PolygonEdges path;
+        path.build(vertices, count);
+        utils::kernels().polygon(buffer, path, fillColor, strokeColor, strokeWidth);
+    }
+
+    void triangle(Buffer& buffer, float x0, float y0, float x1, float y1, float x2, float y2, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        utils::kernels().triangle(buffer, x0, y0, x1, y1, x2, y2, fillColor, strokeColor, strokeWidth);
+    }
+
+    void rect(Buffer& buffer, float left, float top, float width, float height, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        utils::kernels().rect(buffer, left, top, width, height, fillColor, strokeColor, strokeWidth);
+    }
+
+    void rect(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        utils::kernels().rotatedRect(buffer, centerX, centerY, width, height, angle, fillColor, strokeColor, strokeWidth);
+    }
+
+    void roundRect(Buffer& buffer, float left, float top, float width, float height, const Color& fillColor, const Color& strokeColor, float radius, float strokeWidth) {
+        utils::kernels().roundRect(buffer, left, top, width, height, fillColor, strokeColor, radius, strokeWidth);
+    }
+
+    void roundRect(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, const Color& fillColor, const Color& strokeColor, float radius, float strokeWidth) {
+        utils::kernels().rotatedRoundRect(buffer, centerX, centerY, width, height, angle, fillColor, strokeColor, radius, strokeWidth);
+    }
+
+    void circle(Buffer& buffer, float centerX, float centerY, float radius, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        utils::kernels().circle(buffer, centerX, centerY, radius, fillColor, strokeColor, strokeWidth);
+    }
+
+    void ellipse(Buffer& buffer, float centerX, float centerY, float width, float height, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        utils::kernels().ellipse(buffer, centerX, centerY, width, height, fillColor, strokeColor, strokeWidth);
+    }
+
+    void ellipse(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, const Color& fillColor, const Color& strokeColor, float strokeWidth) {
+        utils::kernels().rotatedEllipse(buffer, centerX, centerY, width, height, angle, fillColor, strokeColor, strokeWidth);
+    }
+
+    void sector(Buffer& buffer, float centerX, float centerY, float radius, float startAngle, float endAngle, const Color& fillColor, const Color& strokeColor, float strokeWidth, bool arc, bool edges) {
+        utils::kernels().sector(buffer, centerX, centerY, radius, startAngle, endAngle, fillColor, strokeColor, strokeWidth, arc, edges);
+    }
+}
@@ -0,0 +1,444 @@
+#include"../include/draw.h"
+#include"internal/blend_utils.h"
+#include"internal/thread_pool.h"
+#include"internal/clip.h"
+#include <cfloat>
+
+using namespace pa2d::utils;
+using namespace pa2d::utils::simd;
+
+namespace pa2d { namespace utils { namespace PA2D_ISA {
+    // 某条边在当前扫描线上可能影响的像素区间（闭区间）
+    struct NearEdge {
+        int x0, x1;
+        uint32_t edge;
+    };
+
+
+    void polygon(
+        pa2d::Buffer& buffer,
+        const PolygonEdges& path,
+        const pa2d::Color& fillColor,
+        const pa2d::Color& strokeColor,
+        float strokeWidth
+    ) {
+        if (!buffer.isValid() || path.edges.size() < 3) return;
+
+        // 1. 颜色与不透明度预处理
+        const float finalFillOpacity = fillColor.a * (1.0f / 255.0f);
+        const float finalStrokeOpacity = strokeColor.a * (1.0f / 255.0f);
+        const bool drawFill = (finalFillOpacity > 0.0f);
+        const bool drawStroke = (finalStrokeOpacity > 0.0f) && (strokeWidth > 0.0f);
+        if (!drawFill && !drawStroke) return;
+
+        const bool mode_stroke_over_fill = drawStroke && drawFill;
+        const bool mode_only_stroke = drawStroke && !drawFill;
+
+        // 2. 几何参数与包围盒
+        const float halfStrokeWidth = strokeWidth == 0 ? 0 : (strokeWidth + 1.0) * 0.5f;
+        const float maxExt = halfStrokeWidth + 1.0f;
+
+        const pa2d::Point& minPt = path.minPt;
+        const pa2d::Point& maxPt = path.maxPt;
+        const std::vector<EdgeParams>& edges = path.edges;
+        const std::vector<uint32_t>& edgeTable = path.order;
+        const size_t n = edges.size();
+
+        // 影响半径：与所有边的距离都超过该值的像素，描边 alpha 为 0，填充 alpha 只取决于内外
+        // 这类像素不需要计算距离，内部直接按实心跨度填充
+        const float influence = std::max(2.0f, halfStrokeWidth) + 1.0f;
+
+        const ClipRect clip = currentClip(buffer);
+        int minX = std::max(clip.minX, static_cast<int>(std::floor(minPt.x - maxExt)));
+        int maxX = std::min(clip.maxX, static_cast<int>(std::ceil(maxPt.x + maxExt)));
+        int minY = std::max(clip.minY, static_cast<int>(std::floor(minPt.y - maxExt)));
+        int maxY = std::min(clip.maxY, static_cast<int>(std::ceil(maxPt.y + maxExt)));
+
+        if (minX > maxX || minY > maxY) return;
+        reportDirty(minX, minY, maxX, maxY);
+
+        // 3. SIMD 常量
+#ifdef PA2D_AVX2
+        const __m256 halfStrokeWidth_v = _mm256_set1_ps(halfStrokeWidth);
+        const __m256 v_FLT_MAX = _mm256_set1_ps(FLT_MAX);
+        // 全 1 掩码：用于翻转奇偶规则的内外状态
+        const __m256 all_ones_mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        // 颜色常量
+        const __m256 fillR_v = _mm256_set1_ps(fillColor.r * (1.0f / 255.0f));
+        const __m256 fillG_v = _mm256_set1_ps(fillColor.g * (1.0f / 255.0f));
+        const __m256 fillB_v = _mm256_set1_ps(fillColor.b * (1.0f / 255.0f));
+        const __m256 fillA_v = _mm256_set1_ps(finalFillOpacity);
+
+        const __m256 strokeR_v = _mm256_set1_ps(strokeColor.r * (1.0f / 255.0f));
+        const __m256 strokeG_v = _mm256_set1_ps(strokeColor.g * (1.0f / 255.0f));
+        const __m256 strokeB_v = _mm256_set1_ps(strokeColor.b * (1.0f / 255.0f));
+        const __m256 strokeA_v = _mm256_set1_ps(finalStrokeOpacity);
+#endif
+
+        // SSE 常量
+        const __m128 halfStrokeWidth_sse = _mm_set1_ps(halfStrokeWidth);
+        const __m128 v_FLT_MAX_sse = _mm_set1_ps(FLT_MAX);
+        const __m128 all_ones_mask_sse = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        const __m128 fillR_sse = _mm_set1_ps(fillColor.r * (1.0f / 255.0f));
+        const __m128 fillG_sse = _mm_set1_ps(fillColor.g * (1.0f / 255.0f));
+        const __m128 fillB_sse = _mm_set1_ps(fillColor.b * (1.0f / 255.0f));
+        const __m128 fillA_sse = _mm_set1_ps(finalFillOpacity);
+
+        const __m128 strokeR_sse = _mm_set1_ps(strokeColor.r * (1.0f / 255.0f));
+        const __m128 strokeG_sse = _mm_set1_ps(strokeColor.g * (1.0f / 255.0f));
+        const __m128 strokeB_sse = _mm_set1_ps(strokeColor.b * (1.0f / 255.0f));
+        const __m128 strokeA_sse = _mm_set1_ps(finalStrokeOpacity);
+
+        // 4. 远离所有边的内部跨度按实心填充
+        const SolidSpan solid(fillColor);
+
+        // 5. 扫描线渲染：活动边表 + 按行排序的交点
+        // 远离所有边的像素只做内外判定（实心填充或跳过），靠近边的像素只与附近的边计算距离
+        compositeRows(buffer, minY, maxY, maxX - minX + 1, [&](const auto& comp, int rowBegin, int rowEnd) {
+            std::vector<uint32_t> active;       // 活动边：y 范围扩展影响半径后覆盖当前行
+            std::vector<float> crossings;       // 当前扫描线与多边形边界的交点 X（升序）
+            std::vector<NearEdge> nearEdges;    // 当前行各活动边可能影响的像素区间（按 x0 升序）
+            size_t nextEdge = 0;
+
+            for (int py = rowBegin; py <= rowEnd; ++py) {
+                const float fy = static_cast<float>(py) + 0.5f;
+                pa2d::Color* row = &buffer.at(0, py);
+
+#ifdef PA2D_AVX2
+                const __m256 py_v = _mm256_set1_ps(fy);
+#endif
+                const __m128 py_v_sse = _mm_set1_ps(fy);
+
+                // --- 更新活动边表 ---
+                while (nextEdge < n && edges[edgeTable[nextEdge]].yMin - influence <= fy) {
+                    active.push_back(edgeTable[nextEdge++]);
+                }
+                active.erase(std::remove_if(active.begin(), active.end(),
+                    [&](uint32_t idx) { return edges[idx].yMax + influence < fy; }), active.end());
+
+                // --- 交点与近边区间 ---
+                crossings.clear();
+                nearEdges.clear();
+                for (uint32_t idx : active) {
+                    const EdgeParams& edge = edges[idx];
+                    if (edge.yMin <= fy && edge.yMax > fy) {
+                        crossings.push_back(edge.xOfYMin + (fy - edge.yMin) * edge.invSlope);
+                    }
+                    // 边落在 [fy - influence, fy + influence] 内的部分决定其影响的 X 范围
+                    float t0 = 0.0f, t1 = 1.0f;
+                    if (!edge.isHorizontal) {
+                        float ta = (fy - influence - edge.ay) / edge.dy;
+                        float tb = (fy + influence - edge.ay) / edge.dy;
+                        if (ta > tb) std::swap(ta, tb);
+                        t0 = std::max(0.0f, ta);
+                        t1 = std::min(1.0f, tb);
+                        if (t0 > t1) { t0 = 0.0f; t1 = 1.0f; }
+                    }
+                    const float xa = edge.ax + t0 * edge.dx;
+                    const float xb = edge.ax + t1 * edge.dx;
+                    // 区间向外扩展到整组 8 像素，近边像素尽量走 AVX 路径
+                    NearEdge ne;
+                    ne.x0 = std::max(minX, static_cast<int>(std::floor(std::min(xa, xb) - influence)) & ~7);
+                    ne.x1 = std::min(maxX, static_cast<int>(std::ceil(std::max(xa, xb) + influence)) | 7);
+                    ne.edge = idx;
+                    if (ne.x0 <= ne.x1) nearEdges.push_back(ne);
+                }
+                std::sort(crossings.begin(), crossings.end());
+                std::sort(nearEdges.begin(), nearEdges.end(), [](const NearEdge& a, const NearEdge& b) { return a.x0 < b.x0; });
+
+                const size_t crossCount = crossings.size();
+                size_t crossed = 0; // 不大于当前像素中心的交点个数
+
+                int px = minX;
+                size_t next = 0;
+                while (px <= maxX) {
+                    // --- 远离所有边的区间：内外状态恒定 ---
+                    const int gapEnd = next < nearEdges.size() ? std::min(maxX, nearEdges[next].x0 - 1) : maxX;
+                    if (px <= gapEnd) {
+                        if (drawFill) {
+                            const float fx = static_cast<float>(px) + 0.5f;
+                            while (crossed < crossCount && crossings[crossed] <= fx) ++crossed;
+                            if ((crossCount - crossed) & 1) solid.fill(comp, row, px, gapEnd);
+                        }
+                        px = gapEnd + 1;
+                        continue;
+                    }
+
+                    // --- 合并重叠的近边区间，区间内只遍历这些边 ---
+                    const size_t first = next;
+                    int spanEnd = nearEdges[next].x1;
+                    while (++next < nearEdges.size() && nearEdges[next].x0 <= spanEnd + 1) {
+                        spanEnd = std::max(spanEnd, nearEdges[next].x1);
+                    }
+                    const size_t last = next;
+
+                    while (px <= spanEnd) {
+#ifdef PA2D_AVX2
+                        // --- AVX2 Loop (8 pixels) ---
+                        for (; (px & 7) == 0 && px <= spanEnd - 7; px += 8) {
+                            __m256i xBase = _mm256_setr_epi32(px, px + 1, px + 2, px + 3, px + 4, px + 5, px + 6, px + 7);
+                            __m256 px_v = _mm256_add_ps(_mm256_cvtepi32_ps(xBase), HALF_PIXEL_256);
+
+                            // 奇偶规则：像素右侧交点个数为奇数即在内部
+                            // 右侧交点数 = 总数 - 左侧（含）交点数，块内交点逐个翻转其右侧的通道
+                            const float fx0 = static_cast<float>(px) + 0.5f;
+                            const float fx7 = static_cast<float>(px + 7) + 0.5f;
+                            while (crossed < crossCount && crossings[crossed] <= fx0) ++crossed;
+                            __m256 inside_mask_acc = ((crossCount - crossed) & 1) ? all_ones_mask : ZERO_256;
+                            for (size_t c = crossed; c < crossCount && crossings[c] <= fx7; ++c) {
+                                __m256 cross_mask = _mm256_cmp_ps(px_v, _mm256_set1_ps(crossings[c]), _CMP_GE_OQ);
+                                inside_mask_acc = _mm256_xor_ps(inside_mask_acc, cross_mask);
+                            }
+
+                            __m256 min_dist_sq = v_FLT_MAX;
+                            for (size_t k = first; k < last; ++k) {
+                                const EdgeParams& edge = edges[nearEdges[k].edge];
+                                __m256 v_ax = _mm256_set1_ps(edge.ax);
+                                __m256 v_ay = _mm256_set1_ps(edge.ay);
+                                __m256 v_dx = _mm256_set1_ps(edge.dx);
+                                __m256 v_dy = _mm256_set1_ps(edge.dy);
+                                __m256 v_invLenSq = _mm256_set1_ps(edge.invLenSq);
+
+                                __m256 p_ax = _mm256_sub_ps(px_v, v_ax);
+                                __m256 p_ay = _mm256_sub_ps(py_v, v_ay);
+                                __m256 dot = _mm256_add_ps(_mm256_mul_ps(p_ax, v_dx), _mm256_mul_ps(p_ay, v_dy));
+                                __m256 t = _mm256_mul_ps(dot, v_invLenSq);
+                                t = _mm256_max_ps(ZERO_256, _mm256_min_ps(ONE_256, t));
+
+                                __m256 closestX = _mm256_add_ps(v_ax, _mm256_mul_ps(t, v_dx));
+                                __m256 closestY = _mm256_add_ps(v_ay, _mm256_mul_ps(t, v_dy));
+                                __m256 diffX = _mm256_sub_ps(px_v, closestX);
+                                __m256 diffY = _mm256_sub_ps(py_v, closestY);
+                                __m256 distSq = _mm256_add_ps(_mm256_mul_ps(diffX, diffX), _mm256_mul_ps(diffY, diffY));
+                                min_dist_sq = _mm256_min_ps(min_dist_sq, distSq);
+                            }
+
+                            __m256 dist_unsigned = _mm256_sqrt_ps(min_dist_sq);
+
+                            // Inside -> Negative SDF, Outside -> Positive SDF
+                            __m256 neg_dist = _mm256_sub_ps(ZERO_256, dist_unsigned);
+                            __m256 sdf = _mm256_blendv_ps(dist_unsigned, neg_dist, inside_mask_acc);
+
+                            // --- Alpha & Blending (Standard) ---
+                            __m256 effectiveFillAlpha = ZERO_256, fillCoverage = ZERO_256;
+                            if (drawFill) {
+                                __m256 t_fill = _mm256_div_ps(_mm256_sub_ps(sdf, ANTIALIAS_RANGE_256), ANTIALIAS_RANGE_256);
+                                __m256 fillAlpha_raw = _mm256_sub_ps(ONE_256, t_fill);
+                                fillCoverage = _mm256_max_ps(ZERO_256, _mm256_min_ps(ONE_256, fillAlpha_raw));
+                                effectiveFillAlpha = _mm256_mul_ps(fillCoverage, fillA_v);
+                            }
+
+                            __m256 effectiveStrokeAlpha = ZERO_256, strokeCoverage = ZERO_256;
+                            if (drawStroke) {
+                                __m256 halfWidthMinusDist = _mm256_sub_ps(halfStrokeWidth_v, dist_unsigned);
+                                __m256 t_stroke = _mm256_div_ps(halfWidthMinusDist, ANTIALIAS_RANGE_256);
+                                strokeCoverage = _mm256_max_ps(ZERO_256, _mm256_min_ps(ONE_256, t_stroke));
+                                effectiveStrokeAlpha = _mm256_mul_ps(strokeCoverage, strokeA_v);
+                            }
+
+                            __m256 finalAlpha, finalR, finalG, finalB;
+
+                            if (mode_stroke_over_fill) {
+                                __m256 oneMinusStrk = _mm256_sub_ps(ONE_256, effectiveStrokeAlpha);
+                                __m256 effFillMod = _mm256_mul_ps(effectiveFillAlpha, oneMinusStrk);
+                                finalAlpha = _mm256_add_ps(effectiveStrokeAlpha, effFillMod);
+
+                                finalR = _mm256_add_ps(_mm256_mul_ps(strokeR_v, effectiveStrokeAlpha), _mm256_mul_ps(fillR_v, effFillMod));
+                                finalG = _mm256_add_ps(_mm256_mul_ps(strokeG_v, effectiveStrokeAlpha), _mm256_mul_ps(fillG_v, effFillMod));
+                                finalB = _mm256_add_ps(_mm256_mul_ps(strokeB_v, effectiveStrokeAlpha), _mm256_mul_ps(fillB_v, effFillMod));
+
+                                __m256 invFinalAlpha = _mm256_div_ps(ONE_256, finalAlpha);
+                                __m256 zero_mask = _mm256_cmp_ps(finalAlpha, ZERO_256, _CMP_EQ_OQ);
+                                invFinalAlpha = _mm256_andnot_ps(zero_mask, invFinalAlpha);
+                                finalR = _mm256_mul_ps(finalR, invFinalAlpha);
+                                finalG = _mm256_mul_ps(finalG, invFinalAlpha);
+                                finalB = _mm256_mul_ps(finalB, invFinalAlpha);
+                            }
+                            else if (mode_only_stroke) {
+                                finalAlpha = effectiveStrokeAlpha;
+                                finalR = strokeR_v; finalG = strokeG_v; finalB = strokeB_v;
+                            }
+                            else {
+                                finalAlpha = effectiveFillAlpha;
+                                finalR = fillR_v; finalG = fillG_v; finalB = fillB_v;
+                            }
+
+                            __m256 mask = _mm256_cmp_ps(finalAlpha, ZERO_256, _CMP_GT_OQ);
+                            if (_mm256_testz_ps(mask, mask)) continue;
+
+                            __m256i dest = _mm256_loadu_si256((__m256i*) & row[px]);
+                            __m256i rgba = comp.avx(finalAlpha, dest, finalR, finalG, finalB, unionCoverage_avx(strokeCoverage, fillCoverage));
+                            rgba = _mm256_blendv_epi8(dest, rgba, _mm256_castps_si256(mask));
+                            _mm256_storeu_si256((__m256i*) & row[px], rgba);
+                        }
+#endif
+
+                        const int groupEnd = alignedGroupEnd(px, spanEnd);
+                        // --- SSE Loop (4 pixels) ---
+                        for (; px <= groupEnd - 3; px += 4) {
+                            __m128i xBase = _mm_setr_epi32(px, px + 1, px + 2, px + 3);
+                            __m128 px_v = _mm_add_ps(_mm_cvtepi32_ps(xBase), HALF_PIXEL_128);
+
+                            const float fx0 = static_cast<float>(px) + 0.5f;
+                            const float fx3 = static_cast<float>(px + 3) + 0.5f;
+                            while (crossed < crossCount && crossings[crossed] <= fx0) ++crossed;
+                            __m128 inside_mask_acc = ((crossCount - crossed) & 1) ? all_ones_mask_sse : ZERO_128;
+                            for (size_t c = crossed; c < crossCount && crossings[c] <= fx3; ++c) {
+                                __m128 cross_mask = _mm_cmpge_ps(px_v, _mm_set1_ps(crossings[c]));
+                                inside_mask_acc = _mm_xor_ps(inside_mask_acc, cross_mask);
+                            }
+
+                            __m128 min_dist_sq = v_FLT_MAX_sse;
+                            for (size_t k = first; k < last; ++k) {
+                                const EdgeParams& edge = edges[nearEdges[k].edge];
+                                __m128 v_ax = _mm_set1_ps(edge.ax);
+                                __m128 v_ay = _mm_set1_ps(edge.ay);
+                                __m128 v_dx = _mm_set1_ps(edge.dx);
+                                __m128 v_dy = _mm_set1_ps(edge.dy);
+                                __m128 v_invLenSq = _mm_set1_ps(edge.invLenSq);
+
+                                __m128 p_ax = _mm_sub_ps(px_v, v_ax);
+                                __m128 p_ay = _mm_sub_ps(py_v_sse, v_ay);
+                                __m128 dot = _mm_add_ps(_mm_mul_ps(p_ax, v_dx), _mm_mul_ps(p_ay, v_dy));
+                                __m128 t = _mm_mul_ps(dot, v_invLenSq);
+                                t = _mm_max_ps(ZERO_128, _mm_min_ps(ONE_128, t));
+
+                                __m128 closestX = _mm_add_ps(v_ax, _mm_mul_ps(t, v_dx));
+                                __m128 closestY = _mm_add_ps(v_ay, _mm_mul_ps(t, v_dy));
+                                __m128 diffX = _mm_sub_ps(px_v, closestX);
+                                __m128 diffY = _mm_sub_ps(py_v_sse, closestY);
+                                __m128 distSq = _mm_add_ps(_mm_mul_ps(diffX, diffX), _mm_mul_ps(diffY, diffY));
+                                min_dist_sq = _mm_min_ps(min_dist_sq, distSq);
+                            }
+
+                            __m128 dist_unsigned = _mm_sqrt_ps(min_dist_sq);
+                            __m128 neg_dist = _mm_sub_ps(ZERO_128, dist_unsigned);
+                            __m128 sdf = _mm_blendv_ps(dist_unsigned, neg_dist, inside_mask_acc);
+
+                            __m128 effectiveFillAlpha = ZERO_128, fillCoverage = ZERO_128;
+                            if (drawFill) {
+                                __m128 t_fill = _mm_div_ps(_mm_sub_ps(sdf, ANTIALIAS_RANGE_128), ANTIALIAS_RANGE_128);
+                                __m128 fillAlpha_raw = _mm_sub_ps(ONE_128, t_fill);
+                                fillCoverage = _mm_max_ps(ZERO_128, _mm_min_ps(ONE_128, fillAlpha_raw));
+                                effectiveFillAlpha = _mm_mul_ps(fillCoverage, fillA_sse);
+                            }
+
+                            __m128 effectiveStrokeAlpha = ZERO_128, strokeCoverage = ZERO_128;
+                            if (drawStroke) {
+                                __m128 halfWidthMinusDist = _mm_sub_ps(halfStrokeWidth_sse, dist_unsigned);
+                                __m128 t_stroke = _mm_div_ps(halfWidthMinusDist, ANTIALIAS_RANGE_128);
+                                strokeCoverage = _mm_max_ps(ZERO_128, _mm_min_ps(ONE_128, t_stroke));
+                                effectiveStrokeAlpha = _mm_mul_ps(strokeCoverage, strokeA_sse);
+                            }
+
+                            __m128 finalAlpha, finalR, finalG, finalB;
+                            if (mode_stroke_over_fill) {
+                                __m128 oneMinusStrk = _mm_sub_ps(ONE_128, effectiveStrokeAlpha);
+                                __m128 effFillMod = _mm_mul_ps(effectiveFillAlpha, oneMinusStrk);
+                                finalAlpha = _mm_add_ps(effectiveStrokeAlpha, effFillMod);
+
+                                finalR = _mm_add_ps(_mm_mul_ps(strokeR_sse, effectiveStrokeAlpha), _mm_mul_ps(fillR_sse, effFillMod));
+                                finalG = _mm_add_ps(_mm_mul_ps(strokeG_sse, effectiveStrokeAlpha), _mm_mul_ps(fillG_sse, effFillMod));
+                                finalB = _mm_add_ps(_mm_mul_ps(strokeB_sse, effectiveStrokeAlpha), _mm_mul_ps(fillB_sse, effFillMod));
+
+                                __m128 invFinalAlpha = _mm_div_ps(ONE_128, finalAlpha);
+                                __m128 zero_mask = _mm_cmpeq_ps(finalAlpha, ZERO_128);
+                                invFinalAlpha = _mm_andnot_ps(zero_mask, invFinalAlpha);
+                                finalR = _mm_mul_ps(finalR, invFinalAlpha);
+                                finalG = _mm_mul_ps(finalG, invFinalAlpha);
+                                finalB = _mm_mul_ps(finalB, invFinalAlpha);
+                            }
+                            else if (mode_only_stroke) {
+                                finalAlpha = effectiveStrokeAlpha;
+                                finalR = strokeR_sse; finalG = strokeG_sse; finalB = strokeB_sse;
+                            }
+                            else {
+                                finalAlpha = effectiveFillAlpha;
+                                finalR = fillR_sse; finalG = fillG_sse; finalB = fillB_sse;
+                            }
+
+                            __m128 mask = _mm_cmpgt_ps(finalAlpha, ZERO_128);
+                            if (_mm_movemask_ps(mask)) {
+                                __m128i dest = _mm_loadu_si128((__m128i*) & row[px]);
+                                __m128i rgba = comp.sse(finalAlpha, dest, finalR, finalG, finalB, unionCoverage_sse(strokeCoverage, fillCoverage));
+                                rgba = _mm_blendv_epi8(dest, rgba, _mm_castps_si128(mask));
+                                _mm_storeu_si128((__m128i*) & row[px], rgba);
+                            }
+                        }
+
+                        // --- Scalar Loop (1-3 pixels) ---
+                        for (; px <= groupEnd; ++px) {
+                            const float fx = static_cast<float>(px) + 0.5f;
+                            while (crossed < crossCount && crossings[crossed] <= fx) ++crossed;
+                            const bool inside = ((crossCount - crossed) & 1) != 0;
+
+                            float min_dist_sq = FLT_MAX;
+                            for (size_t k = first; k < last; ++k) {
+                                const EdgeParams& edge = edges[nearEdges[k].edge];
+                                float dx = edge.dx, dy = edge.dy;
+                                float t = ((fx - edge.ax) * dx + (fy - edge.ay) * dy) * edge.invLenSq;
+                                t = std::max(0.0f, std::min(1.0f, t));
+                                float cx = edge.ax + t * dx;
+                                float cy = edge.ay + t * dy;
+                                float d2 = (fx - cx) * (fx - cx) + (fy - cy) * (fy - cy);
+                                min_dist_sq = std::min(min_dist_sq, d2);
+                            }
+
+                            float dist = std::sqrt(min_dist_sq);
+                            float sdf = inside ? -dist : dist;
+
+                            float effectiveFillAlpha = 0.0f, fillCoverage = 0.0f;
+                            if (drawFill) {
+                                float t_fill = (sdf - 1.0f) / 1.0f;
+                                fillCoverage = std::max(0.0f, std::min(1.0f, 1.0f - t_fill));
+                                effectiveFillAlpha = fillCoverage * finalFillOpacity;
+                            }
+                            float effectiveStrokeAlpha = 0.0f, strokeCoverage = 0.0f;
+                            if (drawStroke) {
+                                float t_stroke = (halfStrokeWidth - dist) / 1.0f;
+                                strokeCoverage = std::max(0.0f, std::min(1.0f, t_stroke));
+                                effectiveStrokeAlpha = strokeCoverage * finalStrokeOpacity;
+                            }
+
+                            float finalAlpha, R, G, B;
+                            if (mode_stroke_over_fill) {
+                                float strk = effectiveStrokeAlpha;
+                                float fill = effectiveFillAlpha * (1.0f - strk);
+                                finalAlpha = strk + fill;
+                                R = strokeColor.r * (strk / 255.0f) + fillColor.r * (fill / 255.0f);
+                                G = strokeColor.g * (strk / 255.0f) + fillColor.g * (fill / 255.0f);
+                                B = strokeColor.b * (strk / 255.0f) + fillColor.b * (fill / 255.0f);
+                            }
+                            else if (mode_only_stroke) {
+                                finalAlpha = effectiveStrokeAlpha;
+                                R = strokeColor.r * (finalAlpha / 255.0f);
+                                G = strokeColor.g * (finalAlpha / 255.0f);
+                                B = strokeColor.b * (finalAlpha / 255.0f);
+                            }
+                            else {
+                                finalAlpha = effectiveFillAlpha;
+                                R = fillColor.r * (finalAlpha / 255.0f);
+                                G = fillColor.g * (finalAlpha / 255.0f);
+                                B = fillColor.b * (finalAlpha / 255.0f);
+                            }
+
+                            if (finalAlpha > 0.0f) {
+                                pa2d::Color src;
+                                if (finalAlpha >= 1.0f) {
+                                    src.r = std::min(255.0f, R * 255.0f); src.g = std::min(255.0f, G * 255.0f); src.b = std::min(255.0f, B * 255.0f); src.a = 255;
+                                }
+                                else {
+                                    float inv = 1.0f / finalAlpha;
+                                    src.r = std::min(255.0f, R * inv * 255.0f); src.g = std::min(255.0f, G * inv * 255.0f); src.b = std::min(255.0f, B * inv * 255.0f); src.a = finalAlpha * 255.0f;
+                                }
+                                row[px] = comp.pixel(src, row[px], unionCoverage(strokeCoverage, fillCoverage));
+                            }
+                        }
+                    }
+                }
+            }
+            });
+    }
+}}}
@@ -0,0 +1,233 @@
+#include"../include/draw.h"
+#include"internal/blend_utils.h"
+#include"internal/thread_pool.h"
+#include"internal/clip.h"
+
+using namespace pa2d::utils;
+using namespace pa2d::utils::simd;
+
+namespace pa2d { namespace utils { namespace PA2D_ISA {
+    void polyline(
+        pa2d::Buffer& buffer,
+        const PolylineSegments& path,
+        const pa2d::Color& color,
+        float strokeWidth)
+    {
+        // 早期退出检查
+        if (!buffer.isValid() || color.a == 0 || strokeWidth <= 0 || path.cellsX == 0) {
+            return;
+        }
+
+        const float colorAlpha_01 = color.a * (1.0f / 255.0f);
+        const float halfWidth = strokeWidth * 0.5f;
+
+        // 使用全局常量
+        const float antialiasRange = 1.0f;  // 对应 ANTIALIAS_RANGE
+        const float outerEdge = halfWidth + antialiasRange;
+
+        // 扩展包围盒考虑线宽和抗锯齿
+        int minX = static_cast<int>(std::floor(path.minPt.x - outerEdge));
+        int maxX = static_cast<int>(std::ceil(path.maxPt.x + outerEdge));
+        int minY = static_cast<int>(std::floor(path.minPt.y - outerEdge));
+        int maxY = static_cast<int>(std::ceil(path.maxPt.y + outerEdge));
+
+        // 裁剪到缓冲区与分桶网格
+        const ClipRect clip = currentClip(buffer);
+        minX = std::max(std::max(clip.minX, path.originX), minX);
+        maxX = std::min(std::min(clip.maxX, path.gridMaxX()), maxX);
+        minY = std::max(std::max(clip.minY, path.originY), minY);
+        maxY = std::min(std::min(clip.maxY, path.gridMaxY()), maxY);
+
+        if (minX > maxX || minY > maxY) return;
+        reportDirty(minX, minY, maxX, maxY);
+
+        const std::vector<SegmentParams>& segments = path.segments;
+        const std::vector<uint32_t>& cellStart = path.cellStart;
+        const std::vector<uint32_t>& cellItems = path.cellItems;
+
+        // 预计算 SIMD 常量 - 只保留需要计算的动态变量
+#ifdef PA2D_AVX2
+        const __m256 v_halfWidth = _mm256_set1_ps(halfWidth);
+        const __m256 srcR_avx = _mm256_set1_ps(color.r * (1.0f / 255.0f));
+        const __m256 srcG_avx = _mm256_set1_ps(color.g * (1.0f / 255.0f));
+        const __m256 srcB_avx = _mm256_set1_ps(color.b * (1.0f / 255.0f));
+        const __m256 srcA_avx = _mm256_set1_ps(colorAlpha_01);
+#endif
+
+        const __m128 v_halfWidth_sse = _mm_set1_ps(halfWidth);
+        const __m128 srcR_sse = _mm_set1_ps(color.r * (1.0f / 255.0f));
+        const __m128 srcG_sse = _mm_set1_ps(color.g * (1.0f / 255.0f));
+        const __m128 srcB_sse = _mm_set1_ps(color.b * (1.0f / 255.0f));
+        const __m128 srcA_sse = _mm_set1_ps(colorAlpha_01);
+
+        compositeRows(buffer, minY, maxY, maxX - minX + 1, [&](const auto& comp, int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y <= rowEnd; ++y) {
+                const float fy = static_cast<float>(y) + 0.5f;  // 使用标量 0.5f
+#ifdef PA2D_AVX2
+                const __m256 v_fy_avx = _mm256_set1_ps(fy);
+#endif
+                const __m128 v_fy_sse = _mm_set1_ps(fy);
+                pa2d::Color* row = &buffer.at(0, y);
+                const size_t cellRow = static_cast<size_t>((y - path.originY) / SEGMENT_CELL_SIZE) * path.cellsX;
+
+                int x = minX;
+
+                while (x <= maxX) {
+#ifdef PA2D_AVX2
+                    // AVX2 处理 (8像素)
+                    for (; (x & 7) == 0 && x <= maxX - 7; x += 8) {
+                        __m256i xBase = _mm256_setr_epi32(x, x + 1, x + 2, x + 3, x + 4, x + 5, x + 6, x + 7);
+                        __m256 v_fx = _mm256_add_ps(_mm256_cvtepi32_ps(xBase), HALF_PIXEL_256);
+
+                        __m256 finalAlpha = _mm256_setzero_ps();
+
+                        // 只对所在单元的线段计算贡献
+                        const size_t cell = cellRow + (x - path.originX) / SEGMENT_CELL_SIZE;
+                        for (uint32_t i = cellStart[cell], end = cellStart[cell + 1]; i < end; ++i) {
+                            const SegmentParams& seg = segments[cellItems[i]];
+
+                            __m256 lineX0 = _mm256_set1_ps(seg.x0);
+                            __m256 lineY0 = _mm256_set1_ps(seg.y0);
+                            __m256 lineDx = _mm256_set1_ps(seg.dx);
+                            __m256 lineDy = _mm256_set1_ps(seg.dy);
+                            __m256 v_inv_length_sq = _mm256_set1_ps(seg.invLengthSq);
+
+                            // 计算到当前线段的最小距离
+                            __m256 px = _mm256_sub_ps(v_fx, lineX0);
+                            __m256 py = _mm256_sub_ps(v_fy_avx, lineY0);
+                            __m256 dot = _mm256_add_ps(_mm256_mul_ps(px, lineDx), _mm256_mul_ps(py, lineDy));
+                            __m256 t = _mm256_mul_ps(dot, v_inv_length_sq);
+                            t = _mm256_max_ps(ZERO_256, _mm256_min_ps(ONE_256, t));
+                            __m256 closestX = _mm256_add_ps(lineX0, _mm256_mul_ps(t, lineDx));
+                            __m256 closestY = _mm256_add_ps(lineY0, _mm256_mul_ps(t, lineDy));
+                            __m256 distX = _mm256_sub_ps(v_fx, closestX);
+                            __m256 distY = _mm256_sub_ps(v_fy_avx, closestY);
+                            __m256 distSq = _mm256_add_ps(_mm256_mul_ps(distX, distX), _mm256_mul_ps(distY, distY));
+
+                            // 修正：使用精确的距离计算
+                            __m256 dist = _mm256_sqrt_ps(distSq);
+
+                            // 修正：正确的抗锯齿计算
+                            // 核心区域：距离 <= halfWidth，alpha = 1.0
+                            // 抗锯齿区域：halfWidth < 距离 <= halfWidth + antialiasRange，alpha 线性衰减
+                            __m256 innerDist = _mm256_sub_ps(dist, v_halfWidth);
+                            __m256 intensity = _mm256_sub_ps(ONE_256, _mm256_mul_ps(innerDist, _mm256_rcp_ps(ANTIALIAS_RANGE_256)));
+                            __m256 segmentAlpha = _mm256_max_ps(ZERO_256, _mm256_min_ps(ONE_256, intensity));
+
+                            // 合并alpha：取最大值（避免重叠区域过度变暗）
+                            finalAlpha = _mm256_max_ps(finalAlpha, segmentAlpha);
+                        }
+
+                        // 应用混合
+                        __m256 mask = _mm256_cmp_ps(finalAlpha, ZERO_256, _CMP_GT_OQ);
+                        if (!_mm256_testz_ps(mask, mask)) {
+                            __m256 combinedAlpha = _mm256_mul_ps(finalAlpha, srcA_avx);
+                            __m256i dest = _mm256_loadu_si256((__m256i*) & row[x]);
+
+                            __m256i rgba = comp.avx(
+                                combinedAlpha, dest,
+                                srcR_avx, srcG_avx, srcB_avx, finalAlpha
+                            );
+
+                            rgba = _mm256_blendv_epi8(dest, rgba, _mm256_castps_si256(mask));
+                            _mm256_storeu_si256((__m256i*) & row[x], rgba);
+                        }
+                    }
+#endif
+
+                    const int groupEnd = alignedGroupEnd(x, maxX);
+                    // SSE 处理 (4像素)
+                    for (; x <= groupEnd - 3; x += 4) {
+                        __m128i xBase = _mm_setr_epi32(x, x + 1, x + 2, x + 3);
+                        __m128 v_fx = _mm_add_ps(_mm_cvtepi32_ps(xBase), HALF_PIXEL_128);
+
+                        __m128 finalAlpha = _mm_setzero_ps();
+
+                        const size_t cell = cellRow + (x - path.originX) / SEGMENT_CELL_SIZE;
+                        for (uint32_t i = cellStart[cell], end = cellStart[cell + 1]; i < end; ++i) {
+                            const SegmentParams& seg = segments[cellItems[i]];
+
+                            __m128 lineX0_sse = _mm_set1_ps(seg.x0);
+                            __m128 lineY0_sse = _mm_set1_ps(seg.y0);
+                            __m128 lineDx_sse = _mm_set1_ps(seg.dx);
+                            __m128 lineDy_sse = _mm_set1_ps(seg.dy);
+                            __m128 v_inv_length_sq_sse = _mm_set1_ps(seg.invLengthSq);
+
+                            __m128 px = _mm_sub_ps(v_fx, lineX0_sse);
+                            __m128 py = _mm_sub_ps(v_fy_sse, lineY0_sse);
+                            __m128 dot = _mm_add_ps(_mm_mul_ps(px, lineDx_sse), _mm_mul_ps(py, lineDy_sse));
+                            __m128 t = _mm_mul_ps(dot, v_inv_length_sq_sse);
+                            t = _mm_max_ps(ZERO_128, _mm_min_ps(ONE_128, t));
+                            __m128 closestX = _mm_add_ps(lineX0_sse, _mm_mul_ps(t, lineDx_sse));
+                            __m128 closestY = _mm_add_ps(lineY0_sse, _mm_mul_ps(t, lineDy_sse));
+                            __m128 distX = _mm_sub_ps(v_fx, closestX);
+                            __m128 distY = _mm_sub_ps(v_fy_sse, closestY);
+                            __m128 distSq = _mm_add_ps(_mm_mul_ps(distX, distX), _mm_mul_ps(distY, distY));
+
+                            // 修正：使用精确的距离计算
+                            __m128 dist = _mm_sqrt_ps(distSq);
+
+                            // 修正：正确的抗锯齿计算
+                            __m128 innerDist = _mm_sub_ps(dist, v_halfWidth_sse);
+                            __m128 intensity = _mm_sub_ps(ONE_128, _mm_mul_ps(innerDist, _mm_rcp_ps(ANTIALIAS_RANGE_128)));
+                            __m128 segmentAlpha = _mm_max_ps(ZERO_128, _mm_min_ps(ONE_128, intensity));
+
+                            finalAlpha = _mm_max_ps(finalAlpha, segmentAlpha);
+                        }
+
+                        __m128 mask = _mm_cmpgt_ps(finalAlpha, ZERO_128);
+                        if (_mm_movemask_ps(mask)) {
+                            __m128 combinedAlpha = _mm_mul_ps(finalAlpha, srcA_sse);
+                            __m128i dest = _mm_loadu_si128((__m128i*) & row[x]);
+
+                            __m128i rgba = comp.sse(
+                                combinedAlpha, dest,
+                                srcR_sse, srcG_sse, srcB_sse, finalAlpha
+                            );
+
+                            rgba = _mm_blendv_epi8(dest, rgba, _mm_castps_si128(mask));
+                            _mm_storeu_si128((__m128i*) & row[x], rgba);
+                        }
+                    }
+
+                    // 标量处理 (剩余像素)
+                    for (; x <= groupEnd; ++x) {
+                        const float fx = static_cast<float>(x) + 0.5f;  // 使用标量 0.5f
+                        float maxAlpha = 0.0f;
+
+                        const size_t cell = cellRow + (x - path.originX) / SEGMENT_CELL_SIZE;
+                        for (uint32_t i = cellStart[cell], end = cellStart[cell + 1]; i < end; ++i) {
+                            const SegmentParams& seg = segments[cellItems[i]];
+                            const float vec_x = seg.dx;
+                            const float vec_y = seg.dy;
+
+                            const Point pt(fx, fy);
+                            const float toPt_x = pt.x - seg.x0;
+                            const float toPt_y = pt.y - seg.y0;
+                            const float t = std::max(0.0f, std::min(1.0f, (toPt_x * vec_x + toPt_y * vec_y) / seg.lengthSq));
+                            const Point closest(seg.x0 + vec_x * t, seg.y0 + vec_y * t);
+                            const float dx = pt.x - closest.x;
+                            const float dy = pt.y - closest.y;
+                            const float dist = std::sqrt(dx * dx + dy * dy);
+
+                            if (dist <= halfWidth) {
+                                maxAlpha = 1.0f;
+                            }
+                            else if (dist <= halfWidth + antialiasRange) {
+                                float intensity = 1.0f - (dist - halfWidth) / antialiasRange;
+                                maxAlpha = std::max(maxAlpha, intensity);
+                            }
+                        }
+
+                        if (maxAlpha > 0.0f) {
+                            pa2d::Color& dest = row[x];
+                            pa2d::Color src = color;
+                            src.a = static_cast<uint8_t>(colorAlpha_01 * maxAlpha * 255.0f);
+                            row[x] = comp.pixel(src, dest, maxAlpha);
+                        }
+                    }
+                }
+            }
+            });
+    }
+}}}
@@ -0,0 +1,623 @@
+#include"../include/draw.h"
+#include"internal/blend_utils.h"
+#include"internal/thread_pool.h"
+#include"internal/clip.h"
+#include"internal/vec_math.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace pa2d::utils;
+using namespace pa2d::utils::simd;
+
+namespace pa2d { namespace utils { namespace PA2D_ISA {
+    void sector(
+        pa2d::Buffer& buffer,
+        float cx, float cy, float radius,
+        float startAngleDeg, float endAngleDeg,
+        const pa2d::Color& fillColor,
+        const pa2d::Color& strokeColor,
+        float strokeWidth,
+        bool drawArc,
+        bool drawRadialEdges
+    ) {
+        // --- 1. 参数校验和预处理 ---
+        if (!buffer.isValid() || radius <= 0) return;
+
+        const float finalFillOpacity = fillColor.a * (1.0f / 255.0f);
+        const float finalStrokeOpacity = strokeColor.a * (1.0f / 255.0f);
+
+        const bool drawFill = (finalFillOpacity > 0.0f);
+        const bool drawStroke = (finalStrokeOpacity > 0.0f) && (strokeWidth > 0.0f);
+
+        if (!drawFill && !drawStroke) return;
+
+        const bool mode_stroke_over_fill = drawStroke && drawFill;
+        const bool mode_only_stroke = drawStroke && !drawFill;
+
+        const float arcStrokeWidth = strokeWidth == 0 ? 0 : strokeWidth;
+        const float edgeStrokeWidth = strokeWidth == 0 ? 0 : strokeWidth;
+
+        const float halfArcStrokeWidth = arcStrokeWidth * 0.5f;
+        const float halfEdgeStrokeWidth = edgeStrokeWidth * 0.5f;
+        const float EPSILON = GEOMETRY_EPSILON;
+
+        // 角度处理：规范化
+        // 张角直接由角度差求得，避免起点规范化到 [0, 2π) 后出现负张角（如 -45°~45°）
+        float startAngle = std::fmod(startAngleDeg, 360.0f) * GEOMETRY_PI / 180.0f;
+        if (startAngle < 0.0f) startAngle += 2.0f * GEOMETRY_PI;
+
+        float sweepDeg = endAngleDeg - startAngleDeg;
+        if (sweepDeg < 0.0f) {
+            // 如果结束角度小于开始角度，加上360度
+            sweepDeg = std::fmod(sweepDeg, 360.0f) + 360.0f;
+        }
+        float angleDiff = std::min(sweepDeg, 360.0f) * GEOMETRY_PI / 180.0f;
+
+        const bool isFullCircle = (angleDiff >= 2.0f * GEOMETRY_PI - EPSILON);
+        if (isFullCircle) {
+            angleDiff = 2.0f * GEOMETRY_PI;
+        }
+
+        // 计算结束角度
+        const float actualEndAngle = startAngle + angleDiff;
+
+        // 起始边方向与张角的正余弦
+        float start_sin, start_cos, angleDiff_sin, angleDiff_cos;
+        vmath::sincos_scalar(startAngle, start_sin, start_cos);
+        vmath::sincos_scalar(angleDiff, angleDiff_sin, angleDiff_cos);
+
+        // --- 2. 边界计算和裁剪 ---
+        // 非完整圆只取圆心、两端点和范围内的坐标轴极值点，细扇形不再遍历整个外接正方形
+        float boxMinX = cx - radius, boxMaxX = cx + radius;
+        float boxMinY = cy - radius, boxMaxY = cy + radius;
+        float pad = halfArcStrokeWidth + 1.0f;
+        if (!isFullCircle) {
+            float end_sin, end_cos;
+            vmath::sincos_scalar(actualEndAngle, end_sin, end_cos);
+            boxMinX = std::min({ cx, cx + radius * start_cos, cx + radius * end_cos });
+            boxMaxX = std::max({ cx, cx + radius * start_cos, cx + radius * end_cos });
+            boxMinY = std::min({ cy, cy + radius * start_sin, cy + radius * end_sin });
+            boxMaxY = std::max({ cy, cy + radius * start_sin, cy + radius * end_sin });
+            for (int k = 0; k < 8; ++k) {
+                float axisAngle = k * (GEOMETRY_PI * 0.5f);
+                if (axisAngle < startAngle || axisAngle > actualEndAngle) continue;
+                switch (k & 3) {
+                case 0: boxMaxX = cx + radius; break;
+                case 1: boxMaxY = cy + radius; break;
+                case 2: boxMinX = cx - radius; break;
+                default: boxMinY = cy - radius; break;
+                }
+            }
+            // 径向边描边在边线两侧各延伸 1.5 倍半线宽
+            pad = halfArcStrokeWidth * 1.5f + 2.0f;
+        }
+
+        int minX = static_cast<int>(std::floor(boxMinX - pad));
+        int maxX = static_cast<int>(std::ceil(boxMaxX + pad));
+        int minY = static_cast<int>(std::floor(boxMinY - pad));
+        int maxY = static_cast<int>(std::ceil(boxMaxY + pad));
+
+        const ClipRect clip = currentClip(buffer);
+        minX = std::max(clip.minX, minX);
+        maxX = std::min(clip.maxX, maxX);
+        minY = std::max(clip.minY, minY);
+        maxY = std::min(clip.maxY, maxY);
+
+        if (minX > maxX || minY > maxY) return;
+        reportDirty(minX, minY, maxX, maxY);
+
+        // --- 3. SIMD 常量准备 ---
+        const float edge_sdf_offset_f = halfArcStrokeWidth * 0.5f;
+#ifdef PA2D_AVX2
+        const __m256 cx_v = _mm256_set1_ps(cx);
+        const __m256 cy_v = _mm256_set1_ps(cy);
+        const __m256 radius_v = _mm256_set1_ps(radius);
+
+        const __m256 halfArcStrokeWidth_v = _mm256_set1_ps(halfArcStrokeWidth);
+
+        const __m256 edge_sdf_offset_v = _mm256_set1_ps(edge_sdf_offset_f);
+
+        // 角度常量
+        const __m256 start_cos_v = _mm256_set1_ps(start_cos);
+        const __m256 start_sin_v = _mm256_set1_ps(start_sin);
+
+        // 颜色常量
+        const __m256 fillA_v = _mm256_set1_ps(finalFillOpacity);
+        const __m256 strokeA_v = _mm256_set1_ps(finalStrokeOpacity);
+        const __m256 fillR_v = _mm256_set1_ps(fillColor.r * (1.0f / 255.0f));
+        const __m256 fillG_v = _mm256_set1_ps(fillColor.g * (1.0f / 255.0f));
+        const __m256 fillB_v = _mm256_set1_ps(fillColor.b * (1.0f / 255.0f));
+        const __m256 strokeR_v = _mm256_set1_ps(strokeColor.r * (1.0f / 255.0f));
+        const __m256 strokeG_v = _mm256_set1_ps(strokeColor.g * (1.0f / 255.0f));
+        const __m256 strokeB_v = _mm256_set1_ps(strokeColor.b * (1.0f / 255.0f));
+
+        // 光线SDF所需的角度差常量
+        const __m256 angleDiff_cos_v = _mm256_set1_ps(angleDiff_cos);
+        const __m256 angleDiff_sin_v = _mm256_set1_ps(angleDiff_sin);
+#endif
+
+        // SSE常量
+        const __m128 cx_sse = _mm_set1_ps(cx);
+        const __m128 cy_sse = _mm_set1_ps(cy);
+        const __m128 radius_sse = _mm_set1_ps(radius);
+        const __m128 halfArcStrokeWidth_sse = _mm_set1_ps(halfArcStrokeWidth);
+        const __m128 edge_sdf_offset_sse = _mm_set1_ps(edge_sdf_offset_f);
+
+        // SSE 角度常量
+        const __m128 start_cos_sse = _mm_set1_ps(start_cos);
+        const __m128 start_sin_sse = _mm_set1_ps(start_sin);
+
+        // SSE 颜色常量
+        const __m128 fillA_sse = _mm_set1_ps(finalFillOpacity);
+        const __m128 strokeA_sse = _mm_set1_ps(finalStrokeOpacity);
+        const __m128 fillR_sse = _mm_set1_ps(fillColor.r * (1.0f / 255.0f));
+        const __m128 fillG_sse = _mm_set1_ps(fillColor.g * (1.0f / 255.0f));
+        const __m128 fillB_sse = _mm_set1_ps(fillColor.b * (1.0f / 255.0f));
+        const __m128 strokeR_sse = _mm_set1_ps(strokeColor.r * (1.0f / 255.0f));
+        const __m128 strokeG_sse = _mm_set1_ps(strokeColor.g * (1.0f / 255.0f));
+        const __m128 strokeB_sse = _mm_set1_ps(strokeColor.b * (1.0f / 255.0f));
+
+        // 光线SDF所需的角度差常量
+        const __m128 angleDiff_cos_sse = _mm_set1_ps(angleDiff_cos);
+        const __m128 angleDiff_sin_sse = _mm_set1_ps(angleDiff_sin);
+
+        // --- 4. 自定义绝对值函数 ---
+#ifdef PA2D_AVX2
+        auto mm256_abs_ps = [](__m256 x) -> __m256 {
+            __m256 sign_mask = _mm256_set1_ps(-0.0f);
+            return _mm256_andnot_ps(sign_mask, x);
+        };
+#endif
+
+        auto mm_abs_ps = [](__m128 x) -> __m128 {
+            __m128 sign_mask = _mm_set1_ps(-0.0f);
+            return _mm_andnot_ps(sign_mask, x);
+        };
+
+        // --- 5. SDF 函数 ---
+        // 角度判定使用叉积半平面测试，不再逐像素计算 atan2：
+        // 坐标旋转到起始边为 +x 轴后，点在起始边逆时针一侧 <=> py_rot >= 0，
+        // 在结束边顺时针一侧 <=> cross(p, e) = px_rot * sin(d) - py_rot * cos(d) >= 0。
+        // 张角不超过 pi 时两侧条件同时成立才在扇形内，超过 pi 时满足其一即可
+        const bool wideAngle = angleDiff > GEOMETRY_PI;
+
+        // 每个像素只计算一次的扇形几何量
+#ifdef PA2D_AVX2
+        struct WedgeAvx {
+            __m256 dist;        // 到圆心距离
+            __m256 inRange;     // 是否在扇形角内
+            __m256 rayDist;     // 到两条径向边射线的最近距离
+        };
+#endif
+        struct WedgeSse { __m128 dist, inRange, rayDist; };
+        struct WedgeScalar { float dist; bool inRange; float rayDist; };
+
+#ifdef PA2D_AVX2
+        auto wedge_avx2 = [&](__m256 dx, __m256 dy) -> WedgeAvx {
+            WedgeAvx w;
+            w.dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+            if (isFullCircle) {
+                w.inRange = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                w.rayDist = _mm256_set1_ps(1000.0f);
+                return w;
+            }
+
+            __m256 px_rot = _mm256_add_ps(_mm256_mul_ps(dx, start_cos_v), _mm256_mul_ps(dy, start_sin_v));
+            __m256 py_rot = _mm256_sub_ps(_mm256_mul_ps(dy, start_cos_v), _mm256_mul_ps(dx, start_sin_v));
+            __m256 cross_end = _mm256_sub_ps(_mm256_mul_ps(px_rot, angleDiff_sin_v), _mm256_mul_ps(py_rot, angleDiff_cos_v));
+
+            __m256 after_start = _mm256_cmp_ps(py_rot, ZERO_256, _CMP_GE_OQ);
+            __m256 before_end = _mm256_cmp_ps(cross_end, ZERO_256, _CMP_GE_OQ);
+            w.inRange = wideAngle ? _mm256_or_ps(after_start, before_end) : _mm256_and_ps(after_start, before_end);
+
+            // 投影落在射线前方取到直线的距离，否则取到圆心的距离
+            __m256 behind_start = _mm256_cmp_ps(px_rot, ZERO_256, _CMP_LT_OQ);
+            __m256 sdf_start_ray = _mm256_blendv_ps(mm256_abs_ps(py_rot), w.dist, behind_start);
+
+            __m256 dot_end = _mm256_add_ps(_mm256_mul_ps(px_rot, angleDiff_cos_v), _mm256_mul_ps(py_rot, angleDiff_sin_v));
+            __m256 behind_end = _mm256_cmp_ps(dot_end, ZERO_256, _CMP_LT_OQ);
+            __m256 sdf_end_ray = _mm256_blendv_ps(mm256_abs_ps(cross_end), w.dist, behind_end);
+
+            w.rayDist = _mm256_min_ps(sdf_start_ray, sdf_end_ray);
+            return w;
+        };
+
+        // ** 填充 SDF (AVX2) **：扇形内为圆的 SDF，扇形外再与径向边距离取大
+        auto sector_sdf_avx2 = [&](const WedgeAvx& w) -> __m256 {
+            __m256 circle_sdf = _mm256_sub_ps(w.dist, radius_v);
+            if (isFullCircle) return circle_sdf;
+            __m256 outside_sdf = _mm256_max_ps(circle_sdf, w.rayDist);
+            return _mm256_blendv_ps(outside_sdf, circle_sdf, w.inRange);
+        };
+
+        // ** 弧线 SDF (AVX2) **
+        auto arc_sdf_avx2 = [&](const WedgeAvx& w) -> __m256 {
+            if (!drawArc) return _mm256_set1_ps(1000.0f);
+            __m256 arc_sdf = mm256_abs_ps(_mm256_sub_ps(w.dist, radius_v));
+            return _mm256_blendv_ps(_mm256_set1_ps(1000.0f), arc_sdf, w.inRange);
+        };
+
+        // ** 径向边 SDF (AVX2) **：只在扇形角与半径范围内有效
+        auto radial_edges_sdf_avx2 = [&](const WedgeAvx& w) -> __m256 {
+            if (!drawRadialEdges || isFullCircle) return _mm256_set1_ps(1000.0f);
+            __m256 valid_edge = _mm256_and_ps(w.inRange, _mm256_cmp_ps(w.dist, radius_v, _CMP_LE_OQ));
+            __m256 modified_dist_to_edges = _mm256_sub_ps(w.rayDist, edge_sdf_offset_v);
+            return _mm256_blendv_ps(_mm256_set1_ps(1000.0f), modified_dist_to_edges, valid_edge);
+        };
+
+        // ** 组合描边 SDF (AVX2) **
+        auto combined_stroke_sdf_avx2 = [&](const WedgeAvx& w) -> __m256 {
+            if (!drawStroke) return _mm256_set1_ps(1000.0f);
+            // 取最小的SDF值（最接近描边的距离）
+            return _mm256_min_ps(arc_sdf_avx2(w), radial_edges_sdf_avx2(w));
+        };
+#endif
+
+        // ** SSE 版本 **
+        auto wedge_sse = [&](__m128 dx, __m128 dy) -> WedgeSse {
+            WedgeSse w;
+            w.dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+            if (isFullCircle) {
+                w.inRange = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                w.rayDist = _mm_set1_ps(1000.0f);
+                return w;
+            }
+
+            __m128 px_rot = _mm_add_ps(_mm_mul_ps(dx, start_cos_sse), _mm_mul_ps(dy, start_sin_sse));
+            __m128 py_rot = _mm_sub_ps(_mm_mul_ps(dy, start_cos_sse), _mm_mul_ps(dx, start_sin_sse));
+            __m128 cross_end = _mm_sub_ps(_mm_mul_ps(px_rot, angleDiff_sin_sse), _mm_mul_ps(py_rot, angleDiff_cos_sse));
+
+            __m128 after_start = _mm_cmpge_ps(py_rot, ZERO_128);
+            __m128 before_end = _mm_cmpge_ps(cross_end, ZERO_128);
+            w.inRange = wideAngle ? _mm_or_ps(after_start, before_end) : _mm_and_ps(after_start, before_end);
+
+            __m128 behind_start = _mm_cmplt_ps(px_rot, ZERO_128);
+            __m128 sdf_start_ray = _mm_blendv_ps(mm_abs_ps(py_rot), w.dist, behind_start);
+
+            __m128 dot_end = _mm_add_ps(_mm_mul_ps(px_rot, angleDiff_cos_sse), _mm_mul_ps(py_rot, angleDiff_sin_sse));
+            __m128 behind_end = _mm_cmplt_ps(dot_end, ZERO_128);
+            __m128 sdf_end_ray = _mm_blendv_ps(mm_abs_ps(cross_end), w.dist, behind_end);
+
+            w.rayDist = _mm_min_ps(sdf_start_ray, sdf_end_ray);
+            return w;
+        };
+
+        auto sector_sdf_sse = [&](const WedgeSse& w) -> __m128 {
+            __m128 circle_sdf = _mm_sub_ps(w.dist, radius_sse);
+            if (isFullCircle) return circle_sdf;
+            __m128 outside_sdf = _mm_max_ps(circle_sdf, w.rayDist);
+            return _mm_blendv_ps(outside_sdf, circle_sdf, w.inRange);
+        };
+
+        auto arc_sdf_sse = [&](const WedgeSse& w) -> __m128 {
+            if (!drawArc) return _mm_set1_ps(1000.0f);
+            __m128 arc_sdf = mm_abs_ps(_mm_sub_ps(w.dist, radius_sse));
+            return _mm_blendv_ps(_mm_set1_ps(1000.0f), arc_sdf, w.inRange);
+        };
+
+        auto radial_edges_sdf_sse = [&](const WedgeSse& w) -> __m128 {
+            if (!drawRadialEdges || isFullCircle) return _mm_set1_ps(1000.0f);
+            __m128 valid_edge = _mm_and_ps(w.inRange, _mm_cmple_ps(w.dist, radius_sse));
+            __m128 modified_dist_to_edges = _mm_sub_ps(w.rayDist, edge_sdf_offset_sse);
+            return _mm_blendv_ps(_mm_set1_ps(1000.0f), modified_dist_to_edges, valid_edge);
+        };
+
+        auto combined_stroke_sdf_sse = [&](const WedgeSse& w) -> __m128 {
+            if (!drawStroke) return _mm_set1_ps(1000.0f);
+            return _mm_min_ps(arc_sdf_sse(w), radial_edges_sdf_sse(w));
+        };
+
+        // ** 标量版本 **
+        auto wedge_scalar = [&](float dx, float dy) -> WedgeScalar {
+            WedgeScalar w;
+            w.dist = std::sqrt(dx * dx + dy * dy);
+            if (isFullCircle) {
+                w.inRange = true;
+                w.rayDist = 1000.0f;
+                return w;
+            }
+
+            float px_rot = dx * start_cos + dy * start_sin;
+            float py_rot = dy * start_cos - dx * start_sin;
+            float cross_end = px_rot * angleDiff_sin - py_rot * angleDiff_cos;
+
+            bool after_start = py_rot >= 0.0f;
+            bool before_end = cross_end >= 0.0f;
+            w.inRange = wideAngle ? (after_start || before_end) : (after_start && before_end);
+
+            float sdf_start_ray = px_rot < 0.0f ? w.dist : std::abs(py_rot);
+            float dot_end = px_rot * angleDiff_cos + py_rot * angleDiff_sin;
+            float sdf_end_ray = dot_end < 0.0f ? w.dist : std::abs(cross_end);
+
+            w.rayDist = std::min(sdf_start_ray, sdf_end_ray);
+            return w;
+        };
+
+        auto sector_sdf_scalar = [&](const WedgeScalar& w) -> float {
+            float circle_sdf = w.dist - radius;
+            if (isFullCircle || w.inRange) return circle_sdf;
+            return std::max(circle_sdf, w.rayDist);
+        };
+
+        auto arc_sdf_scalar = [&](const WedgeScalar& w) -> float {
+            if (!drawArc) return 1000.0f;
+            return w.inRange ? std::abs(w.dist - radius) : 1000.0f;
+        };
+
+        auto radial_edges_sdf_scalar = [&](const WedgeScalar& w) -> float {
+            if (!drawRadialEdges || isFullCircle) return 1000.0f;
+            if (!w.inRange || w.dist > radius) return 1000.0f;
+            return w.rayDist - edge_sdf_offset_f;
+        };
+
+        auto combined_stroke_sdf_scalar = [&](const WedgeScalar& w) -> float {
+            if (!drawStroke) return 1000.0f;
+            return std::min(arc_sdf_scalar(w), radial_edges_sdf_scalar(w));
+        };
+
+        // --- 6. 主绘制循环 ---
+        compositeRows(buffer, minY, maxY, maxX - minX + 1, [&](const auto& comp, int rowBegin, int rowEnd) {
+            for (int py = rowBegin; py <= rowEnd; ++py) {
+                const float fy = static_cast<float>(py) + 0.5f;
+                pa2d::Color* row = &buffer.at(0, py);
+
+#ifdef PA2D_AVX2
+                const __m256 py_v = _mm256_set1_ps(fy);
+#endif
+                const __m128 py_v_sse = _mm_set1_ps(fy);
+
+                int px = minX;
+
+                while (px <= maxX) {
+#ifdef PA2D_AVX2
+                    // AVX2处理 (8像素)
+                    for (; (px & 7) == 0 && px <= maxX - 7; px += 8) {
+                        __m256i xBase = _mm256_setr_epi32(px, px + 1, px + 2, px + 3, px + 4, px + 5, px + 6, px + 7);
+                        __m256 px_v = _mm256_add_ps(_mm256_cvtepi32_ps(xBase), HALF_PIXEL_256);
+
+                        __m256 dx = _mm256_sub_ps(px_v, cx_v);
+                        __m256 dy = _mm256_sub_ps(py_v, cy_v);
+
+                        // 计算SDF
+                        const WedgeAvx wedge = wedge_avx2(dx, dy);
+                        __m256 sdf_fill = sector_sdf_avx2(wedge);
+                        __m256 sdf_stroke = combined_stroke_sdf_avx2(wedge);
+
+                        // 填充计算
+                        __m256 fill_alpha = ZERO_256, fill_coverage = ZERO_256;
+                        if (drawFill) {
+                            __m256 t = _mm256_div_ps(_mm256_sub_ps(ANTIALIAS_RANGE_256, sdf_fill), ANTIALIAS_RANGE_256);
+                            t = _mm256_max_ps(ZERO_256, _mm256_min_ps(ONE_256, t));
+                            fill_coverage = t;
+                            fill_alpha = _mm256_mul_ps(t, fillA_v);
+                        }
+
+                        __m256 stroke_alpha = ZERO_256, stroke_coverage = ZERO_256;
+                        if (drawStroke) {
+                            // 统一的有效半宽度
+                            __m256 effective_half_stroke_width = halfArcStrokeWidth_v;
+
+                            __m256 t_stroke = _mm256_div_ps(_mm256_sub_ps(effective_half_stroke_width, sdf_stroke), ANTIALIAS_RANGE_256);
+                            t_stroke = _mm256_max_ps(ZERO_256, _mm256_min_ps(ONE_256, t_stroke));
+                            stroke_coverage = t_stroke;
+                            stroke_alpha = _mm256_mul_ps(t_stroke, strokeA_v);
+                        }
+
+                        __m256 final_alpha;
+                        __m256 final_r, final_g, final_b;
+
+                        if (mode_stroke_over_fill) {
+                            // 混合逻辑: A_new = A_stroke + A_fill * (1 - A_stroke)
+                            // C_new = (C_stroke * A_stroke + C_fill * A_fill * (1 - A_stroke)) / A_new
+                            __m256 one_minus_stroke = _mm256_sub_ps(ONE_256, stroke_alpha);
+                            __m256 fill_contribution_alpha = _mm256_mul_ps(fill_alpha, one_minus_stroke);
+                            final_alpha = _mm256_add_ps(stroke_alpha, fill_contribution_alpha);
+
+                            // C_stroke * A_stroke: 描边像素对最终颜色的贡献 (已预乘)
+                            __m256 stroke_premult_r = _mm256_mul_ps(strokeR_v, stroke_alpha);
+                            __m256 stroke_premult_g = _mm256_mul_ps(strokeG_v, stroke_alpha);
+                            __m256 stroke_premult_b = _mm256_mul_ps(strokeB_v, stroke_alpha);
+
+                            // C_fill * A_fill * (1 - A_stroke): 填充像素对最终颜色的贡献 (已预乘)
+                            __m256 fill_premult_r = _mm256_mul_ps(fillR_v, fill_contribution_alpha);
+                            __m256 fill_premult_g = _mm256_mul_ps(fillG_v, fill_contribution_alpha);
+                            __m256 fill_premult_b = _mm256_mul_ps(fillB_v, fill_contribution_alpha);
+
+                            // 总颜色贡献 (预乘)
+                            __m256 total_premult_r = _mm256_add_ps(stroke_premult_r, fill_premult_r);
+                            __m256 total_premult_g = _mm256_add_ps(stroke_premult_g, fill_premult_g);
+                            __m256 total_premult_b = _mm256_add_ps(stroke_premult_b, fill_premult_b);
+
+                            // 解除预乘: C_new = C_premult / A_new
+                            __m256 final_alpha_recip = _mm256_div_ps(ONE_256, final_alpha);
+
+                            final_r = _mm256_mul_ps(total_premult_r, final_alpha_recip);
+                            final_g = _mm256_mul_ps(total_premult_g, final_alpha_recip);
+                            final_b = _mm256_mul_ps(total_premult_b, final_alpha_recip);
+                        }
+                        else if (mode_only_stroke) {
+                            final_alpha = stroke_alpha;
+                            final_r = strokeR_v;
+                            final_g = strokeG_v;
+                            final_b = strokeB_v;
+                        }
+                        else {
+                            // 仅填充模式
+                            final_alpha = fill_alpha;
+                            final_r = fillR_v;
+                            final_g = fillG_v;
+                            final_b = fillB_v;
+                        }
+
+                        // 写入像素
+                        __m256 mask = _mm256_cmp_ps(final_alpha, ZERO_256, _CMP_GT_OQ);
+                        if (!_mm256_testz_ps(mask, mask)) {
+                            __m256i dest = _mm256_loadu_si256((__m256i*) & row[px]);
+                            __m256i rgba = comp.avx(final_alpha, dest, final_r, final_g, final_b, unionCoverage_avx(stroke_coverage, fill_coverage));
+                            rgba = _mm256_blendv_epi8(dest, rgba, _mm256_castps_si256(mask));
+                            _mm256_storeu_si256((__m256i*) & row[px], rgba);
+                        }
+                    }
+#endif
+
+                    const int groupEnd = alignedGroupEnd(px, maxX);
+                    // SSE处理 (4像素)
+                    for (; px <= groupEnd - 3; px += 4) {
+                        __m128i xBase = _mm_setr_epi32(px, px + 1, px + 2, px + 3);
+                        __m128 px_v_sse = _mm_add_ps(_mm_cvtepi32_ps(xBase), HALF_PIXEL_128);
+
+                        __m128 dx = _mm_sub_ps(px_v_sse, cx_sse);
+                        __m128 dy = _mm_sub_ps(py_v_sse, cy_sse);
+
+                        // 计算SDF
+                        const WedgeSse wedge = wedge_sse(dx, dy);
+                        __m128 sdf_fill = sector_sdf_sse(wedge);
+                        __m128 sdf_stroke = combined_stroke_sdf_sse(wedge);
+
+                        // 填充计算
+                        __m128 fill_alpha = ZERO_128, fill_coverage = ZERO_128;
+                        if (drawFill) {
+                            __m128 t = _mm_div_ps(_mm_sub_ps(ANTIALIAS_RANGE_128, sdf_fill), ANTIALIAS_RANGE_128);
+                            t = _mm_max_ps(ZERO_128, _mm_min_ps(ONE_128, t));
+                            fill_coverage = t;
+                            fill_alpha = _mm_mul_ps(t, fillA_sse);
+                        }
+
+                        __m128 stroke_alpha = ZERO_128, stroke_coverage = ZERO_128;
+                        if (drawStroke) {
+                            // 统一的有效半宽度
+                            __m128 effective_half_stroke_width = halfArcStrokeWidth_sse;
+
+                            __m128 t_stroke = _mm_div_ps(_mm_sub_ps(effective_half_stroke_width, sdf_stroke), ANTIALIAS_RANGE_128);
+                            t_stroke = _mm_max_ps(ZERO_128, _mm_min_ps(ONE_128, t_stroke));
+                            stroke_coverage = t_stroke;
+                            stroke_alpha = _mm_mul_ps(t_stroke, strokeA_sse);
+                        }
+
+                        __m128 final_alpha;
+                        __m128 final_r, final_g, final_b;
+
+                        if (mode_stroke_over_fill) {
+                            __m128 one_minus_stroke = _mm_sub_ps(ONE_128, stroke_alpha);
+                            __m128 fill_contribution_alpha = _mm_mul_ps(fill_alpha, one_minus_stroke);
+                            final_alpha = _mm_add_ps(stroke_alpha, fill_contribution_alpha);
+
+                            // 颜色预乘
+                            __m128 stroke_premult_r = _mm_mul_ps(strokeR_sse, stroke_alpha);
+                            __m128 stroke_premult_g = _mm_mul_ps(strokeG_sse, stroke_alpha);
+                            __m128 stroke_premult_b = _mm_mul_ps(strokeB_sse, stroke_alpha);
+                            __m128 fill_premult_r = _mm_mul_ps(fillR_sse, fill_contribution_alpha);
+                            __m128 fill_premult_g = _mm_mul_ps(fillG_sse, fill_contribution_alpha);
+                            __m128 fill_premult_b = _mm_mul_ps(fillB_sse, fill_contribution_alpha);
+
+                            __m128 total_premult_r = _mm_add_ps(stroke_premult_r, fill_premult_r);
+                            __m128 total_premult_g = _mm_add_ps(stroke_premult_g, fill_premult_g);
+                            __m128 total_premult_b = _mm_add_ps(stroke_premult_b, fill_premult_b);
+
+                            // 解除预乘
+                            __m128 final_alpha_recip = _mm_div_ps(ONE_128, final_alpha);
+
+                            final_r = _mm_mul_ps(total_premult_r, final_alpha_recip);
+                            final_g = _mm_mul_ps(total_premult_g, final_alpha_recip);
+                            final_b = _mm_mul_ps(total_premult_b, final_alpha_recip);
+                        }
+                        else if (mode_only_stroke) {
+                            final_alpha = stroke_alpha;
+                            final_r = strokeR_sse;
+                            final_g = strokeG_sse;
+                            final_b = strokeB_sse;
+                        }
+                        else {
+                            final_alpha = fill_alpha;
+                            final_r = fillR_sse;
+                            final_g = fillG_sse;
+                            final_b = fillB_sse;
+                        }
+
+                        // 写入像素
+                        __m128 mask = _mm_cmpgt_ps(final_alpha, ZERO_128);
+                        if (_mm_movemask_ps(mask)) {
+                            __m128i dest = _mm_loadu_si128((__m128i*) & row[px]);
+                            __m128i rgba = comp.sse(final_alpha, dest, final_r, final_g, final_b, unionCoverage_sse(stroke_coverage, fill_coverage));
+                            rgba = _mm_blendv_epi8(dest, rgba, _mm_castps_si128(mask));
+                            _mm_storeu_si128((__m128i*) & row[px], rgba);
+                        }
+                    }
+
+                    // 标量收尾处理
+                    for (; px <= groupEnd; ++px) {
+                        const float fx = static_cast<float>(px) + 0.5f;
+                        float dx = fx - cx;
+                        float dy = fy - cy;
+
+                        // 计算SDF
+                        const WedgeScalar wedge = wedge_scalar(dx, dy);
+                        float sdf_fill = sector_sdf_scalar(wedge);
+                        float sdf_stroke = combined_stroke_sdf_scalar(wedge);
+
+                        // 填充alpha
+                        float fill_alpha = 0.0f, fill_coverage = 0.0f;
+                        if (drawFill) {
+                            float t = (1.0f - sdf_fill) / 1.0f;
+                            t = std::max(0.0f, std::min(1.0f, t));
+                            fill_coverage = t;
+                            fill_alpha = t * finalFillOpacity;
+                        }
+
+                        float stroke_alpha = 0.0f, stroke_coverage = 0.0f;
+                        if (drawStroke) {
+                            // 统一的有效半宽度
+                            float effective_half_stroke_width = halfArcStrokeWidth;
+
+                            float t_stroke = (effective_half_stroke_width - sdf_stroke) / 1.0f;
+                            t_stroke = std::max(0.0f, std::min(1.0f, t_stroke));
+                            stroke_coverage = t_stroke;
+                            stroke_alpha = t_stroke * finalStrokeOpacity;
+                        }
+
+                        if (fill_alpha > 0.0f || stroke_alpha > 0.0f) {
+                            pa2d::Color srcColor;
+
+                            if (mode_stroke_over_fill) {
+                                float one_minus_stroke = 1.0f - stroke_alpha;
+                                float fill_contribution_alpha = fill_alpha * one_minus_stroke;
+                                float final_alpha = stroke_alpha + fill_contribution_alpha;
+
+                                if (final_alpha > 0.0f) {
+                                    // 预乘颜色
+                                    float pre_r = strokeColor.r * stroke_alpha + fillColor.r * fill_contribution_alpha;
+                                    float pre_g = strokeColor.g * stroke_alpha + fillColor.g * fill_contribution_alpha;
+                                    float pre_b = strokeColor.b * stroke_alpha + fillColor.b * fill_contribution_alpha;
+
+                                    // 解除预乘
+                                    srcColor.r = static_cast<uint8_t>(std::min(255.0f, pre_r / final_alpha));
+                                    srcColor.g = static_cast<uint8_t>(std::min(255.0f, pre_g / final_alpha));
+                                    srcColor.b = static_cast<uint8_t>(std::min(255.0f, pre_b / final_alpha));
+                                    srcColor.a = static_cast<uint8_t>(std::min(255.0f, final_alpha * 255.0f));
+                                }
+                            }
+                            else if (mode_only_stroke) {
+                                srcColor.r = strokeColor.r;
+                                srcColor.g = strokeColor.g;
+                                srcColor.b = strokeColor.b;
+                                srcColor.a = static_cast<uint8_t>(std::min(255.0f, stroke_alpha * 255.0f));
+                            }
+                            else {
+                                // 仅填充模式
+                                srcColor.r = fillColor.r;
+                                srcColor.g = fillColor.g;
+                                srcColor.b = fillColor.b;
+                                srcColor.a = static_cast<uint8_t>(std::min(255.0f, fill_alpha * 255.0f));
+                            }
+
+                            if (srcColor.a > 0) {
+                                pa2d::Color& dest = row[px];
+                                row[px] = comp.pixel(srcColor, dest, unionCoverage(stroke_coverage, fill_coverage));
+                            }
+                        }
+                    }
+                }
+            }
+            });
+    }
+}}}
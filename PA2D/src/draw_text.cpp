@@ -270,7 +270,7 @@ namespace pa2d {
                 return false;
             }
 
-            int stride = buffer.width * sizeof(Color);
+            int stride = buffer.stride * sizeof(Color);
             Gdiplus::Bitmap bmp(buffer.width, buffer.height, stride,
                 PixelFormat32bppARGB,
                 reinterpret_cast<BYTE*>(buffer.color));
@@ -175,8 +175,8 @@ namespace pa2d {
         return center_;
     }
 
-    // ͷʵ...
-    // ƪƣֻչʾؼ
+    // 迭代器和访问器实现...
+    // 由于篇幅限制，这里只展示关键部分
 
     void Rect::ensureVerticesUpdated() const {
         if (verticesDirty_) {
@@ -226,25 +226,25 @@ namespace pa2d {
     void Rect::calculateParametersFromVertices() {
         if (cachedVertices_.size() != 4) return;
 
-        // ==================== 1. ͹ȷ㰴ʱ˳ ====================
-        // ƶ
+        // ==================== 1. 计算凸包（确保顶点按逆时针顺序） ====================
+        // 复制顶点
         std::array<Point, 4> points = cachedVertices_;
 
-        // ҵ½ǵĵΪ͹
+        // 找到最左下角的点作为凸包起点
         auto startIt = std::min_element(points.begin(), points.end(),
             [](const Point& a, const Point& b) {
                 return (a.y < b.y) || (a.y == b.y && a.x < b.x);
             });
 
-        // ½ǵΪοм
+        // 以最左下角点为参考点进行极角排序
         Point startPoint = *startIt;
         std::sort(points.begin(), points.end(),
             [startPoint](const Point& a, const Point& b) {
-                // 㼫
+                // 计算极角
                 float angleA = std::atan2(a.y - startPoint.y, a.x - startPoint.x);
                 float angleB = std::atan2(b.y - startPoint.y, b.x - startPoint.x);
 
-                // ͬ
+                // 如果极角相同，按距离排序
                 if (std::abs(angleA - angleB) < 1e-6f) {
                     float distA = (a.x - startPoint.x) * (a.x - startPoint.x) +
                         (a.y - startPoint.y) * (a.y - startPoint.y);
@@ -255,7 +255,7 @@ namespace pa2d {
                 return angleA < angleB;
             });
 
-        // Grahamɨ蹹͹
+        // Graham扫描构建凸包
         std::array<Point, 4> hull;
         hull[0] = points[0];
         hull[1] = points[1];
@@ -273,9 +273,9 @@ namespace pa2d {
             hull[hullSize++] = points[i];
         }
 
-        // ˻ߵ㣩ֱӼ
+        // 如果是退化情况（共线点），直接计算
         if (hullSize < 3) {
-            // ˻Ϊ߶
+            // 退化为线段
             float minX = points[0].x, maxX = points[0].x;
             float minY = points[0].y, maxY = points[0].y;
             for (const auto& p : points) {
@@ -293,30 +293,30 @@ namespace pa2d {
             return;
         }
 
-        // ==================== 2. ת㷨С ====================
-        // ʼ
+        // ==================== 2. 旋转卡壳算法求最小面积矩形 ====================
+        // 初始化变量
         float minArea = std::numeric_limits<float>::max();
         float bestWidth = 0, bestHeight = 0;
         float bestAngle = 0;
         Point bestCenter;
 
-        // ͹ÿΪεһ
+        // 对于凸包的每条边作为矩形的一边
         for (int i = 0; i < hullSize; ++i) {
             int j = (i + 1) % hullSize;
 
-            // ǰߵ
+            // 当前边的向量
             Point edge = hull[j] - hull[i];
             float edgeLength = std::hypot(edge.x, edge.y);
             if (edgeLength < 1e-6f) continue;
 
-            // 㵱ǰߵĽǶ
+            // 计算当前边的角度
             float angle = std::atan2(edge.y, edge.x);
 
-            // תϵʹǰˮƽ
+            // 旋转坐标系，使当前边水平
             float cosA = std::cos(-angle);
             float sinA = std::sin(-angle);
 
-            // еתϵе
+            // 计算所有点在旋转后的坐标系中的坐标
             std::array<float, 4> rotatedX, rotatedY;
             float minX = std::numeric_limits<float>::max();
             float maxX = -std::numeric_limits<float>::max();
@@ -324,38 +324,38 @@ namespace pa2d {
             float maxY = -std::numeric_limits<float>::max();
 
             for (int k = 0; k < hullSize; ++k) {
-                // ƽƣʹhull[i]Ϊԭ
+                // 平移，使hull[i]为原点
                 float dx = hull[k].x - hull[i].x;
                 float dy = hull[k].y - hull[i].y;
 
-                // ת
+                // 旋转
                 rotatedX[k] = dx * cosA - dy * sinA;
                 rotatedY[k] = dx * sinA + dy * cosA;
 
-                // ±߽
+                // 更新边界
                 minX = std::min(minX, rotatedX[k]);
                 maxX = std::max(maxX, rotatedX[k]);
                 minY = std::min(minY, rotatedY[k]);
                 maxY = std::max(maxY, rotatedY[k]);
             }
 
-            // ǰתµľβ
+            // 当前旋转下的矩形参数
             float width = maxX - minX;
             float height = maxY - minY;
             float area = width * height;
 
-            // ĵתϵ
+            // 计算中心点在旋转后的坐标系中
             float centerX = (minX + maxX) * 0.5f;
             float centerY = (minY + maxY) * 0.5f;
 
-            // תԭϵ
+            // 旋转回原坐标系
             float cosA_inv = std::cos(angle);
             float sinA_inv = std::sin(angle);
             Point center;
             center.x = centerX * cosA_inv - centerY * sinA_inv + hull[i].x;
             center.y = centerX * sinA_inv + centerY * cosA_inv + hull[i].y;
 
-            // ҵС½
+            // 如果找到更小的面积，更新结果
             if (area < minArea) {
                 minArea = area;
                 bestWidth = width;
@@ -365,9 +365,9 @@ namespace pa2d {
             }
         }
 
-        // ==================== 3. ǷΪЧ ====================
+        // ==================== 3. 检查是否为有效矩形 ====================
         if (minArea < 1e-6f || bestWidth < 1e-6f || bestHeight < 1e-6f) {
-            // ˻㹲߻غ
+            // 退化情况：点共线或重合
             float minX = points[0].x, maxX = points[0].x;
             float minY = points[0].y, maxY = points[0].y;
             for (const auto& p : points) {
@@ -383,17 +383,17 @@ namespace pa2d {
             rotation_ = 0.0f;
         }
         else {
-            // 
+            // 正常情况
             center_ = bestCenter;
             width_ = bestWidth;
             height_ = bestHeight;
             rotation_ = bestAngle;
 
-            // ȷǶ[0, 180)Χ
+            // 确保角度在[0, 180)范围内
             while (rotation_ < 0) rotation_ += 180.0f;
             while (rotation_ >= 180.0f) rotation_ -= 180.0f;
 
-            // ȷ >= ߶ȣǶȶӦȷ
+            // 确保宽度 >= 高度，角度对应宽度方向
             if (width_ < height_) {
                 std::swap(width_, height_);
                 rotation_ += 90.0f;
@@ -11,7 +11,7 @@
 
 namespace pa2d {
 
-    // ڲʵϸ - ¶û
+    // 内部实现细节 - 不暴露给用户
     namespace internal {
         bool EnsureCOMInitialized();
         void ConvertRGBAtoBGRA(Color* dest, const uint32_t* src, int pixelCount);
@@ -32,7 +32,7 @@ namespace pa2d {
         };
     }
 
-    // COMʼ
+    // COM初始化
     bool internal::EnsureCOMInitialized() {
         static std::atomic<bool> com_initialized(false);
         if (!com_initialized.load(std::memory_order_acquire)) {
@@ -45,7 +45,7 @@ namespace pa2d {
         return true;
     }
 
-    // ɫת
+    // 颜色转换
     void internal::ConvertRGBAtoBGRA(Color* dest, const uint32_t* src, int pixelCount) {
         const int avxCount = pixelCount / 8;
         for (int i = 0; i < avxCount; ++i) {
@@ -56,14 +56,14 @@ namespace pa2d {
             _mm256_storeu_si256((__m256i*) & dest[i * 8], shuffled);
         }
 
-        // ʣ
+        // 处理剩余像素
         for (int i = avxCount * 8; i < pixelCount; ++i) {
             uint32_t rgba = src[i];
             dest[i].data = (rgba & 0xFF00FF00) | ((rgba & 0x00FF0000) >> 16) | ((rgba & 0x000000FF) << 16);
         }
     }
 
-    // WICResource
+    // WICResource析构函数
     internal::WICResource::~WICResource() {
         if (converter) converter->Release();
         if (frame) frame->Release();
@@ -72,13 +72,13 @@ namespace pa2d {
         if (factory) factory->Release();
     }
 
-    // WICResourceʼ
+    // WICResource工厂初始化
     bool internal::WICResource::InitializeFactory() {
         return SUCCEEDED(CoCreateInstance(CLSID_WICImagingFactory, nullptr,
             CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory)));
     }
 
-    // Ҫ߼
+    // 主要加载逻辑
     bool internal::LoadImageCommon(Buffer& buffer, std::function<bool(WICResource&)> loader) {
         if (!EnsureCOMInitialized()) return false;
 
@@ -95,11 +95,9 @@ namespace pa2d {
             SUCCEEDED(wic.converter->Initialize(wic.frame, GUID_WICPixelFormat32bppRGBA,
                 WICBitmapDitherTypeNone, nullptr, 0.0f, WICBitmapPaletteTypeCustom))) {
 
-            if (buffer.width != width || buffer.height != height) {
-                if (buffer.color) free(buffer.color);
-                buffer.width = width;
-                buffer.height = height;
-                buffer.color = static_cast<Color*>(malloc(width * height * sizeof(Color)));
+            // 像素存储经 Buffer 的分配器管理，尺寸不同时整体替换
+            if (buffer.width != static_cast<int>(width) || buffer.height != static_cast<int>(height)) {
+                buffer = Buffer(static_cast<int>(width), static_cast<int>(height));
             }
 
             if (buffer.color) {
@@ -109,7 +107,9 @@ namespace pa2d {
                     static_cast<UINT>(tempBuffer.size() * sizeof(uint32_t)),
                     reinterpret_cast<BYTE*>(tempBuffer.data())))) {
 
-                    ConvertRGBAtoBGRA(buffer.color, tempBuffer.data(), width * height);
+                    for (UINT y = 0; y < height; ++y) {
+                        ConvertRGBAtoBGRA(buffer.getRow(static_cast<int>(y)), tempBuffer.data() + static_cast<size_t>(y) * width, static_cast<int>(width));
+                    }
                     return true;
                 }
             }
@@ -117,7 +117,7 @@ namespace pa2d {
         return false;
     }
 
-    // Դļ
+    // 资源文件加载
     bool internal::LoadImageFromResourceInternal(Buffer& buffer, void* hInstancePtr, unsigned int resourceID) {
         return LoadImageCommon(buffer, [&](WICResource& wic) {
             HINSTANCE hInstance = static_cast<HINSTANCE>(hInstancePtr);
@@ -139,7 +139,7 @@ namespace pa2d {
             });
     }
 
-    // ļ
+    // 文件加载
     bool internal::LoadImageFromFileInternal(Buffer& buffer, const char* filePath) {
         if (GetFileAttributesA(filePath) == INVALID_FILE_ATTRIBUTES) return false;
 
@@ -156,7 +156,7 @@ namespace pa2d {
             });
     }
 
-    // ӿʵ
+    // 公共接口实现
     bool loadImage(Buffer& buffer, const char* filePath) {
         if (!internal::EnsureCOMInitialized()) return false;
 
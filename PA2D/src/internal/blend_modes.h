@@ -0,0 +1,385 @@
+// blend_modes.h
+// 通用混合引擎：混合模式只描述 Porter-Duff 因子与逐通道混合函数，解包、合成、打包与行遍历只写一次，按向量宽度实例化
+// 合成公式（W3C Compositing and Blending Level 1，颜色为直通 0-1）：
+//   Cs' = (1 - Ad) * Cs + Ad * B(Cs, Cd)          可分离模式；Porter-Duff 模式 B(Cs, Cd) = Cs，即 Cs' = Cs
+//   Co  = As * Fa * Cs' + Ad * Fb * Cd            预乘结果
+//   Ao  = As * Fa + Ad * Fb
+// 可分离模式统一以源覆盖（Fa = 1，Fb = 1 - As）合成；直通目标再除以 Ao，预乘目标直接写回
+// 向量类型与模板按指令集分别实例化，位于 PA2D_ISA 命名空间（见 isa.h）
+#pragma once
+#include "../include/blend_mode.h"
+#include "../include/color.h"
+#include "isa.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace pa2d {
+    namespace utils {
+        const int BLEND_MODE_COUNT = static_cast<int>(BlendMode::DestAlpha) + 1;
+
+        // 源完全透明时目标是否保持不变；否则（Clear、Src、SrcIn、DstIn、SrcOut、DstAtop）透明源也会改写目标
+        inline bool blendModeNoopOnTransparent(BlendMode mode) {
+            switch (mode) {
+            case BlendMode::Clear: case BlendMode::Src: case BlendMode::SrcIn:
+            case BlendMode::DstIn: case BlendMode::SrcOut: case BlendMode::DstAtop:
+                return false;
+            default:
+                return true;
+            }
+        }
+
+        namespace PA2D_ISA {
+        // ============================================================================
+        // 向量类型：F 为浮点通道，M 为比较结果，I 为打包像素
+        // ============================================================================
+
+        // 标量：逐像素尾部与光栅化的单像素路径
+        struct BlendLanes1 {
+            typedef float F;
+            typedef bool M;
+            typedef Color I;
+            static const int width = 1;
+
+            static F set1(float v) { return v; }
+            static F add(F a, F b) { return a + b; }
+            static F sub(F a, F b) { return a - b; }
+            static F mul(F a, F b) { return a * b; }
+            static F div(F a, F b) { return a / b; }
+            static F rcp(F a) { return 1.0f / a; }
+            static F min(F a, F b) { return b < a ? b : a; }
+            static F max(F a, F b) { return a < b ? b : a; }
+            static F sqrt(F a) { return std::sqrt(a); }
+            static M lt(F a, F b) { return a < b; }
+            static M le(F a, F b) { return a <= b; }
+            static M gt(F a, F b) { return a > b; }
+            static F select(M m, F a, F b) { return m ? a : b; }
+
+            static I load(const Color* p) { return *p; }
+            static void store(Color* p, I v) { *p = v; }
+            static bool transparent(I v) { return v.a == 0; }
+            static bool opaque(I v) { return v.a == 255; }
+            static void unpack(I v, F& r, F& g, F& b, F& a) {
+                const float k = 1.0f / 255.0f;
+                r = v.r * k; g = v.g * k; b = v.b * k; a = v.a * k;
+            }
+            // 与 SIMD 版本的 cvtps 一致：截断到 0-1 后按最近偶数舍入
+            static uint8_t quantize(F v) {
+                return static_cast<uint8_t>(std::nearbyint(min(max(v, 0.0f), 1.0f) * 255.0f));
+            }
+            static I pack(F r, F g, F b, F a) {
+                return Color(quantize(a), quantize(r), quantize(g), quantize(b));
+            }
+        };
+
+        // SSE4.1：4 像素
+        struct BlendLanes4 {
+            typedef __m128 F;
+            typedef __m128 M;
+            typedef __m128i I;
+            static const int width = 4;
+
+            static F set1(float v) { return _mm_set1_ps(v); }
+            static F add(F a, F b) { return _mm_add_ps(a, b); }
+            static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+            static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+            static F div(F a, F b) { return _mm_div_ps(a, b); }
+            // 近似倒数加一次牛顿迭代，相对误差约 1e-7
+            static F rcp(F a) {
+                const __m128 r = _mm_rcp_ps(a);
+                return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(a, r)));
+            }
+            static F min(F a, F b) { return _mm_min_ps(a, b); }
+            static F max(F a, F b) { return _mm_max_ps(a, b); }
+            static F sqrt(F a) { return _mm_sqrt_ps(a); }
+            static M lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+            static M le(F a, F b) { return _mm_cmple_ps(a, b); }
+            static M gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+            static F select(M m, F a, F b) { return _mm_blendv_ps(b, a, m); }
+
+            static I load(const Color* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void store(Color* p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static bool transparent(I v) { return _mm_testz_si128(v, _mm_set1_epi32(static_cast<int>(0xFF000000))) != 0; }
+            static bool opaque(I v) { return _mm_testc_si128(v, _mm_set1_epi32(static_cast<int>(0xFF000000))) != 0; }
+            static void unpack(I v, F& r, F& g, F& b, F& a) {
+                const __m128i mask = _mm_set1_epi32(0xFF);
+                const __m128 k = _mm_set1_ps(1.0f / 255.0f);
+                b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(v, mask)), k);
+                g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), mask)), k);
+                r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), mask)), k);
+                a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(v, 24)), k);
+            }
+            // 饱和打包：cvtps 后 packus 截断到 0-255，再把 BBBB GGGG RRRR AAAA 重排为逐像素 BGRA
+            static I pack(F r, F g, F b, F a) {
+                const __m128 k = _mm_set1_ps(255.0f);
+                const __m128i bg = _mm_packus_epi32(_mm_cvtps_epi32(_mm_mul_ps(b, k)), _mm_cvtps_epi32(_mm_mul_ps(g, k)));
+                const __m128i ra = _mm_packus_epi32(_mm_cvtps_epi32(_mm_mul_ps(r, k)), _mm_cvtps_epi32(_mm_mul_ps(a, k)));
+                const __m128i order = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+                return _mm_shuffle_epi8(_mm_packus_epi16(bg, ra), order);
+            }
+        };
+
+        // AVX2：8 像素；只在 256 位版本（PA2D_AVX2）中可见
+#ifdef PA2D_AVX2
+        struct BlendLanes8 {
+            typedef __m256 F;
+            typedef __m256 M;
+            typedef __m256i I;
+            static const int width = 8;
+
+            static F set1(float v) { return _mm256_set1_ps(v); }
+            static F add(F a, F b) { return _mm256_add_ps(a, b); }
+            static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+            static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+            static F div(F a, F b) { return _mm256_div_ps(a, b); }
+            static F rcp(F a) {
+                const __m256 r = _mm256_rcp_ps(a);
+                return _mm256_mul_ps(r, _mm256_fnmadd_ps(a, r, _mm256_set1_ps(2.0f)));
+            }
+            static F min(F a, F b) { return _mm256_min_ps(a, b); }
+            static F max(F a, F b) { return _mm256_max_ps(a, b); }
+            static F sqrt(F a) { return _mm256_sqrt_ps(a); }
+            static M lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static M le(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+            static M gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+            static F select(M m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+
+            static I load(const Color* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(Color* p, I v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static bool transparent(I v) { return _mm256_testz_si256(v, _mm256_set1_epi32(static_cast<int>(0xFF000000))) != 0; }
+            static bool opaque(I v) { return _mm256_testc_si256(v, _mm256_set1_epi32(static_cast<int>(0xFF000000))) != 0; }
+            static void unpack(I v, F& r, F& g, F& b, F& a) {
+                const __m256i mask = _mm256_set1_epi32(0xFF);
+                const __m256 k = _mm256_set1_ps(1.0f / 255.0f);
+                b = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(v, mask)), k);
+                g = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 8), mask)), k);
+                r = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 16), mask)), k);
+                a = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(v, 24)), k);
+            }
+            static I pack(F r, F g, F b, F a) {
+                const __m256 k = _mm256_set1_ps(255.0f);
+                const __m256i bg = _mm256_packus_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(b, k)), _mm256_cvtps_epi32(_mm256_mul_ps(g, k)));
+                const __m256i ra = _mm256_packus_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(r, k)), _mm256_cvtps_epi32(_mm256_mul_ps(a, k)));
+                const __m256i order = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                                                       0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+                return _mm256_shuffle_epi8(_mm256_packus_epi16(bg, ra), order);
+            }
+        };
+#endif
+
+        // ============================================================================
+        // 混合模式：factors 给出 Fa / Fb，channel 给出 B(Cs, Cd)（Porter-Duff 模式恒为 Cs，合成时不参与计算）
+        // noopOnTransparent：源完全透明时目标不变（Fb(As = 0) = 1），行遍历据此跳过整组像素
+        // keepsOpaque：不透明目标合成后仍不透明（As * Fa + Fb = 1），走省去除法的快速路径
+        // ============================================================================
+        namespace blendops {
+#define PA2D_PORTER_DUFF(Name, FA, FB, NOOP, OPAQUE)                                        \
+            struct Name {                                                                   \
+                static const bool separable = false;                                        \
+                static const bool noopOnTransparent = NOOP;                                 \
+                static const bool keepsOpaque = OPAQUE;                                     \
+                template<class V>                                                           \
+                static void factors(typename V::F as, typename V::F ad,                     \
+                                    typename V::F& fa, typename V::F& fb) {                 \
+                    const typename V::F one = V::set1(1.0f), zero = V::set1(0.0f);          \
+                    (void)as; (void)ad; (void)one; (void)zero;                              \
+                    fa = FA; fb = FB;                                                       \
+                }                                                                           \
+                template<class V>                                                           \
+                static typename V::F channel(typename V::F s, typename V::F) { return s; }  \
+            };
+
+            PA2D_PORTER_DUFF(Clear, zero, zero, false, false)
+            PA2D_PORTER_DUFF(Src, one, zero, false, false)
+            PA2D_PORTER_DUFF(Dst, zero, one, true, true)
+            PA2D_PORTER_DUFF(SrcOver, one, V::sub(one, as), true, true)
+            PA2D_PORTER_DUFF(DstOver, V::sub(one, ad), one, true, true)
+            PA2D_PORTER_DUFF(SrcIn, ad, zero, false, false)
+            PA2D_PORTER_DUFF(DstIn, zero, as, false, false)
+            PA2D_PORTER_DUFF(SrcOut, V::sub(one, ad), zero, false, false)
+            PA2D_PORTER_DUFF(DstOut, zero, V::sub(one, as), true, false)
+            PA2D_PORTER_DUFF(SrcAtop, ad, V::sub(one, as), true, true)
+            PA2D_PORTER_DUFF(DstAtop, V::sub(one, ad), as, false, false)
+            PA2D_PORTER_DUFF(Xor, V::sub(one, ad), V::sub(one, as), true, false)
+            // destAlphaBlend：源 alpha 先乘以目标 alpha，只画在目标已有内容上
+            PA2D_PORTER_DUFF(DestAlpha, ad, V::sub(one, V::mul(as, ad)), true, true)
+#undef PA2D_PORTER_DUFF
+
+#define PA2D_SEPARABLE(Name, EXPR)                                                          \
+            struct Name {                                                                   \
+                static const bool separable = true;                                         \
+                static const bool noopOnTransparent = true;                                 \
+                static const bool keepsOpaque = true;                                       \
+                template<class V>                                                           \
+                static void factors(typename V::F as, typename V::F ad,                     \
+                                    typename V::F& fa, typename V::F& fb) {                 \
+                    (void)ad;                                                               \
+                    fa = V::set1(1.0f); fb = V::sub(V::set1(1.0f), as);                     \
+                }                                                                           \
+                template<class V>                                                           \
+                static typename V::F channel(typename V::F s, typename V::F d) {            \
+                    typedef typename V::F F;                                                \
+                    const F one = V::set1(1.0f), zero = V::set1(0.0f), half = V::set1(0.5f); \
+                    (void)one; (void)zero; (void)half;                                      \
+                    EXPR                                                                    \
+                }                                                                           \
+            };
+
+            PA2D_SEPARABLE(Add, return V::min(one, V::add(s, d));)
+            PA2D_SEPARABLE(Subtract, return V::max(zero, V::sub(d, s));)
+            PA2D_SEPARABLE(Multiply, return V::mul(s, d);)
+            PA2D_SEPARABLE(Screen, return V::sub(V::add(s, d), V::mul(s, d));)
+            PA2D_SEPARABLE(Darken, return V::min(s, d);)
+            PA2D_SEPARABLE(Lighten, return V::max(s, d);)
+            PA2D_SEPARABLE(Difference, return V::max(V::sub(s, d), V::sub(d, s));)
+            PA2D_SEPARABLE(Exclusion, return V::sub(V::add(s, d), V::mul(V::add(s, s), d));)
+            // HardLight(s, d)：s <= 0.5 时 2sd，否则 Screen(2s - 1, d)
+            PA2D_SEPARABLE(HardLight,
+                const F s2 = V::add(s, s);
+                const F screen = V::sub(one, V::mul(V::sub(one, d), V::sub(V::set1(2.0f), s2)));
+                return V::select(V::le(s, half), V::mul(s2, d), screen);)
+            // Overlay(s, d) = HardLight(d, s)
+            PA2D_SEPARABLE(Overlay,
+                const F d2 = V::add(d, d);
+                const F screen = V::sub(one, V::mul(V::sub(one, s), V::sub(V::set1(2.0f), d2)));
+                return V::select(V::le(d, half), V::mul(d2, s), screen);)
+            // ColorDodge：d = 0 时 0，s = 1 时 1，否则 min(1, d / (1 - s))
+            PA2D_SEPARABLE(ColorDodge,
+                F r = V::min(one, V::div(d, V::max(V::sub(one, s), V::set1(1e-6f))));
+                r = V::select(V::lt(s, one), r, one);
+                return V::select(V::gt(d, zero), r, zero);)
+            // ColorBurn：d = 1 时 1，s = 0 时 0，否则 1 - min(1, (1 - d) / s)
+            PA2D_SEPARABLE(ColorBurn,
+                F r = V::sub(one, V::min(one, V::div(V::sub(one, d), V::max(s, V::set1(1e-6f)))));
+                r = V::select(V::gt(s, zero), r, zero);
+                return V::select(V::lt(d, one), r, one);)
+            // SoftLight：W3C 公式，d <= 0.25 时用三次多项式代替 sqrt(d)
+            PA2D_SEPARABLE(SoftLight,
+                const F s2m1 = V::sub(V::add(s, s), one);
+                const F poly = V::mul(V::add(V::mul(V::sub(V::mul(V::set1(16.0f), d), V::set1(12.0f)), d), V::set1(4.0f)), d);
+                const F dd = V::select(V::le(d, V::set1(0.25f)), poly, V::sqrt(d));
+                const F darker = V::sub(d, V::mul(V::mul(V::sub(one, V::add(s, s)), d), V::sub(one, d)));
+                const F lighter = V::add(d, V::mul(s2m1, V::sub(dd, d)));
+                return V::select(V::le(s, half), darker, lighter);)
+#undef PA2D_SEPARABLE
+        }
+
+        // ============================================================================
+        // 合成与行遍历
+        // ============================================================================
+
+        // 目标整组不透明：Ad = 1，直通与预乘格式相同，Cs' = B(Cs, Cd)，Ao = 1
+        template<class V, class Mode>
+        inline typename V::I blendModePixelsOpaque(typename V::F sr, typename V::F sg, typename V::F sb, typename V::F sa,
+                                                   typename V::I dest) {
+            typedef typename V::F F;
+            const F one = V::set1(1.0f);
+
+            F dr, dg, db, da;
+            V::unpack(dest, dr, dg, db, da);
+            F fa, fb;
+            Mode::template factors<V>(sa, one, fa, fb);
+            const F wa = V::mul(sa, fa);
+            if (Mode::separable) {
+                sr = Mode::template channel<V>(sr, dr);
+                sg = Mode::template channel<V>(sg, dg);
+                sb = Mode::template channel<V>(sb, db);
+            }
+            return V::pack(V::add(V::mul(wa, sr), V::mul(fb, dr)),
+                           V::add(V::mul(wa, sg), V::mul(fb, dg)),
+                           V::add(V::mul(wa, sb), V::mul(fb, db)), one);
+        }
+
+        // 一组像素的合成：源为直通颜色，sa 已乘上不透明度 / 覆盖率；dstPremultiplied 决定目标像素的解释与写回格式
+        template<class V, class Mode>
+        inline typename V::I blendModePixels(typename V::F sr, typename V::F sg, typename V::F sb, typename V::F sa,
+                                             typename V::I dest, bool dstPremultiplied) {
+            typedef typename V::F F;
+            const F one = V::set1(1.0f), zero = V::set1(0.0f);
+            if (Mode::keepsOpaque && V::opaque(dest)) return blendModePixelsOpaque<V, Mode>(sr, sg, sb, sa, dest);
+
+            F dr, dg, db, da;
+            V::unpack(dest, dr, dg, db, da);
+            // 统一到预乘的目标颜色 Dp = Ad * Cd
+            F pr = dr, pg = dg, pb = db;
+            if (!dstPremultiplied) {
+                pr = V::mul(dr, da); pg = V::mul(dg, da); pb = V::mul(db, da);
+            }
+
+            F fa, fb;
+            Mode::template factors<V>(sa, da, fa, fb);
+            const F wa = V::mul(sa, fa);
+
+            if (Mode::separable) {
+                // B 需要直通的目标颜色
+                if (dstPremultiplied) {
+                    const F inv = V::select(V::gt(da, zero), V::rcp(da), zero);
+                    dr = V::mul(dr, inv); dg = V::mul(dg, inv); db = V::mul(db, inv);
+                }
+                const F ka = V::sub(one, da);
+                sr = V::add(V::mul(ka, sr), V::mul(da, Mode::template channel<V>(sr, dr)));
+                sg = V::add(V::mul(ka, sg), V::mul(da, Mode::template channel<V>(sg, dg)));
+                sb = V::add(V::mul(ka, sb), V::mul(da, Mode::template channel<V>(sb, db)));
+            }
+
+            F outR = V::add(V::mul(wa, sr), V::mul(fb, pr));
+            F outG = V::add(V::mul(wa, sg), V::mul(fb, pg));
+            F outB = V::add(V::mul(wa, sb), V::mul(fb, pb));
+            const F outA = V::add(wa, V::mul(fb, da));
+
+            if (!dstPremultiplied) {
+                const F inv = V::select(V::gt(outA, zero), V::rcp(outA), zero);
+                outR = V::mul(outR, inv); outG = V::mul(outG, inv); outB = V::mul(outB, inv);
+            }
+            return V::pack(outR, outG, outB, outA);
+        }
+
+        // 按 V::width 遍历一行，返回已处理的像素数，剩余部分由调用方交给更窄的版本
+        template<class V, class Mode>
+        size_t blendModeRowT(Color* destRow, const Color* srcRow, size_t count, float opacity,
+                             bool srcPremultiplied, bool dstPremultiplied) {
+            typedef typename V::F F;
+            const F zero = V::set1(0.0f);
+            const F op = V::set1(opacity);
+
+            size_t x = 0;
+            for (; x + V::width <= count; x += V::width) {
+                const typename V::I src = V::load(srcRow + x);
+                if (Mode::noopOnTransparent && V::transparent(src)) continue;
+
+                F sr, sg, sb, sa;
+                V::unpack(src, sr, sg, sb, sa);
+                if (srcPremultiplied) {
+                    const F inv = V::select(V::gt(sa, zero), V::rcp(sa), zero);
+                    sr = V::mul(sr, inv); sg = V::mul(sg, inv); sb = V::mul(sb, inv);
+                }
+                sa = V::mul(sa, op);
+
+                V::store(destRow + x, blendModePixels<V, Mode>(sr, sg, sb, sa, V::load(destRow + x), dstPremultiplied));
+            }
+            return x;
+        }
+
+        // 按运行时模式选择实例，每个模式、每种宽度只生成一份行遍历
+        template<class V>
+        size_t blendModeRows(BlendMode mode, Color* destRow, const Color* srcRow, size_t count, float opacity,
+                             bool srcPremultiplied, bool dstPremultiplied) {
+            switch (mode) {
+#define PA2D_BLEND_CASE(Name) \
+            case BlendMode::Name: return blendModeRowT<V, blendops::Name>(destRow, srcRow, count, opacity, srcPremultiplied, dstPremultiplied);
+            PA2D_BLEND_CASE(SrcOver) PA2D_BLEND_CASE(Clear) PA2D_BLEND_CASE(Src) PA2D_BLEND_CASE(Dst)
+            PA2D_BLEND_CASE(DstOver) PA2D_BLEND_CASE(SrcIn) PA2D_BLEND_CASE(DstIn) PA2D_BLEND_CASE(SrcOut)
+            PA2D_BLEND_CASE(DstOut) PA2D_BLEND_CASE(SrcAtop) PA2D_BLEND_CASE(DstAtop) PA2D_BLEND_CASE(Xor)
+            PA2D_BLEND_CASE(Add) PA2D_BLEND_CASE(Subtract) PA2D_BLEND_CASE(Multiply) PA2D_BLEND_CASE(Screen)
+            PA2D_BLEND_CASE(Overlay) PA2D_BLEND_CASE(Darken) PA2D_BLEND_CASE(Lighten) PA2D_BLEND_CASE(ColorDodge)
+            PA2D_BLEND_CASE(ColorBurn) PA2D_BLEND_CASE(HardLight) PA2D_BLEND_CASE(SoftLight) PA2D_BLEND_CASE(Difference)
+            PA2D_BLEND_CASE(Exclusion) PA2D_BLEND_CASE(DestAlpha)
+#undef PA2D_BLEND_CASE
+            }
+            return 0;
+        }
+        }
+    }
+}
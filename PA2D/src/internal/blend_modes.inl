@@ -0,0 +1,89 @@
+// blend_modes.inl
+// 光栅化合成步骤使用的混合引擎入口（ModeComposite）：源颜色为直通 0-1，combinedAlpha 为源 alpha 与覆盖率之积，coverage 为覆盖率
+// 由 kernels_draw_*.cpp 按各自指令集编译
+#include "blend_utils.h"
+#include "blend_modes.h"
+
+namespace pa2d {
+    namespace utils {
+        namespace PA2D_ISA {
+        namespace {
+            // 在预乘空间按覆盖率从目标插值到混合结果：Out = Dst + (Blended - Dst) * coverage
+            template<class V>
+            typename V::I lerpPixels(typename V::I dest, typename V::I blended, typename V::F coverage, bool premultiplied) {
+                typedef typename V::F F;
+                F dr, dg, db, da, br, bg, bb, ba;
+                V::unpack(dest, dr, dg, db, da);
+                V::unpack(blended, br, bg, bb, ba);
+                if (!premultiplied) {
+                    dr = V::mul(dr, da); dg = V::mul(dg, da); db = V::mul(db, da);
+                    br = V::mul(br, ba); bg = V::mul(bg, ba); bb = V::mul(bb, ba);
+                }
+                F r = V::add(dr, V::mul(V::sub(br, dr), coverage));
+                F g = V::add(dg, V::mul(V::sub(bg, dg), coverage));
+                F b = V::add(db, V::mul(V::sub(bb, db), coverage));
+                const F a = V::add(da, V::mul(V::sub(ba, da), coverage));
+                if (!premultiplied) {
+                    const F zero = V::set1(0.0f);
+                    const F inv = V::select(V::gt(a, zero), V::div(V::set1(1.0f), a), zero);
+                    r = V::mul(r, inv); g = V::mul(g, inv); b = V::mul(b, inv);
+                }
+                return V::pack(r, g, b, a);
+            }
+
+            // alpha 为源 alpha、覆盖率与不透明度之积
+            // 透明源保持目标不变的模式对 alpha 是线性的，覆盖率并入 alpha 与插值等价；其余模式先去掉覆盖率再插值
+            template<class V, class Mode>
+            typename V::I blendCovered(typename V::F alpha, typename V::F coverage, typename V::I dest,
+                                       typename V::F r, typename V::F g, typename V::F b, bool premultiplied) {
+                typedef typename V::F F;
+                const F zero = V::set1(0.0f), one = V::set1(1.0f);
+                alpha = V::min(V::max(alpha, zero), one);
+                if (Mode::noopOnTransparent) return blendModePixels<V, Mode>(r, g, b, alpha, dest, premultiplied);
+                coverage = V::min(V::max(coverage, zero), one);
+                const F full = V::min(V::select(V::gt(coverage, zero), V::div(alpha, coverage), zero), one);
+                return lerpPixels<V>(dest, blendModePixels<V, Mode>(r, g, b, full, dest, premultiplied), coverage, premultiplied);
+            }
+
+            template<class V>
+            typename V::I blendModeDispatch(const ModeComposite& comp, typename V::F alpha, typename V::F coverage, typename V::I dest,
+                                            typename V::F r, typename V::F g, typename V::F b) {
+                alpha = V::mul(alpha, V::set1(comp.opacity));
+                switch (comp.mode) {
+#define PA2D_BLEND_CASE(Name) \
+                case BlendMode::Name: return blendCovered<V, blendops::Name>(alpha, coverage, dest, r, g, b, comp.premultiplied);
+                PA2D_BLEND_CASE(SrcOver) PA2D_BLEND_CASE(Clear) PA2D_BLEND_CASE(Src) PA2D_BLEND_CASE(Dst)
+                PA2D_BLEND_CASE(DstOver) PA2D_BLEND_CASE(SrcIn) PA2D_BLEND_CASE(DstIn) PA2D_BLEND_CASE(SrcOut)
+                PA2D_BLEND_CASE(DstOut) PA2D_BLEND_CASE(SrcAtop) PA2D_BLEND_CASE(DstAtop) PA2D_BLEND_CASE(Xor)
+                PA2D_BLEND_CASE(Add) PA2D_BLEND_CASE(Subtract) PA2D_BLEND_CASE(Multiply) PA2D_BLEND_CASE(Screen)
+                PA2D_BLEND_CASE(Overlay) PA2D_BLEND_CASE(Darken) PA2D_BLEND_CASE(Lighten) PA2D_BLEND_CASE(ColorDodge)
+                PA2D_BLEND_CASE(ColorBurn) PA2D_BLEND_CASE(HardLight) PA2D_BLEND_CASE(SoftLight) PA2D_BLEND_CASE(Difference)
+                PA2D_BLEND_CASE(Exclusion) PA2D_BLEND_CASE(DestAlpha)
+#undef PA2D_BLEND_CASE
+                }
+                return dest;
+            }
+        }
+
+#ifdef PA2D_AVX2
+        __m256i ModeComposite::avx(const __m256& combinedAlpha, const __m256i& dest, const __m256& r, const __m256& g, const __m256& b,
+                                   const __m256& coverage) const {
+            return blendModeDispatch<BlendLanes8>(*this, combinedAlpha, coverage, dest, r, g, b);
+        }
+#endif
+
+        __m128i ModeComposite::sse(const __m128& combinedAlpha, const __m128i& dest, const __m128& r, const __m128& g, const __m128& b,
+                                   const __m128& coverage) const {
+            return blendModeDispatch<BlendLanes4>(*this, combinedAlpha, coverage, dest, r, g, b);
+        }
+
+        Color ModeComposite::pixel(const Color& src, const Color& dst, float coverage) const {
+            const float k = 1.0f / 255.0f;
+            float alpha = src.a * k;
+            // src.a 已截断为 8 位：去掉覆盖率前取截断区间的上界，完全不透明的源在抗锯齿边缘仍还原为 1
+            if (!blendModeNoopOnTransparent(mode) && coverage < 1.0f) alpha = std::min((src.a + 1) * k, coverage);
+            return blendModeDispatch<BlendLanes1>(*this, alpha, coverage, dst, src.r * k, src.g * k, src.b * k);
+        }
+        }
+    }
+}
@@ -1,46 +1,87 @@
+// blend_utils.cpp
 #include "blend_utils.h"
+#include <cstdint>
 
 namespace pa2d {
     namespace utils {
+        namespace {
+            // 向量常量经标量数组逐通道写入再整体复制：静态初始化不执行 AVX 指令，本文件按基线指令集编译
+            union Lanes256 {
+                float f[8];
+                uint32_t u[8];
+                __m256 ps;
+                __m256i si;
+                explicit Lanes256(float v) { for (float& x : f) x = v; }
+                explicit Lanes256(uint32_t v) { for (uint32_t& x : u) x = v; }
+            };
+
+            union Lanes128 {
+                float f[4];
+                uint32_t u[4];
+                __m128 ps;
+                __m128i si;
+                explicit Lanes128(float v) { for (float& x : f) x = v; }
+                explicit Lanes128(uint32_t v) { for (uint32_t& x : u) x = v; }
+            };
+        }
+
         namespace simd {
-            // AVX 
-            alignas(32) const __m256 ZERO_256 = _mm256_setzero_ps();
-            alignas(32) const __m256 ONE_256 = _mm256_set1_ps(1.0f);
-            alignas(32) const __m256 _255_256 = _mm256_set1_ps(255.0f);
-            alignas(32) const __m256 _255_RECIP_256 = _mm256_set1_ps(1.0f / 255.0f);
-
-            // س
-            alignas(32) const __m256 HALF_PIXEL_256 = _mm256_set1_ps(0.5f);
-            alignas(32) const __m256 ANTIALIAS_RANGE_256 = _mm256_set1_ps(1.0f);
-            alignas(32) const __m256 ANTIALIAS_RANGE_INV_256 = _mm256_set1_ps(1.0f / 1.0f);
-
-            // ͳ
-            alignas(32) const __m256i MASK_RED = _mm256_set1_epi32(0x00FF0000);
-            alignas(32) const __m256i MASK_GREEN = _mm256_set1_epi32(0x0000FF00);
-            alignas(32) const __m256i MASK_BLUE = _mm256_set1_epi32(0x000000FF);
-            alignas(32) const __m256i MASK_ALPHA = _mm256_set1_epi32(0xFF000000);
-            alignas(32) const __m256i SHIFT_8 = _mm256_set1_epi32(8);
-            alignas(32) const __m256i SHIFT_16 = _mm256_set1_epi32(16);
-            alignas(32) const __m256i SHIFT_24 = _mm256_set1_epi32(24);
-
-            // SSE 
-            alignas(16) const __m128 ZERO_128 = _mm_setzero_ps();
-            alignas(16) const __m128 ONE_128 = _mm_set1_ps(1.0f);
-            alignas(16) const __m128 _255_128 = _mm_set1_ps(255.0f);
-            alignas(16) const __m128 _255_RECIP_128 = _mm_set1_ps(1.0f / 255.0f);
-
-            // س
-            alignas(16) const __m128 HALF_PIXEL_128 = _mm_set1_ps(0.5f);
-            alignas(16) const __m128 ANTIALIAS_RANGE_128 = _mm_set1_ps(1.0f);
-            alignas(16) const __m128 ANTIALIAS_RANGE_INV_128 = _mm_set1_ps(1.0f / 1.0f);
-
-            // ͳ
-            alignas(16) const __m128i MASK_RED_128 = _mm_set1_epi32(0x00FF0000);
-            alignas(16) const __m128i MASK_GREEN_128 = _mm_set1_epi32(0x0000FF00);
-            alignas(16) const __m128i MASK_BLUE_128 = _mm_set1_epi32(0x000000FF);
-            alignas(16) const __m128i SHIFT_8_128 = _mm_set1_epi32(8);
-            alignas(16) const __m128i SHIFT_16_128 = _mm_set1_epi32(16);
-            alignas(16) const __m128i SHIFT_24_128 = _mm_set1_epi32(24);
+            // AVX 常量
+            alignas(32) const __m256 ZERO_256 = Lanes256(0.0f).ps;
+            alignas(32) const __m256 ONE_256 = Lanes256(1.0f).ps;
+            alignas(32) const __m256 _255_256 = Lanes256(255.0f).ps;
+            alignas(32) const __m256 _255_RECIP_256 = Lanes256(1.0f / 255.0f).ps;
+
+            // 几何相关常量
+            alignas(32) const __m256 HALF_PIXEL_256 = Lanes256(0.5f).ps;
+            alignas(32) const __m256 ANTIALIAS_RANGE_256 = Lanes256(1.0f).ps;
+            alignas(32) const __m256 ANTIALIAS_RANGE_INV_256 = Lanes256(1.0f / 1.0f).ps;
+
+            // 整型常量
+            alignas(32) const __m256i MASK_RED = Lanes256(0x00FF0000u).si;
+            alignas(32) const __m256i MASK_GREEN = Lanes256(0x0000FF00u).si;
+            alignas(32) const __m256i MASK_BLUE = Lanes256(0x000000FFu).si;
+            alignas(32) const __m256i MASK_ALPHA = Lanes256(0xFF000000u).si;
+            alignas(32) const __m256i SHIFT_8 = Lanes256(8u).si;
+            alignas(32) const __m256i SHIFT_16 = Lanes256(16u).si;
+            alignas(32) const __m256i SHIFT_24 = Lanes256(24u).si;
+
+            // SSE 常量
+            alignas(16) const __m128 ZERO_128 = Lanes128(0.0f).ps;
+            alignas(16) const __m128 ONE_128 = Lanes128(1.0f).ps;
+            alignas(16) const __m128 _255_128 = Lanes128(255.0f).ps;
+            alignas(16) const __m128 _255_RECIP_128 = Lanes128(1.0f / 255.0f).ps;
+
+            // 几何相关常量
+            alignas(16) const __m128 HALF_PIXEL_128 = Lanes128(0.5f).ps;
+            alignas(16) const __m128 ANTIALIAS_RANGE_128 = Lanes128(1.0f).ps;
+            alignas(16) const __m128 ANTIALIAS_RANGE_INV_128 = Lanes128(1.0f / 1.0f).ps;
+
+            // 整型常量
+            alignas(16) const __m128i MASK_RED_128 = Lanes128(0x00FF0000u).si;
+            alignas(16) const __m128i MASK_GREEN_128 = Lanes128(0x0000FF00u).si;
+            alignas(16) const __m128i MASK_BLUE_128 = Lanes128(0x000000FFu).si;
+            alignas(16) const __m128i SHIFT_8_128 = Lanes128(8u).si;
+            alignas(16) const __m128i SHIFT_16_128 = Lanes128(16u).si;
+            alignas(16) const __m128i SHIFT_24_128 = Lanes128(24u).si;
         }
+
+        std::atomic<bool> fixedPointComposite{ false };
+        thread_local CompositeOp compositeOp;
+
+        ScopedCompositeOp::ScopedCompositeOp(BlendMode mode, float opacity) : saved_(compositeOp) {
+            compositeOp.mode = mode;
+            compositeOp.opacity = std::min(std::max(opacity, 0.0f), 1.0f);
+        }
+
+        ScopedCompositeOp::~ScopedCompositeOp() { compositeOp = saved_; }
+    }
+
+    void setCompositeMode(CompositeMode mode) {
+        utils::fixedPointComposite.store(mode == CompositeMode::Fast, std::memory_order_relaxed);
+    }
+
+    CompositeMode getCompositeMode() {
+        return utils::fixedPointComposite.load(std::memory_order_relaxed) ? CompositeMode::Fast : CompositeMode::Precise;
     }
 }
@@ -1,7 +1,20 @@
 // blend_utils.h
+// 前半部分（合成状态、向量常量的声明）与指令集无关；合成函数、合成器与 SolidSpan 随指令集变化，位于 PA2D_ISA 命名空间（见 isa.h）
+#pragma once
+#include"../include/blend_mode.h"
 #include"../include/color.h"
+#include"../include/buffer.h"
+#include"../include/composite.h"
+#include"isa.h"
+#include"kernels.h"
+#include"thread_pool.h"
 #include <immintrin.h>
 #include <emmintrin.h>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
 
 
 namespace pa2d {
@@ -9,14 +22,15 @@ namespace pa2d {
         const float GEOMETRY_PI = 3.14159265358979323846f;
         const float GEOMETRY_EPSILON = 1e-6f;
 
+        // 常量在 blend_utils.cpp 中按字节初始化，静态初始化阶段不执行 AVX 指令
         namespace simd {
-            // AVX 
+            // AVX 常量
             extern const __m256 ZERO_256;
             extern const __m256 ONE_256;
             extern const __m256 _255_256;
             extern const __m256 _255_RECIP_256;
 
-            // س
+            // 几何相关常量
             extern const __m256 HALF_PIXEL_256;  // 0.5f
             extern const __m256 ANTIALIAS_RANGE_256;  // 1.0f
             extern const __m256 ANTIALIAS_RANGE_INV_256;  // 1.0f / 1.0f = 1.0f
@@ -29,13 +43,13 @@ namespace pa2d {
             extern const __m256i SHIFT_16;
             extern const __m256i SHIFT_24;
 
-            // SSE 
+            // SSE 常量
             extern const __m128 ZERO_128;
             extern const __m128 ONE_128;
             extern const __m128 _255_128;
             extern const __m128 _255_RECIP_128;
 
-            // س
+            // 几何相关常量
             extern const __m128 HALF_PIXEL_128;  // 0.5f
             extern const __m128 ANTIALIAS_RANGE_128;  // 1.0f
             extern const __m128 ANTIALIAS_RANGE_INV_128;  // 1.0f / 1.0f = 1.0f
@@ -48,7 +62,219 @@ namespace pa2d {
             extern const __m128i SHIFT_24_128;
         }
 
+        // 定点合成开关（CompositeMode::Fast），由 setCompositeMode 设置
+        extern std::atomic<bool> fixedPointComposite;
+
+        // 当前线程形状合成步骤的混合模式与图层不透明度（Style::blend / Style::opacity）
+        // 只在光栅化入口读取一次（见 withComposite），行循环与工作线程不再访问
+        struct CompositeOp {
+            BlendMode mode = BlendMode::SrcOver;
+            float opacity = 1.0f;
+        };
+        extern thread_local CompositeOp compositeOp;
+
+        // Canvas 形状绘制与 CommandList 回放按 Style 设置 compositeOp，析构时恢复
+        class ScopedCompositeOp {
+        private:
+            CompositeOp saved_;
+        public:
+            ScopedCompositeOp(BlendMode mode, float opacity);
+            ~ScopedCompositeOp();
+            ScopedCompositeOp(const ScopedCompositeOp&) = delete;
+            ScopedCompositeOp& operator=(const ScopedCompositeOp&) = delete;
+        };
+
+        namespace PA2D_ISA {
+        // 16 位定点合成：目标完全不透明时 OutA = 255，OutRGB = (Src * SrcA + Dst * (255 - SrcA)) / 255
+        // 通道解包为 16 位后用 x / 255 = ((x + 128) * 257) >> 16 完成除法，结果与浮点路径相差不超过 1
+        // premultiplied 为 true 时目标为预乘格式，同一公式对任意目标 alpha 成立：源 alpha 通道按 255 参与，OutA = SrcA + DstA * (255 - SrcA) / 255
+#ifdef PA2D_AVX2
+        inline __m256i blend_pixels_fixed_avx(
+            const __m256& combinedAlpha,
+            const __m256i& dest,
+            const __m256& srcR_01,
+            const __m256& srcG_01,
+            const __m256& srcB_01,
+            bool premultiplied = false
+        ) {
+            using namespace simd;
+
+            // 1. 源颜色与覆盖率量化为 8 位并打包
+            __m256i ai = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(combinedAlpha, ZERO_256), ONE_256), _255_256));
+            __m256i ri = _mm256_cvtps_epi32(_mm256_mul_ps(srcR_01, _255_256));
+            __m256i gi = _mm256_cvtps_epi32(_mm256_mul_ps(srcG_01, _255_256));
+            __m256i bi = _mm256_cvtps_epi32(_mm256_mul_ps(srcB_01, _255_256));
+            __m256i src = _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi32(ai, 24), _mm256_slli_epi32(ri, 16)),
+                _mm256_or_si256(_mm256_slli_epi32(gi, 8), bi)
+            );
+
+            // 2. 解包为 16 位通道，alpha 广播到同一像素的 4 个通道
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i c255 = _mm256_set1_epi16(255);
+            const __m256i c128 = _mm256_set1_epi16(128);
+            const __m256i c257 = _mm256_set1_epi16(257);
+
+            __m256i srcLo = _mm256_unpacklo_epi8(src, zero);
+            __m256i srcHi = _mm256_unpackhi_epi8(src, zero);
+            __m256i dstLo = _mm256_unpacklo_epi8(dest, zero);
+            __m256i dstHi = _mm256_unpackhi_epi8(dest, zero);
+            __m256i alphaLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(srcLo, 0xFF), 0xFF);
+            __m256i alphaHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(srcHi, 0xFF), 0xFF);
+            if (premultiplied) {
+                const __m256i alphaLane = _mm256_set1_epi64x(0x00FF000000000000LL);
+                srcLo = _mm256_or_si256(srcLo, alphaLane);
+                srcHi = _mm256_or_si256(srcHi, alphaLane);
+            }
+
+            // 3. 混合：最大 255 * 255 + 128，不会溢出 16 位无符号
+            __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(srcLo, alphaLo), _mm256_mullo_epi16(dstLo, _mm256_sub_epi16(c255, alphaLo)));
+            __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(srcHi, alphaHi), _mm256_mullo_epi16(dstHi, _mm256_sub_epi16(c255, alphaHi)));
+            lo = _mm256_mulhi_epu16(_mm256_add_epi16(lo, c128), c257);
+            hi = _mm256_mulhi_epu16(_mm256_add_epi16(hi, c128), c257);
+
+            // 4. 打包，不透明目标的输出 alpha 恒为 255
+            if (premultiplied) return _mm256_packus_epi16(lo, hi);
+            return _mm256_or_si256(_mm256_packus_epi16(lo, hi), MASK_ALPHA);
+        }
+
+#endif
+
+        inline __m128i blend_pixels_fixed_sse(
+            const __m128& combinedAlpha,
+            const __m128i& dest,
+            const __m128& srcR_01,
+            const __m128& srcG_01,
+            const __m128& srcB_01,
+            bool premultiplied = false
+        ) {
+            using namespace simd;
+
+            __m128i ai = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(combinedAlpha, ZERO_128), ONE_128), _255_128));
+            __m128i ri = _mm_cvtps_epi32(_mm_mul_ps(srcR_01, _255_128));
+            __m128i gi = _mm_cvtps_epi32(_mm_mul_ps(srcG_01, _255_128));
+            __m128i bi = _mm_cvtps_epi32(_mm_mul_ps(srcB_01, _255_128));
+            __m128i src = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(ai, 24), _mm_slli_epi32(ri, 16)),
+                _mm_or_si128(_mm_slli_epi32(gi, 8), bi)
+            );
+
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i c255 = _mm_set1_epi16(255);
+            const __m128i c128 = _mm_set1_epi16(128);
+            const __m128i c257 = _mm_set1_epi16(257);
+
+            __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+            __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+            __m128i dstLo = _mm_unpacklo_epi8(dest, zero);
+            __m128i dstHi = _mm_unpackhi_epi8(dest, zero);
+            __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcLo, 0xFF), 0xFF);
+            __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcHi, 0xFF), 0xFF);
+            if (premultiplied) {
+                const __m128i alphaLane = _mm_set1_epi64x(0x00FF000000000000LL);
+                srcLo = _mm_or_si128(srcLo, alphaLane);
+                srcHi = _mm_or_si128(srcHi, alphaLane);
+            }
 
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(srcLo, alphaLo), _mm_mullo_epi16(dstLo, _mm_sub_epi16(c255, alphaLo)));
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(srcHi, alphaHi), _mm_mullo_epi16(dstHi, _mm_sub_epi16(c255, alphaHi)));
+            lo = _mm_mulhi_epu16(_mm_add_epi16(lo, c128), c257);
+            hi = _mm_mulhi_epu16(_mm_add_epi16(hi, c128), c257);
+
+            if (premultiplied) return _mm_packus_epi16(lo, hi);
+            return _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32(static_cast<int>(0xFF000000)));
+        }
+
+        // 常量源的定点合成（SolidSpan）：term = Src * SrcA + 128、inv = 255 - SrcA 已按 16 位通道打包，
+        // 只剩目标的解包、乘加与 mulhi；与覆盖率为 1 时的 blend_pixels_fixed_avx / _sse 逐位相同
+#ifdef PA2D_AVX2
+        inline __m256i blend_span_fixed_avx(const __m256i& dest, const __m256i& term, const __m256i& inv, bool premultiplied) {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i c257 = _mm256_set1_epi16(257);
+            __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(dest, zero), inv), term);
+            __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(dest, zero), inv), term);
+            lo = _mm256_mulhi_epu16(lo, c257);
+            hi = _mm256_mulhi_epu16(hi, c257);
+            if (premultiplied) return _mm256_packus_epi16(lo, hi);
+            return _mm256_or_si256(_mm256_packus_epi16(lo, hi), simd::MASK_ALPHA);
+        }
+#endif
+
+        inline __m128i blend_span_fixed_sse(const __m128i& dest, const __m128i& term, const __m128i& inv, bool premultiplied) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i c257 = _mm_set1_epi16(257);
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dest, zero), inv), term);
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dest, zero), inv), term);
+            lo = _mm_mulhi_epu16(lo, c257);
+            hi = _mm_mulhi_epu16(hi, c257);
+            if (premultiplied) return _mm_packus_epi16(lo, hi);
+            return _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32(static_cast<int>(0xFF000000)));
+        }
+
+        // 预乘目标的浮点合成：OutRGB = SrcRGB * SrcA + DstRGB * (1 - SrcA)，OutA = SrcA + DstA * (1 - SrcA)，没有除法
+#ifdef PA2D_AVX2
+        inline __m256i blend_pixels_premultiplied_avx(
+            const __m256& combinedAlpha,
+            const __m256i& dest,
+            const __m256& srcR_01,
+            const __m256& srcG_01,
+            const __m256& srcB_01
+        ) {
+            using namespace simd;
+
+            // 目标按 0-255 参与，省去归一化；源颜色预先乘以 255
+            __m256 fb = _mm256_cvtepi32_ps(_mm256_and_si256(dest, MASK_BLUE));
+            __m256 fg = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(dest, 8), MASK_BLUE));
+            __m256 fr = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(dest, 16), MASK_BLUE));
+            __m256 fa = _mm256_cvtepi32_ps(_mm256_srli_epi32(dest, 24));
+
+            __m256 srcA = _mm256_min_ps(_mm256_max_ps(combinedAlpha, ZERO_256), ONE_256);
+            __m256 srcA255 = _mm256_mul_ps(srcA, _255_256);
+            __m256 inv = _mm256_sub_ps(ONE_256, srcA);
+
+            __m256i ri = _mm256_cvtps_epi32(_mm256_fmadd_ps(srcR_01, srcA255, _mm256_mul_ps(fr, inv)));
+            __m256i gi = _mm256_cvtps_epi32(_mm256_fmadd_ps(srcG_01, srcA255, _mm256_mul_ps(fg, inv)));
+            __m256i bi = _mm256_cvtps_epi32(_mm256_fmadd_ps(srcB_01, srcA255, _mm256_mul_ps(fb, inv)));
+            __m256i ai = _mm256_cvtps_epi32(_mm256_fmadd_ps(fa, inv, srcA255));
+
+            return _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi32(ai, 24), _mm256_slli_epi32(ri, 16)),
+                _mm256_or_si256(_mm256_slli_epi32(gi, 8), bi)
+            );
+        }
+
+#endif
+
+        inline __m128i blend_pixels_premultiplied_sse(
+            const __m128& combinedAlpha,
+            const __m128i& dest,
+            const __m128& srcR_01,
+            const __m128& srcG_01,
+            const __m128& srcB_01
+        ) {
+            using namespace simd;
+
+            __m128 fb = _mm_cvtepi32_ps(_mm_and_si128(dest, MASK_BLUE_128));
+            __m128 fg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dest, 8), MASK_BLUE_128));
+            __m128 fr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dest, 16), MASK_BLUE_128));
+            __m128 fa = _mm_cvtepi32_ps(_mm_srli_epi32(dest, 24));
+
+            __m128 srcA = _mm_min_ps(_mm_max_ps(combinedAlpha, ZERO_128), ONE_128);
+            __m128 srcA255 = _mm_mul_ps(srcA, _255_128);
+            __m128 inv = _mm_sub_ps(ONE_128, srcA);
+
+            __m128i ri = _mm_cvtps_epi32(fmadd_sse(srcR_01, srcA255, _mm_mul_ps(fr, inv)));
+            __m128i gi = _mm_cvtps_epi32(fmadd_sse(srcG_01, srcA255, _mm_mul_ps(fg, inv)));
+            __m128i bi = _mm_cvtps_epi32(fmadd_sse(srcB_01, srcA255, _mm_mul_ps(fb, inv)));
+            __m128i ai = _mm_cvtps_epi32(fmadd_sse(fa, inv, srcA255));
+
+            return _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(ai, 24), _mm_slli_epi32(ri, 16)),
+                _mm_or_si128(_mm_slli_epi32(gi, 8), bi)
+            );
+        }
+
+#ifdef PA2D_AVX2
         inline __m256i blend_pixels_avx(
             const __m256& combinedAlpha,
             const __m256i& dest,
@@ -56,9 +282,9 @@ namespace pa2d {
             const __m256& srcG_01,
             const __m256& srcB_01
         ) {
-            using namespace simd; // ʹռеĳ
+            using namespace simd; // 使用命名空间中的常量
 
-            // 1. Ŀ
+            // 1. 解包目标
             __m256i b_i = _mm256_and_si256(dest, MASK_BLUE);
             __m256i g_i = _mm256_and_si256(_mm256_srli_epi32(dest, 8), MASK_BLUE);
             __m256i r_i = _mm256_and_si256(_mm256_srli_epi32(dest, 16), MASK_BLUE);
@@ -69,7 +295,7 @@ namespace pa2d {
             __m256 fr = _mm256_mul_ps(_mm256_cvtepi32_ps(r_i), _255_RECIP_256);
             __m256 fa = _mm256_mul_ps(_mm256_cvtepi32_ps(a_i), _255_RECIP_256); // DstA
 
-            // 2. 
+            // 2. 混合
             __m256 invCombinedAlpha = _mm256_sub_ps(ONE_256, combinedAlpha); // 1 - SrcA
 
             // OutA = SrcA + DstA * (1 - SrcA)
@@ -77,7 +303,7 @@ namespace pa2d {
 
             __m256 invOutAlpha = _mm256_div_ps(ONE_256, blendedA);
             __m256 zero_mask = _mm256_cmp_ps(blendedA, ZERO_256, _CMP_EQ_OQ);
-            invOutAlpha = _mm256_andnot_ps(zero_mask, invOutAlpha); //  0
+            invOutAlpha = _mm256_andnot_ps(zero_mask, invOutAlpha); // 避免除以 0
 
             // OutRGB = (SrcRGB * SrcA + DstRGB * DstA * (1 - SrcA)) / OutA
             __m256 numR = _mm256_add_ps(_mm256_mul_ps(srcR_01, combinedAlpha), _mm256_mul_ps(fr, _mm256_mul_ps(fa, invCombinedAlpha)));
@@ -88,19 +314,21 @@ namespace pa2d {
             __m256 blendedG = _mm256_mul_ps(numG, invOutAlpha);
             __m256 blendedB = _mm256_mul_ps(numB, invOutAlpha);
 
-            // 3. ת 0-255
+            // 3. 转换回 0-255
             __m256i ri = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(blendedR, ZERO_256), ONE_256), _255_256));
             __m256i gi = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(blendedG, ZERO_256), ONE_256), _255_256));
             __m256i bi = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(blendedB, ZERO_256), ONE_256), _255_256));
             __m256i ai = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(blendedA, ZERO_256), ONE_256), _255_256));
 
-            // 4. 
+            // 4. 打包
             return _mm256_or_si256(
                 _mm256_or_si256(_mm256_slli_epi32(ai, 24), _mm256_slli_epi32(ri, 16)),
                 _mm256_or_si256(_mm256_slli_epi32(gi, 8), bi)
             );
         }
 
+#endif
+
         inline __m128i blend_pixels_sse(
             const __m128& combinedAlpha,
             const __m128i& dest,
@@ -108,9 +336,9 @@ namespace pa2d {
             const __m128& srcG_01,
             const __m128& srcB_01
         ) {
-            using namespace simd; // ʹռеĳ
+            using namespace simd; // 使用命名空间中的常量
 
-            // 1. 
+            // 1. 解包
             __m128i b_i = _mm_and_si128(dest, MASK_BLUE_128);
             __m128i g_i = _mm_and_si128(_mm_srli_epi32(dest, 8), MASK_BLUE_128);
             __m128i r_i = _mm_and_si128(_mm_srli_epi32(dest, 16), MASK_BLUE_128);
@@ -121,7 +349,7 @@ namespace pa2d {
             __m128 fr = _mm_mul_ps(_mm_cvtepi32_ps(r_i), _255_RECIP_128);
             __m128 fa = _mm_mul_ps(_mm_cvtepi32_ps(a_i), _255_RECIP_128);
 
-            // 2. 
+            // 2. 混合
             __m128 invCombinedAlpha = _mm_sub_ps(ONE_128, combinedAlpha);
             __m128 blendedA = _mm_add_ps(combinedAlpha, _mm_mul_ps(fa, invCombinedAlpha));
             __m128 invOutAlpha = _mm_div_ps(ONE_128, blendedA);
@@ -135,35 +363,45 @@ namespace pa2d {
             __m128 blendedG = _mm_mul_ps(numG, invOutAlpha);
             __m128 blendedB = _mm_mul_ps(numB, invOutAlpha);
 
-            // 3. ת
+            // 3. 转换
             __m128i ri = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(blendedR, ZERO_128), ONE_128), _255_128));
             __m128i gi = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(blendedG, ZERO_128), ONE_128), _255_128));
             __m128i bi = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(blendedB, ZERO_128), ONE_128), _255_128));
             __m128i ai = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(blendedA, ZERO_128), ONE_128), _255_128));
 
-            // 4. 
+            // 4. 打包
             return _mm_or_si128(
                 _mm_or_si128(_mm_slli_epi32(ai, 24), _mm_slli_epi32(ri, 16)),
                 _mm_or_si128(_mm_slli_epi32(gi, 8), bi)
             );
         }
 
+        // 预乘目标的单像素合成：Out = Src * SrcA / 255 + Dst * (255 - SrcA) / 255，四个通道同一公式
+        inline Color BlendPremultiplied(const Color& src, const Color& dst) {
+            const unsigned int srcAlpha = src.a;
+            const unsigned int inv = 255 - srcAlpha;
+            auto channel = [&](unsigned int s, unsigned int d) {
+                return static_cast<unsigned char>(((s * srcAlpha + d * inv + 128) * 257) >> 16);
+            };
+            return Color(channel(255, dst.a), channel(src.r, dst.r), channel(src.g, dst.g), channel(src.b, dst.b));
+        }
+
         inline Color Blend(const Color& src, const Color& dst) {
-            // ȡAlpha
+            // 提取Alpha分量
             unsigned int srcAlpha = src.a;
             unsigned int dstAlpha = dst.a;
 
-            // ϺAlpha
-            // ʽout_alpha = src_alpha + dst_alpha * (1 - src_alpha/255)
+            // 计算混合后的总Alpha
+            // 公式：out_alpha = src_alpha + dst_alpha * (1 - src_alpha/255)
             unsigned int outAlpha = srcAlpha + dstAlpha - (srcAlpha * dstAlpha) / 255;
 
-            // AlphaΪ0ȫ͸ɫ
+            // 如果总Alpha为0，返回完全透明色
             if (outAlpha == 0) {
                 return Color(0, 0, 0, 0);
             }
 
-            // ϺRGB
-            // ʽcolor = (src * src_alpha + dst * dst_alpha * (1 - src_alpha/255)) / out_alpha
+            // 计算混合后的RGB分量
+            // 公式：color = (src * src_alpha + dst * dst_alpha * (1 - src_alpha/255)) / out_alpha
             unsigned int invSrcAlpha = 255 - srcAlpha;
             unsigned int dstWeight = dstAlpha * invSrcAlpha / 255;
 
@@ -171,7 +409,7 @@ namespace pa2d {
             unsigned int green = src.g * srcAlpha + dst.g * dstWeight;
             unsigned int blue = src.b * srcAlpha + dst.b * dstWeight;
 
-            // һؽ
+            // 归一化并返回结果
             return Color(
                 static_cast<unsigned char>(outAlpha),
                 static_cast<unsigned char>(red / outAlpha),
@@ -179,5 +417,289 @@ namespace pa2d {
                 static_cast<unsigned char>(blue / outAlpha)
             );
         }
+
+        // ============================================================================
+        // 合成器：光栅化入口按目标格式、定点开关与混合模式选定一次，行循环按具体类型实例化，不再读全局状态
+        // avx / sse 的 combinedAlpha（pixel 的 src.a）为源 alpha 与覆盖率之积，coverage 为覆盖率本身；
+        // 源覆盖类合成只用 combinedAlpha，coverage 的计算随内联消去；avx 只在 256 位版本（PA2D_AVX2）中提供
+        // ============================================================================
+
+        // 直通目标、浮点源覆盖（默认）
+        struct StraightComposite {
+            static const bool sourceOver = true;
+#ifdef PA2D_AVX2
+            __m256i avx(const __m256& combinedAlpha, const __m256i& dest, const __m256& r, const __m256& g, const __m256& b, const __m256&) const {
+                return blend_pixels_avx(combinedAlpha, dest, r, g, b);
+            }
+#endif
+            __m128i sse(const __m128& combinedAlpha, const __m128i& dest, const __m128& r, const __m128& g, const __m128& b, const __m128&) const {
+                return blend_pixels_sse(combinedAlpha, dest, r, g, b);
+            }
+            Color pixel(const Color& src, const Color& dst, float) const { return Blend(src, dst); }
+        };
+
+        // 直通目标、定点源覆盖：一组目标像素全部不透明时走整数路径，否则仍需按 OutA 做除法
+        struct StraightFixedComposite {
+            static const bool sourceOver = true;
+#ifdef PA2D_AVX2
+            __m256i avx(const __m256& combinedAlpha, const __m256i& dest, const __m256& r, const __m256& g, const __m256& b, const __m256&) const {
+                if (_mm256_testc_si256(dest, simd::MASK_ALPHA)) return blend_pixels_fixed_avx(combinedAlpha, dest, r, g, b);
+                return blend_pixels_avx(combinedAlpha, dest, r, g, b);
+            }
+#endif
+            __m128i sse(const __m128& combinedAlpha, const __m128i& dest, const __m128& r, const __m128& g, const __m128& b, const __m128&) const {
+                if (_mm_testc_si128(dest, _mm_set1_epi32(static_cast<int>(0xFF000000)))) return blend_pixels_fixed_sse(combinedAlpha, dest, r, g, b);
+                return blend_pixels_sse(combinedAlpha, dest, r, g, b);
+            }
+            Color pixel(const Color& src, const Color& dst, float) const { return Blend(src, dst); }
+        };
+
+        // 预乘目标：不需要按 OutA 做除法
+        struct PremultipliedComposite {
+            static const bool sourceOver = true;
+#ifdef PA2D_AVX2
+            __m256i avx(const __m256& combinedAlpha, const __m256i& dest, const __m256& r, const __m256& g, const __m256& b, const __m256&) const {
+                return blend_pixels_premultiplied_avx(combinedAlpha, dest, r, g, b);
+            }
+#endif
+            __m128i sse(const __m128& combinedAlpha, const __m128i& dest, const __m128& r, const __m128& g, const __m128& b, const __m128&) const {
+                return blend_pixels_premultiplied_sse(combinedAlpha, dest, r, g, b);
+            }
+            Color pixel(const Color& src, const Color& dst, float) const { return BlendPremultiplied(src, dst); }
+        };
+
+        // 预乘目标、定点：对任意目标 alpha 都可用
+        struct PremultipliedFixedComposite {
+            static const bool sourceOver = true;
+#ifdef PA2D_AVX2
+            __m256i avx(const __m256& combinedAlpha, const __m256i& dest, const __m256& r, const __m256& g, const __m256& b, const __m256&) const {
+                return blend_pixels_fixed_avx(combinedAlpha, dest, r, g, b, true);
+            }
+#endif
+            __m128i sse(const __m128& combinedAlpha, const __m128i& dest, const __m128& r, const __m128& g, const __m128& b, const __m128&) const {
+                return blend_pixels_fixed_sse(combinedAlpha, dest, r, g, b, true);
+            }
+            Color pixel(const Color& src, const Color& dst, float) const { return BlendPremultiplied(src, dst); }
+        };
+
+        // 任意混合模式与图层不透明度（blend_modes.inl，通用混合引擎）
+        // 源 alpha 为透明时仍改写目标的模式（Clear、Src、SrcIn、DstIn、SrcOut、DstAtop）不把覆盖率并入源 alpha，
+        // 而是以完全覆盖计算混合结果，再按覆盖率与目标插值，抗锯齿边缘与源覆盖一致
+        struct ModeComposite {
+            static const bool sourceOver = false;
+            BlendMode mode;
+            float opacity;
+            bool premultiplied;
+#ifdef PA2D_AVX2
+            __m256i avx(const __m256& combinedAlpha, const __m256i& dest, const __m256& r, const __m256& g, const __m256& b, const __m256& coverage) const;
+#endif
+            __m128i sse(const __m128& combinedAlpha, const __m128i& dest, const __m128& r, const __m128& g, const __m128& b, const __m128& coverage) const;
+            Color pixel(const Color& src, const Color& dst, float coverage) const;
+        };
+
+        // 按目标格式、定点开关与混合模式选定合成器，以具体类型调用 f(comp)
+        template<typename F>
+        inline void withComposite(const Buffer& target, BlendMode mode, float opacity, const F& f) {
+            if (mode != BlendMode::SrcOver || opacity < 1.0f) {
+                f(ModeComposite{ mode, opacity, target.isPremultiplied() });
+                return;
+            }
+            const bool fixed = fixedPointComposite.load(std::memory_order_relaxed);
+            if (target.isPremultiplied()) {
+                if (fixed) f(PremultipliedFixedComposite());
+                else f(PremultipliedComposite());
+            }
+            else if (fixed) f(StraightFixedComposite());
+            else f(StraightComposite());
+        }
+
+        // 使用当前线程 compositeOp 的混合模式与不透明度
+        template<typename F>
+        inline void withComposite(const Buffer& target, const F& f) {
+            withComposite(target, compositeOp.mode, compositeOp.opacity, f);
+        }
+
+        // 光栅化入口：选定合成器后按条带遍历行，body(comp, rowBegin, rowEnd)
+        template<typename Body>
+        inline void compositeRows(const Buffer& target, int minY, int maxY, int spanWidth, const Body& body) {
+            withComposite(target, [&](const auto& comp) {
+                parallelRows(minY, maxY, spanWidth, [&](int rowBegin, int rowEnd) { body(comp, rowBegin, rowEnd); });
+            });
+        }
+
+        // 描边叠在填充上时像素的覆盖率：两者覆盖区域的并集，只画其中一种时即为它的覆盖率
+#ifdef PA2D_AVX2
+        inline __m256 unionCoverage_avx(const __m256& a, const __m256& b) {
+            return _mm256_sub_ps(_mm256_add_ps(a, b), _mm256_mul_ps(a, b));
+        }
+#endif
+        inline __m128 unionCoverage_sse(const __m128& a, const __m128& b) {
+            return _mm_sub_ps(_mm_add_ps(a, b), _mm_mul_ps(a, b));
+        }
+        inline float unionCoverage(float a, float b) {
+            return a + b - a * b;
+        }
+
+        // 光栅化按绝对坐标分组：AVX2 只处理从 8 的倍数开始的整组，组内其余像素走 SSE/标量，返回 x 所在组在 end 之前的最后一个像素
+        // 每个像素的计算路径只由它的 x 与图形自身的范围决定，与裁剪区域无关；分块渲染的图块边界是 8 的倍数，结果与整体回放逐位一致
+        inline int alignedGroupEnd(int x, int end) {
+            return std::min(end, x | 7);
+        }
+
+        // 实心跨度：覆盖率恒为 1 的像素段绕过距离场直接写入
+        // 不透明颜色与 Buffer::clear 一样走内核表 fillRow，半透明颜色做常量源混合
+        struct SolidSpan {
+            // 短于该长度的跨度不单独拆分，拆分开销抵不过节省的距离计算
+            static constexpr int MIN_LENGTH = 16;
+
+            explicit SolidSpan(const Color& color)
+                : value(color.data), opaque(color.a == 255),
+#ifdef PA2D_AVX2
+                a_avx(_mm256_set1_ps(color.a * (1.0f / 255.0f))),
+                r_avx(_mm256_set1_ps(color.r * (1.0f / 255.0f))),
+                g_avx(_mm256_set1_ps(color.g * (1.0f / 255.0f))),
+                b_avx(_mm256_set1_ps(color.b * (1.0f / 255.0f))),
+#endif
+                a_sse(_mm_set1_ps(color.a * (1.0f / 255.0f))),
+                r_sse(_mm_set1_ps(color.r * (1.0f / 255.0f))),
+                g_sse(_mm_set1_ps(color.g * (1.0f / 255.0f))),
+                b_sse(_mm_set1_ps(color.b * (1.0f / 255.0f))) {
+                // 定点合成器的源项：每像素 B、G、R、A 四个 16 位通道，alpha 通道按 255 参与（直通目标随后写回 255）
+                const int a = color.a;
+                const uint64_t lanes = static_cast<uint64_t>(color.b * a + 128) | static_cast<uint64_t>(color.g * a + 128) << 16 |
+                                       static_cast<uint64_t>(color.r * a + 128) << 32 | static_cast<uint64_t>(255 * a + 128) << 48;
+                term_sse = _mm_set1_epi64x(static_cast<long long>(lanes));
+                inv_sse = _mm_set1_epi16(static_cast<short>(255 - a));
+#ifdef PA2D_AVX2
+                term_avx = _mm256_set1_epi64x(static_cast<long long>(lanes));
+                inv_avx = _mm256_set1_epi16(static_cast<short>(255 - a));
+#endif
+            }
+
+            // 像素中心落在 [lo, hi] 内、按绝对坐标 8 像素对齐的整组与 [minX, maxX] 求交，过短时置为空区间 (begin > end)
+            // 是否拆分只看裁剪前的跨度，两侧边缘段的分组与不拆分时一致，且不随裁剪区域变化
+            static void range(float lo, float hi, int minX, int maxX, int& begin, int& end) {
+                begin = maxX + 1;
+                end = maxX;
+                if (!(lo <= hi)) return;
+                const int first = (static_cast<int>(std::ceil(lo - 0.5f)) + 7) & ~7;
+                const int last = ((static_cast<int>(std::floor(hi - 0.5f)) + 1) & ~7) - 1;
+                if (last - first + 1 < MIN_LENGTH || first > maxX || last < minX) return;
+                begin = std::max(minX, first);
+                end = std::min(maxX, last);
+            }
+
+            // 旋转矩形 |u| <= ex, |v| <= ey (u = dx*c + dy*s, v = dy*c - dx*s) 与纵向偏移为 dy 的行求交，得到 dx 区间
+            static bool boxRow(float dy, float c, float s, float ex, float ey, float& lo, float& hi) {
+                lo = -FLT_MAX;
+                hi = FLT_MAX;
+                auto clampAxis = [&](float k, float offset, float extent) {
+                    // 约束 |k*dx + offset| <= extent
+                    if (std::abs(k) < 1e-6f) {
+                        if (std::abs(offset) > extent) hi = -FLT_MAX;
+                        return;
+                    }
+                    float a = (-extent - offset) / k, b = (extent - offset) / k;
+                    if (a > b) std::swap(a, b);
+                    lo = std::max(lo, a);
+                    hi = std::min(hi, b);
+                };
+                clampAxis(c, dy * s, ex);
+                clampAxis(-s, dy * c, ey);
+                return lo <= hi;
+            }
+
+            // 写入 row[begin..end]，半透明或混合模式非源覆盖时与距离场路径使用同一合成器，覆盖率为 1
+            template<typename Composite>
+            void fill(const Composite& comp, Color* row, int begin, int end) const {
+                if (begin > end) return;
+                if (opaque && Composite::sourceOver) {
+                    kernels().fillRow(row + begin, static_cast<size_t>(end - begin + 1), value);
+                    return;
+                }
+
+                int x = begin;
+                while (x <= end) {
+#ifdef PA2D_AVX2
+                    for (; (x & 7) == 0 && x <= end - 7; x += 8) {
+                        __m256i dest = _mm256_loadu_si256((__m256i*)(row + x));
+                        _mm256_storeu_si256((__m256i*)(row + x), comp.avx(a_avx, dest, r_avx, g_avx, b_avx, simd::ONE_256));
+                    }
+#endif
+                    const int groupEnd = alignedGroupEnd(x, end);
+                    for (; x <= groupEnd - 3; x += 4) {
+                        __m128i dest = _mm_loadu_si128((__m128i*)(row + x));
+                        _mm_storeu_si128((__m128i*)(row + x), comp.sse(a_sse, dest, r_sse, g_sse, b_sse, simd::ONE_128));
+                    }
+                    if (x <= groupEnd) {
+                        // 不足 4 像素的尾部经临时缓冲走同一 SSE 公式
+                        const int n = groupEnd - x + 1;
+                        Color tail[4];
+                        std::memcpy(tail, row + x, n * sizeof(Color));
+                        __m128i dest = _mm_loadu_si128((__m128i*)tail);
+                        _mm_storeu_si128((__m128i*)tail, comp.sse(a_sse, dest, r_sse, g_sse, b_sse, simd::ONE_128));
+                        std::memcpy(row + x, tail, n * sizeof(Color));
+                        x = groupEnd + 1;
+                    }
+                }
+            }
+
+            // 定点合成器：常量源直接用打包好的整数源项，直通目标中不透明的像素组不再经过浮点
+            void fill(const StraightFixedComposite& comp, Color* row, int begin, int end) const { fillFixed(comp, row, begin, end, false); }
+            void fill(const PremultipliedFixedComposite& comp, Color* row, int begin, int end) const { fillFixed(comp, row, begin, end, true); }
+
+        private:
+            uint32_t value;
+            bool opaque;
+#ifdef PA2D_AVX2
+            __m256 a_avx, r_avx, g_avx, b_avx;
+            __m256i term_avx, inv_avx;
+#endif
+            __m128 a_sse, r_sse, g_sse, b_sse;
+            __m128i term_sse, inv_sse;
+
+            // 直通目标中含半透明像素的一组仍需按 OutA 做除法，交回合成器的浮点路径
+            template<typename Composite>
+            void fillFixed(const Composite& comp, Color* row, int begin, int end, bool premultiplied) const {
+                if (begin > end) return;
+                if (opaque) {
+                    kernels().fillRow(row + begin, static_cast<size_t>(end - begin + 1), value);
+                    return;
+                }
+
+                const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+                auto block = [&](const __m128i& dest) {
+                    return premultiplied || _mm_testc_si128(dest, alphaMask)
+                        ? blend_span_fixed_sse(dest, term_sse, inv_sse, premultiplied)
+                        : comp.sse(a_sse, dest, r_sse, g_sse, b_sse, simd::ONE_128);
+                };
+                int x = begin;
+                while (x <= end) {
+#ifdef PA2D_AVX2
+                    for (; (x & 7) == 0 && x <= end - 7; x += 8) {
+                        const __m256i dest = _mm256_loadu_si256((__m256i*)(row + x));
+                        const __m256i out = premultiplied || _mm256_testc_si256(dest, simd::MASK_ALPHA)
+                            ? blend_span_fixed_avx(dest, term_avx, inv_avx, premultiplied)
+                            : comp.avx(a_avx, dest, r_avx, g_avx, b_avx, simd::ONE_256);
+                        _mm256_storeu_si256((__m256i*)(row + x), out);
+                    }
+#endif
+                    const int groupEnd = alignedGroupEnd(x, end);
+                    for (; x <= groupEnd - 3; x += 4) {
+                        _mm_storeu_si128((__m128i*)(row + x), block(_mm_loadu_si128((__m128i*)(row + x))));
+                    }
+                    if (x <= groupEnd) {
+                        // 空位填不透明像素，路径只由实际像素决定
+                        const int n = groupEnd - x + 1;
+                        Color tail[4] = { Color(0xFF000000), Color(0xFF000000), Color(0xFF000000), Color(0xFF000000) };
+                        std::memcpy(tail, row + x, n * sizeof(Color));
+                        _mm_storeu_si128((__m128i*)tail, block(_mm_loadu_si128((__m128i*)tail)));
+                        std::memcpy(row + x, tail, n * sizeof(Color));
+                        x = groupEnd + 1;
+                    }
+                }
+            }
+        };
+        }
     }
 }
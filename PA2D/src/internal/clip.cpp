@@ -0,0 +1,45 @@
+#include "clip.h"
+#include <algorithm>
+
+namespace pa2d {
+    namespace utils {
+        // 线程局部：并行分块时每个线程持有各自的图块
+        static thread_local ClipRect t_clip = { 0, 0, -1, -1 };
+        static thread_local bool t_hasClip = false;
+        static thread_local DirtyRegion* t_dirty = nullptr;
+
+        ClipRect currentClip(const Buffer& buffer) {
+            ClipRect clip = { 0, 0, buffer.width - 1, buffer.height - 1 };
+            if (t_hasClip) {
+                clip.minX = std::max(clip.minX, t_clip.minX);
+                clip.minY = std::max(clip.minY, t_clip.minY);
+                clip.maxX = std::min(clip.maxX, t_clip.maxX);
+                clip.maxY = std::min(clip.maxY, t_clip.maxY);
+            }
+            return clip;
+        }
+
+        ScopedClip::ScopedClip(const ClipRect& clip) : saved_(t_clip), hadClip_(t_hasClip) {
+            t_clip = clip;
+            t_hasClip = true;
+        }
+
+        ScopedClip::~ScopedClip() {
+            t_clip = saved_;
+            t_hasClip = hadClip_;
+        }
+
+        void reportDirty(int minX, int minY, int maxX, int maxY) {
+            if (!t_dirty || minX > maxX || minY > maxY) return;
+            t_dirty->add(minX, minY, maxX - minX + 1, maxY - minY + 1);
+        }
+
+        ScopedDirtyRegion::ScopedDirtyRegion(DirtyRegion& region) : saved_(t_dirty) {
+            t_dirty = &region;
+        }
+
+        ScopedDirtyRegion::~ScopedDirtyRegion() {
+            t_dirty = saved_;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// clip.h
+#pragma once
+#include"../include/buffer.h"
+#include"../include/dirty_region.h"
+
+namespace pa2d {
+    namespace utils {
+        // 闭区间像素裁剪矩形
+        struct ClipRect {
+            int minX, minY, maxX, maxY;
+        };
+
+        // 当前线程的光栅化裁剪区域与缓冲区边界的交集
+        // 未设置裁剪时即为整个缓冲区；各光栅化函数据此限定包围盒
+        ClipRect currentClip(const Buffer& buffer);
+
+        // 在作用域内限定当前线程的光栅化区域（分块渲染时每个图块使用）
+        class ScopedClip {
+        private:
+            ClipRect saved_;
+            bool hadClip_;
+        public:
+            explicit ScopedClip(const ClipRect& clip);
+            ~ScopedClip();
+            ScopedClip(const ScopedClip&) = delete;
+            ScopedClip& operator=(const ScopedClip&) = delete;
+        };
+
+        // 上报本次调用实际写入的包围盒（闭区间，已裁剪到缓冲区）
+        // 各光栅化、变换与混合函数在确定包围盒后调用；未设置收集目标时为空操作
+        void reportDirty(int minX, int minY, int maxX, int maxY);
+
+        // 在作用域内把当前线程上报的写入范围收集到指定脏区域（Canvas 绘制调用使用）
+        class ScopedDirtyRegion {
+        private:
+            DirtyRegion* saved_;
+        public:
+            explicit ScopedDirtyRegion(DirtyRegion& region);
+            ~ScopedDirtyRegion();
+            ScopedDirtyRegion(const ScopedDirtyRegion&) = delete;
+            ScopedDirtyRegion& operator=(const ScopedDirtyRegion&) = delete;
+        };
+    }
+}
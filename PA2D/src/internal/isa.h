@@ -0,0 +1,37 @@
+// isa.h
+// 按指令集分别编译的代码约定：
+// kernels_*.cpp 在包含任何头文件之前定义 PA2D_ISA（sse41 / avx2 / avx512），256 位版本另外定义 PA2D_AVX2
+// blend_utils.h、blend_modes.h、vec_math.h 中随指令集变化的内联函数与模板都位于 pa2d::utils::PA2D_ISA，
+// 不同编译选项生成的副本名字不同，链接器不会把 AVX2 编译的副本合并给基线代码使用
+// 标准库与公共头文件由 kernel_prelude.h 在关闭 AVX 的目标下先行包含，同名副本同样是基线代码
+// 其余翻译单元按基线指令集（SSE4.1）编译，与 SSE4.1 内核共用 sse41 命名空间
+#pragma once
+#include <immintrin.h>
+
+#ifndef PA2D_ISA
+#define PA2D_ISA sse41
+#endif
+
+namespace pa2d {
+    namespace utils {
+        namespace PA2D_ISA {
+            // 4 路乘加 a * b + c：AVX2 版本为 FMA，与 8 路主循环的舍入一致；SSE4.1 版本拆成乘法与加法
+            inline __m128 fmadd_sse(__m128 a, __m128 b, __m128 c) {
+#ifdef PA2D_AVX2
+                return _mm_fmadd_ps(a, b, c);
+#else
+                return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+            }
+
+            // c - a * b
+            inline __m128 fnmadd_sse(__m128 a, __m128 b, __m128 c) {
+#ifdef PA2D_AVX2
+                return _mm_fnmadd_ps(a, b, c);
+#else
+                return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+            }
+        }
+    }
+}
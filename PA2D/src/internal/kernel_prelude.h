@@ -0,0 +1,41 @@
+// kernel_prelude.h
+// AVX2 / AVX-512 内核翻译单元在定义 PA2D_ISA 之后、包含其余头文件之前包含本文件
+// 这些翻译单元按文件加了 -mavx2 等选项，而标准库模板与公共头文件中的内联函数在各翻译单元生成同名的弱符号，
+// 链接器任取其一；若取到 AVX 编译的副本，基线代码调用时会在不支持 AVX2 的处理器上崩溃
+// 因此先在关闭 AVX 的目标下包含这些头文件，其中的内联函数与模板按基线指令集生成，
+// 之后包含的 isa.h 等头文件中随指令集变化的代码位于 PA2D_ISA 命名空间，不受影响
+// kernels.h 不在此列：GCC 把声明处的目标选项带到定义上，内核函数必须在 AVX 目标下声明
+// MSVC 不需要编译选项即可使用内建函数，Clang 不支持该 pragma，两者都原样包含
+#pragma once
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC target("no-avx")
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "../../include/blend_mode.h"
+#include "../../include/buffer.h"
+#include "../../include/buffer_blender.h"
+#include "../../include/color.h"
+#include "../../include/composite.h"
+#include "../../include/dirty_region.h"
+#include "../../include/dispatch.h"
+#include "../../include/draw.h"
+#include "../../include/store_mode.h"
+#include "clip.h"
+#include "path_geometry.h"
+#include "thread_pool.h"
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
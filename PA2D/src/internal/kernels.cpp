@@ -0,0 +1,137 @@
+// kernels.cpp
+#include "kernels.h"
+#include <atomic>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace pa2d {
+    namespace utils {
+        static void cpuid(int leaf, int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, leaf, subleaf);
+            for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned int>(info[i]);
+#else
+            if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3])) {
+                regs[0] = regs[1] = regs[2] = regs[3] = 0;
+            }
+#endif
+        }
+
+        // XCR0：操作系统是否在上下文切换时保存 YMM/ZMM 寄存器
+        static unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            unsigned int lo, hi;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+        }
+
+        bool cpuHasBaseline() {
+            unsigned int regs[4];
+            cpuid(1, 0, regs);
+            return (regs[2] & (1u << 19)) != 0;
+        }
+
+        static SimdLevel detectSimdLevel() {
+            unsigned int regs[4];
+            cpuid(0, 0, regs);
+            const unsigned int maxLeaf = regs[0];
+
+            cpuid(1, 0, regs);
+            const unsigned int ecx1 = regs[2];
+            const bool osxsave = (ecx1 & (1u << 27)) != 0;
+            const bool avx = (ecx1 & (1u << 28)) != 0;
+            const bool fma = (ecx1 & (1u << 12)) != 0;
+            if (!osxsave || !avx || !fma || maxLeaf < 7) return SimdLevel::SSE41;
+
+            const unsigned long long xcr0 = xgetbv0();
+            if ((xcr0 & 0x6) != 0x6) return SimdLevel::SSE41;
+
+            cpuid(7, 0, regs);
+            const unsigned int ebx7 = regs[1];
+            if (!(ebx7 & (1u << 5))) return SimdLevel::SSE41;
+
+            const bool avx512f = (ebx7 & (1u << 16)) != 0;
+            const bool avx512bw = (ebx7 & (1u << 30)) != 0;
+            if (avx512f && avx512bw && (xcr0 & 0xE6) == 0xE6) return SimdLevel::AVX512;
+            return SimdLevel::AVX2;
+        }
+
+        static const KernelTable* tableFor(SimdLevel level) {
+            switch (level) {
+            case SimdLevel::AVX512: return &avx512::table;
+            case SimdLevel::AVX2: return &avx2::table;
+            default: return &sse41::table;
+            }
+        }
+
+        static SimdLevel cpuLevel() {
+            static const SimdLevel level = detectSimdLevel();
+            return level;
+        }
+
+        // 首次使用时按检测结果选定，setSimdLevel 可随时替换
+        static std::atomic<const KernelTable*> g_active{ nullptr };
+
+        const KernelTable& kernels() {
+            const KernelTable* table = g_active.load(std::memory_order_acquire);
+            if (!table) {
+                table = tableFor(cpuLevel());
+                const KernelTable* expected = nullptr;
+                if (!g_active.compare_exchange_strong(expected, table, std::memory_order_acq_rel)) {
+                    table = expected;
+                }
+            }
+            return *table;
+        }
+
+        static std::atomic<StoreMode> g_storeMode{ StoreMode::Auto };
+        static std::atomic<size_t> g_streamingThreshold{ size_t(4) << 20 };
+
+        bool useStreamingStores(size_t bytes) {
+            switch (g_storeMode.load(std::memory_order_relaxed)) {
+            case StoreMode::Streaming: return true;
+            case StoreMode::Cached: return false;
+            default: return bytes >= g_streamingThreshold.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    SimdLevel getCpuSimdLevel() {
+        return utils::cpuLevel();
+    }
+
+    SimdLevel getSimdLevel() {
+        const utils::KernelTable* table = &utils::kernels();
+        if (table == &utils::avx512::table) return SimdLevel::AVX512;
+        if (table == &utils::avx2::table) return SimdLevel::AVX2;
+        return SimdLevel::SSE41;
+    }
+
+    void setSimdLevel(SimdLevel level) {
+        if (static_cast<int>(level) > static_cast<int>(utils::cpuLevel())) level = utils::cpuLevel();
+        utils::g_active.store(utils::tableFor(level), std::memory_order_release);
+    }
+
+    void setStoreMode(StoreMode mode) {
+        utils::g_storeMode.store(mode, std::memory_order_relaxed);
+    }
+
+    StoreMode getStoreMode() {
+        return utils::g_storeMode.load(std::memory_order_relaxed);
+    }
+
+    void setStreamingThreshold(size_t bytes) {
+        utils::g_streamingThreshold.store(bytes, std::memory_order_relaxed);
+    }
+
+    size_t getStreamingThreshold() {
+        return utils::g_streamingThreshold.load(std::memory_order_relaxed);
+    }
+}
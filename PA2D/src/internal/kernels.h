@@ -0,0 +1,165 @@
+// kernels.h
+#pragma once
+#include"../include/blend_mode.h"
+#include"../include/buffer.h"
+#include"../include/color.h"
+#include"../include/dispatch.h"
+#include"../include/store_mode.h"
+#include"../include/geometry/point.h"
+#include"path_geometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pa2d {
+    namespace utils {
+        // Resampler 权重表的定点位数：权重之和为 1 << RESAMPLE_WEIGHT_BITS
+        const int RESAMPLE_WEIGHT_BITS = 14;
+
+        // SpriteBatch 的一个实例（见 sprite_batch.h）：目标像素 (px, py) 映射到源矩形内坐标 u = u0 + dudx * px + dudy * py，v 同理
+        struct SpriteInstance {
+            const Color* pixels;                // 源矩形左上角
+            int stride, width, height;
+            bool premultiplied;
+            float u0, dudx, dudy, v0, dvdx, dvdy;
+            float opacity;
+            BlendMode blend;
+        };
+
+        // 像素内核表：每个指令集等级各一份，宽版本把不足一个向量的尾部交给下一级处理
+        // 整个函数级的内核（光栅化、图像采样）按指令集整体编译，AVX-512 表沿用 AVX2 版本
+        struct KernelTable {
+            void (*fillRow)(Color* dst, size_t count, uint32_t value);
+            void (*copyRow)(Color* dst, const Color* src, size_t count);
+            // 对齐版本：dst/src 按 32 字节对齐且 count 为 8 的倍数，没有尾部处理
+            void (*fillRowAligned)(Color* dst, size_t count, uint32_t value);
+            void (*copyRowAligned)(Color* dst, const Color* src, size_t count);
+            // 非临时存储版本：写入绕过缓存，调用方在全部写完后执行一次 _mm_sfence()
+            void (*fillRowStream)(Color* dst, size_t count, uint32_t value);
+            void (*copyRowStream)(Color* dst, const Color* src, size_t count);
+            void (*alphaBlendRow)(Color* destRow, const Color* srcRow, int rowWidth, int opacity);
+            // 预乘格式：源覆盖 Out = Src * op + Dst * (1 - SrcA * op)，四个通道同一公式，/255 四舍五入
+            void (*premultipliedBlendRow)(Color* destRow, const Color* srcRow, int rowWidth, int opacity);
+            // 就地格式转换：RGB * A / 255 四舍五入；RGB * 255 / A 四舍五入并截断到 255，A 为 0 时整像素置 0
+            void (*premultiplyRow)(Color* row, size_t count);
+            void (*unpremultiplyRow)(Color* row, size_t count);
+            // 通用混合引擎（blend_modes.h）：任意 BlendMode，源 / 目标可分别为直通或预乘格式
+            void (*blendModeRow)(Color* destRow, const Color* srcRow, int rowWidth, int opacity,
+                                 BlendMode mode, bool srcPremultiplied, bool dstPremultiplied);
+            // 2:1 盒式滤波一行：row0/row1 为参与平均的两行，halveX 为 false 时只减半高度
+            void (*halveRow)(const Color* row0, const Color* row1, Color* out, int srcWidth, int outWidth, bool halveX);
+            // Resampler 横向一遍：输出 x 从 start[x] 起读取 taps 个源像素，taps 为 4 的倍数
+            void (*resampleRow)(const Color* src, int srcWidth, Color* out, int outWidth,
+                                const int* start, const int16_t* coeffs, int taps);
+            // 最近邻一行：index 单调不减
+            void (*nearestRow)(const Color* src, int srcWidth, Color* out, int outWidth, const int* index);
+            // Resampler 纵向一遍：taps 行按列累加，写入 out[begin, end)，taps 为偶数
+            void (*resampleColumns)(const Color* const* rows, const int16_t* coeffs, int taps, Color* out, int begin, int end);
+
+            // 图形光栅化（draw.h），合成方式取自当前线程的 compositeOp
+            void (*line)(Buffer& buffer, float startX, float startY, float endX, float endY, const Color& color, float width);
+            // 折线与多边形接收预先构建的线段网格与边表（path_geometry.h），分块渲染时各图块共用
+            void (*polyline)(Buffer& buffer, const PolylineSegments& path, const Color& color, float width);
+            void (*polygon)(Buffer& buffer, const PolygonEdges& path, const Color& fillColor, const Color& strokeColor, float strokeWidth);
+            void (*triangle)(Buffer& buffer, float x0, float y0, float x1, float y1, float x2, float y2,
+                             const Color& fillColor, const Color& strokeColor, float strokeWidth);
+            void (*rect)(Buffer& buffer, float left, float top, float width, float height,
+                         const Color& fillColor, const Color& strokeColor, float strokeWidth);
+            void (*rotatedRect)(Buffer& buffer, float centerX, float centerY, float width, float height, float angle,
+                                const Color& fillColor, const Color& strokeColor, float strokeWidth);
+            void (*roundRect)(Buffer& buffer, float left, float top, float width, float height,
+                              const Color& fillColor, const Color& strokeColor, float radius, float strokeWidth);
+            void (*rotatedRoundRect)(Buffer& buffer, float centerX, float centerY, float width, float height, float angle,
+                                     const Color& fillColor, const Color& strokeColor, float radius, float strokeWidth);
+            void (*circle)(Buffer& buffer, float centerX, float centerY, float radius,
+                           const Color& fillColor, const Color& strokeColor, float strokeWidth);
+            void (*ellipse)(Buffer& buffer, float centerX, float centerY, float width, float height,
+                            const Color& fillColor, const Color& strokeColor, float strokeWidth);
+            void (*rotatedEllipse)(Buffer& buffer, float centerX, float centerY, float width, float height, float angle,
+                                   const Color& fillColor, const Color& strokeColor, float strokeWidth);
+            void (*sector)(Buffer& buffer, float centerX, float centerY, float radius, float startAngle, float endAngle,
+                           const Color& fillColor, const Color& strokeColor, float strokeWidth, bool arc, bool edges);
+
+            // 图像采样（buffer.h、sprite_batch.h）
+            Buffer (*resizedBilinear)(const Buffer& src, int width, int height);
+            Buffer (*rotated)(const Buffer& src, float rotation);
+            void (*drawScaled)(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY);
+            void (*drawResized)(Buffer& dest, const Buffer& src, float centerX, float centerY, int width, int height);
+            void (*drawRotated)(Buffer& dest, const Buffer& src, float centerX, float centerY, float rotation);
+            void (*drawTransformed)(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY, float rotation);
+            void (*drawTransformedUniform)(Buffer& dest, const Buffer& src, float centerX, float centerY, float scale, float rotation);
+            // 在闭区间 [minX, maxX] x [minY, maxY] 内光栅化一个精灵实例
+            void (*spriteInstance)(const SpriteInstance& inst, Buffer& target, int minX, int minY, int maxX, int maxY);
+        };
+
+        // 当前等级对应的内核表
+        const KernelTable& kernels();
+
+        // 处理器是否支持基线指令集 SSE4.1（非内核源文件按此编译）
+        bool cpuHasBaseline();
+
+        // 按 StoreMode 判断一次写入 bytes 字节是否使用非临时存储
+        bool useStreamingStores(size_t bytes);
+
+#define PA2D_DECLARE_KERNELS                                                                    \
+        extern const KernelTable table;                                                         \
+        void fillRow(Color* dst, size_t count, uint32_t value);                                 \
+        void copyRow(Color* dst, const Color* src, size_t count);                               \
+        void fillRowAligned(Color* dst, size_t count, uint32_t value);                          \
+        void copyRowAligned(Color* dst, const Color* src, size_t count);                        \
+        void fillRowStream(Color* dst, size_t count, uint32_t value);                           \
+        void copyRowStream(Color* dst, const Color* src, size_t count);                         \
+        void alphaBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity);     \
+        void premultipliedBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity); \
+        void premultiplyRow(Color* row, size_t count);                                          \
+        void unpremultiplyRow(Color* row, size_t count);                                        \
+        void blendModeRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity,       \
+                          BlendMode mode, bool srcPremultiplied, bool dstPremultiplied);
+
+        // 只有 SSE4.1 与 AVX2 两个版本的内核
+        // 行内核位于 kernels_sse41.cpp / kernels_avx2.cpp，光栅化位于 kernels_draw_*.cpp，图像采样位于 kernels_sample_*.cpp
+#define PA2D_DECLARE_SHARED_KERNELS                                                             \
+        void halveRow(const Color* row0, const Color* row1, Color* out, int srcWidth, int outWidth, bool halveX); \
+        void resampleRow(const Color* src, int srcWidth, Color* out, int outWidth,              \
+                         const int* start, const int16_t* coeffs, int taps);                    \
+        void nearestRow(const Color* src, int srcWidth, Color* out, int outWidth, const int* index); \
+        void resampleColumns(const Color* const* rows, const int16_t* coeffs, int taps, Color* out, int begin, int end); \
+        void line(Buffer& buffer, float startX, float startY, float endX, float endY, const Color& color, float width); \
+        void polyline(Buffer& buffer, const PolylineSegments& path, const Color& color, float width); \
+        void polygon(Buffer& buffer, const PolygonEdges& path, const Color& fillColor, const Color& strokeColor, float strokeWidth); \
+        void triangle(Buffer& buffer, float x0, float y0, float x1, float y1, float x2, float y2, \
+                      const Color& fillColor, const Color& strokeColor, float strokeWidth);     \
+        void rect(Buffer& buffer, float left, float top, float width, float height,             \
+                  const Color& fillColor, const Color& strokeColor, float strokeWidth);         \
+        void rect(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, \
+                  const Color& fillColor, const Color& strokeColor, float strokeWidth);         \
+        void roundRect(Buffer& buffer, float left, float top, float width, float height,        \
+                       const Color& fillColor, const Color& strokeColor, float radius, float strokeWidth); \
+        void roundRect(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, \
+                       const Color& fillColor, const Color& strokeColor, float radius, float strokeWidth); \
+        void circle(Buffer& buffer, float centerX, float centerY, float radius,                 \
+                    const Color& fillColor, const Color& strokeColor, float strokeWidth);       \
+        void ellipse(Buffer& buffer, float centerX, float centerY, float width, float height,   \
+                     const Color& fillColor, const Color& strokeColor, float strokeWidth);      \
+        void ellipse(Buffer& buffer, float centerX, float centerY, float width, float height, float angle, \
+                     const Color& fillColor, const Color& strokeColor, float strokeWidth);      \
+        void sector(Buffer& buffer, float centerX, float centerY, float radius, float startAngle, float endAngle, \
+                    const Color& fillColor, const Color& strokeColor, float strokeWidth, bool arc, bool edges); \
+        Buffer resizedBilinear(const Buffer& src, int width, int height);                       \
+        Buffer rotated(const Buffer& src, float rotation);                                      \
+        void drawScaled(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY); \
+        void drawResized(Buffer& dest, const Buffer& src, float centerX, float centerY, int width, int height); \
+        void drawRotated(Buffer& dest, const Buffer& src, float centerX, float centerY, float rotation); \
+        void drawTransformed(Buffer& dest, const Buffer& src, float centerX, float centerY, float scaleX, float scaleY, float rotation); \
+        void drawTransformed(Buffer& dest, const Buffer& src, float centerX, float centerY, float scale, float rotation); \
+        void spriteInstance(const SpriteInstance& inst, Buffer& target, int minX, int minY, int maxX, int maxY);
+
+        // 各等级实现分别位于 kernels_sse41.cpp / kernels_avx2.cpp / kernels_avx512.cpp
+        namespace sse41 { PA2D_DECLARE_KERNELS PA2D_DECLARE_SHARED_KERNELS }
+        namespace avx2 { PA2D_DECLARE_KERNELS PA2D_DECLARE_SHARED_KERNELS }
+        namespace avx512 { PA2D_DECLARE_KERNELS }
+
+#undef PA2D_DECLARE_KERNELS
+#undef PA2D_DECLARE_SHARED_KERNELS
+    }
+}
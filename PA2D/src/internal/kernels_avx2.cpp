@@ -0,0 +1,461 @@
+// kernels_avx2.cpp
+// AVX2 版本：8像素并行，尾部交给 SSE4.1 版本
+#define PA2D_ISA avx2
+#define PA2D_AVX2
+#include "kernel_prelude.h"
+#include "kernels.h"
+#include "blend_modes.h"
+#include <immintrin.h>
+#include <cstdint>
+
+namespace pa2d {
+    namespace utils {
+        namespace avx2 {
+            void fillRow(Color* dst, size_t count, uint32_t value) {
+                const __m256i color_vec = _mm256_set1_epi32(static_cast<int>(value));
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), color_vec);
+                }
+                if (i < count) sse41::fillRow(dst + i, count - i, value);
+            }
+
+            void copyRow(Color* dst, const Color* src, size_t count) {
+                size_t i = 0;
+                // 32像素/次，循环展开
+                for (; i + 32 <= count; i += 32) {
+                    __m256i data1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                    __m256i data2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 8));
+                    __m256i data3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+                    __m256i data4 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 24));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), data1);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), data2);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), data3);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 24), data4);
+                }
+                for (; i + 8 <= count; i += 8) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+                }
+                if (i < count) sse41::copyRow(dst + i, src + i, count - i);
+            }
+
+            void fillRowAligned(Color* dst, size_t count, uint32_t value) {
+                const __m256i color_vec = _mm256_set1_epi32(static_cast<int>(value));
+                for (size_t i = 0; i < count; i += 8) {
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), color_vec);
+                }
+            }
+
+            void copyRowAligned(Color* dst, const Color* src, size_t count) {
+                size_t i = 0;
+                for (; i + 32 <= count; i += 32) {
+                    __m256i data1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i));
+                    __m256i data2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + 8));
+                    __m256i data3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+                    __m256i data4 = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + 24));
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), data1);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + 8), data2);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + 16), data3);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + 24), data4);
+                }
+                for (; i < count; i += 8) {
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i)));
+                }
+            }
+
+            void fillRowStream(Color* dst, size_t count, uint32_t value) {
+                size_t i = 0;
+                // 逐像素写到 32 字节边界
+                for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 31) != 0; ++i) dst[i].data = value;
+                const __m256i color_vec = _mm256_set1_epi32(static_cast<int>(value));
+                for (; i + 8 <= count; i += 8) {
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), color_vec);
+                }
+                for (; i < count; ++i) dst[i].data = value;
+            }
+
+            void copyRowStream(Color* dst, const Color* src, size_t count) {
+                size_t i = 0;
+                for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 31) != 0; ++i) dst[i] = src[i];
+                for (; i + 32 <= count; i += 32) {
+                    __m256i data1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                    __m256i data2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 8));
+                    __m256i data3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+                    __m256i data4 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 24));
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), data1);
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 8), data2);
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 16), data3);
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 24), data4);
+                }
+                for (; i + 8 <= count; i += 8) {
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+                }
+                for (; i < count; ++i) dst[i] = src[i];
+            }
+
+            // Alpha透明度混合
+            void alphaBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity) {
+                const __m256i global_opacity_vec = _mm256_set1_epi32(opacity);
+
+                size_t x = 0;
+
+                // AVX2优化（8像素并行）
+                const size_t simd_count8 = rowWidth & ~7;
+                if (simd_count8 > 0) {
+                    const __m256i mask_ff = _mm256_set1_epi32(0xFF);
+                    const __m256i const_255 = _mm256_set1_epi32(255);
+                    const __m256i zero = _mm256_setzero_si256();
+
+                    for (; x < simd_count8; x += 8) {
+                        // 预取下一缓存行
+                        _mm_prefetch((const char*)(srcRow + x + 16), _MM_HINT_T0);
+                        _mm_prefetch((const char*)(destRow + x + 16), _MM_HINT_T0);
+
+                        __m256i src_vec = _mm256_loadu_si256((const __m256i*)(srcRow + x));
+                        __m256i dst_vec = _mm256_loadu_si256((const __m256i*)(destRow + x));
+
+                        // 解包RGBA通道
+                        __m256i src_a = _mm256_srli_epi32(src_vec, 24);
+                        __m256i src_r = _mm256_and_si256(_mm256_srli_epi32(src_vec, 16), mask_ff);
+                        __m256i src_g = _mm256_and_si256(_mm256_srli_epi32(src_vec, 8), mask_ff);
+                        __m256i src_b = _mm256_and_si256(src_vec, mask_ff);
+
+                        __m256i dst_a = _mm256_srli_epi32(dst_vec, 24);
+                        __m256i dst_r = _mm256_and_si256(_mm256_srli_epi32(dst_vec, 16), mask_ff);
+                        __m256i dst_g = _mm256_and_si256(_mm256_srli_epi32(dst_vec, 8), mask_ff);
+                        __m256i dst_b = _mm256_and_si256(dst_vec, mask_ff);
+
+                        // 计算有效alpha并快速检查
+                        __m256i effective_a = _mm256_srli_epi32(_mm256_mullo_epi32(src_a, global_opacity_vec), 8);
+                        if (_mm256_testz_si256(effective_a, effective_a)) {
+                            continue; // 所有像素都透明，跳过
+                        }
+
+                        // 混合计算
+                        __m256i inv_alpha = _mm256_sub_epi32(const_255, effective_a);
+
+                        __m256i blended_r = _mm256_srli_epi32(_mm256_add_epi32(
+                            _mm256_mullo_epi32(src_r, effective_a),
+                            _mm256_mullo_epi32(dst_r, inv_alpha)), 8);
+
+                        __m256i blended_g = _mm256_srli_epi32(_mm256_add_epi32(
+                            _mm256_mullo_epi32(src_g, effective_a),
+                            _mm256_mullo_epi32(dst_g, inv_alpha)), 8);
+
+                        __m256i blended_b = _mm256_srli_epi32(_mm256_add_epi32(
+                            _mm256_mullo_epi32(src_b, effective_a),
+                            _mm256_mullo_epi32(dst_b, inv_alpha)), 8);
+
+                        __m256i blended_a = _mm256_add_epi32(effective_a,
+                            _mm256_srli_epi32(_mm256_mullo_epi32(dst_a, inv_alpha), 8));
+
+                        // 饱和运算确保范围
+                        blended_r = _mm256_min_epu8(blended_r, const_255);
+                        blended_g = _mm256_min_epu8(blended_g, const_255);
+                        blended_b = _mm256_min_epu8(blended_b, const_255);
+                        blended_a = _mm256_min_epu8(blended_a, const_255);
+
+                        // 打包结果
+                        __m256i result = _mm256_or_si256(
+                            _mm256_slli_epi32(blended_r, 16),
+                            _mm256_slli_epi32(blended_g, 8));
+                        result = _mm256_or_si256(result, blended_b);
+                        result = _mm256_or_si256(result, _mm256_slli_epi32(blended_a, 24));
+
+                        _mm256_storeu_si256((__m256i*)(destRow + x), result);
+                    }
+                }
+
+                // 剩余不足 8 像素交给 SSE4.1 版本
+                if (x < static_cast<size_t>(rowWidth)) {
+                    sse41::alphaBlendRow(destRow + x, srcRow + x, rowWidth - static_cast<int>(x), opacity);
+                }
+            }
+
+            // 16 位通道的 x / 255 四舍五入（x <= 255 * 255）：((x + 128) * 257) >> 16
+            static inline __m256i div255_epu16(__m256i x) {
+                return _mm256_mulhi_epu16(_mm256_add_epi16(x, _mm256_set1_epi16(128)), _mm256_set1_epi16(257));
+            }
+
+            void premultipliedBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity) {
+                if (opacity > 255) opacity = 255;
+                const bool full = opacity == 255;
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+                const __m256i const_255 = _mm256_set1_epi16(255);
+                const __m256i opacity_vec = _mm256_set1_epi16(static_cast<short>(opacity));
+
+                int x = 0;
+                for (; x + 8 <= rowWidth; x += 8) {
+                    __m256i src_vec = _mm256_loadu_si256((const __m256i*)(srcRow + x));
+                    __m256i src_a = _mm256_and_si256(src_vec, alpha_mask);
+                    if (_mm256_testz_si256(src_a, src_a)) continue; // 源全透明
+                    if (full && _mm256_movemask_epi8(_mm256_cmpeq_epi32(src_a, alpha_mask)) == -1) {
+                        _mm256_storeu_si256((__m256i*)(destRow + x), src_vec); // 源全不透明
+                        continue;
+                    }
+                    __m256i dst_vec = _mm256_loadu_si256((const __m256i*)(destRow + x));
+
+                    __m256i src_lo = _mm256_unpacklo_epi8(src_vec, zero);
+                    __m256i src_hi = _mm256_unpackhi_epi8(src_vec, zero);
+                    if (!full) {
+                        src_lo = div255_epu16(_mm256_mullo_epi16(src_lo, opacity_vec));
+                        src_hi = div255_epu16(_mm256_mullo_epi16(src_hi, opacity_vec));
+                    }
+                    __m256i inv_lo = _mm256_sub_epi16(const_255, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_lo, 0xFF), 0xFF));
+                    __m256i inv_hi = _mm256_sub_epi16(const_255, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_hi, 0xFF), 0xFF));
+
+                    __m256i out_lo = _mm256_add_epi16(src_lo, div255_epu16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(dst_vec, zero), inv_lo)));
+                    __m256i out_hi = _mm256_add_epi16(src_hi, div255_epu16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(dst_vec, zero), inv_hi)));
+                    _mm256_storeu_si256((__m256i*)(destRow + x), _mm256_packus_epi16(out_lo, out_hi));
+                }
+
+                // 剩余不足 8 像素交给 SSE4.1 版本
+                if (x < rowWidth) {
+                    sse41::premultipliedBlendRow(destRow + x, srcRow + x, rowWidth - x, opacity);
+                }
+            }
+
+            void premultiplyRow(Color* row, size_t count) {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+                // alpha 通道自身乘以 255，保持不变
+                const __m256i alpha_lane = _mm256_set1_epi64x(0x00FF000000000000LL);
+
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i v = _mm256_loadu_si256((const __m256i*)(row + i));
+                    if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(v, alpha_mask), alpha_mask)) == -1) continue;
+                    __m256i lo = _mm256_unpacklo_epi8(v, zero);
+                    __m256i hi = _mm256_unpackhi_epi8(v, zero);
+                    __m256i alpha_lo = _mm256_or_si256(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xFF), 0xFF), alpha_lane);
+                    __m256i alpha_hi = _mm256_or_si256(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xFF), 0xFF), alpha_lane);
+                    lo = div255_epu16(_mm256_mullo_epi16(lo, alpha_lo));
+                    hi = div255_epu16(_mm256_mullo_epi16(hi, alpha_hi));
+                    _mm256_storeu_si256((__m256i*)(row + i), _mm256_packus_epi16(lo, hi));
+                }
+                if (i < count) sse41::premultiplyRow(row + i, count - i);
+            }
+
+            void unpremultiplyRow(Color* row, size_t count) {
+                const __m256i mask_ff = _mm256_set1_epi32(0xFF);
+                const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+                const __m256 v_zero = _mm256_setzero_ps();
+                const __m256 v_one = _mm256_set1_ps(1.0f);
+                const __m256 v_255 = _mm256_set1_ps(255.0f);
+                // 与标量 (c * 255 + a / 2) / a 一致：倒数乘法的误差远小于 1/512，而商的小数部分不超过 254/255
+                const __m256 v_bias = _mm256_set1_ps(1.0f / 512.0f);
+
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i v = _mm256_loadu_si256((const __m256i*)(row + i));
+                    if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(v, alpha_mask), alpha_mask)) == -1) continue;
+                    __m256i a_i = _mm256_srli_epi32(v, 24);
+                    __m256 fa = _mm256_cvtepi32_ps(a_i);
+                    __m256 half = _mm256_cvtepi32_ps(_mm256_srli_epi32(a_i, 1));
+                    __m256 rcp = _mm256_and_ps(_mm256_div_ps(v_one, fa), _mm256_cmp_ps(fa, v_zero, _CMP_GT_OQ)); // A 为 0 时 RGB 置 0
+                    auto channel = [&](__m256i c) {
+                        __m256 num = _mm256_fmadd_ps(_mm256_cvtepi32_ps(c), v_255, half);
+                        return _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_fmadd_ps(num, rcp, v_bias)), mask_ff);
+                    };
+                    __m256i r = channel(_mm256_and_si256(_mm256_srli_epi32(v, 16), mask_ff));
+                    __m256i g = channel(_mm256_and_si256(_mm256_srli_epi32(v, 8), mask_ff));
+                    __m256i b = channel(_mm256_and_si256(v, mask_ff));
+                    __m256i result = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(a_i, 24), _mm256_slli_epi32(r, 16)),
+                        _mm256_or_si256(_mm256_slli_epi32(g, 8), b));
+                    _mm256_storeu_si256((__m256i*)(row + i), result);
+                }
+                if (i < count) sse41::unpremultiplyRow(row + i, count - i);
+            }
+
+            void blendModeRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity,
+                              BlendMode mode, bool srcPremultiplied, bool dstPremultiplied) {
+                if (rowWidth <= 0) return;
+                const size_t count = static_cast<size_t>(rowWidth);
+                const size_t x = blendModeRows<BlendLanes8>(mode, destRow, srcRow, count, opacity * (1.0f / 255.0f), srcPremultiplied, dstPremultiplied);
+
+                // 剩余不足 8 像素交给 SSE4.1 版本
+                if (x < count) {
+                    sse41::blendModeRow(destRow + x, srcRow + x, rowWidth - static_cast<int>(x), opacity, mode, srcPremultiplied, dstPremultiplied);
+                }
+            }
+
+            // 一行 2:1 盒式滤波：row0/row1 为参与平均的两行（只减半宽度时为同一行），输出 outWidth 个像素
+            // 每个输出像素为对应 2x2（或 2x1、1x2）源像素各通道的四舍五入均值，末列为奇数时与自身平均；顺序读取，没有 gather
+            void halveRow(const Color* row0, const Color* row1, Color* out, int srcWidth, int outWidth, bool halveX) {
+                // 可整组处理的输出列数：两个源像素都在行内的列
+                const int vecWidth = halveX ? srcWidth / 2 : srcWidth;
+                int x = 0;
+                if (halveX) {
+                    const __m256i v_zero = _mm256_setzero_si256();
+                    const __m256i v_two = _mm256_set1_epi16(2);
+                    // 每次读取两行各 16 个源像素，输出 8 个像素
+                    for (; x + 8 <= vecWidth; x += 8) {
+                        const __m256 a0 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + 2 * x)));
+                        const __m256 a1 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + 2 * x + 8)));
+                        const __m256 b0 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + 2 * x)));
+                        const __m256 b1 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + 2 * x + 8)));
+
+                        // 分离偶数列与奇数列，每个 128 位通道内依次为输出像素 0,1,4,5 / 2,3,6,7
+                        const __m256i e0 = _mm256_castps_si256(_mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(2, 0, 2, 0)));
+                        const __m256i o0 = _mm256_castps_si256(_mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(3, 1, 3, 1)));
+                        const __m256i e1 = _mm256_castps_si256(_mm256_shuffle_ps(b0, b1, _MM_SHUFFLE(2, 0, 2, 0)));
+                        const __m256i o1 = _mm256_castps_si256(_mm256_shuffle_ps(b0, b1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                        // 扩展到 16 位求四个源像素之和，(sum + 2) >> 2 四舍五入
+                        __m256i lo = _mm256_add_epi16(
+                            _mm256_add_epi16(_mm256_unpacklo_epi8(e0, v_zero), _mm256_unpacklo_epi8(o0, v_zero)),
+                            _mm256_add_epi16(_mm256_unpacklo_epi8(e1, v_zero), _mm256_unpacklo_epi8(o1, v_zero)));
+                        __m256i hi = _mm256_add_epi16(
+                            _mm256_add_epi16(_mm256_unpackhi_epi8(e0, v_zero), _mm256_unpackhi_epi8(o0, v_zero)),
+                            _mm256_add_epi16(_mm256_unpackhi_epi8(e1, v_zero), _mm256_unpackhi_epi8(o1, v_zero)));
+                        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, v_two), 2);
+                        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, v_two), 2);
+
+                        // 恢复输出顺序 0..7
+                        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), packed);
+                    }
+                }
+                else {
+                    // 只减半高度：两行逐字节取平均，(a + b + 1) >> 1
+                    for (; x + 8 <= vecWidth; x += 8) {
+                        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + x));
+                        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + x));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), _mm256_avg_epu8(a, b));
+                    }
+                }
+
+                // 剩余列（含奇数宽度的末列）交给 SSE4.1 版本
+                if (x < outWidth) {
+                    const int offset = halveX ? 2 * x : x;
+                    sse41::halveRow(row0 + offset, row1 + offset, out + x, srcWidth - offset, outWidth - x, halveX);
+                }
+            }
+
+            // 两个相邻 16 位权重拼成 _mm_madd_epi16 所需的 32 位
+            static inline int weightPair(const int16_t* coeffs) {
+                return static_cast<int>(static_cast<uint16_t>(coeffs[0]) | (static_cast<uint32_t>(static_cast<uint16_t>(coeffs[1])) << 16));
+            }
+
+            // 横向一遍：每个输出像素从 start 起连续读取 taps 个源像素
+            void resampleRow(const Color* src, int srcWidth, Color* out, int outWidth,
+                const int* start, const int16_t* coeffs, int taps) {
+                // 每个像素的 4 个 16 位通道按 (p0, p1) 交错，使 madd 一次完成两个源像素的乘加
+                const __m256i v_interleave = _mm256_setr_epi8(
+                    0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+                    0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+                // 4 个 16 位权重 (w0, w1, w2, w3) 展开为低 128 位 4 x (w0, w1)、高 128 位 4 x (w2, w3)
+                const __m256i v_pairIndex = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+                const __m256i v_round = _mm256_set1_epi32(1 << (RESAMPLE_WEIGHT_BITS - 1));
+                // 打包后 4 个输出依次位于第 0、4、1、5 个 32 位元素
+                const __m256i v_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+                // 单个输出像素的乘加，两个 128 位半部之和为 4 个通道的 32 位结果
+                auto accumulate = [&](int x) {
+                    const Color* p = src + start[x];
+                    const int16_t* c = coeffs + static_cast<size_t>(x) * taps;
+                    __m256i acc = _mm256_setzero_si256();
+                    for (int k = 0; k < taps; k += 4) {
+                        __m256i px = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k)));
+                        px = _mm256_shuffle_epi8(px, v_interleave);
+                        const __m256i w = _mm256_permutevar8x32_epi32(
+                            _mm256_castsi128_si256(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(c + k))), v_pairIndex);
+                        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(px, w));
+                    }
+                    return acc;
+                };
+
+                int x = 0;
+                // 权重表保证 start + taps 不越过行尾；源行比 taps 还短时全部走标量
+                if (taps <= srcWidth) {
+                    // 每次 4 个输出，合并两半、舍入与打包一起完成
+                    for (; x + 4 <= outWidth; x += 4) {
+                        const __m256i a0 = accumulate(x), a1 = accumulate(x + 1);
+                        const __m256i a2 = accumulate(x + 2), a3 = accumulate(x + 3);
+                        __m256i s01 = _mm256_add_epi32(_mm256_permute2x128_si256(a0, a1, 0x20), _mm256_permute2x128_si256(a0, a1, 0x31));
+                        __m256i s23 = _mm256_add_epi32(_mm256_permute2x128_si256(a2, a3, 0x20), _mm256_permute2x128_si256(a2, a3, 0x31));
+                        s01 = _mm256_srai_epi32(_mm256_add_epi32(s01, v_round), RESAMPLE_WEIGHT_BITS);
+                        s23 = _mm256_srai_epi32(_mm256_add_epi32(s23, v_round), RESAMPLE_WEIGHT_BITS);
+                        __m256i packed = _mm256_packs_epi32(s01, s23);
+                        packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(packed, packed), v_order);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm256_castsi256_si128(packed));
+                    }
+                }
+
+                // 剩余不足 4 个输出（或源行过短）交给 SSE4.1 版本，start 为源行内的绝对位置
+                if (x < outWidth) {
+                    sse41::resampleRow(src, srcWidth, out + x, outWidth - x, start + x, coeffs + static_cast<size_t>(x) * taps, taps);
+                }
+            }
+
+            // 最近邻一行：index 单调不减；8 个输出取自同一组 8 个连续源像素时（放大）用一次读取 + 置换
+            void nearestRow(const Color* src, int srcWidth, Color* out, int outWidth, const int* index) {
+                int x = 0;
+                for (; x + 8 <= outWidth; x += 8) {
+                    const int base = index[x];
+                    if (index[x + 7] - base < 8 && base + 8 <= srcWidth) {
+                        const __m256i v_rel = _mm256_sub_epi32(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + x)), _mm256_set1_epi32(base));
+                        const __m256i v_src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + base));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), _mm256_permutevar8x32_epi32(v_src, v_rel));
+                    }
+                    else {
+                        for (int i = 0; i < 8; ++i) out[x + i] = src[index[x + i]];
+                    }
+                }
+                for (; x < outWidth; ++x) out[x] = src[index[x]];
+            }
+
+            // 纵向一遍：taps 行按列同时累加，每次 8 个像素，两行一组做 madd
+            void resampleColumns(const Color* const* rows, const int16_t* coeffs, int taps, Color* out, int begin, int end) {
+                const __m256i v_zero = _mm256_setzero_si256();
+                const __m256i v_round = _mm256_set1_epi32(1 << (RESAMPLE_WEIGHT_BITS - 1));
+                int x = begin;
+                for (; x + 8 <= end; x += 8) {
+                    // acc0..3 依次为每个 128 位通道内的第 0..3 个像素
+                    __m256i acc0 = _mm256_setzero_si256(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+                    for (int k = 0; k < taps; k += 2) {
+                        const __m256i w = _mm256_set1_epi32(weightPair(coeffs + k));
+                        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k] + x));
+                        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k + 1] + x));
+                        const __m256i lo = _mm256_unpacklo_epi8(a, b);
+                        const __m256i hi = _mm256_unpackhi_epi8(a, b);
+                        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, v_zero), w));
+                        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, v_zero), w));
+                        acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, v_zero), w));
+                        acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, v_zero), w));
+                    }
+                    acc0 = _mm256_srai_epi32(_mm256_add_epi32(acc0, v_round), RESAMPLE_WEIGHT_BITS);
+                    acc1 = _mm256_srai_epi32(_mm256_add_epi32(acc1, v_round), RESAMPLE_WEIGHT_BITS);
+                    acc2 = _mm256_srai_epi32(_mm256_add_epi32(acc2, v_round), RESAMPLE_WEIGHT_BITS);
+                    acc3 = _mm256_srai_epi32(_mm256_add_epi32(acc3, v_round), RESAMPLE_WEIGHT_BITS);
+                    // 负瓣产生的越界值在两次饱和打包中截断到 0..255
+                    const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(acc0, acc1), _mm256_packs_epi32(acc2, acc3));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), packed);
+                }
+                if (x < end) sse41::resampleColumns(rows, coeffs, taps, out, x, end);
+            }
+
+            const KernelTable table = {
+                fillRow, copyRow,
+                fillRowAligned, copyRowAligned,
+                fillRowStream, copyRowStream,
+                alphaBlendRow, premultipliedBlendRow,
+                premultiplyRow, unpremultiplyRow,
+                blendModeRow,
+                halveRow, resampleRow, nearestRow, resampleColumns,
+                line, polyline, polygon, triangle,
+                rect, rect, roundRect, roundRect,
+                circle, ellipse, ellipse, sector,
+                resizedBilinear, rotated,
+                drawScaled, drawResized, drawRotated,
+                drawTransformed, drawTransformed,
+                spriteInstance
+            };
+        }
+    }
+}
\ No newline at end of file
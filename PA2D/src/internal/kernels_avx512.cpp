@@ -0,0 +1,365 @@
+// kernels_avx512.cpp
+// AVX-512 版本（需要 AVX512F + AVX512BW）：16像素并行，尾部交给 AVX2 版本
+#define PA2D_ISA avx512
+#define PA2D_AVX2
+#include "kernel_prelude.h"
+#include "kernels.h"
+#include "blend_modes.h"
+#include <immintrin.h>
+#include <cstdint>
+
+namespace pa2d {
+    namespace utils {
+        namespace avx512 {
+            void fillRow(Color* dst, size_t count, uint32_t value) {
+                const __m512i color_vec = _mm512_set1_epi32(static_cast<int>(value));
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    _mm512_storeu_si512(dst + i, color_vec);
+                }
+                if (i < count) avx2::fillRow(dst + i, count - i, value);
+            }
+
+            void copyRow(Color* dst, const Color* src, size_t count) {
+                size_t i = 0;
+                // 64像素/次，循环展开
+                for (; i + 64 <= count; i += 64) {
+                    __m512i data1 = _mm512_loadu_si512(src + i);
+                    __m512i data2 = _mm512_loadu_si512(src + i + 16);
+                    __m512i data3 = _mm512_loadu_si512(src + i + 32);
+                    __m512i data4 = _mm512_loadu_si512(src + i + 48);
+                    _mm512_storeu_si512(dst + i, data1);
+                    _mm512_storeu_si512(dst + i + 16, data2);
+                    _mm512_storeu_si512(dst + i + 32, data3);
+                    _mm512_storeu_si512(dst + i + 48, data4);
+                }
+                for (; i + 16 <= count; i += 16) {
+                    _mm512_storeu_si512(dst + i, _mm512_loadu_si512(src + i));
+                }
+                if (i < count) avx2::copyRow(dst + i, src + i, count - i);
+            }
+
+            // 只保证 32 字节对齐：先用一次 AVX2 写对齐到 64 字节，剩余不足 16 像素时同样交给 AVX2
+            void fillRowAligned(Color* dst, size_t count, uint32_t value) {
+                size_t i = 0;
+                if (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 63) != 0) {
+                    avx2::fillRowAligned(dst, 8, value);
+                    i = 8;
+                }
+                const __m512i color_vec = _mm512_set1_epi32(static_cast<int>(value));
+                for (; i + 16 <= count; i += 16) {
+                    _mm512_store_si512(dst + i, color_vec);
+                }
+                if (i < count) avx2::fillRowAligned(dst + i, count - i, value);
+            }
+
+            // 源与目标相对 64 字节的偏移不同时，整行交给 AVX2 版本
+            void copyRowAligned(Color* dst, const Color* src, size_t count) {
+                if (((reinterpret_cast<uintptr_t>(dst) ^ reinterpret_cast<uintptr_t>(src)) & 63) != 0) {
+                    avx2::copyRowAligned(dst, src, count);
+                    return;
+                }
+                size_t i = 0;
+                if (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 63) != 0) {
+                    avx2::copyRowAligned(dst, src, 8);
+                    i = 8;
+                }
+                for (; i + 64 <= count; i += 64) {
+                    __m512i data1 = _mm512_load_si512(src + i);
+                    __m512i data2 = _mm512_load_si512(src + i + 16);
+                    __m512i data3 = _mm512_load_si512(src + i + 32);
+                    __m512i data4 = _mm512_load_si512(src + i + 48);
+                    _mm512_store_si512(dst + i, data1);
+                    _mm512_store_si512(dst + i + 16, data2);
+                    _mm512_store_si512(dst + i + 32, data3);
+                    _mm512_store_si512(dst + i + 48, data4);
+                }
+                for (; i + 16 <= count; i += 16) {
+                    _mm512_store_si512(dst + i, _mm512_load_si512(src + i));
+                }
+                if (i < count) avx2::copyRowAligned(dst + i, src + i, count - i);
+            }
+
+            void fillRowStream(Color* dst, size_t count, uint32_t value) {
+                size_t i = 0;
+                // 逐像素写到 64 字节边界
+                for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 63) != 0; ++i) dst[i].data = value;
+                const __m512i color_vec = _mm512_set1_epi32(static_cast<int>(value));
+                for (; i + 16 <= count; i += 16) {
+                    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), color_vec);
+                }
+                for (; i < count; ++i) dst[i].data = value;
+            }
+
+            void copyRowStream(Color* dst, const Color* src, size_t count) {
+                size_t i = 0;
+                for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 63) != 0; ++i) dst[i] = src[i];
+                for (; i + 64 <= count; i += 64) {
+                    __m512i data1 = _mm512_loadu_si512(src + i);
+                    __m512i data2 = _mm512_loadu_si512(src + i + 16);
+                    __m512i data3 = _mm512_loadu_si512(src + i + 32);
+                    __m512i data4 = _mm512_loadu_si512(src + i + 48);
+                    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), data1);
+                    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 16), data2);
+                    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 32), data3);
+                    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 48), data4);
+                }
+                for (; i + 16 <= count; i += 16) {
+                    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), _mm512_loadu_si512(src + i));
+                }
+                for (; i < count; ++i) dst[i] = src[i];
+            }
+
+            // Alpha透明度混合
+            void alphaBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity) {
+                const __m512i global_opacity_vec = _mm512_set1_epi32(opacity);
+
+                size_t x = 0;
+
+                // AVX-512 优化（16像素并行）
+                const size_t simd_count16 = rowWidth & ~15;
+                if (simd_count16 > 0) {
+                    const __m512i mask_ff = _mm512_set1_epi32(0xFF);
+                    const __m512i const_255 = _mm512_set1_epi32(255);
+                    const __m512i zero = _mm512_setzero_si512();
+
+                    for (; x < simd_count16; x += 16) {
+                        // 预取下一缓存行
+                        _mm_prefetch((const char*)(srcRow + x + 32), _MM_HINT_T0);
+                        _mm_prefetch((const char*)(destRow + x + 32), _MM_HINT_T0);
+
+                        __m512i src_vec = _mm512_loadu_si512((const void*)(srcRow + x));
+                        __m512i dst_vec = _mm512_loadu_si512((const void*)(destRow + x));
+
+                        // 解包RGBA通道
+                        __m512i src_a = _mm512_srli_epi32(src_vec, 24);
+                        __m512i src_r = _mm512_and_si512(_mm512_srli_epi32(src_vec, 16), mask_ff);
+                        __m512i src_g = _mm512_and_si512(_mm512_srli_epi32(src_vec, 8), mask_ff);
+                        __m512i src_b = _mm512_and_si512(src_vec, mask_ff);
+
+                        __m512i dst_a = _mm512_srli_epi32(dst_vec, 24);
+                        __m512i dst_r = _mm512_and_si512(_mm512_srli_epi32(dst_vec, 16), mask_ff);
+                        __m512i dst_g = _mm512_and_si512(_mm512_srli_epi32(dst_vec, 8), mask_ff);
+                        __m512i dst_b = _mm512_and_si512(dst_vec, mask_ff);
+
+                        // 计算有效alpha并快速检查
+                        __m512i effective_a = _mm512_srli_epi32(_mm512_mullo_epi32(src_a, global_opacity_vec), 8);
+                        if (_mm512_test_epi32_mask(effective_a, effective_a) == 0) {
+                            continue; // 所有像素都透明，跳过
+                        }
+
+                        // 混合计算
+                        __m512i inv_alpha = _mm512_sub_epi32(const_255, effective_a);
+
+                        __m512i blended_r = _mm512_srli_epi32(_mm512_add_epi32(
+                            _mm512_mullo_epi32(src_r, effective_a),
+                            _mm512_mullo_epi32(dst_r, inv_alpha)), 8);
+
+                        __m512i blended_g = _mm512_srli_epi32(_mm512_add_epi32(
+                            _mm512_mullo_epi32(src_g, effective_a),
+                            _mm512_mullo_epi32(dst_g, inv_alpha)), 8);
+
+                        __m512i blended_b = _mm512_srli_epi32(_mm512_add_epi32(
+                            _mm512_mullo_epi32(src_b, effective_a),
+                            _mm512_mullo_epi32(dst_b, inv_alpha)), 8);
+
+                        __m512i blended_a = _mm512_add_epi32(effective_a,
+                            _mm512_srli_epi32(_mm512_mullo_epi32(dst_a, inv_alpha), 8));
+
+                        // 饱和运算确保范围
+                        blended_r = _mm512_min_epu8(blended_r, const_255);
+                        blended_g = _mm512_min_epu8(blended_g, const_255);
+                        blended_b = _mm512_min_epu8(blended_b, const_255);
+                        blended_a = _mm512_min_epu8(blended_a, const_255);
+
+                        // 打包结果
+                        __m512i result = _mm512_or_si512(
+                            _mm512_slli_epi32(blended_r, 16),
+                            _mm512_slli_epi32(blended_g, 8));
+                        result = _mm512_or_si512(result, blended_b);
+                        result = _mm512_or_si512(result, _mm512_slli_epi32(blended_a, 24));
+
+                        _mm512_storeu_si512((void*)(destRow + x), result);
+                    }
+                }
+
+                // 剩余不足 16 像素交给 AVX2 版本
+                if (x < static_cast<size_t>(rowWidth)) {
+                    avx2::alphaBlendRow(destRow + x, srcRow + x, rowWidth - static_cast<int>(x), opacity);
+                }
+            }
+
+            // 16 位通道的 x / 255 四舍五入（x <= 255 * 255）：((x + 128) * 257) >> 16
+            static inline __m512i div255_epu16(__m512i x) {
+                return _mm512_mulhi_epu16(_mm512_add_epi16(x, _mm512_set1_epi16(128)), _mm512_set1_epi16(257));
+            }
+
+            void premultipliedBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity) {
+                if (opacity > 255) opacity = 255;
+                const bool full = opacity == 255;
+                const __m512i zero = _mm512_setzero_si512();
+                const __m512i alpha_mask = _mm512_set1_epi32(static_cast<int>(0xFF000000));
+                const __m512i const_255 = _mm512_set1_epi16(255);
+                const __m512i opacity_vec = _mm512_set1_epi16(static_cast<short>(opacity));
+
+                int x = 0;
+                for (; x + 16 <= rowWidth; x += 16) {
+                    __m512i src_vec = _mm512_loadu_si512((const void*)(srcRow + x));
+                    if (_mm512_test_epi32_mask(src_vec, alpha_mask) == 0) continue; // 源全透明
+                    if (full && _mm512_cmpeq_epi32_mask(_mm512_and_si512(src_vec, alpha_mask), alpha_mask) == 0xFFFF) {
+                        _mm512_storeu_si512((void*)(destRow + x), src_vec); // 源全不透明
+                        continue;
+                    }
+                    __m512i dst_vec = _mm512_loadu_si512((const void*)(destRow + x));
+
+                    __m512i src_lo = _mm512_unpacklo_epi8(src_vec, zero);
+                    __m512i src_hi = _mm512_unpackhi_epi8(src_vec, zero);
+                    if (!full) {
+                        src_lo = div255_epu16(_mm512_mullo_epi16(src_lo, opacity_vec));
+                        src_hi = div255_epu16(_mm512_mullo_epi16(src_hi, opacity_vec));
+                    }
+                    __m512i inv_lo = _mm512_sub_epi16(const_255, _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(src_lo, 0xFF), 0xFF));
+                    __m512i inv_hi = _mm512_sub_epi16(const_255, _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(src_hi, 0xFF), 0xFF));
+
+                    __m512i out_lo = _mm512_add_epi16(src_lo, div255_epu16(_mm512_mullo_epi16(_mm512_unpacklo_epi8(dst_vec, zero), inv_lo)));
+                    __m512i out_hi = _mm512_add_epi16(src_hi, div255_epu16(_mm512_mullo_epi16(_mm512_unpackhi_epi8(dst_vec, zero), inv_hi)));
+                    _mm512_storeu_si512((void*)(destRow + x), _mm512_packus_epi16(out_lo, out_hi));
+                }
+
+                // 剩余不足 16 像素交给 AVX2 版本
+                if (x < rowWidth) {
+                    avx2::premultipliedBlendRow(destRow + x, srcRow + x, rowWidth - x, opacity);
+                }
+            }
+
+            void premultiplyRow(Color* row, size_t count) {
+                const __m512i zero = _mm512_setzero_si512();
+                const __m512i alpha_mask = _mm512_set1_epi32(static_cast<int>(0xFF000000));
+                // alpha 通道自身乘以 255，保持不变
+                const __m512i alpha_lane = _mm512_set1_epi64(0x00FF000000000000LL);
+
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    __m512i v = _mm512_loadu_si512((const void*)(row + i));
+                    if (_mm512_cmpeq_epi32_mask(_mm512_and_si512(v, alpha_mask), alpha_mask) == 0xFFFF) continue;
+                    __m512i lo = _mm512_unpacklo_epi8(v, zero);
+                    __m512i hi = _mm512_unpackhi_epi8(v, zero);
+                    __m512i alpha_lo = _mm512_or_si512(_mm512_shufflehi_epi16(_mm512_shufflelo_epi16(lo, 0xFF), 0xFF), alpha_lane);
+                    __m512i alpha_hi = _mm512_or_si512(_mm512_shufflehi_epi16(_mm512_shufflelo_epi16(hi, 0xFF), 0xFF), alpha_lane);
+                    lo = div255_epu16(_mm512_mullo_epi16(lo, alpha_lo));
+                    hi = div255_epu16(_mm512_mullo_epi16(hi, alpha_hi));
+                    _mm512_storeu_si512((void*)(row + i), _mm512_packus_epi16(lo, hi));
+                }
+                if (i < count) avx2::premultiplyRow(row + i, count - i);
+            }
+
+            void unpremultiplyRow(Color* row, size_t count) {
+                const __m512i mask_ff = _mm512_set1_epi32(0xFF);
+                const __m512i alpha_mask = _mm512_set1_epi32(static_cast<int>(0xFF000000));
+                const __m512 v_one = _mm512_set1_ps(1.0f);
+                const __m512 v_255 = _mm512_set1_ps(255.0f);
+                // 与标量 (c * 255 + a / 2) / a 一致：倒数乘法的误差远小于 1/512，而商的小数部分不超过 254/255
+                const __m512 v_bias = _mm512_set1_ps(1.0f / 512.0f);
+
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    __m512i v = _mm512_loadu_si512((const void*)(row + i));
+                    if (_mm512_cmpeq_epi32_mask(_mm512_and_si512(v, alpha_mask), alpha_mask) == 0xFFFF) continue;
+                    __m512i a_i = _mm512_srli_epi32(v, 24);
+                    __m512 half = _mm512_cvtepi32_ps(_mm512_srli_epi32(a_i, 1));
+                    // A 为 0 时 RGB 置 0
+                    __m512 rcp = _mm512_maskz_div_ps(_mm512_test_epi32_mask(a_i, a_i), v_one, _mm512_cvtepi32_ps(a_i));
+                    auto channel = [&](__m512i c) {
+                        __m512 num = _mm512_fmadd_ps(_mm512_cvtepi32_ps(c), v_255, half);
+                        return _mm512_min_epi32(_mm512_cvttps_epi32(_mm512_fmadd_ps(num, rcp, v_bias)), mask_ff);
+                    };
+                    __m512i r = channel(_mm512_and_si512(_mm512_srli_epi32(v, 16), mask_ff));
+                    __m512i g = channel(_mm512_and_si512(_mm512_srli_epi32(v, 8), mask_ff));
+                    __m512i b = channel(_mm512_and_si512(v, mask_ff));
+                    __m512i result = _mm512_or_si512(_mm512_or_si512(_mm512_slli_epi32(a_i, 24), _mm512_slli_epi32(r, 16)),
+                        _mm512_or_si512(_mm512_slli_epi32(g, 8), b));
+                    _mm512_storeu_si512((void*)(row + i), result);
+                }
+                if (i < count) avx2::unpremultiplyRow(row + i, count - i);
+            }
+
+            // 混合引擎的 16 像素向量类型，比较结果为 16 位掩码
+            struct BlendLanes16 {
+                typedef __m512 F;
+                typedef __mmask16 M;
+                typedef __m512i I;
+                static const int width = 16;
+
+                static F set1(float v) { return _mm512_set1_ps(v); }
+                static F add(F a, F b) { return _mm512_add_ps(a, b); }
+                static F sub(F a, F b) { return _mm512_sub_ps(a, b); }
+                static F mul(F a, F b) { return _mm512_mul_ps(a, b); }
+                static F div(F a, F b) { return _mm512_div_ps(a, b); }
+                static F rcp(F a) {
+                    const __m512 r = _mm512_rcp14_ps(a);
+                    return _mm512_mul_ps(r, _mm512_fnmadd_ps(a, r, _mm512_set1_ps(2.0f)));
+                }
+                static F min(F a, F b) { return _mm512_min_ps(a, b); }
+                static F max(F a, F b) { return _mm512_max_ps(a, b); }
+                static F sqrt(F a) { return _mm512_sqrt_ps(a); }
+                static M lt(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+                static M le(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+                static M gt(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+                static F select(M m, F a, F b) { return _mm512_mask_blend_ps(m, b, a); }
+
+                static I load(const Color* p) { return _mm512_loadu_si512(p); }
+                static void store(Color* p, I v) { _mm512_storeu_si512(p, v); }
+                static bool transparent(I v) { return _mm512_test_epi32_mask(v, _mm512_set1_epi32(static_cast<int>(0xFF000000))) == 0; }
+                static bool opaque(I v) {
+                    const __m512i mask = _mm512_set1_epi32(static_cast<int>(0xFF000000));
+                    return _mm512_cmpneq_epi32_mask(_mm512_and_si512(v, mask), mask) == 0;
+                }
+                static void unpack(I v, F& r, F& g, F& b, F& a) {
+                    const __m512i mask = _mm512_set1_epi32(0xFF);
+                    const __m512 k = _mm512_set1_ps(1.0f / 255.0f);
+                    b = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_and_si512(v, mask)), k);
+                    g = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(v, 8), mask)), k);
+                    r = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(v, 16), mask)), k);
+                    a = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(v, 24)), k);
+                }
+                static I pack(F r, F g, F b, F a) {
+                    const __m512 k = _mm512_set1_ps(255.0f);
+                    const __m512i bg = _mm512_packus_epi32(_mm512_cvtps_epi32(_mm512_mul_ps(b, k)), _mm512_cvtps_epi32(_mm512_mul_ps(g, k)));
+                    const __m512i ra = _mm512_packus_epi32(_mm512_cvtps_epi32(_mm512_mul_ps(r, k)), _mm512_cvtps_epi32(_mm512_mul_ps(a, k)));
+                    const __m512i order = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15));
+                    return _mm512_shuffle_epi8(_mm512_packus_epi16(bg, ra), order);
+                }
+            };
+
+            void blendModeRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity,
+                              BlendMode mode, bool srcPremultiplied, bool dstPremultiplied) {
+                if (rowWidth <= 0) return;
+                const size_t count = static_cast<size_t>(rowWidth);
+                const size_t x = blendModeRows<BlendLanes16>(mode, destRow, srcRow, count, opacity * (1.0f / 255.0f), srcPremultiplied, dstPremultiplied);
+
+                // 剩余不足 16 像素交给 AVX2 版本
+                if (x < count) {
+                    avx2::blendModeRow(destRow + x, srcRow + x, rowWidth - static_cast<int>(x), opacity, mode, srcPremultiplied, dstPremultiplied);
+                }
+            }
+
+            // 重采样、光栅化与图像采样没有 16 像素版本，沿用 AVX2 版本
+            const KernelTable table = {
+                fillRow, copyRow,
+                fillRowAligned, copyRowAligned,
+                fillRowStream, copyRowStream,
+                alphaBlendRow, premultipliedBlendRow,
+                premultiplyRow, unpremultiplyRow,
+                blendModeRow,
+                avx2::halveRow, avx2::resampleRow, avx2::nearestRow, avx2::resampleColumns,
+                avx2::line, avx2::polyline, avx2::polygon, avx2::triangle,
+                avx2::rect, avx2::rect, avx2::roundRect, avx2::roundRect,
+                avx2::circle, avx2::ellipse, avx2::ellipse, avx2::sector,
+                avx2::resizedBilinear, avx2::rotated,
+                avx2::drawScaled, avx2::drawResized, avx2::drawRotated,
+                avx2::drawTransformed, avx2::drawTransformed,
+                avx2::spriteInstance
+            };
+        }
+    }
+}
\ No newline at end of file
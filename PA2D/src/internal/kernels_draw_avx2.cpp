@@ -0,0 +1,15 @@
+// kernels_draw_avx2.cpp
+// AVX2 版本：8 像素并行的图形光栅化，由 kernels_avx512.cpp 的内核表共用
+#define PA2D_ISA avx2
+#define PA2D_AVX2
+#include "kernel_prelude.h"
+#include "blend_modes.inl"
+#include "../draw/line.inl"
+#include "../draw/polyline.inl"
+#include "../draw/polygon.inl"
+#include "../draw/triangle.inl"
+#include "../draw/rect.inl"
+#include "../draw/roundRect.inl"
+#include "../draw/circle.inl"
+#include "../draw/ellipse.inl"
+#include "../draw/sector.inl"
@@ -0,0 +1,13 @@
+// kernels_draw_sse41.cpp
+// SSE4.1 版本：4 像素并行的图形光栅化
+#define PA2D_ISA sse41
+#include "blend_modes.inl"
+#include "../draw/line.inl"
+#include "../draw/polyline.inl"
+#include "../draw/polygon.inl"
+#include "../draw/triangle.inl"
+#include "../draw/rect.inl"
+#include "../draw/roundRect.inl"
+#include "../draw/circle.inl"
+#include "../draw/ellipse.inl"
+#include "../draw/sector.inl"
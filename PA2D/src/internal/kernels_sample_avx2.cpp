@@ -0,0 +1,7 @@
+// kernels_sample_avx2.cpp
+// AVX2 版本：8 像素并行的双线性缩放、旋转与精灵采样，由 kernels_avx512.cpp 的内核表共用
+#define PA2D_ISA avx2
+#define PA2D_AVX2
+#include "internal/kernel_prelude.h"
+#include "../buffer_sampling.inl"
+#include "../sprite_batch.inl"
@@ -0,0 +1,5 @@
+// kernels_sample_sse41.cpp
+// SSE4.1 版本：4 像素并行的双线性缩放、旋转与精灵采样
+#define PA2D_ISA sse41
+#include "../buffer_sampling.inl"
+#include "../sprite_batch.inl"
@@ -0,0 +1,514 @@
+// kernels_sse41.cpp
+// SSE4.1 版本：最低等级，同时负责所有宽版本剩余的尾部像素
+#define PA2D_ISA sse41
+#include "kernels.h"
+#include "blend_modes.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cstdint>
+
+namespace pa2d {
+    namespace utils {
+        namespace sse41 {
+            void fillRow(Color* dst, size_t count, uint32_t value) {
+                const __m128i color_vec = _mm_set1_epi32(static_cast<int>(value));
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), color_vec);
+                }
+                for (; i < count; ++i) dst[i].data = value;
+            }
+
+            void copyRow(Color* dst, const Color* src, size_t count) {
+                size_t i = 0;
+                // 16像素/次，循环展开
+                for (; i + 16 <= count; i += 16) {
+                    __m128i data1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                    __m128i data2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+                    __m128i data3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+                    __m128i data4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), data1);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), data2);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), data3);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 12), data4);
+                }
+                for (; i + 4 <= count; i += 4) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+                }
+                for (; i < count; ++i) dst[i] = src[i];
+            }
+
+            void fillRowAligned(Color* dst, size_t count, uint32_t value) {
+                const __m128i color_vec = _mm_set1_epi32(static_cast<int>(value));
+                for (size_t i = 0; i < count; i += 8) {
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), color_vec);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst + i + 4), color_vec);
+                }
+            }
+
+            void copyRowAligned(Color* dst, const Color* src, size_t count) {
+                for (size_t i = 0; i < count; i += 8) {
+                    __m128i data1 = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+                    __m128i data2 = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), data1);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst + i + 4), data2);
+                }
+            }
+
+            void fillRowStream(Color* dst, size_t count, uint32_t value) {
+                size_t i = 0;
+                // 逐像素写到 16 字节边界
+                for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 15) != 0; ++i) dst[i].data = value;
+                const __m128i color_vec = _mm_set1_epi32(static_cast<int>(value));
+                for (; i + 4 <= count; i += 4) {
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), color_vec);
+                }
+                for (; i < count; ++i) dst[i].data = value;
+            }
+
+            void copyRowStream(Color* dst, const Color* src, size_t count) {
+                size_t i = 0;
+                for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 15) != 0; ++i) dst[i] = src[i];
+                for (; i + 16 <= count; i += 16) {
+                    __m128i data1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                    __m128i data2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+                    __m128i data3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+                    __m128i data4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), data1);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 4), data2);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 8), data3);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 12), data4);
+                }
+                for (; i + 4 <= count; i += 4) {
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+                }
+                for (; i < count; ++i) dst[i] = src[i];
+            }
+
+            // Alpha透明度混合
+            void alphaBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity) {
+                const __m128i global_opacity_vec_sse = _mm_set1_epi32(opacity);
+
+                size_t x = 0;
+
+                // SSE4优化（4像素并行）
+                const size_t simd_count4 = rowWidth & ~3;
+                if (simd_count4 > x) {
+                    const __m128i mask_ff = _mm_set1_epi32(0xFF);
+                    const __m128i const_255 = _mm_set1_epi32(255);
+                    const __m128i zero = _mm_setzero_si128();
+
+                    for (; x < simd_count4; x += 4) {
+                        __m128i src_vec = _mm_loadu_si128((const __m128i*)(srcRow + x));
+                        __m128i dst_vec = _mm_loadu_si128((const __m128i*)(destRow + x));
+
+                        // 解包RGBA通道
+                        __m128i src_a = _mm_srli_epi32(src_vec, 24);
+                        __m128i src_r = _mm_and_si128(_mm_srli_epi32(src_vec, 16), mask_ff);
+                        __m128i src_g = _mm_and_si128(_mm_srli_epi32(src_vec, 8), mask_ff);
+                        __m128i src_b = _mm_and_si128(src_vec, mask_ff);
+
+                        __m128i dst_a = _mm_srli_epi32(dst_vec, 24);
+                        __m128i dst_r = _mm_and_si128(_mm_srli_epi32(dst_vec, 16), mask_ff);
+                        __m128i dst_g = _mm_and_si128(_mm_srli_epi32(dst_vec, 8), mask_ff);
+                        __m128i dst_b = _mm_and_si128(dst_vec, mask_ff);
+
+                        // 计算有效alpha
+                        __m128i effective_a = _mm_srli_epi32(_mm_mullo_epi32(src_a, global_opacity_vec_sse), 8);
+                        if (_mm_test_all_zeros(effective_a, effective_a)) {
+                            continue;
+                        }
+
+                        // 混合计算
+                        __m128i inv_alpha = _mm_sub_epi32(const_255, effective_a);
+
+                        __m128i blended_r = _mm_srli_epi32(_mm_add_epi32(
+                            _mm_mullo_epi32(src_r, effective_a),
+                            _mm_mullo_epi32(dst_r, inv_alpha)), 8);
+
+                        __m128i blended_g = _mm_srli_epi32(_mm_add_epi32(
+                            _mm_mullo_epi32(src_g, effective_a),
+                            _mm_mullo_epi32(dst_g, inv_alpha)), 8);
+
+                        __m128i blended_b = _mm_srli_epi32(_mm_add_epi32(
+                            _mm_mullo_epi32(src_b, effective_a),
+                            _mm_mullo_epi32(dst_b, inv_alpha)), 8);
+
+                        __m128i blended_a = _mm_add_epi32(effective_a,
+                            _mm_srli_epi32(_mm_mullo_epi32(dst_a, inv_alpha), 8));
+
+                        // 饱和运算
+                        blended_r = _mm_min_epu8(blended_r, const_255);
+                        blended_g = _mm_min_epu8(blended_g, const_255);
+                        blended_b = _mm_min_epu8(blended_b, const_255);
+                        blended_a = _mm_min_epu8(blended_a, const_255);
+
+                        // 打包
+                        __m128i result = _mm_or_si128(
+                            _mm_slli_epi32(blended_r, 16),
+                            _mm_slli_epi32(blended_g, 8));
+                        result = _mm_or_si128(result, blended_b);
+                        result = _mm_or_si128(result, _mm_slli_epi32(blended_a, 24));
+
+                        _mm_storeu_si128((__m128i*)(destRow + x), result);
+                    }
+                }
+
+                // 标量处理（剩余像素）
+                for (; x < rowWidth; ++x) {
+                    const Color& src_color = srcRow[x];
+                    Color& dst_color = destRow[x];
+
+                    // 快速路径检查
+                    if (src_color.a == 0 || opacity == 0) continue;
+
+                    uint32_t effective_alpha = (static_cast<uint32_t>(src_color.a) * opacity) >> 8;
+                    if (effective_alpha == 0) continue;
+
+                    uint32_t inv_alpha = 255 - effective_alpha;
+
+                    // 混合计算
+                    uint32_t r = (static_cast<uint32_t>(src_color.r) * effective_alpha +
+                        static_cast<uint32_t>(dst_color.r) * inv_alpha) >> 8;
+                    uint32_t g = (static_cast<uint32_t>(src_color.g) * effective_alpha +
+                        static_cast<uint32_t>(dst_color.g) * inv_alpha) >> 8;
+                    uint32_t b = (static_cast<uint32_t>(src_color.b) * effective_alpha +
+                        static_cast<uint32_t>(dst_color.b) * inv_alpha) >> 8;
+                    uint32_t a = effective_alpha +
+                        ((static_cast<uint32_t>(dst_color.a) * inv_alpha) >> 8);
+
+                    // 确保范围
+                    dst_color = Color(
+                        static_cast<uint8_t>(a > 255 ? 255 : a),
+                        static_cast<uint8_t>(r > 255 ? 255 : r),
+                        static_cast<uint8_t>(g > 255 ? 255 : g),
+                        static_cast<uint8_t>(b > 255 ? 255 : b)
+                    );
+                }
+            }
+
+            // 16 位通道的 x / 255 四舍五入（x <= 255 * 255）：((x + 128) * 257) >> 16
+            static inline __m128i div255_epu16(__m128i x) {
+                return _mm_mulhi_epu16(_mm_add_epi16(x, _mm_set1_epi16(128)), _mm_set1_epi16(257));
+            }
+
+            static inline uint32_t div255(uint32_t x) {
+                return ((x + 128) * 257) >> 16;
+            }
+
+            void premultipliedBlendRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity) {
+                if (opacity > 255) opacity = 255;
+                const bool full = opacity == 255;
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+                const __m128i const_255 = _mm_set1_epi16(255);
+                const __m128i opacity_vec = _mm_set1_epi16(static_cast<short>(opacity));
+
+                int x = 0;
+                for (; x + 4 <= rowWidth; x += 4) {
+                    __m128i src_vec = _mm_loadu_si128((const __m128i*)(srcRow + x));
+                    __m128i src_a = _mm_and_si128(src_vec, alpha_mask);
+                    if (_mm_testz_si128(src_a, src_a)) continue; // 源全透明
+                    if (full && _mm_movemask_epi8(_mm_cmpeq_epi32(src_a, alpha_mask)) == 0xFFFF) {
+                        _mm_storeu_si128((__m128i*)(destRow + x), src_vec); // 源全不透明
+                        continue;
+                    }
+                    __m128i dst_vec = _mm_loadu_si128((const __m128i*)(destRow + x));
+
+                    __m128i src_lo = _mm_unpacklo_epi8(src_vec, zero);
+                    __m128i src_hi = _mm_unpackhi_epi8(src_vec, zero);
+                    if (!full) {
+                        src_lo = div255_epu16(_mm_mullo_epi16(src_lo, opacity_vec));
+                        src_hi = div255_epu16(_mm_mullo_epi16(src_hi, opacity_vec));
+                    }
+                    __m128i inv_lo = _mm_sub_epi16(const_255, _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_lo, 0xFF), 0xFF));
+                    __m128i inv_hi = _mm_sub_epi16(const_255, _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_hi, 0xFF), 0xFF));
+
+                    __m128i out_lo = _mm_add_epi16(src_lo, div255_epu16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst_vec, zero), inv_lo)));
+                    __m128i out_hi = _mm_add_epi16(src_hi, div255_epu16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst_vec, zero), inv_hi)));
+                    _mm_storeu_si128((__m128i*)(destRow + x), _mm_packus_epi16(out_lo, out_hi));
+                }
+
+                // 标量处理（剩余像素）
+                for (; x < rowWidth; ++x) {
+                    const Color& src_color = srcRow[x];
+                    if (src_color.a == 0) continue;
+                    Color& dst_color = destRow[x];
+
+                    uint32_t a = src_color.a, r = src_color.r, g = src_color.g, b = src_color.b;
+                    if (!full) {
+                        a = div255(a * opacity);
+                        r = div255(r * opacity);
+                        g = div255(g * opacity);
+                        b = div255(b * opacity);
+                    }
+                    const uint32_t inv_alpha = 255 - a;
+                    a += div255(dst_color.a * inv_alpha);
+                    r += div255(dst_color.r * inv_alpha);
+                    g += div255(dst_color.g * inv_alpha);
+                    b += div255(dst_color.b * inv_alpha);
+
+                    dst_color = Color(
+                        static_cast<uint8_t>(a > 255 ? 255 : a),
+                        static_cast<uint8_t>(r > 255 ? 255 : r),
+                        static_cast<uint8_t>(g > 255 ? 255 : g),
+                        static_cast<uint8_t>(b > 255 ? 255 : b)
+                    );
+                }
+            }
+
+            void premultiplyRow(Color* row, size_t count) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+                // alpha 通道自身乘以 255，保持不变
+                const __m128i alpha_lane = _mm_set1_epi64x(0x00FF000000000000LL);
+
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    __m128i v = _mm_loadu_si128((const __m128i*)(row + i));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, alpha_mask), alpha_mask)) == 0xFFFF) continue;
+                    __m128i lo = _mm_unpacklo_epi8(v, zero);
+                    __m128i hi = _mm_unpackhi_epi8(v, zero);
+                    __m128i alpha_lo = _mm_or_si128(_mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF), alpha_lane);
+                    __m128i alpha_hi = _mm_or_si128(_mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF), alpha_lane);
+                    lo = div255_epu16(_mm_mullo_epi16(lo, alpha_lo));
+                    hi = div255_epu16(_mm_mullo_epi16(hi, alpha_hi));
+                    _mm_storeu_si128((__m128i*)(row + i), _mm_packus_epi16(lo, hi));
+                }
+                for (; i < count; ++i) {
+                    Color& c = row[i];
+                    const uint32_t a = c.a;
+                    c.r = static_cast<uint8_t>(div255(c.r * a));
+                    c.g = static_cast<uint8_t>(div255(c.g * a));
+                    c.b = static_cast<uint8_t>(div255(c.b * a));
+                }
+            }
+
+            void unpremultiplyRow(Color* row, size_t count) {
+                const __m128i mask_ff = _mm_set1_epi32(0xFF);
+                const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+                const __m128 v_zero = _mm_setzero_ps();
+                const __m128 v_one = _mm_set1_ps(1.0f);
+                const __m128 v_255 = _mm_set1_ps(255.0f);
+                // 与标量 (c * 255 + a / 2) / a 一致：倒数乘法的误差远小于 1/512，而商的小数部分不超过 254/255
+                const __m128 v_bias = _mm_set1_ps(1.0f / 512.0f);
+
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    __m128i v = _mm_loadu_si128((const __m128i*)(row + i));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, alpha_mask), alpha_mask)) == 0xFFFF) continue;
+                    __m128i a_i = _mm_srli_epi32(v, 24);
+                    __m128 fa = _mm_cvtepi32_ps(a_i);
+                    __m128 half = _mm_cvtepi32_ps(_mm_srli_epi32(a_i, 1));
+                    __m128 rcp = _mm_and_ps(_mm_div_ps(v_one, fa), _mm_cmpgt_ps(fa, v_zero)); // A 为 0 时 RGB 置 0
+                    auto channel = [&](__m128i c) {
+                        __m128 num = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), v_255), half);
+                        return _mm_min_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(num, rcp), v_bias)), mask_ff);
+                    };
+                    __m128i r = channel(_mm_and_si128(_mm_srli_epi32(v, 16), mask_ff));
+                    __m128i g = channel(_mm_and_si128(_mm_srli_epi32(v, 8), mask_ff));
+                    __m128i b = channel(_mm_and_si128(v, mask_ff));
+                    __m128i result = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a_i, 24), _mm_slli_epi32(r, 16)),
+                        _mm_or_si128(_mm_slli_epi32(g, 8), b));
+                    _mm_storeu_si128((__m128i*)(row + i), result);
+                }
+                for (; i < count; ++i) {
+                    Color& c = row[i];
+                    const uint32_t a = c.a;
+                    if (a == 255) continue;
+                    if (a == 0) {
+                        c.data = 0;
+                        continue;
+                    }
+                    const uint32_t r = (c.r * 255 + a / 2) / a, g = (c.g * 255 + a / 2) / a, b = (c.b * 255 + a / 2) / a;
+                    c.r = static_cast<uint8_t>(r > 255 ? 255 : r);
+                    c.g = static_cast<uint8_t>(g > 255 ? 255 : g);
+                    c.b = static_cast<uint8_t>(b > 255 ? 255 : b);
+                }
+            }
+
+            // 通用混合引擎：4 像素一组，尾部逐像素
+            void blendModeRow(Color* destRow, const Color* srcRow, int rowWidth, int opacity,
+                              BlendMode mode, bool srcPremultiplied, bool dstPremultiplied) {
+                if (rowWidth <= 0) return;
+                const size_t count = static_cast<size_t>(rowWidth);
+                const float op = opacity * (1.0f / 255.0f);
+                const size_t x = blendModeRows<BlendLanes4>(mode, destRow, srcRow, count, op, srcPremultiplied, dstPremultiplied);
+                if (x < count) blendModeRows<BlendLanes1>(mode, destRow + x, srcRow + x, count - x, op, srcPremultiplied, dstPremultiplied);
+            }
+
+            // 2:1 盒式滤波：每个输出像素为对应 2x2（或 2x1、1x2）源像素各通道的四舍五入均值，末列为奇数时与自身平均
+            void halveRow(const Color* row0, const Color* row1, Color* out, int srcWidth, int outWidth, bool halveX) {
+                // 可整组处理的输出列数：两个源像素都在行内的列
+                const int vecWidth = halveX ? srcWidth / 2 : srcWidth;
+                int x = 0;
+                if (halveX) {
+                    const __m128i v_zero = _mm_setzero_si128();
+                    const __m128i v_two = _mm_set1_epi16(2);
+                    // 每次读取两行各 8 个源像素，输出 4 个像素
+                    for (; x + 4 <= vecWidth; x += 4) {
+                        const __m128 a0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 2 * x)));
+                        const __m128 a1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 2 * x + 4)));
+                        const __m128 b0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 2 * x)));
+                        const __m128 b1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 2 * x + 4)));
+
+                        // 分离偶数列与奇数列
+                        const __m128i e0 = _mm_castps_si128(_mm_shuffle_ps(a0, a1, _MM_SHUFFLE(2, 0, 2, 0)));
+                        const __m128i o0 = _mm_castps_si128(_mm_shuffle_ps(a0, a1, _MM_SHUFFLE(3, 1, 3, 1)));
+                        const __m128i e1 = _mm_castps_si128(_mm_shuffle_ps(b0, b1, _MM_SHUFFLE(2, 0, 2, 0)));
+                        const __m128i o1 = _mm_castps_si128(_mm_shuffle_ps(b0, b1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+                        // 扩展到 16 位求四个源像素之和，(sum + 2) >> 2 四舍五入
+                        __m128i lo = _mm_add_epi16(
+                            _mm_add_epi16(_mm_unpacklo_epi8(e0, v_zero), _mm_unpacklo_epi8(o0, v_zero)),
+                            _mm_add_epi16(_mm_unpacklo_epi8(e1, v_zero), _mm_unpacklo_epi8(o1, v_zero)));
+                        __m128i hi = _mm_add_epi16(
+                            _mm_add_epi16(_mm_unpackhi_epi8(e0, v_zero), _mm_unpackhi_epi8(o0, v_zero)),
+                            _mm_add_epi16(_mm_unpackhi_epi8(e1, v_zero), _mm_unpackhi_epi8(o1, v_zero)));
+                        lo = _mm_srli_epi16(_mm_add_epi16(lo, v_two), 2);
+                        hi = _mm_srli_epi16(_mm_add_epi16(hi, v_two), 2);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(lo, hi));
+                    }
+                }
+                else {
+                    // 只减半高度：两行逐字节取平均，(a + b + 1) >> 1
+                    for (; x + 4 <= vecWidth; x += 4) {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_avg_epu8(a, b));
+                    }
+                }
+
+                // 标量尾部（含奇数宽度的末列）
+                for (; x < outWidth; ++x) {
+                    const int sx0 = halveX ? x * 2 : x;
+                    const int sx1 = halveX ? std::min(sx0 + 1, srcWidth - 1) : sx0;
+                    const uint32_t c00 = row0[sx0].data, c10 = row0[sx1].data;
+                    const uint32_t c01 = row1[sx0].data, c11 = row1[sx1].data;
+                    uint32_t value = 0;
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        const uint32_t sum = ((c00 >> shift) & 0xFF) + ((c10 >> shift) & 0xFF) +
+                            ((c01 >> shift) & 0xFF) + ((c11 >> shift) & 0xFF);
+                        value |= ((sum + 2) >> 2) << shift;
+                    }
+                    out[x].data = value;
+                }
+            }
+
+            // 两个相邻 16 位权重拼成 _mm_madd_epi16 所需的 32 位
+            static inline int weightPair(const int16_t* coeffs) {
+                return static_cast<int>(static_cast<uint16_t>(coeffs[0]) | (static_cast<uint32_t>(static_cast<uint16_t>(coeffs[1])) << 16));
+            }
+
+            static inline uint32_t packChannels(const int sum[4]) {
+                uint32_t value = 0;
+                for (int c = 0; c < 4; ++c) {
+                    const int v = (sum[c] + (1 << (RESAMPLE_WEIGHT_BITS - 1))) >> RESAMPLE_WEIGHT_BITS;
+                    value |= static_cast<uint32_t>(std::min(255, std::max(0, v))) << (c * 8);
+                }
+                return value;
+            }
+
+            // 横向一遍：每个输出像素两个源像素一组做 madd，4 个输出一起舍入与打包
+            void resampleRow(const Color* src, int srcWidth, Color* out, int outWidth,
+                             const int* start, const int16_t* coeffs, int taps) {
+                // 两个像素的 4 个 16 位通道按 (p0, p1) 交错
+                const __m128i v_interleave = _mm_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+                const __m128i v_round = _mm_set1_epi32(1 << (RESAMPLE_WEIGHT_BITS - 1));
+
+                // 单个输出像素的 4 个通道之和（32 位）
+                auto accumulate = [&](int x) {
+                    const Color* p = src + start[x];
+                    const int16_t* c = coeffs + static_cast<size_t>(x) * taps;
+                    __m128i acc = _mm_setzero_si128();
+                    for (int k = 0; k < taps; k += 2) {
+                        __m128i px = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + k)));
+                        px = _mm_shuffle_epi8(px, v_interleave);
+                        acc = _mm_add_epi32(acc, _mm_madd_epi16(px, _mm_set1_epi32(weightPair(c + k))));
+                    }
+                    return _mm_srai_epi32(_mm_add_epi32(acc, v_round), RESAMPLE_WEIGHT_BITS);
+                };
+
+                int x = 0;
+                // 权重表保证 start + taps 不越过行尾；源行比 taps 还短时全部走标量
+                if (taps <= srcWidth) {
+                    for (; x + 4 <= outWidth; x += 4) {
+                        const __m128i s01 = _mm_packs_epi32(accumulate(x), accumulate(x + 1));
+                        const __m128i s23 = _mm_packs_epi32(accumulate(x + 2), accumulate(x + 3));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(s01, s23));
+                    }
+                }
+
+                for (; x < outWidth; ++x) {
+                    const Color* p = src + start[x];
+                    const int16_t* c = coeffs + static_cast<size_t>(x) * taps;
+                    int sum[4] = { 0, 0, 0, 0 };
+                    for (int k = 0; k < taps && start[x] + k < srcWidth; ++k) {
+                        const uint32_t value = p[k].data;
+                        for (int ch = 0; ch < 4; ++ch) sum[ch] += static_cast<int>((value >> (ch * 8)) & 0xFF) * c[k];
+                    }
+                    out[x].data = packChannels(sum);
+                }
+            }
+
+            void nearestRow(const Color* src, int, Color* out, int outWidth, const int* index) {
+                for (int x = 0; x < outWidth; ++x) out[x] = src[index[x]];
+            }
+
+            // 纵向一遍：taps 行按列同时累加，每次 4 个像素，两行一组做 madd
+            void resampleColumns(const Color* const* rows, const int16_t* coeffs, int taps, Color* out, int begin, int end) {
+                const __m128i v_zero = _mm_setzero_si128();
+                const __m128i v_round = _mm_set1_epi32(1 << (RESAMPLE_WEIGHT_BITS - 1));
+                int x = begin;
+                for (; x + 4 <= end; x += 4) {
+                    __m128i acc0 = _mm_setzero_si128(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+                    for (int k = 0; k < taps; k += 2) {
+                        const __m128i w = _mm_set1_epi32(weightPair(coeffs + k));
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + x));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1] + x));
+                        const __m128i lo = _mm_unpacklo_epi8(a, b);
+                        const __m128i hi = _mm_unpackhi_epi8(a, b);
+                        acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, v_zero), w));
+                        acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, v_zero), w));
+                        acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, v_zero), w));
+                        acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, v_zero), w));
+                    }
+                    acc0 = _mm_srai_epi32(_mm_add_epi32(acc0, v_round), RESAMPLE_WEIGHT_BITS);
+                    acc1 = _mm_srai_epi32(_mm_add_epi32(acc1, v_round), RESAMPLE_WEIGHT_BITS);
+                    acc2 = _mm_srai_epi32(_mm_add_epi32(acc2, v_round), RESAMPLE_WEIGHT_BITS);
+                    acc3 = _mm_srai_epi32(_mm_add_epi32(acc3, v_round), RESAMPLE_WEIGHT_BITS);
+                    // 负瓣产生的越界值在两次饱和打包中截断到 0..255
+                    const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(acc0, acc1), _mm_packs_epi32(acc2, acc3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), packed);
+                }
+                for (; x < end; ++x) {
+                    int sum[4] = { 0, 0, 0, 0 };
+                    for (int k = 0; k < taps; ++k) {
+                        const uint32_t value = rows[k][x].data;
+                        for (int ch = 0; ch < 4; ++ch) sum[ch] += static_cast<int>((value >> (ch * 8)) & 0xFF) * coeffs[k];
+                    }
+                    out[x].data = packChannels(sum);
+                }
+            }
+
+            const KernelTable table = {
+                fillRow, copyRow,
+                fillRowAligned, copyRowAligned,
+                fillRowStream, copyRowStream,
+                alphaBlendRow, premultipliedBlendRow,
+                premultiplyRow, unpremultiplyRow,
+                blendModeRow,
+                halveRow, resampleRow, nearestRow, resampleColumns,
+                line, polyline, polygon, triangle,
+                rect, rect, roundRect, roundRect,
+                circle, ellipse, ellipse, sector,
+                resizedBilinear, rotated,
+                drawScaled, drawResized, drawRotated,
+                drawTransformed, drawTransformed,
+                spriteInstance
+            };
+        }
+    }
+}
\ No newline at end of file
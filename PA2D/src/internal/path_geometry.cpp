@@ -0,0 +1,153 @@
+// path_geometry.cpp
+#include "path_geometry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pa2d {
+    namespace utils {
+        namespace {
+            constexpr float GEOMETRY_EPSILON = 1e-6f;
+
+            // 遍历线段（扩展 reach 后）可能覆盖的网格单元
+            // 按单元行裁剪线段参数区间，长斜线只登记其实际经过的单元
+            template<typename Visit>
+            void forEachSegmentCell(const SegmentParams& seg, float reach, int minX, int minY, int cellsX, int cellsY, const Visit& visit) {
+                const float segMinY = std::min(seg.y0, seg.y0 + seg.dy);
+                const float segMaxY = std::max(seg.y0, seg.y0 + seg.dy);
+                const int rowLo = static_cast<int>(std::floor(segMinY - reach)) - minY;
+                const int rowHi = static_cast<int>(std::ceil(segMaxY + reach)) - minY;
+                if (rowHi < 0 || rowLo >= cellsY * SEGMENT_CELL_SIZE) return;
+                const int cy0 = std::max(0, rowLo) / SEGMENT_CELL_SIZE;
+                const int cy1 = std::min(cellsY - 1, rowHi / SEGMENT_CELL_SIZE);
+                const bool horizontal = std::abs(seg.dy) < GEOMETRY_EPSILON;
+
+                for (int cy = cy0; cy <= cy1; ++cy) {
+                    float t0 = 0.0f, t1 = 1.0f;
+                    if (!horizontal) {
+                        const float bandTop = static_cast<float>(minY + cy * SEGMENT_CELL_SIZE) + 0.5f - reach;
+                        const float bandBottom = static_cast<float>(minY + (cy + 1) * SEGMENT_CELL_SIZE) - 0.5f + reach;
+                        float ta = (bandTop - seg.y0) / seg.dy;
+                        float tb = (bandBottom - seg.y0) / seg.dy;
+                        if (ta > tb) std::swap(ta, tb);
+                        t0 = std::max(0.0f, ta);
+                        t1 = std::min(1.0f, tb);
+                        if (t0 > t1) { t0 = 0.0f; t1 = 1.0f; }
+                    }
+                    const float xa = seg.x0 + t0 * seg.dx;
+                    const float xb = seg.x0 + t1 * seg.dx;
+                    const int colLo = static_cast<int>(std::floor(std::min(xa, xb) - reach)) - minX;
+                    const int colHi = static_cast<int>(std::ceil(std::max(xa, xb) + reach)) - minX;
+                    if (colHi < 0 || colLo >= cellsX * SEGMENT_CELL_SIZE) continue;
+                    const int cx0 = std::max(0, colLo) / SEGMENT_CELL_SIZE;
+                    const int cx1 = std::min(cellsX - 1, colHi / SEGMENT_CELL_SIZE);
+                    for (int cx = cx0; cx <= cx1; ++cx) visit(static_cast<size_t>(cy) * cellsX + cx);
+                }
+            }
+        }
+
+        void PolygonEdges::build(const Point* vertices, size_t n) {
+            edges.clear();
+            edges.reserve(n);
+            if (n == 0) return;
+            minPt = maxPt = vertices[0];
+
+            for (size_t i = 0; i < n; ++i) {
+                const Point& p1 = vertices[i];
+                const Point& p2 = vertices[(i + 1) % n];
+
+                minPt.x = std::min(minPt.x, p1.x); minPt.y = std::min(minPt.y, p1.y);
+                maxPt.x = std::max(maxPt.x, p1.x); maxPt.y = std::max(maxPt.y, p1.y);
+
+                EdgeParams e;
+                e.ax = p1.x; e.ay = p1.y;
+                e.dx = p2.x - p1.x;
+                e.dy = p2.y - p1.y;
+                float lenSq = e.dx * e.dx + e.dy * e.dy;
+                e.invLenSq = (lenSq > GEOMETRY_EPSILON) ? (1.0f / lenSq) : 0.0f;
+
+                // 射线法预处理
+                e.isHorizontal = (std::abs(e.dy) < GEOMETRY_EPSILON);
+                if (p1.y < p2.y) {
+                    e.yMin = p1.y; e.yMax = p2.y; e.xOfYMin = p1.x;
+                }
+                else {
+                    e.yMin = p2.y; e.yMax = p1.y; e.xOfYMin = p2.x;
+                }
+                e.invSlope = e.isHorizontal ? 0.0f : (e.dx / e.dy); // 水平线不会触发相交逻辑，invSlope 设为0安全
+
+                edges.push_back(e);
+            }
+
+            order.resize(n);
+            for (size_t i = 0; i < n; ++i) order[i] = static_cast<uint32_t>(i);
+            std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return edges[a].yMin < edges[b].yMin; });
+        }
+
+        void PolylineSegments::build(const Point* points, size_t count, bool closed, float strokeWidth, const ClipRect& bounds) {
+            segments.clear();
+            cellsX = cellsY = 0;
+            if (count < 2) return;
+
+            minPt = maxPt = points[0];
+            for (size_t i = 1; i < count; ++i) {
+                minPt.x = std::min(minPt.x, points[i].x);
+                minPt.y = std::min(minPt.y, points[i].y);
+                maxPt.x = std::max(maxPt.x, points[i].x);
+                maxPt.y = std::max(maxPt.y, points[i].y);
+            }
+
+            // 每条线段的常量只计算一次
+            segments.reserve(count);
+            auto addSegment = [&](const Point& p0, const Point& p1) {
+                SegmentParams seg;
+                seg.x0 = p0.x; seg.y0 = p0.y;
+                seg.dx = p1.x - p0.x;
+                seg.dy = p1.y - p0.y;
+                seg.lengthSq = seg.dx * seg.dx + seg.dy * seg.dy;
+                if (seg.lengthSq < 0.0001f) return;
+                seg.invLengthSq = 1.0f / seg.lengthSq;
+                segments.push_back(seg);
+                };
+            for (size_t i = 0; i + 1 < count; ++i) {
+                addSegment(points[i], points[i + 1]);
+            }
+            if (closed && count >= 3) {
+                addSegment(points[count - 1], points[0]);
+            }
+            if (segments.empty()) return;
+
+            // 网格覆盖描边包围盒与目标的交集，原点向下取整到单元边长
+            const float outerEdge = strokeWidth * 0.5f + 1.0f;
+            const int minX = std::max(bounds.minX, static_cast<int>(std::floor(minPt.x - outerEdge)));
+            const int maxX = std::min(bounds.maxX, static_cast<int>(std::ceil(maxPt.x + outerEdge)));
+            const int minY = std::max(bounds.minY, static_cast<int>(std::floor(minPt.y - outerEdge)));
+            const int maxY = std::min(bounds.maxY, static_cast<int>(std::ceil(maxPt.y + outerEdge)));
+            if (minX > maxX || minY > maxY) return;
+            originX = minX - ((minX % SEGMENT_CELL_SIZE) + SEGMENT_CELL_SIZE) % SEGMENT_CELL_SIZE;
+            originY = minY - ((minY % SEGMENT_CELL_SIZE) + SEGMENT_CELL_SIZE) % SEGMENT_CELL_SIZE;
+            cellsX = (maxX - originX) / SEGMENT_CELL_SIZE + 1;
+            cellsY = (maxY - originY) / SEGMENT_CELL_SIZE + 1;
+            const size_t cellCount = static_cast<size_t>(cellsX) * cellsY;
+
+            // 超出 outerEdge 的线段对像素没有贡献，reach 额外留 1 像素余量
+            // 每个像素块只需遍历所在单元登记的线段，长折线的开销随长度线性增长
+            const float reach = outerEdge + 1.0f;
+
+            // 第一遍：统计每个单元的线段数
+            cellStart.assign(cellCount + 1, 0);
+            for (const auto& seg : segments) {
+                forEachSegmentCell(seg, reach, originX, originY, cellsX, cellsY, [&](size_t cell) { ++cellStart[cell + 1]; });
+            }
+            for (size_t i = 0; i < cellCount; ++i) cellStart[i + 1] += cellStart[i];
+
+            // 第二遍：填入线段下标
+            cellItems.resize(cellStart[cellCount]);
+            std::vector<uint32_t> cellCursor(cellStart.begin(), cellStart.end() - 1);
+            for (size_t i = 0; i < segments.size(); ++i) {
+                forEachSegmentCell(segments[i], reach, originX, originY, cellsX, cellsY, [&](size_t cell) {
+                    cellItems[cellCursor[cell]++] = static_cast<uint32_t>(i);
+                    });
+            }
+        }
+    }
+}
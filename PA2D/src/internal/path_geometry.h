@@ -0,0 +1,63 @@
+// path_geometry.h
+// 多边形边表与折线线段分桶网格：只依赖几何与目标尺寸，与裁剪区域、指令集无关
+// 单独调用时由 draw.cpp 构建后交给光栅化内核；分块渲染时每条命令只构建一次，各图块共用
+#pragma once
+#include"../include/geometry/point.h"
+#include"clip.h"
+#include <cstdint>
+#include <vector>
+
+namespace pa2d {
+    namespace utils {
+        // 预计算的边数据
+        struct EdgeParams {
+            float ax, ay;
+            float dx, dy;
+            float invLenSq; // 1.0 / (dx*dx + dy*dy)
+
+            // 射线法相关参数
+            float yMin, yMax;
+            float xOfYMin;    // yMin 对应的 x 坐标
+            float invSlope;   // (x2 - x1) / (y2 - y1)，用于快速计算交点 X
+            bool  isHorizontal; // 是否水平线
+        };
+
+        // 多边形边表：边参数与按 yMin 排序的下标
+        struct PolygonEdges {
+            std::vector<EdgeParams> edges;
+            std::vector<uint32_t> order;    // 按 yMin 升序的边下标
+            Point minPt, maxPt;             // 顶点包围盒
+
+            void build(const Point* vertices, size_t n);
+        };
+
+        // 预计算的线段参数，退化线段在构建时剔除
+        struct SegmentParams {
+            float x0, y0;
+            float dx, dy;
+            float lengthSq, invLengthSq;
+        };
+
+        // 线段分桶网格的单元边长（像素），取 8 的倍数使按绝对坐标对齐的 AVX 块不会跨越单元
+        const int SEGMENT_CELL_SIZE = 32;
+
+        // 折线线段与分桶网格
+        // 网格原点取 SEGMENT_CELL_SIZE 的整数倍，覆盖包围盒与目标缓冲区的交集；
+        // 像素所在单元只由其绝对坐标决定，图块之间共用同一网格
+        struct PolylineSegments {
+            std::vector<SegmentParams> segments;
+            Point minPt, maxPt;             // 顶点包围盒
+            int originX = 0, originY = 0;
+            int cellsX = 0, cellsY = 0;
+            std::vector<uint32_t> cellStart;    // 每个单元在 cellItems 中的起始位置（前缀和）
+            std::vector<uint32_t> cellItems;    // 按单元排列的线段下标
+
+            // bounds 为目标缓冲区范围；strokeWidth 决定线段影响的范围
+            void build(const Point* points, size_t count, bool closed, float strokeWidth, const ClipRect& bounds);
+
+            // 网格覆盖的像素范围（闭区间）
+            int gridMaxX() const { return originX + cellsX * SEGMENT_CELL_SIZE - 1; }
+            int gridMaxY() const { return originY + cellsY * SEGMENT_CELL_SIZE - 1; }
+        };
+    }
+}
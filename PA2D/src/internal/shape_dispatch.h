@@ -0,0 +1,72 @@
+// shape_dispatch.h
+// Shape 到基础绘制调用的分派，Canvas::draw 与 CommandList::draw 共用（两者的同名绘制方法参数一致）
+#pragma once
+#include "../include/geometry.h"
+#include "../include/style.h"
+#include <cassert>
+
+namespace pa2d {
+    namespace utils {
+        template<typename Target>
+        Target& drawShape(Target& target, const Shape& shape, const Style& style) {
+            switch (shape.getType()) {
+            case Shape::GeometryType::POINTS: {
+                // 三点以上按折线，两点按线段，单点画半径 1 的圆（只有描边色时用描边色填充）
+                const std::vector<Point>& points = static_cast<const Points&>(shape).points;
+                if (points.size() >= 3) {
+                    return target.polyline(points, style, false);
+                }
+                else if (points.size() == 2) {
+                    return target.line(points[0].x, points[0].y, points[1].x, points[1].y, style);
+                }
+                else if (points.size() == 1) {
+                    Style pointStyle = style;
+                    if (style.fill_ == None && style.stroke_ != None) {
+                        pointStyle.fill(style.stroke_);
+                    }
+                    return target.circle(points[0].x, points[0].y, 1.0f, pointStyle);
+                }
+                return target;
+            }
+            case Shape::GeometryType::LINE: {
+                const Line& line = static_cast<const Line&>(shape);
+                return target.line(line.start().x, line.start().y, line.end().x, line.end().y, style);
+            }
+            case Shape::GeometryType::POLYGON: {
+                const Polygon& polygon = static_cast<const Polygon&>(shape);
+                return target.polygon(polygon.getPoints(), style);
+            }
+            case Shape::GeometryType::RECT: {
+                const Rect& rect = static_cast<const Rect&>(shape);
+                return target.rect(rect.center().x, rect.center().y, rect.width(), rect.height(), rect.rotation(), style);
+            }
+            case Shape::GeometryType::TRIANGLE: {
+                const Triangle& triangle = static_cast<const Triangle&>(shape);
+                return target.triangle(triangle[0].x, triangle[0].y, triangle[1].x, triangle[1].y, triangle[2].x, triangle[2].y, style);
+            }
+            case Shape::GeometryType::CIRCLE: {
+                const Circle& circle = static_cast<const Circle&>(shape);
+                return target.circle(circle.x(), circle.y(), circle.radius(), style);
+            }
+            case Shape::GeometryType::ELLIPTIC: {
+                const Elliptic& ellipse = static_cast<const Elliptic&>(shape);
+                return target.ellipse(ellipse.x(), ellipse.y(), ellipse.width(), ellipse.height(), ellipse.rotation(), style);
+            }
+            case Shape::GeometryType::SECTOR: {
+                const Sector& sector = static_cast<const Sector&>(shape);
+                return target.sector(sector.x(), sector.y(), sector.radius(), sector.startAngle(), sector.endAngle(), style);
+            }
+            case Shape::GeometryType::RAY: {
+                const Ray& ray = static_cast<const Ray&>(shape);
+                return target.line(ray.start().x, ray.start().y, ray.end().x, ray.end().y, style);
+            }
+            default: {
+#ifdef _DEBUG
+                assert(false && "Unknown shape type in draw");
+#endif
+                return target;
+            }
+            }
+        }
+    }
+}
@@ -0,0 +1,198 @@
+#include "thread_pool.h"
+#include "../include/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pa2d {
+    namespace utils {
+        // 工作线程标记：嵌套提交时直接串行执行，避免死锁
+        static thread_local bool t_insideWorker = false;
+
+        class RenderThreadPool {
+        private:
+            std::vector<std::thread> m_workers;
+            std::mutex m_mutex;                 // 保护任务状态
+            std::mutex m_submitMutex;           // 同一时间只执行一个并行任务
+            std::condition_variable m_wakeCV;   // 唤醒工作线程
+            std::condition_variable m_doneCV;   // 通知提交线程任务完成
+            std::atomic<int> m_threadCount;     // 总线程数（含调用线程）
+            std::atomic<int> m_nextBand;
+
+            const std::function<void(int, int)>* m_body;
+            int m_minY, m_maxY, m_bandRows, m_bandCount;
+            int m_activeWorkers;
+            unsigned m_generation;
+            bool m_stop;
+
+            RenderThreadPool();
+            ~RenderThreadPool();
+            void StartWorkers(int count);
+            void StopWorkers();
+            void WorkerLoop(unsigned seenGeneration);
+            void RunBands();
+
+        public:
+            static RenderThreadPool& GetInstance();
+            void SetThreadCount(int count);
+            int GetThreadCount() const { return m_threadCount.load(std::memory_order_relaxed); }
+            bool TryRun(int minY, int maxY, int minBandRows, const std::function<void(int, int)>& body);
+
+            RenderThreadPool(const RenderThreadPool&) = delete;
+            RenderThreadPool& operator=(const RenderThreadPool&) = delete;
+        };
+
+        RenderThreadPool::RenderThreadPool()
+            : m_threadCount(1), m_nextBand(0), m_body(nullptr),
+            m_minY(0), m_maxY(-1), m_bandRows(1), m_bandCount(0),
+            m_activeWorkers(0), m_generation(0), m_stop(false) {
+        }
+
+        RenderThreadPool::~RenderThreadPool() {
+            StopWorkers();
+        }
+
+        RenderThreadPool& RenderThreadPool::GetInstance() {
+            static RenderThreadPool instance;
+            return instance;
+        }
+
+        void RenderThreadPool::StartWorkers(int count) {
+            // 新线程从当前代数开始等待，否则会把已经结束的任务当作新任务再执行一次
+            unsigned generation;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                generation = m_generation;
+            }
+            for (int i = 0; i < count; ++i) {
+                m_workers.emplace_back(&RenderThreadPool::WorkerLoop, this, generation);
+            }
+        }
+
+        void RenderThreadPool::StopWorkers() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wakeCV.notify_all();
+            for (auto& worker : m_workers) {
+                if (worker.joinable()) worker.join();
+            }
+            m_workers.clear();
+            m_stop = false;
+        }
+
+        void RenderThreadPool::SetThreadCount(int count) {
+            if (count <= 0) {
+                count = static_cast<int>(std::thread::hardware_concurrency());
+                if (count <= 0) count = 1;
+            }
+
+            // 等待正在执行的任务结束后再重建线程
+            std::lock_guard<std::mutex> submitLock(m_submitMutex);
+            if (count == GetThreadCount()) return;
+
+            StopWorkers();
+            StartWorkers(count - 1);
+            m_threadCount.store(count, std::memory_order_relaxed);
+        }
+
+        void RenderThreadPool::WorkerLoop(unsigned seenGeneration) {
+            t_insideWorker = true;
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wakeCV.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+                    if (m_stop) return;
+                    seenGeneration = m_generation;
+                }
+
+                RunBands();
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (--m_activeWorkers == 0) m_doneCV.notify_one();
+                }
+            }
+        }
+
+        void RenderThreadPool::RunBands() {
+            for (;;) {
+                const int band = m_nextBand.fetch_add(1, std::memory_order_relaxed);
+                if (band >= m_bandCount) return;
+
+                const int rowBegin = m_minY + band * m_bandRows;
+                const int rowEnd = std::min(m_maxY, rowBegin + m_bandRows - 1);
+                (*m_body)(rowBegin, rowEnd);
+            }
+        }
+
+        bool RenderThreadPool::TryRun(int minY, int maxY, int minBandRows, const std::function<void(int, int)>& body) {
+            if (t_insideWorker) return false;
+
+            // 其他线程（例如另一个窗口线程）正在使用线程池时退回串行
+            std::unique_lock<std::mutex> submitLock(m_submitMutex, std::try_to_lock);
+            if (!submitLock.owns_lock() || m_workers.empty()) return false;
+
+            const int rows = maxY - minY + 1;
+            const int threads = static_cast<int>(m_workers.size()) + 1;
+            const int bandCount = std::max(1, std::min(threads * 4, rows / minBandRows));
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_body = &body;
+                m_minY = minY;
+                m_maxY = maxY;
+                m_bandRows = (rows + bandCount - 1) / bandCount;
+                m_bandCount = (rows + m_bandRows - 1) / m_bandRows;
+                m_nextBand.store(0, std::memory_order_relaxed);
+                m_activeWorkers = static_cast<int>(m_workers.size());
+                ++m_generation;
+            }
+            m_wakeCV.notify_all();
+
+            // 调用线程同样参与条带处理
+            t_insideWorker = true;
+            RunBands();
+            t_insideWorker = false;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCV.wait(lock, [&] { return m_activeWorkers == 0; });
+            m_body = nullptr;
+            return true;
+        }
+
+        bool shouldParallelize(int rows, int spanWidth) {
+            if (rows < PARALLEL_MIN_BAND_ROWS * 2 || spanWidth <= 0) return false;
+            if (static_cast<long long>(rows) * spanWidth < PARALLEL_MIN_PIXELS) return false;
+            return RenderThreadPool::GetInstance().GetThreadCount() > 1;
+        }
+
+        void parallelRowsImpl(int minY, int maxY, const std::function<void(int, int)>& body) {
+            if (!RenderThreadPool::GetInstance().TryRun(minY, maxY, PARALLEL_MIN_BAND_ROWS, body)) {
+                body(minY, maxY);
+            }
+        }
+
+        bool shouldParallelizeTasks(int count) {
+            return count > 1 && RenderThreadPool::GetInstance().GetThreadCount() > 1;
+        }
+
+        void parallelTasksImpl(int first, int last, const std::function<void(int, int)>& body) {
+            if (!RenderThreadPool::GetInstance().TryRun(first, last, 1, body)) {
+                body(first, last);
+            }
+        }
+    }
+
+    void setRenderThreads(int threads) {
+        utils::RenderThreadPool::GetInstance().SetThreadCount(threads);
+    }
+
+    int getRenderThreads() {
+        return utils::RenderThreadPool::GetInstance().GetThreadCount();
+    }
+}
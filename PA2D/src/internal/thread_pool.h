@@ -0,0 +1,46 @@
+// thread_pool.h
+#pragma once
+#include <functional>
+
+namespace pa2d {
+    namespace utils {
+        // 并行阈值：包围盒像素数过少时，线程调度开销大于收益
+        const int PARALLEL_MIN_PIXELS = 32 * 1024;
+        // 每个条带的最少行数
+        const int PARALLEL_MIN_BAND_ROWS = 4;
+
+        // 当前配置下是否值得拆分为多个条带
+        bool shouldParallelize(int rows, int spanWidth);
+
+        // 将闭区间 [minY, maxY] 切分为水平条带并交给渲染线程池执行（调用线程同样参与）
+        // 条带之间互不重叠，每行仍由原有的 AVX2/SSE/标量 路径完整处理，输出与串行逐位一致
+        void parallelRowsImpl(int minY, int maxY, const std::function<void(int, int)>& body);
+
+        // body(rowBegin, rowEnd) 处理闭区间内的行
+        // 串行模式或任务过小时直接在调用线程执行，不经过 std::function
+        template<typename Body>
+        inline void parallelRows(int minY, int maxY, int spanWidth, const Body& body) {
+            if (minY > maxY) return;
+            if (!shouldParallelize(maxY - minY + 1, spanWidth)) {
+                body(minY, maxY);
+                return;
+            }
+            parallelRowsImpl(minY, maxY, body);
+        }
+
+        // 粗粒度独立任务（例如分块渲染的图块）是否值得分发
+        bool shouldParallelizeTasks(int count);
+        void parallelTasksImpl(int first, int last, const std::function<void(int, int)>& body);
+
+        // body(first, last) 处理闭区间内的任务下标，每个任务已足够大，不设最小批量
+        template<typename Body>
+        inline void parallelTasks(int first, int last, const Body& body) {
+            if (first > last) return;
+            if (!shouldParallelizeTasks(last - first + 1)) {
+                body(first, last);
+                return;
+            }
+            parallelTasksImpl(first, last, body);
+        }
+    }
+}
@@ -0,0 +1,219 @@
+// vec_math.h
+// 可移植的向量超越函数：不依赖 SVML，AVX2 与标量版本使用同一组多项式（SSE 版本只提供 4 像素路径用到的函数）
+// 随指令集分别实例化，位于 PA2D_ISA 命名空间（见 isa.h）；utils::vmath 指向本翻译单元的版本
+// 最大误差（与双精度 std 函数对比，1600 万组随机输入测得，TESTS/test_vec_math.cpp 检查这些上限）：
+//   atan2     绝对误差 3e-7 弧度
+//   sin / cos 绝对误差 1e-7（|x| <= 8192，更大的参数规约精度逐渐下降）
+//   rsqrt     相对误差 3e-7（要求 x > 0，x = 0 得到 NaN，调用方需限制下界）
+//   exp       相对误差 1.5e-7（x 截断到 [-87.3, 88.3]）
+#pragma once
+#include "isa.h"
+#include <immintrin.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace pa2d {
+    namespace utils {
+        namespace PA2D_ISA {
+        namespace vmath {
+            // atan：先把 min(|x|,|y|) / max(|x|,|y|) 规约到 [0, tan(pi/8)]，再用 Cephes atanf 的多项式
+            const float TAN_PI_8 = 0.414213562373095f;
+            const float ATAN_C3 = -3.33329491539e-1f;
+            const float ATAN_C5 = 1.99777106478e-1f;
+            const float ATAN_C7 = -1.38776856032e-1f;
+            const float ATAN_C9 = 8.05374449538e-2f;
+
+            // sin/cos：以 pi/2 为周期做 Cody-Waite 三段规约，规约后 |r| <= pi/4
+            const float TWO_OVER_PI = 0.636619772367581f;
+            const float PIO2_1 = 1.5703125f;
+            const float PIO2_2 = 4.837512969970703125e-4f;
+            const float PIO2_3 = 7.54978995489188216e-8f;
+            const float SIN_C3 = -1.6666654611e-1f;
+            const float SIN_C5 = 8.3321608736e-3f;
+            const float SIN_C7 = -1.9515295891e-4f;
+            const float COS_C4 = 4.166664568298827e-2f;
+            const float COS_C6 = -1.388731625493765e-3f;
+            const float COS_C8 = 2.443315711809948e-5f;
+
+            // exp：x = n * ln2 + r，2^n 直接写入指数位
+            const float EXP_HI = 88.3762626647949f;
+            const float EXP_LO = -87.3365478515625f;
+            const float LOG2E = 1.44269504088896341f;
+            const float LN2_HI = 0.693359375f;
+            const float LN2_LO = -2.12194440e-4f;
+            const float EXP_P0 = 1.9875691500e-4f;
+            const float EXP_P1 = 1.3981999507e-3f;
+            const float EXP_P2 = 8.3334519073e-3f;
+            const float EXP_P3 = 4.1665795894e-2f;
+            const float EXP_P4 = 1.6666665459e-1f;
+            const float EXP_P5 = 5.0000001201e-1f;
+
+            const float QUARTER_PI = 0.785398163397448310f;
+            const float HALF_PI = 1.57079632679489662f;
+            const float PI = 3.14159265358979324f;
+
+            // ==================== 标量版本 ====================
+            inline float atan2_scalar(float y, float x) {
+                float ax = std::fabs(x), ay = std::fabs(y);
+                float hi = ax > ay ? ax : ay;
+                float lo = ax > ay ? ay : ax;
+                // lo / hi > tan(pi/8) 时改用 atan(t) = pi/4 + atan((t - 1) / (t + 1))
+                bool big = lo > TAN_PI_8 * hi;
+                float num = big ? lo - hi : lo;
+                float den = big ? lo + hi : hi;
+                float a = den > 0.0f ? num / den : 0.0f;
+                float z = a * a;
+                float p = ((ATAN_C9 * z + ATAN_C7) * z + ATAN_C5) * z + ATAN_C3;
+                float r = p * z * a + a + (big ? QUARTER_PI : 0.0f);
+                if (ay > ax) r = HALF_PI - r;
+                if (x < 0.0f) r = PI - r;
+                return std::signbit(y) ? -r : r;
+            }
+
+            inline void sincos_scalar(float x, float& s, float& c) {
+                float j = std::nearbyint(x * TWO_OVER_PI);
+                float r = ((x - j * PIO2_1) - j * PIO2_2) - j * PIO2_3;
+                float z = r * r;
+                float sr = ((SIN_C7 * z + SIN_C5) * z + SIN_C3) * z * r + r;
+                float cr = ((COS_C8 * z + COS_C6) * z + COS_C4) * z * z - 0.5f * z + 1.0f;
+                switch (static_cast<int>(static_cast<int64_t>(j) & 3)) {
+                case 0: s = sr; c = cr; break;
+                case 1: s = cr; c = -sr; break;
+                case 2: s = -sr; c = -cr; break;
+                default: s = -cr; c = sr; break;
+                }
+            }
+
+            inline float sin_scalar(float x) { float s, c; sincos_scalar(x, s, c); return s; }
+            inline float cos_scalar(float x) { float s, c; sincos_scalar(x, s, c); return c; }
+
+            inline float rsqrt_scalar(float x) {
+                float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+                return y * (1.5f - 0.5f * x * y * y);
+            }
+
+            inline float exp_scalar(float x) {
+                x = x > EXP_HI ? EXP_HI : (x < EXP_LO ? EXP_LO : x);
+                float n = std::nearbyint(x * LOG2E);
+                float r = (x - n * LN2_HI) - n * LN2_LO;
+                float p = EXP_P0;
+                p = p * r + EXP_P1;
+                p = p * r + EXP_P2;
+                p = p * r + EXP_P3;
+                p = p * r + EXP_P4;
+                p = p * r + EXP_P5;
+                p = p * r * r + r + 1.0f;
+                uint32_t bits = static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23;
+                float scale;
+                std::memcpy(&scale, &bits, sizeof(scale));
+                return p * scale;
+            }
+
+            // ==================== AVX2 版本 ====================
+#ifdef PA2D_AVX2
+            inline __m256 atan2_avx(__m256 y, __m256 x) {
+                const __m256 signMask = _mm256_set1_ps(-0.0f);
+                __m256 ax = _mm256_andnot_ps(signMask, x);
+                __m256 ay = _mm256_andnot_ps(signMask, y);
+                __m256 hi = _mm256_max_ps(ax, ay);
+                __m256 lo = _mm256_min_ps(ax, ay);
+                __m256 big = _mm256_cmp_ps(lo, _mm256_mul_ps(_mm256_set1_ps(TAN_PI_8), hi), _CMP_GT_OQ);
+                __m256 num = _mm256_blendv_ps(lo, _mm256_sub_ps(lo, hi), big);
+                __m256 den = _mm256_blendv_ps(hi, _mm256_add_ps(lo, hi), big);
+                // 原点处 0 / 0 取 0
+                __m256 a = _mm256_and_ps(_mm256_div_ps(num, den), _mm256_cmp_ps(den, _mm256_setzero_ps(), _CMP_GT_OQ));
+                __m256 z = _mm256_mul_ps(a, a);
+                __m256 p = _mm256_fmadd_ps(_mm256_set1_ps(ATAN_C9), z, _mm256_set1_ps(ATAN_C7));
+                p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(ATAN_C5));
+                p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(ATAN_C3));
+                __m256 r = _mm256_fmadd_ps(_mm256_mul_ps(p, z), a, _mm256_add_ps(a, _mm256_and_ps(big, _mm256_set1_ps(QUARTER_PI))));
+                r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(HALF_PI), r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+                r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(PI), r), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+                return _mm256_xor_ps(r, _mm256_and_ps(y, signMask));
+            }
+
+            inline void sincos_avx(__m256 x, __m256& s, __m256& c) {
+                __m256 j = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(TWO_OVER_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                __m256 r = _mm256_fnmadd_ps(j, _mm256_set1_ps(PIO2_1), x);
+                r = _mm256_fnmadd_ps(j, _mm256_set1_ps(PIO2_2), r);
+                r = _mm256_fnmadd_ps(j, _mm256_set1_ps(PIO2_3), r);
+                __m256 z = _mm256_mul_ps(r, r);
+
+                __m256 sr = _mm256_fmadd_ps(_mm256_set1_ps(SIN_C7), z, _mm256_set1_ps(SIN_C5));
+                sr = _mm256_fmadd_ps(sr, z, _mm256_set1_ps(SIN_C3));
+                sr = _mm256_fmadd_ps(_mm256_mul_ps(sr, z), r, r);
+
+                __m256 cr = _mm256_fmadd_ps(_mm256_set1_ps(COS_C8), z, _mm256_set1_ps(COS_C6));
+                cr = _mm256_fmadd_ps(cr, z, _mm256_set1_ps(COS_C4));
+                cr = _mm256_fmadd_ps(_mm256_mul_ps(cr, z), z, _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, _mm256_set1_ps(1.0f)));
+
+                // 象限 q = j & 3：q 为奇数时 sin/cos 互换，sin 在 q = 2,3 取负，cos 在 q = 1,2 取负
+                __m256i q = _mm256_cvtps_epi32(j);
+                __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+                __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30));
+                __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+                s = _mm256_xor_ps(_mm256_blendv_ps(sr, cr, swap), sinSign);
+                c = _mm256_xor_ps(_mm256_blendv_ps(cr, sr, swap), cosSign);
+            }
+
+            inline __m256 sin_avx(__m256 x) { __m256 s, c; sincos_avx(x, s, c); return s; }
+            inline __m256 cos_avx(__m256 x) { __m256 s, c; sincos_avx(x, s, c); return c; }
+
+            inline __m256 rsqrt_avx(__m256 x) {
+                __m256 y = _mm256_rsqrt_ps(x);
+                // 一次牛顿迭代：y = y * (1.5 - 0.5 * x * y^2)
+                __m256 hxy = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), y);
+                return _mm256_mul_ps(y, _mm256_fnmadd_ps(hxy, y, _mm256_set1_ps(1.5f)));
+            }
+
+            inline __m256 exp_avx(__m256 x) {
+                x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXP_LO)), _mm256_set1_ps(EXP_HI));
+                __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_HI), x);
+                r = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_LO), r);
+                __m256 p = _mm256_set1_ps(EXP_P0);
+                p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P1));
+                p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P2));
+                p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P3));
+                p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P4));
+                p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_P5));
+                p = _mm256_fmadd_ps(_mm256_mul_ps(p, r), r, _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+                __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+                return _mm256_mul_ps(p, _mm256_castsi256_ps(bits));
+            }
+
+#endif
+
+            // ==================== SSE 版本（4 像素） ====================
+            inline __m128 atan2_sse(__m128 y, __m128 x) {
+                const __m128 signMask = _mm_set1_ps(-0.0f);
+                __m128 ax = _mm_andnot_ps(signMask, x);
+                __m128 ay = _mm_andnot_ps(signMask, y);
+                __m128 hi = _mm_max_ps(ax, ay);
+                __m128 lo = _mm_min_ps(ax, ay);
+                __m128 big = _mm_cmpgt_ps(lo, _mm_mul_ps(_mm_set1_ps(TAN_PI_8), hi));
+                __m128 num = _mm_blendv_ps(lo, _mm_sub_ps(lo, hi), big);
+                __m128 den = _mm_blendv_ps(hi, _mm_add_ps(lo, hi), big);
+                __m128 a = _mm_and_ps(_mm_div_ps(num, den), _mm_cmpgt_ps(den, _mm_setzero_ps()));
+                __m128 z = _mm_mul_ps(a, a);
+                __m128 p = fmadd_sse(_mm_set1_ps(ATAN_C9), z, _mm_set1_ps(ATAN_C7));
+                p = fmadd_sse(p, z, _mm_set1_ps(ATAN_C5));
+                p = fmadd_sse(p, z, _mm_set1_ps(ATAN_C3));
+                __m128 r = fmadd_sse(_mm_mul_ps(p, z), a, _mm_add_ps(a, _mm_and_ps(big, _mm_set1_ps(QUARTER_PI))));
+                r = _mm_blendv_ps(r, _mm_sub_ps(_mm_set1_ps(HALF_PI), r), _mm_cmpgt_ps(ay, ax));
+                r = _mm_blendv_ps(r, _mm_sub_ps(_mm_set1_ps(PI), r), _mm_cmplt_ps(x, _mm_setzero_ps()));
+                return _mm_xor_ps(r, _mm_and_ps(y, signMask));
+            }
+
+            inline __m128 rsqrt_sse(__m128 x) {
+                __m128 y = _mm_rsqrt_ps(x);
+                __m128 hxy = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), y);
+                return _mm_mul_ps(y, fnmadd_sse(hxy, y, _mm_set1_ps(1.5f)));
+            }
+        }
+        }
+
+        namespace vmath = PA2D_ISA::vmath;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+// mip_chain.cpp
+#include "../include/mip_chain.h"
+#include <algorithm>
+
+namespace pa2d {
+    MipChain::MipChain(const Buffer& src, int maxLevels) {
+        build(src, maxLevels);
+    }
+
+    void MipChain::build(const Buffer& src, int maxLevels) {
+        levels_.clear();
+        if (!src.isValid()) return;
+        levels_.push_back(src);
+        while (maxLevels <= 0 || static_cast<int>(levels_.size()) < maxLevels) {
+            const Buffer& last = levels_.back();
+            if (last.width == 1 && last.height == 1) break;
+            Buffer next = halved(last);
+            if (!next.isValid()) break;
+            levels_.push_back(std::move(next));
+        }
+    }
+
+    int MipChain::levelFor(int width, int height) const {
+        int index = 0;
+        while (index + 1 < levels() &&
+            levels_[index + 1].width >= width && levels_[index + 1].height >= height) {
+            ++index;
+        }
+        return index;
+    }
+
+    Buffer MipChain::resized(int width, int height) const {
+        if (!isValid() || width <= 0 || height <= 0) return Buffer();
+        // 剩余的单方向大比例缩小仍由 pa2d::resized 逐级减半
+        return pa2d::resized(levels_[levelFor(width, height)], width, height);
+    }
+
+    Buffer MipChain::scaled(float scaleX, float scaleY) const {
+        if (!isValid() || scaleX <= 0.0f || scaleY <= 0.0f) return Buffer();
+        const Buffer& src = levels_[0];
+        return resized(std::max(1, static_cast<int>(src.width * scaleX)),
+            std::max(1, static_cast<int>(src.height * scaleY)));
+    }
+
+    Buffer MipChain::scaled(float factor) const {
+        return scaled(factor, factor);
+    }
+
+    void MipChain::drawScaled(Buffer& dest, float centerX, float centerY, float scaleX, float scaleY) const {
+        if (!isValid() || scaleX <= 0.0f || scaleY <= 0.0f) return;
+        const Buffer& src = levels_[0];
+        const Buffer& level = levels_[levelFor(static_cast<int>(src.width * scaleX), static_cast<int>(src.height * scaleY))];
+        // 换算成相对所选级别的比例，保持与直接缩放源图相同的目标尺寸
+        pa2d::drawScaled(dest, level, centerX, centerY,
+            scaleX * src.width / level.width, scaleY * src.height / level.height);
+    }
+
+    void MipChain::drawScaled(Buffer& dest, float centerX, float centerY, float scale) const {
+        drawScaled(dest, centerX, centerY, scale, scale);
+    }
+
+    void MipChain::drawResized(Buffer& dest, float centerX, float centerY, int width, int height) const {
+        if (!isValid() || width <= 0 || height <= 0) return;
+        pa2d::drawResized(dest, levels_[levelFor(width, height)], centerX, centerY, width, height);
+    }
+}
@@ -0,0 +1,238 @@
+// resample.cpp
+#include "../include/resample.h"
+#include "internal/kernels.h"
+#include "internal/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace pa2d {
+    namespace {
+        const int WEIGHT_BITS = utils::RESAMPLE_WEIGHT_BITS;
+        const int WEIGHT_ONE = 1 << WEIGHT_BITS;
+        const double PI = 3.14159265358979323846;
+
+        double filterRadius(ResampleFilter filter) {
+            switch (filter) {
+            case ResampleFilter::Nearest: return 0.5;
+            case ResampleFilter::Bilinear: return 1.0;
+            case ResampleFilter::Bicubic: return 2.0;
+            default: return 3.0;
+            }
+        }
+
+        double filterWeight(ResampleFilter filter, double x) {
+            const double ax = std::fabs(x);
+            switch (filter) {
+            case ResampleFilter::Nearest:
+                return (x >= -0.5 && x < 0.5) ? 1.0 : 0.0;
+            case ResampleFilter::Bilinear:
+                return ax < 1.0 ? 1.0 - ax : 0.0;
+            case ResampleFilter::Bicubic: {
+                const double a = -0.5;
+                if (ax < 1.0) return ((a + 2.0) * ax - (a + 3.0)) * ax * ax + 1.0;
+                if (ax < 2.0) return ((a * ax - 5.0 * a) * ax + 8.0 * a) * ax - 4.0 * a;
+                return 0.0;
+            }
+            default:
+                if (ax < 1e-8) return 1.0;
+                if (ax >= 3.0) return 0.0;
+                return 3.0 * std::sin(PI * x) * std::sin(PI * x / 3.0) / (PI * PI * x * x);
+            }
+        }
+    }
+
+    // ============================================================================
+    // 权重表
+    // ============================================================================
+
+    Resampler::Table Resampler::buildTable(int srcSize, int dstSize, ResampleFilter filter) {
+        const double scale = static_cast<double>(srcSize) / dstSize;
+        // 缩小时展宽滤波器做区域平均；最近邻始终只取一个像素
+        const double filterScale = filter == ResampleFilter::Nearest ? 1.0 : std::max(1.0, scale);
+        const double support = filterRadius(filter) * filterScale;
+        const int maxSpan = static_cast<int>(std::ceil(support * 2.0)) + 2;
+
+        Table table;
+        if (filter == ResampleFilter::Nearest) {
+            // 最近邻只需下标：taps = 1，start 即源像素
+            table.taps = 1;
+            table.start.resize(dstSize);
+            for (int i = 0; i < dstSize; ++i) {
+                table.start[i] = std::min(srcSize - 1, static_cast<int>((i + 0.5) * scale));
+            }
+            return table;
+        }
+
+        std::vector<int> first(dstSize), count(dstSize);
+        std::vector<double> weights(static_cast<size_t>(dstSize) * maxSpan);
+        int widest = 1;
+        for (int i = 0; i < dstSize; ++i) {
+            // 像素中心对齐：输出像素 i 的中心映射到源坐标 (i + 0.5) * scale
+            const double center = (i + 0.5) * scale;
+            const int lo = std::max(0, static_cast<int>(std::floor(center - support + 0.5)));
+            const int hi = std::min(std::min(srcSize, lo + maxSpan), static_cast<int>(std::floor(center + support + 0.5)));
+            double* w = &weights[static_cast<size_t>(i) * maxSpan];
+            double total = 0.0;
+            for (int x = lo; x < hi; ++x) {
+                w[x - lo] = filterWeight(filter, (x + 0.5 - center) / filterScale);
+                total += w[x - lo];
+            }
+            if (hi <= lo || total <= 0.0) {
+                // 窗口内没有有效权重（恰好落在边界上），退化为最近的源像素
+                first[i] = std::min(srcSize - 1, std::max(0, static_cast<int>(center)));
+                count[i] = 1;
+                w[0] = 1.0;
+                continue;
+            }
+            for (int x = lo; x < hi; ++x) w[x - lo] /= total;
+            first[i] = lo;
+            count[i] = hi - lo;
+            widest = std::max(widest, hi - lo);
+        }
+
+        // 每个输出的抽头数统一向上取到 4 的倍数，横向一次读 4 个像素，纵向两行一组
+        table.taps = (widest + 3) & ~3;
+        table.start.resize(dstSize);
+        table.coeffs.assign(static_cast<size_t>(dstSize) * table.taps, 0);
+        for (int i = 0; i < dstSize; ++i) {
+            // 起点左移使窗口不越过末尾，多出的抽头权重为 0
+            const int start = std::max(0, std::min(first[i], srcSize - table.taps));
+            const int offset = first[i] - start;
+            int16_t* c = &table.coeffs[static_cast<size_t>(i) * table.taps + offset];
+            const double* w = &weights[static_cast<size_t>(i) * maxSpan];
+            int total = 0, peak = 0;
+            for (int k = 0; k < count[i]; ++k) {
+                c[k] = static_cast<int16_t>(std::lround(w[k] * WEIGHT_ONE));
+                total += c[k];
+                if (c[k] > c[peak]) peak = k;
+            }
+            // 舍入误差补到最大权重上，保证纯色区域不变
+            c[peak] = static_cast<int16_t>(c[peak] + WEIGHT_ONE - total);
+            table.start[i] = start;
+        }
+        return table;
+    }
+
+    // ============================================================================
+    // 重采样
+    // ============================================================================
+
+    Resampler::Resampler(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ResampleFilter filter)
+        : filter_(filter) {
+        if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0) return;
+        srcWidth_ = srcWidth;
+        srcHeight_ = srcHeight;
+        dstWidth_ = dstWidth;
+        dstHeight_ = dstHeight;
+        if (srcWidth != dstWidth) horizontal_ = buildTable(srcWidth, dstWidth, filter);
+        if (srcHeight != dstHeight) vertical_ = buildTable(srcHeight, dstHeight, filter);
+    }
+
+    bool Resampler::matches(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ResampleFilter filter) const {
+        return isValid() && srcWidth_ == srcWidth && srcHeight_ == srcHeight &&
+            dstWidth_ == dstWidth && dstHeight_ == dstHeight && filter_ == filter;
+    }
+
+    bool Resampler::apply(const Buffer& src, Buffer& dest) const {
+        if (!isValid() || !src.isValid() || src.width != srcWidth_ || src.height != srcHeight_) return false;
+        if (dest.width != dstWidth_ || dest.height != dstHeight_) {
+            if (dest.color && !dest.allocator) return false;
+            dest = Buffer(dstWidth_, dstHeight_);
+            if (!dest.isValid()) return false;
+        }
+        dest.format = src.format;
+
+        const bool scaleX = srcWidth_ != dstWidth_;
+        const bool scaleY = srcHeight_ != dstHeight_;
+
+        if (filter_ == ResampleFilter::Nearest) {
+            utils::parallelRows(0, dstHeight_ - 1, dstWidth_, [&](int rowBegin, int rowEnd) {
+                for (int y = rowBegin; y <= rowEnd; ++y) {
+                    const int sy = scaleY ? vertical_.start[y] : y;
+                    Color* out = dest.getRow(y);
+                    // 放大时相邻输出行取自同一源行，直接复制上一行
+                    if (y > rowBegin && scaleY && vertical_.start[y - 1] == sy) {
+                        std::memcpy(out, dest.getRow(y - 1), static_cast<size_t>(dstWidth_) * sizeof(Color));
+                        continue;
+                    }
+                    const Color* row = src.getRow(sy);
+                    if (!scaleX) {
+                        std::memcpy(out, row, static_cast<size_t>(dstWidth_) * sizeof(Color));
+                        continue;
+                    }
+                    utils::kernels().nearestRow(row, srcWidth_, out, dstWidth_, horizontal_.start.data());
+                }
+            });
+            return true;
+        }
+
+        if (!scaleY) {
+            utils::parallelRows(0, dstHeight_ - 1, dstWidth_, [&](int rowBegin, int rowEnd) {
+                for (int y = rowBegin; y <= rowEnd; ++y) {
+                    if (scaleX) {
+                        utils::kernels().resampleRow(src.getRow(y), srcWidth_, dest.getRow(y), dstWidth_,
+                            horizontal_.start.data(), horizontal_.coeffs.data(), horizontal_.taps);
+                    }
+                    else {
+                        std::memcpy(dest.getRow(y), src.getRow(y), static_cast<size_t>(dstWidth_) * sizeof(Color));
+                    }
+                }
+            });
+            return true;
+        }
+
+        // 横向结果不落成整张中间图：每个行带维护 taps 行的环形缓存，源行 r 存放在 r % taps 槽位
+        // 纵向窗口的起点单调不减，窗口内的行互不冲突，每个源行在行带内只横向处理一次
+        const int taps = vertical_.taps;
+        utils::parallelRows(0, dstHeight_ - 1, dstWidth_, [&](int rowBegin, int rowEnd) {
+            std::vector<Color> ring(scaleX ? static_cast<size_t>(taps) * dstWidth_ : 0);
+            std::vector<const Color*> rows(taps);
+            int filled = vertical_.start[rowBegin]; // 已横向处理到的源行（不含）
+            for (int y = rowBegin; y <= rowEnd; ++y) {
+                const int first = vertical_.start[y];
+                const int last = std::min(first + taps, srcHeight_);
+                for (int r = std::max(filled, first); r < last; ++r) {
+                    if (scaleX) {
+                        utils::kernels().resampleRow(src.getRow(r), srcWidth_, &ring[static_cast<size_t>(r % taps) * dstWidth_], dstWidth_,
+                            horizontal_.start.data(), horizontal_.coeffs.data(), horizontal_.taps);
+                    }
+                }
+                filled = std::max(filled, last);
+                // 超出末行的抽头权重为 0，指向窗口首行即可
+                for (int k = 0; k < taps; ++k) {
+                    const int r = first + k < srcHeight_ ? first + k : first;
+                    rows[k] = scaleX ? &ring[static_cast<size_t>(r % taps) * dstWidth_] : src.getRow(r);
+                }
+                utils::kernels().resampleColumns(rows.data(), &vertical_.coeffs[static_cast<size_t>(y) * taps], taps, dest.getRow(y), 0, dstWidth_);
+            }
+        });
+        return true;
+    }
+
+    Buffer Resampler::apply(const Buffer& src) const {
+        Buffer result;
+        if (!apply(src, result)) return Buffer();
+        return result;
+    }
+
+    Buffer resized(const Buffer& src, int width, int height, ResampleFilter filter) {
+        if (!src.isValid() || width <= 0 || height <= 0) return Buffer();
+        thread_local Resampler cached;
+        if (!cached.matches(src.width, src.height, width, height, filter)) {
+            cached = Resampler(src.width, src.height, width, height, filter);
+        }
+        return cached.apply(src);
+    }
+
+    Buffer upscaled(const Buffer& src, int factor) {
+        if (!src.isValid() || factor <= 0) return Buffer();
+        return resized(src, src.width * factor, src.height * factor, ResampleFilter::Nearest);
+    }
+
+    Buffer scaled(const Buffer& src, float scaleX, float scaleY, ResampleFilter filter) {
+        if (!src.isValid() || scaleX <= 0.0f || scaleY <= 0.0f) return Buffer();
+        return resized(src, std::max(1, static_cast<int>(src.width * scaleX)),
+            std::max(1, static_cast<int>(src.height * scaleY)), filter);
+    }
+}
@@ -0,0 +1,186 @@
+// sprite_batch.cpp
+#include "../include/sprite_batch.h"
+#include "internal/blend_modes.h"
+#include "internal/clip.h"
+#include "internal/kernels.h"
+#include "internal/thread_pool.h"
+#include "internal/vec_math.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pa2d {
+    SpriteBatch::SpriteBatch(int tileSize) : tileSize_(std::max(16, tileSize)) {}
+
+    SpriteBatch& SpriteBatch::clear() {
+        sprites_.clear();
+        return *this;
+    }
+
+    SpriteBatch& SpriteBatch::reserve(size_t count) {
+        sprites_.reserve(count);
+        instances_.reserve(count);
+        return *this;
+    }
+
+    SpriteBatch& SpriteBatch::add(const Sprite& sprite) {
+        sprites_.push_back(sprite);
+        return *this;
+    }
+
+    SpriteBatch& SpriteBatch::add(const Buffer& source, float x, float y, float scale, float rotation,
+                                  float opacity, BlendMode blend) {
+        return add(source, 0, 0, 0, 0, x, y, scale, rotation, opacity, blend);
+    }
+
+    SpriteBatch& SpriteBatch::add(const Buffer& source, int srcX, int srcY, int srcWidth, int srcHeight,
+                                  float x, float y, float scale, float rotation, float opacity, BlendMode blend) {
+        Sprite sprite;
+        sprite.source = &source;
+        sprite.srcX = srcX;
+        sprite.srcY = srcY;
+        sprite.srcWidth = srcWidth;
+        sprite.srcHeight = srcHeight;
+        sprite.x = x;
+        sprite.y = y;
+        sprite.scaleX = sprite.scaleY = scale;
+        sprite.rotation = rotation;
+        sprite.opacity = opacity;
+        sprite.blend = blend;
+        sprites_.push_back(sprite);
+        return *this;
+    }
+
+    SpriteBatch& SpriteBatch::add(const Atlas& atlas, const AtlasRegion& region, float x, float y, float scale,
+                                  float rotation, float opacity, BlendMode blend) {
+        // 宽高为 0 的源矩形表示整张源图，无效区域必须在此排除
+        if (!region) return *this;
+        return add(atlas.buffer(), region.x, region.y, region.width, region.height, x, y, scale, rotation, opacity, blend);
+    }
+
+    void SpriteBatch::prepare(const Buffer& target) {
+        instances_.clear();
+        const utils::ClipRect clip = utils::currentClip(target);
+
+        for (const Sprite& sprite : sprites_) {
+            const Buffer* src = sprite.source;
+            if (!src || !src->isValid() || sprite.scaleX <= 0.0f || sprite.scaleY <= 0.0f) continue;
+            const float opacity = std::min(std::max(sprite.opacity, 0.0f), 1.0f);
+            if (opacity <= 0.0f && utils::blendModeNoopOnTransparent(sprite.blend)) continue;
+
+            // 源矩形与源图求交
+            int left = sprite.srcX, top = sprite.srcY, right, bottom;
+            if (sprite.srcWidth <= 0 || sprite.srcHeight <= 0) {
+                left = top = 0;
+                right = src->width;
+                bottom = src->height;
+            }
+            else {
+                right = std::min(src->width, left + sprite.srcWidth);
+                bottom = std::min(src->height, top + sprite.srcHeight);
+                left = std::max(0, left);
+                top = std::max(0, top);
+            }
+            if (left >= right || top >= bottom) continue;
+
+            Instance inst;
+            inst.pixels = src->getRow(top) + left;
+            inst.stride = src->stride;
+            inst.width = right - left;
+            inst.height = bottom - top;
+            inst.premultiplied = src->isPremultiplied();
+            inst.opacity = opacity;
+            inst.blend = sprite.blend;
+
+            // 逆变换：目标像素相对精灵中心的偏移先反向旋转再除以缩放，与 drawTransformed 的采样位置一致
+            float sinA, cosA;
+            utils::vmath::sincos_scalar(sprite.rotation, sinA, cosA);
+            const float invScaleX = 1.0f / sprite.scaleX;
+            const float invScaleY = 1.0f / sprite.scaleY;
+            inst.dudx = cosA * invScaleX;
+            inst.dudy = sinA * invScaleX;
+            inst.dvdx = -sinA * invScaleY;
+            inst.dvdy = cosA * invScaleY;
+            inst.u0 = inst.width * 0.5f - sprite.x * inst.dudx - sprite.y * inst.dudy;
+            inst.v0 = inst.height * 0.5f - sprite.x * inst.dvdx - sprite.y * inst.dvdy;
+
+            // 包围盒覆盖 (-1, width) x (-1, height) 的采样范围，源矩形两侧各放宽一个像素
+            const float halfW = (inst.width + 2) * 0.5f * sprite.scaleX;
+            const float halfH = (inst.height + 2) * 0.5f * sprite.scaleY;
+            const float boundX = std::abs(halfW * cosA) + std::abs(halfH * sinA);
+            const float boundY = std::abs(halfW * sinA) + std::abs(halfH * cosA);
+            inst.minX = std::max(clip.minX, static_cast<int>(std::floor(sprite.x - boundX)));
+            inst.minY = std::max(clip.minY, static_cast<int>(std::floor(sprite.y - boundY)));
+            inst.maxX = std::min(clip.maxX, static_cast<int>(std::ceil(sprite.x + boundX)));
+            inst.maxY = std::min(clip.maxY, static_cast<int>(std::ceil(sprite.y + boundY)));
+            if (inst.minX > inst.maxX || inst.minY > inst.maxY) continue;
+
+            utils::reportDirty(inst.minX, inst.minY, inst.maxX, inst.maxY);
+            instances_.push_back(inst);
+        }
+    }
+
+    void SpriteBatch::bin(int width, int height) {
+        tilesX_ = (width + tileSize_ - 1) / tileSize_;
+        tilesY_ = (height + tileSize_ - 1) / tileSize_;
+        const size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+
+        // 第一遍：统计每个图块的实例数
+        binStart_.assign(tileCount + 1, 0);
+        for (const Instance& inst : instances_) {
+            for (int ty = inst.minY / tileSize_; ty <= inst.maxY / tileSize_; ++ty)
+                for (int tx = inst.minX / tileSize_; tx <= inst.maxX / tileSize_; ++tx)
+                    ++binStart_[static_cast<size_t>(ty) * tilesX_ + tx + 1];
+        }
+        for (size_t i = 0; i < tileCount; ++i) binStart_[i + 1] += binStart_[i];
+
+        // 第二遍：按录制顺序填入实例下标
+        binItems_.resize(binStart_[tileCount]);
+        binCursor_.assign(binStart_.begin(), binStart_.end() - 1);
+        for (size_t i = 0; i < instances_.size(); ++i) {
+            const Instance& inst = instances_[i];
+            for (int ty = inst.minY / tileSize_; ty <= inst.maxY / tileSize_; ++ty)
+                for (int tx = inst.minX / tileSize_; tx <= inst.maxX / tileSize_; ++tx)
+                    binItems_[binCursor_[static_cast<size_t>(ty) * tilesX_ + tx]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    void SpriteBatch::drawInstance(const Instance& inst, Buffer& target, int minX, int minY, int maxX, int maxY) {
+        minX = std::max(minX, inst.minX);
+        minY = std::max(minY, inst.minY);
+        maxX = std::min(maxX, inst.maxX);
+        maxY = std::min(maxY, inst.maxY);
+        if (minX > maxX || minY > maxY) return;
+
+        utils::SpriteInstance sample = {
+            inst.pixels, inst.stride, inst.width, inst.height, inst.premultiplied,
+            inst.u0, inst.dudx, inst.dudy, inst.v0, inst.dvdx, inst.dvdy,
+            inst.opacity, inst.blend
+        };
+        utils::kernels().spriteInstance(sample, target, minX, minY, maxX, maxY);
+    }
+
+    void SpriteBatch::render(Buffer& target) {
+        if (!target.isValid() || sprites_.empty()) return;
+        prepare(target);
+        if (instances_.empty()) return;
+        bin(target.width, target.height);
+
+        utils::parallelTasks(0, tilesX_ * tilesY_ - 1, [&](int first, int last) {
+            for (int tile = first; tile <= last; ++tile) {
+                const uint32_t begin = binStart_[tile];
+                const uint32_t end = binStart_[tile + 1];
+                if (begin == end) continue;
+
+                const int tx = tile % tilesX_;
+                const int ty = tile / tilesX_;
+                const int minX = tx * tileSize_;
+                const int minY = ty * tileSize_;
+                const int maxX = std::min(target.width, minX + tileSize_) - 1;
+                const int maxY = std::min(target.height, minY + tileSize_) - 1;
+                for (uint32_t i = begin; i < end; ++i) {
+                    drawInstance(instances_[binItems_[i]], target, minX, minY, maxX, maxY);
+                }
+            }
+            });
+    }
+}
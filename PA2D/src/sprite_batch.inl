@@ -0,0 +1,261 @@
+// sprite_batch.inl
+// SpriteBatch 单个实例的光栅化，由 kernels_sample_*.cpp 按各自指令集编译
+// AVX2 版本每次 8 像素并用 gather 取样；SSE4.1 版本每次 4 像素，逐个读取采样点
+#include "internal/blend_utils.h"
+#include "internal/kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace pa2d { namespace utils { namespace PA2D_ISA {
+    namespace {
+        // 约束 -1 < base + k * x < limit 与 [lo, hi] 求交，返回 false 表示本行没有像素落在源矩形附近
+        inline bool clampSpan(float base, float k, float limit, float& lo, float& hi) {
+            if (std::abs(k) < 1e-12f) return base > -1.0f && base < limit;
+            float a = (-1.0f - base) / k, b = (limit - base) / k;
+            if (a > b) std::swap(a, b);
+            lo = std::max(lo, a);
+            hi = std::min(hi, b);
+            return lo <= hi;
+        }
+    }
+
+    void spriteInstance(const SpriteInstance& inst, Buffer& target, int minX, int minY, int maxX, int maxY) {
+#ifdef PA2D_AVX2
+        const __m256 lane = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256 ones = _mm256_set1_ps(1.0f);
+        const __m256 minusOne = _mm256_set1_ps(-1.0f);
+        const __m256 limitU = _mm256_set1_ps(static_cast<float>(inst.width));
+        const __m256 limitV = _mm256_set1_ps(static_cast<float>(inst.height));
+        const __m256 dudx = _mm256_set1_ps(inst.dudx);
+        const __m256 dvdx = _mm256_set1_ps(inst.dvdx);
+        const __m256 alphaScale = _mm256_set1_ps(inst.opacity * (1.0f / 255.0f));
+        const __m256 inv255 = _mm256_set1_ps(1.0f / 255.0f);
+        const __m256i zeroIdx = _mm256_setzero_si256();
+        const __m256i maxU = _mm256_set1_epi32(inst.width - 1);
+        const __m256i maxV = _mm256_set1_epi32(inst.height - 1);
+        const __m256i stride = _mm256_set1_epi32(inst.stride);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i minusOneIdx = _mm256_set1_epi32(-1);
+        const __m256i maskFF = _mm256_set1_epi32(0xFF);
+        // 越界采样点：直通源与 drawTransformed 一样取透明白色，避免边缘变暗；预乘源取全 0
+        const __m256i border = _mm256_set1_epi32(inst.premultiplied ? 0 : 0x00FFFFFF);
+        const int* base = reinterpret_cast<const int*>(inst.pixels);
+
+        // 图层不透明度已乘进源 alpha，合成器只按混合模式与目标格式选取一次，源覆盖时走原有快速路径
+        withComposite(target, inst.blend, 1.0f, [&](const auto& comp) {
+        for (int y = minY; y <= maxY; ++y) {
+            const float rowU = inst.u0 + inst.dudy * static_cast<float>(y);
+            const float rowV = inst.v0 + inst.dvdy * static_cast<float>(y);
+
+            // 本行与源矩形相交的 x 区间，两端各放宽一个像素，逐像素的有效性由掩码判定
+            float lo = static_cast<float>(minX), hi = static_cast<float>(maxX);
+            if (!clampSpan(rowU, inst.dudx, static_cast<float>(inst.width), lo, hi) ||
+                !clampSpan(rowV, inst.dvdx, static_cast<float>(inst.height), lo, hi)) continue;
+            const int begin = std::max(minX, static_cast<int>(std::floor(lo)));
+            const int end = std::min(maxX, static_cast<int>(std::ceil(hi)));
+            const __m256 rowU8 = _mm256_set1_ps(rowU);
+            const __m256 rowV8 = _mm256_set1_ps(rowV);
+
+            Color* row = target.getRow(y);
+            for (int x = begin; x <= end; x += 8) {
+                const int count = std::min(8, end - x + 1);
+                const __m256 px = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), lane);
+                const __m256 u = _mm256_fmadd_ps(px, dudx, rowU8);
+                const __m256 v = _mm256_fmadd_ps(px, dvdx, rowV8);
+
+                __m256 inside = _mm256_and_ps(_mm256_cmp_ps(u, minusOne, _CMP_GT_OQ), _mm256_cmp_ps(u, limitU, _CMP_LT_OQ));
+                inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(v, minusOne, _CMP_GT_OQ), _mm256_cmp_ps(v, limitV, _CMP_LT_OQ)));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(lane, _mm256_set1_ps(static_cast<float>(count)), _CMP_LT_OQ));
+                if (_mm256_movemask_ps(inside) == 0) continue;
+                const __m256i insideI = _mm256_castps_si256(inside);
+
+                // 1. 四个采样点的下标与有效性，越界点不访问内存
+                const __m256 floorU = _mm256_floor_ps(u);
+                const __m256 floorV = _mm256_floor_ps(v);
+                const __m256 fx = _mm256_sub_ps(u, floorU);
+                const __m256 fy = _mm256_sub_ps(v, floorV);
+                const __m256i ix = _mm256_cvttps_epi32(floorU);
+                const __m256i iy = _mm256_cvttps_epi32(floorV);
+                const __m256i validX0 = _mm256_cmpgt_epi32(ix, minusOneIdx);
+                const __m256i validX1 = _mm256_cmpgt_epi32(maxU, ix);
+                const __m256i validY0 = _mm256_and_si256(_mm256_cmpgt_epi32(iy, minusOneIdx), insideI);
+                const __m256i validY1 = _mm256_and_si256(_mm256_cmpgt_epi32(maxV, iy), insideI);
+                const __m256i row0 = _mm256_mullo_epi32(_mm256_max_epi32(iy, zeroIdx), stride);
+                const __m256i row1 = _mm256_mullo_epi32(_mm256_min_epi32(_mm256_add_epi32(iy, one), maxV), stride);
+                const __m256i col0 = _mm256_max_epi32(ix, zeroIdx);
+                const __m256i col1 = _mm256_min_epi32(_mm256_add_epi32(ix, one), maxU);
+
+                const __m256i c00 = _mm256_mask_i32gather_epi32(border, base, _mm256_add_epi32(row0, col0), _mm256_and_si256(validX0, validY0), 4);
+                const __m256i c10 = _mm256_mask_i32gather_epi32(border, base, _mm256_add_epi32(row0, col1), _mm256_and_si256(validX1, validY0), 4);
+                const __m256i c01 = _mm256_mask_i32gather_epi32(border, base, _mm256_add_epi32(row1, col0), _mm256_and_si256(validX0, validY1), 4);
+                const __m256i c11 = _mm256_mask_i32gather_epi32(border, base, _mm256_add_epi32(row1, col1), _mm256_and_si256(validX1, validY1), 4);
+
+                // 2. 双线性插值（0-255）
+                const __m256 gx = _mm256_sub_ps(ones, fx);
+                const __m256 gy = _mm256_sub_ps(ones, fy);
+                const __m256 w00 = _mm256_mul_ps(gx, gy);
+                const __m256 w10 = _mm256_mul_ps(fx, gy);
+                const __m256 w01 = _mm256_mul_ps(gx, fy);
+                const __m256 w11 = _mm256_mul_ps(fx, fy);
+                auto channel = [&](int shift) {
+                    auto tap = [&](const __m256i& c) {
+                        return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c, shift), maskFF));
+                    };
+                    return _mm256_fmadd_ps(tap(c00), w00, _mm256_fmadd_ps(tap(c10), w10,
+                        _mm256_fmadd_ps(tap(c01), w01, _mm256_mul_ps(tap(c11), w11))));
+                };
+                const __m256 a = channel(24);
+                __m256 r = channel(16);
+                __m256 g = channel(8);
+                __m256 b = channel(0);
+
+                // 3. 转为直通 0-1 颜色，预乘源按插值后的 alpha 还原
+                __m256 colorScale = inv255;
+                if (inst.premultiplied) {
+                    const __m256 positive = _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_GT_OQ);
+                    colorScale = _mm256_and_ps(positive, _mm256_div_ps(ones, a));
+                }
+                r = _mm256_min_ps(_mm256_mul_ps(r, colorScale), ones);
+                g = _mm256_min_ps(_mm256_mul_ps(g, colorScale), ones);
+                b = _mm256_min_ps(_mm256_mul_ps(b, colorScale), ones);
+                const __m256 alpha = _mm256_mul_ps(a, alphaScale);
+                const __m256 write = _mm256_and_ps(inside, _mm256_cmp_ps(alpha, _mm256_setzero_ps(), _CMP_GT_OQ));
+                if (_mm256_movemask_ps(write) == 0) continue;
+
+                // 4. 合成；inside 已排除 count 之外的通道，尾部用掩码读写，不越过行尾
+                const __m256i writeMask = _mm256_castps_si256(write);
+                int* dst = reinterpret_cast<int*>(row + x);
+                const __m256i dest = count == 8 ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst))
+                                                : _mm256_maskload_epi32(dst, insideI);
+                const __m256i blended = comp.avx(alpha, dest, r, g, b, ones);
+                _mm256_maskstore_epi32(dst, writeMask, blended);
+            }
+        }
+        });
+#else
+        const __m128 lane = _mm_setr_ps(0, 1, 2, 3);
+        const __m128 ones = _mm_set1_ps(1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+        const __m128 limitU = _mm_set1_ps(static_cast<float>(inst.width));
+        const __m128 limitV = _mm_set1_ps(static_cast<float>(inst.height));
+        const __m128 dudx = _mm_set1_ps(inst.dudx);
+        const __m128 dvdx = _mm_set1_ps(inst.dvdx);
+        const __m128 alphaScale = _mm_set1_ps(inst.opacity * (1.0f / 255.0f));
+        const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+        const __m128i zeroIdx = _mm_setzero_si128();
+        const __m128i maxU = _mm_set1_epi32(inst.width - 1);
+        const __m128i maxV = _mm_set1_epi32(inst.height - 1);
+        const __m128i stride = _mm_set1_epi32(inst.stride);
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i minusOneIdx = _mm_set1_epi32(-1);
+        const __m128i maskFF = _mm_set1_epi32(0xFF);
+        // 越界采样点：直通源与 drawTransformed 一样取透明白色，避免边缘变暗；预乘源取全 0
+        const int border = inst.premultiplied ? 0 : 0x00FFFFFF;
+        const int* base = reinterpret_cast<const int*>(inst.pixels);
+
+        // 没有 gather 指令：4 个下标逐个读取，无效的采样点不访问内存
+        auto gather = [&](const __m128i& offset, const __m128i& valid) {
+            alignas(16) int index[4], ok[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(index), offset);
+            _mm_store_si128(reinterpret_cast<__m128i*>(ok), valid);
+            return _mm_setr_epi32(ok[0] ? base[index[0]] : border, ok[1] ? base[index[1]] : border,
+                                  ok[2] ? base[index[2]] : border, ok[3] ? base[index[3]] : border);
+        };
+
+        withComposite(target, inst.blend, 1.0f, [&](const auto& comp) {
+        for (int y = minY; y <= maxY; ++y) {
+            const float rowU = inst.u0 + inst.dudy * static_cast<float>(y);
+            const float rowV = inst.v0 + inst.dvdy * static_cast<float>(y);
+
+            float lo = static_cast<float>(minX), hi = static_cast<float>(maxX);
+            if (!clampSpan(rowU, inst.dudx, static_cast<float>(inst.width), lo, hi) ||
+                !clampSpan(rowV, inst.dvdx, static_cast<float>(inst.height), lo, hi)) continue;
+            const int begin = std::max(minX, static_cast<int>(std::floor(lo)));
+            const int end = std::min(maxX, static_cast<int>(std::ceil(hi)));
+            const __m128 rowU4 = _mm_set1_ps(rowU);
+            const __m128 rowV4 = _mm_set1_ps(rowV);
+
+            Color* row = target.getRow(y);
+            for (int x = begin; x <= end; x += 4) {
+                const int count = std::min(4, end - x + 1);
+                const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane);
+                const __m128 u = fmadd_sse(px, dudx, rowU4);
+                const __m128 v = fmadd_sse(px, dvdx, rowV4);
+
+                __m128 inside = _mm_and_ps(_mm_cmpgt_ps(u, minusOne), _mm_cmplt_ps(u, limitU));
+                inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpgt_ps(v, minusOne), _mm_cmplt_ps(v, limitV)));
+                inside = _mm_and_ps(inside, _mm_cmplt_ps(lane, _mm_set1_ps(static_cast<float>(count))));
+                if (_mm_movemask_ps(inside) == 0) continue;
+                const __m128i insideI = _mm_castps_si128(inside);
+
+                // 1. 四个采样点的下标与有效性
+                const __m128 floorU = _mm_floor_ps(u);
+                const __m128 floorV = _mm_floor_ps(v);
+                const __m128 fx = _mm_sub_ps(u, floorU);
+                const __m128 fy = _mm_sub_ps(v, floorV);
+                const __m128i ix = _mm_cvttps_epi32(floorU);
+                const __m128i iy = _mm_cvttps_epi32(floorV);
+                const __m128i validX0 = _mm_cmpgt_epi32(ix, minusOneIdx);
+                const __m128i validX1 = _mm_cmpgt_epi32(maxU, ix);
+                const __m128i validY0 = _mm_and_si128(_mm_cmpgt_epi32(iy, minusOneIdx), insideI);
+                const __m128i validY1 = _mm_and_si128(_mm_cmpgt_epi32(maxV, iy), insideI);
+                const __m128i row0 = _mm_mullo_epi32(_mm_max_epi32(iy, zeroIdx), stride);
+                const __m128i row1 = _mm_mullo_epi32(_mm_min_epi32(_mm_add_epi32(iy, one), maxV), stride);
+                const __m128i col0 = _mm_max_epi32(ix, zeroIdx);
+                const __m128i col1 = _mm_min_epi32(_mm_add_epi32(ix, one), maxU);
+
+                const __m128i c00 = gather(_mm_add_epi32(row0, col0), _mm_and_si128(validX0, validY0));
+                const __m128i c10 = gather(_mm_add_epi32(row0, col1), _mm_and_si128(validX1, validY0));
+                const __m128i c01 = gather(_mm_add_epi32(row1, col0), _mm_and_si128(validX0, validY1));
+                const __m128i c11 = gather(_mm_add_epi32(row1, col1), _mm_and_si128(validX1, validY1));
+
+                // 2. 双线性插值（0-255）
+                const __m128 gx = _mm_sub_ps(ones, fx);
+                const __m128 gy = _mm_sub_ps(ones, fy);
+                const __m128 w00 = _mm_mul_ps(gx, gy);
+                const __m128 w10 = _mm_mul_ps(fx, gy);
+                const __m128 w01 = _mm_mul_ps(gx, fy);
+                const __m128 w11 = _mm_mul_ps(fx, fy);
+                auto channel = [&](int shift) {
+                    auto tap = [&](const __m128i& c) {
+                        return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c, shift), maskFF));
+                    };
+                    return fmadd_sse(tap(c00), w00, fmadd_sse(tap(c10), w10,
+                        fmadd_sse(tap(c01), w01, _mm_mul_ps(tap(c11), w11))));
+                };
+                const __m128 a = channel(24);
+                __m128 r = channel(16);
+                __m128 g = channel(8);
+                __m128 b = channel(0);
+
+                // 3. 转为直通 0-1 颜色，预乘源按插值后的 alpha 还原
+                __m128 colorScale = inv255;
+                if (inst.premultiplied) {
+                    const __m128 positive = _mm_cmpgt_ps(a, _mm_setzero_ps());
+                    colorScale = _mm_and_ps(positive, _mm_div_ps(ones, a));
+                }
+                r = _mm_min_ps(_mm_mul_ps(r, colorScale), ones);
+                g = _mm_min_ps(_mm_mul_ps(g, colorScale), ones);
+                b = _mm_min_ps(_mm_mul_ps(b, colorScale), ones);
+                const __m128 alpha = _mm_mul_ps(a, alphaScale);
+                const __m128 write = _mm_and_ps(inside, _mm_cmpgt_ps(alpha, _mm_setzero_ps()));
+                if (_mm_movemask_ps(write) == 0) continue;
+
+                // 4. 合成；不写入的通道保留目标值，不足 4 像素的尾部经临时缓冲读写
+                Color tail[4];
+                Color* dst = row + x;
+                if (count < 4) {
+                    std::memcpy(tail, dst, count * sizeof(Color));
+                    dst = tail;
+                }
+                const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                const __m128i blended = comp.sse(alpha, dest, r, g, b, ones);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_blendv_epi8(dest, blended, _mm_castps_si128(write)));
+                if (count < 4) std::memcpy(row + x, tail, count * sizeof(Color));
+            }
+        }
+        });
+#endif
+    }
+}}}
@@ -3,7 +3,7 @@
 #include <algorithm>
 #include <string>
 namespace pa2d {
-    // 
+    // 常量定义
     const Style arc = [] {return Style().arc(true);}();
     const Style no_arc = [] {return Style().arc(false);}();
     const Style edges = [] {return Style().edges(true);}();
@@ -21,17 +21,19 @@ namespace pa2d {
         Gray_fill = 0xFF808080_fill, Gray_stroke = 0xFF808080_stroke,
         LightGray_fill = 0xFFC0C0C0_fill, LightGray_stroke = 0xFFC0C0C0_stroke,
         DarkGray_fill = 0xFF404040_fill, DarkGray_stroke = 0xFF404040_stroke;
-    // 캯
+    // 构造函数
     Style& Style::fill(Color v) { fill_ = v; return *this; }
     Style& Style::stroke(Color v) { stroke_ = v; return *this; }
     Style& Style::width(float v) { width_ = v; return *this; }
     Style& Style::radius(float v) { radius_ = v; return *this; }
     Style& Style::arc(bool v) { arc_ = v; return *this; }
     Style& Style::edges(bool v) { edges_ = v; return *this; }
-    Style::Style(Color fill, Color stroke, float width,float radius, bool arc, bool edges)
-        : fill_(fill), stroke_(stroke), width_(width),radius_(radius), arc_(arc), edges_(edges) {}
+    Style& Style::blend(BlendMode v) { blend_ = v; return *this; }
+    Style& Style::opacity(float v) { opacity_ = std::min(std::max(v, 0.0f), 1.0f); return *this; }
+    Style::Style(Color fill, Color stroke, float width,float radius, bool arc, bool edges, BlendMode blend, float opacity)
+        : fill_(fill), stroke_(stroke), width_(width),radius_(radius), arc_(arc), edges_(edges), blend_(blend), opacity_(opacity) {}
 
-    // ӷ
+    // 加法运算符
     Style Style::operator+(const Style& other) const {
         Style result = *this;
         if (other.fill_ != 0) result.fill_ = other.fill_;
@@ -40,6 +42,8 @@ namespace pa2d {
         if (other.radius_ != 0.0f) result.radius_ = other.radius_;
         if (other.arc_ != true) result.arc_ = other.arc_;
         if (other.edges_ != true) result.edges_ = other.edges_;
+        if (other.blend_ != BlendMode::SrcOver) result.blend_ = other.blend_;
+        if (other.opacity_ != 1.0f) result.opacity_ = other.opacity_;
         return result;
     }
 
@@ -48,7 +52,7 @@ namespace pa2d {
         return *this;
     }
 
-    // ɫַ
+    // 颜色字符串解析辅助函数
     namespace {
         inline uint8_t hexToDigit(char c) {
             if (c >= '0' && c <= '9') return c - '0';
@@ -61,42 +65,42 @@ namespace pa2d {
     uint32_t parseColorString(const char* str, size_t len) {
         std::string s(str, len);
 
-        //  #RRGGBB  #AARRGGBB ʽ
+        // 处理 #RRGGBB 或 #AARRGGBB 格式
         if (!s.empty() && s[0] == '#') {
             uint32_t color = 0;
             for (size_t i = 1; i < s.length(); ++i) {
                 color = (color << 4) | hexToDigit(s[i]);
             }
 
-            // 6λ# + 6ַAlpha
+            // 如果是6位（# + 6个字符），添加Alpha
             if (s.length() == 7) {
                 color |= 0xFF000000;
             }
             return color;
         }
 
-        //  R,G,B  A,R,G,B ʽ
+        // 处理 R,G,B 或 A,R,G,B 格式
         size_t pos1 = s.find(',');
         if (pos1 == std::string::npos) {
-            return 0x00000000;  // Чʽ
+            return 0x00000000;  // 无效格式
         }
 
         size_t pos2 = s.find(',', pos1 + 1);
         if (pos2 == std::string::npos) {
-            return 0x00000000;  // Ҫ
+            return 0x00000000;  // 至少需要两个逗号
         }
 
         size_t pos3 = s.find(',', pos2 + 1);
 
         if (pos3 == std::string::npos) {
-            // R,G,B ʽ - 
+            // R,G,B 格式 - 两个逗号
             int r = std::min(std::max(std::stoi(s.substr(0, pos1)), 0), 255);
             int g = std::min(std::max(std::stoi(s.substr(pos1 + 1, pos2 - pos1 - 1)), 0), 255);
             int b = std::min(std::max(std::stoi(s.substr(pos2 + 1)), 0), 255);
             return (255u << 24) | (r << 16) | (g << 8) | b;
         }
         else {
-            // A,R,G,B ʽ - 
+            // A,R,G,B 格式 - 三个逗号
             int a = std::min(std::max(std::stoi(s.substr(0, pos1)), 0), 255);
             int r = std::min(std::max(std::stoi(s.substr(pos1 + 1, pos2 - pos1 - 1)), 0), 255);
             int g = std::min(std::max(std::stoi(s.substr(pos2 + 1, pos3 - pos2 - 1)), 0), 255);
@@ -0,0 +1,115 @@
+// tile_renderer.cpp
+#include "../include/tile_renderer.h"
+#include "internal/blend_utils.h"
+#include "internal/clip.h"
+#include "internal/kernels.h"
+#include "internal/path_geometry.h"
+#include "internal/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pa2d {
+    TileRenderer::TileRenderer(int tileSize) : tileSize_((std::max(16, tileSize) + 7) & ~7) {}
+
+    void TileRenderer::bin(const CommandList& commands, int width, int height) {
+        tilesX_ = (width + tileSize_ - 1) / tileSize_;
+        tilesY_ = (height + tileSize_ - 1) / tileSize_;
+        const size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+        const auto& cmds = commands.commands();
+
+        // 命令包围盒对应的图块范围，返回 false 表示完全位于缓冲区之外
+        auto tileRange = [&](const CommandList::Command& cmd, int& tx0, int& ty0, int& tx1, int& ty1) {
+            const int minX = std::max(0, static_cast<int>(std::floor(cmd.minX)));
+            const int minY = std::max(0, static_cast<int>(std::floor(cmd.minY)));
+            const int maxX = std::min(width - 1, static_cast<int>(std::ceil(cmd.maxX)));
+            const int maxY = std::min(height - 1, static_cast<int>(std::ceil(cmd.maxY)));
+            if (minX > maxX || minY > maxY) return false;
+            tx0 = minX / tileSize_; ty0 = minY / tileSize_;
+            tx1 = maxX / tileSize_; ty1 = maxY / tileSize_;
+            return true;
+            };
+
+        // 第一遍：统计每个图块的命令数
+        binStart_.assign(tileCount + 1, 0);
+        for (const auto& cmd : cmds) {
+            int tx0, ty0, tx1, ty1;
+            if (!tileRange(cmd, tx0, ty0, tx1, ty1)) continue;
+            for (int ty = ty0; ty <= ty1; ++ty)
+                for (int tx = tx0; tx <= tx1; ++tx)
+                    ++binStart_[static_cast<size_t>(ty) * tilesX_ + tx + 1];
+        }
+        for (size_t i = 0; i < tileCount; ++i) binStart_[i + 1] += binStart_[i];
+
+        // 第二遍：按录制顺序填入命令下标
+        binItems_.resize(binStart_[tileCount]);
+        binCursor_.assign(binStart_.begin(), binStart_.end() - 1);
+        for (size_t i = 0; i < cmds.size(); ++i) {
+            int tx0, ty0, tx1, ty1;
+            if (!tileRange(cmds[i], tx0, ty0, tx1, ty1)) continue;
+            for (int ty = ty0; ty <= ty1; ++ty)
+                for (int tx = tx0; tx <= tx1; ++tx)
+                    binItems_[binCursor_[static_cast<size_t>(ty) * tilesX_ + tx]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    void TileRenderer::render(const CommandList& commands, Buffer& target) {
+        if (!target.isValid() || commands.empty()) return;
+
+        bin(commands, target.width, target.height);
+        const auto& cmds = commands.commands();
+
+        // 折线与多边形的线段网格、边表每条命令只构建一次，各图块共用（slot 为其在对应数组中的下标）
+        const utils::ClipRect bounds = { 0, 0, target.width - 1, target.height - 1 };
+        std::vector<utils::PolygonEdges> polygons;
+        std::vector<utils::PolylineSegments> polylines;
+        std::vector<uint32_t> slot(cmds.size(), UINT32_MAX);
+        for (uint32_t item : binItems_) {
+            if (slot[item] != UINT32_MAX) continue;
+            const CommandList::Command& cmd = cmds[item];
+            if (cmd.op == CommandList::Op::Polygon) {
+                slot[item] = static_cast<uint32_t>(polygons.size());
+                polygons.emplace_back();
+                polygons.back().build(commands.points(cmd), cmd.pointCount);
+            }
+            else if (cmd.op == CommandList::Op::Polyline) {
+                slot[item] = static_cast<uint32_t>(polylines.size());
+                polylines.emplace_back();
+                polylines.back().build(commands.points(cmd), cmd.pointCount, cmd.closed, commands.style(cmd).width_, bounds);
+            }
+        }
+
+        utils::parallelTasks(0, tilesX_ * tilesY_ - 1, [&](int first, int last) {
+            for (int tile = first; tile <= last; ++tile) {
+                const uint32_t begin = binStart_[tile];
+                const uint32_t end = binStart_[tile + 1];
+                if (begin == end) continue;
+
+                const int tx = tile % tilesX_;
+                const int ty = tile / tilesX_;
+                const utils::ClipRect clip = {
+                    tx * tileSize_, ty * tileSize_,
+                    std::min(target.width, (tx + 1) * tileSize_) - 1,
+                    std::min(target.height, (ty + 1) * tileSize_) - 1
+                };
+                utils::ScopedClip scope(clip);
+                for (uint32_t i = begin; i < end; ++i) {
+                    const uint32_t index = binItems_[i];
+                    const CommandList::Command& cmd = cmds[index];
+                    const Style& s = commands.style(cmd);
+                    if (cmd.op == CommandList::Op::Polygon) {
+                        const utils::ScopedCompositeOp op(s.blend_, s.opacity_);
+                        utils::kernels().polygon(target, polygons[slot[index]], s.fill_, s.stroke_, s.width_);
+                    }
+                    else if (cmd.op == CommandList::Op::Polyline) {
+                        if (s.stroke_.a == 0 || s.width_ <= 0) continue;
+                        const utils::ScopedCompositeOp op(s.blend_, s.opacity_);
+                        utils::kernels().polyline(target, polylines[slot[index]], s.stroke_, s.width_);
+                    }
+                    else {
+                        commands.execute(target, cmd);
+                    }
+                }
+            }
+            });
+    }
+}
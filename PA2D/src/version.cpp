@@ -1,23 +1,33 @@
 #include"../include/version.h"
+#include"internal/kernels.h"
+#ifdef _WIN32
 #include <windows.h>
+#endif
+#ifndef _WIN32
+#include <cstdio>
+#include <cstdlib>
+#endif
 #include <string>
 namespace pa2d {
-    // ==================== 汾Ϣ ====================
+    // ==================== 版本信息 ====================
     const char* VERSION_STRING = "1.0.0-beta.1";
-    // ȡ汾Ϣ
+    // 获取完整版本信息
     const char* getVersion() {
-        // ʹþֲ̬֤̰߳ȫһԳʼ
+        // 使用静态局部变量保证线程安全和一次性初始化
         static const std::string fullVersion = []() {
             std::string version = "PA2D v" + std::string(VERSION_STRING);
 
-            // ӹʱ
+            // 添加构建时间
             version += " (Build: " + std::string(__DATE__) + " " + __TIME__ + ")";
 
-            // 
+            // 构建配置
 #ifdef _DEBUG
             version += " [Debug]";
 #else
             version += " [Release]";
+#endif
+#ifdef PA2D_HEADLESS
+            version += " [Headless]";
 #endif
             return version;
             }();
@@ -25,18 +35,21 @@ namespace pa2d {
     }
 
     AVX2_Verifier::AVX2_Verifier() {
-        int info[4];
-        __cpuid(info, 0);
-        if (info[0] < 7) fail();
-        __cpuidex(info, 7, 0);
-        if (!(info[1] & (1 << 5))) fail();
+        // AVX2/AVX-512 由运行时分派按需启用，这里只检查所有源文件共用的基线指令集
+        if (!utils::cpuHasBaseline()) fail();
     }
     void AVX2_Verifier::fail() {
+#ifdef _WIN32
         MessageBoxA(nullptr,
-            "PA2D requires AVX2 CPU support.\n\n"
-            "Minimum: Intel Haswell (2013) / AMD Excavator (2015)",
+            "PA2D requires SSE4.1 CPU support.\n\n"
+            "Minimum: Intel Penryn (2008) / AMD Bulldozer (2011)",
             "CPU Not Supported",
             MB_OK | MB_ICONERROR);
         ExitProcess(1);
+#else
+        std::fputs("PA2D requires SSE4.1 CPU support.\n"
+            "Minimum: Intel Penryn (2008) / AMD Bulldozer (2011)\n", stderr);
+        std::exit(1);
+#endif
     }
 }
\ No newline at end of file
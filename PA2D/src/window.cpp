@@ -55,6 +55,15 @@ namespace pa2d {
         int lastBufferHeight_ = 0;
         bool sizeChanged_ = true;
 
+        // renderDirty 上次提交时的状态，任一项变化都需要整帧提交
+        const Canvas* lastDirtyCanvas_ = nullptr;
+        int lastDirtyDestX_ = 0;
+        int lastDirtyDestY_ = 0;
+        int lastDirtyClientWidth_ = 0;
+        int lastDirtyClientHeight_ = 0;
+        int lastDirtyBufferWidth_ = 0;
+        int lastDirtyBufferHeight_ = 0;
+
         KeyCallback keyCb_;
         MouseCallback mouseCb_;
         ResizeCallback resizeCb_;
@@ -1191,9 +1200,10 @@ namespace pa2d {
             pImpl_->sizeChanged_ = false;
         }
 
-        if (pImpl_->directBuffer_.bmi.bmiHeader.biWidth != buffer.width ||
+        // DIB 宽度取行跨度，视图按其所在存储的行布局提交
+        if (pImpl_->directBuffer_.bmi.bmiHeader.biWidth != buffer.stride ||
             pImpl_->directBuffer_.bmi.bmiHeader.biHeight != -buffer.height) {
-            pImpl_->directBuffer_.bmi.bmiHeader.biWidth = buffer.width;
+            pImpl_->directBuffer_.bmi.bmiHeader.biWidth = buffer.stride;
             pImpl_->directBuffer_.bmi.bmiHeader.biHeight = -buffer.height;
         }
 
@@ -1264,9 +1274,10 @@ namespace pa2d {
             pImpl_->sizeChanged_ = false;
         }
 
-        if (pImpl_->directBuffer_.bmi.bmiHeader.biWidth != buffer.width ||
+        // DIB 宽度取行跨度，视图按其所在存储的行布局提交
+        if (pImpl_->directBuffer_.bmi.bmiHeader.biWidth != buffer.stride ||
             pImpl_->directBuffer_.bmi.bmiHeader.biHeight != -buffer.height) {
-            pImpl_->directBuffer_.bmi.bmiHeader.biWidth = buffer.width;
+            pImpl_->directBuffer_.bmi.bmiHeader.biWidth = buffer.stride;
             pImpl_->directBuffer_.bmi.bmiHeader.biHeight = -buffer.height;
         }
 
@@ -1293,6 +1304,40 @@ namespace pa2d {
         return renderCentered(canvas.getBuffer(), clearBackground, bgColor);
     }
 
+    Window& Window::renderDirty(const Canvas& canvas, int destX, int destY) {
+        const Buffer& buffer = canvas.getBuffer();
+        if (!pImpl_->hwnd_ || !buffer.color || !pImpl_->persistentDC_) return *this;
+
+        RECT clientRect;
+        GetClientRect(REAL_HWND(pImpl_->hwnd_), &clientRect);
+        const int clientWidth = clientRect.right;
+        const int clientHeight = clientRect.bottom;
+
+        const bool fullPresent = (&canvas != pImpl_->lastDirtyCanvas_ ||
+            destX != pImpl_->lastDirtyDestX_ || destY != pImpl_->lastDirtyDestY_ ||
+            clientWidth != pImpl_->lastDirtyClientWidth_ ||
+            clientHeight != pImpl_->lastDirtyClientHeight_ ||
+            buffer.width != pImpl_->lastDirtyBufferWidth_ ||
+            buffer.height != pImpl_->lastDirtyBufferHeight_);
+
+        if (fullPresent) {
+            render(buffer, destX, destY);
+            pImpl_->lastDirtyCanvas_ = &canvas;
+            pImpl_->lastDirtyDestX_ = destX;
+            pImpl_->lastDirtyDestY_ = destY;
+            pImpl_->lastDirtyClientWidth_ = clientWidth;
+            pImpl_->lastDirtyClientHeight_ = clientHeight;
+            pImpl_->lastDirtyBufferWidth_ = buffer.width;
+            pImpl_->lastDirtyBufferHeight_ = buffer.height;
+            return *this;
+        }
+
+        for (const RectInt& r : canvas.getDirtyRegion().rects()) {
+            render(buffer, destX + r.x, destY + r.y, r.x, r.y, r.width, r.height, false);
+        }
+        return *this;
+    }
+
     Point getScreenSize() {
         return { (float)GetSystemMetrics(SM_CXSCREEN), (float)GetSystemMetrics(SM_CYSCREEN) };
     }
@@ -0,0 +1,144 @@
+// test_allocator.cpp
+// 像素分配器：分级内存池按级复用与缓存上限，帧内存区的顺序切分、立即退回、自动回到起点与溢出转交；返回的内存按 64 字节对齐
+#include"test_utils.h"
+#include<cstdint>
+#include<map>
+using namespace pa2d;
+
+namespace {
+    // 记录经过的上游分配，并检查 deallocate 收到的 count 与分配时相同
+    class CountingAllocator : public BufferAllocator {
+    public:
+        std::map<Color*, size_t> live;
+        int allocations = 0, deallocations = 0;
+        size_t lastCount = 0;
+        bool countsMatch = true;
+
+        Color* allocate(size_t count) override {
+            Color* pixels = heapAllocator().allocate(count);
+            if (!pixels) return nullptr;
+            ++allocations;
+            lastCount = count;
+            live[pixels] = count;
+            return pixels;
+        }
+
+        void deallocate(Color* pixels, size_t count) override {
+            ++deallocations;
+            auto it = live.find(pixels);
+            countsMatch = countsMatch && it != live.end() && it->second == count;
+            if (it != live.end()) live.erase(it);
+            heapAllocator().deallocate(pixels, count);
+        }
+    };
+
+    bool aligned(const void* pixels) {
+        return (reinterpret_cast<uintptr_t>(pixels) & (BUFFER_ALIGNMENT - 1)) == 0;
+    }
+
+    // 同级的请求复用释放的块，不同级的请求向上游申请；缓存超过上限的块直接归还，trim 与析构归还全部缓存
+    void testPoolAllocator() {
+        CountingAllocator upstream;
+        {
+            PoolAllocator pool(1000, upstream);
+            // 100 像素落在 (64, 128] 的第 3 级：按 112 像素向上游申请
+            Color* a = pool.allocate(100);
+            PA2D_CHECK(a && aligned(a) && upstream.allocations == 1 && upstream.lastCount == 112);
+            pool.deallocate(a, 100);
+            PA2D_CHECK(pool.cachedBytes() == 112 * sizeof(Color) && upstream.deallocations == 0);
+
+            Color* b = pool.allocate(105);
+            PA2D_CHECK(b == a && upstream.allocations == 1 && pool.cachedBytes() == 0);
+            Color* c = pool.allocate(120);
+            PA2D_CHECK(c && c != b && aligned(c) && upstream.allocations == 2 && upstream.lastCount == 128);
+            Color* d = pool.allocate(10);
+            PA2D_CHECK(d && aligned(d) && upstream.lastCount == 16);
+
+            // 上限 1000 字节：112 像素块与 128 像素块（448 + 512）可以缓存，再放入 16 像素块（64）就超出
+            pool.deallocate(b, 105);
+            pool.deallocate(c, 120);
+            PA2D_CHECK(pool.cachedBytes() == (112 + 128) * sizeof(Color) && upstream.deallocations == 0);
+            pool.deallocate(d, 10);
+            PA2D_CHECK(pool.cachedBytes() == (112 + 128) * sizeof(Color) && upstream.deallocations == 1);
+
+            pool.trim();
+            PA2D_CHECK(pool.cachedBytes() == 0 && upstream.live.empty() && upstream.deallocations == 3);
+
+            // Buffer 经作用域使用内存池，析构后块回到缓存，同尺寸的下一个 Buffer 复用它
+            {
+                BufferAllocatorScope scope(pool);
+                Buffer first(10, 10, Color(255, 1, 2, 3));
+                PA2D_CHECK(first.allocator == &pool && aligned(first.color));
+            }
+            PA2D_CHECK(pool.cachedBytes() > 0);
+            const int before = upstream.allocations;
+            {
+                BufferAllocatorScope scope(pool);
+                Buffer second(10, 10);
+                PA2D_CHECK(upstream.allocations == before && pool.cachedBytes() == 0);
+            }
+            PA2D_CHECK(&getBufferAllocator() != &pool);
+        }
+        PA2D_CHECK(upstream.live.empty() && upstream.countsMatch);
+    }
+
+    // 顺序切分并按 64 字节对齐；释放最后一块立即退回，全部释放后回到起点；放不下的请求转交上游
+    void testFrameArena() {
+        CountingAllocator upstream;
+        {
+            FrameArena arena(4000, upstream);
+            PA2D_CHECK(arena.capacity() == 4032 && arena.usedBytes() == 0 && upstream.allocations == 0);
+
+            Color* a = arena.allocate(10);
+            PA2D_CHECK(a && aligned(a) && upstream.allocations == 1 && upstream.lastCount == 4032 / sizeof(Color));
+            PA2D_CHECK(arena.usedBytes() == 64);
+            Color* b = arena.allocate(20);
+            PA2D_CHECK(reinterpret_cast<char*>(b) - reinterpret_cast<char*>(a) == 64 && arena.usedBytes() == 192);
+
+            // 释放最后一块：立即退回，再次分配得到同一地址
+            arena.deallocate(b, 20);
+            PA2D_CHECK(arena.usedBytes() == 64);
+            Color* c = arena.allocate(20);
+            PA2D_CHECK(c == b && arena.usedBytes() == 192);
+
+            // 释放较早的块不退回，最后一块释放后整体回到起点
+            arena.deallocate(a, 10);
+            PA2D_CHECK(arena.usedBytes() == 192);
+            arena.deallocate(c, 20);
+            PA2D_CHECK(arena.usedBytes() == 0);
+
+            // 剩余空间不足时转交上游，内存区状态不变，释放时同样交回上游
+            Color* big = arena.allocate(900);
+            PA2D_CHECK(big && arena.usedBytes() == 3648);
+            Color* overflow = arena.allocate(100);
+            PA2D_CHECK(overflow && aligned(overflow) && upstream.allocations == 2 && upstream.lastCount == 100);
+            PA2D_CHECK(arena.usedBytes() == 3648);
+            arena.deallocate(overflow, 100);
+            PA2D_CHECK(upstream.deallocations == 1 && arena.usedBytes() == 3648);
+            Color* tail = arena.allocate(96);
+            PA2D_CHECK(tail && upstream.allocations == 2 && arena.usedBytes() == 4032);
+
+            // reset 强制回到起点
+            arena.reset();
+            PA2D_CHECK(arena.usedBytes() == 0);
+            PA2D_CHECK(arena.allocate(1) == a);
+            arena.reset();
+
+            // Buffer 经作用域从内存区分配，析构后回到起点
+            {
+                BufferAllocatorScope scope(arena);
+                Buffer frame(17, 9, Color(255, 4, 5, 6));
+                PA2D_CHECK(frame.allocator == &arena && frame.color == a && aligned(frame.color));
+                PA2D_CHECK(arena.usedBytes() > 0);
+            }
+            PA2D_CHECK(arena.usedBytes() == 0 && upstream.allocations == 2);
+        }
+        PA2D_CHECK(upstream.live.empty() && upstream.countsMatch && upstream.deallocations == 2);
+    }
+}
+
+int main() {
+    testPoolAllocator();
+    testFrameArena();
+    return pa2d_test::finish("test_allocator");
+}
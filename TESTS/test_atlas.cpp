@@ -0,0 +1,128 @@
+// test_atlas.cpp
+// 纹理图集：区域在页面内且带间隔互不重叠，像素与纹理坐标正确，装满后返回无效区域而不影响已有区域
+#include"test_utils.h"
+#include<cmath>
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    // 两个区域之间在水平或竖直方向上至少隔开 padding 像素
+    bool separated(const AtlasRegion& a, const AtlasRegion& b, int padding) {
+        return a.x + a.width + padding <= b.x || b.x + b.width + padding <= a.x ||
+               a.y + a.height + padding <= b.y || b.y + b.height + padding <= a.y;
+    }
+
+    bool samePixels(const Buffer& a, const Buffer& b) {
+        return pa2d_test::maxDiff(a, b) == 0;
+    }
+
+    // 检查全部有效区域：位置、间隔、纹理坐标、像素内容与占用率
+    void checkRegions(Atlas& atlas, const std::vector<Buffer>& images, const std::vector<AtlasRegion>& regions) {
+        long long area = 0;
+        int valid = 0;
+        for (size_t i = 0; i < regions.size(); ++i) {
+            const AtlasRegion& r = regions[i];
+            if (!r) continue;
+            ++valid;
+            area += static_cast<long long>(r.width) * r.height;
+            PA2D_CHECK(r.width == images[i].width && r.height == images[i].height);
+            PA2D_CHECK(r.x >= 0 && r.y >= 0 && r.x + r.width <= atlas.width() && r.y + r.height <= atlas.height());
+            const double invW = 1.0 / atlas.width(), invH = 1.0 / atlas.height();
+            PA2D_CHECK_LE(std::abs(r.u0 - r.x * invW), 1e-6);
+            PA2D_CHECK_LE(std::abs(r.v0 - r.y * invH), 1e-6);
+            PA2D_CHECK_LE(std::abs(r.u1 - (r.x + r.width) * invW), 1e-6);
+            PA2D_CHECK_LE(std::abs(r.v1 - (r.y + r.height) * invH), 1e-6);
+            PA2D_CHECK(samePixels(atlas.view(r), images[i]));
+            for (size_t j = 0; j < i; ++j) {
+                if (regions[j]) PA2D_CHECK(separated(r, regions[j], atlas.padding()));
+            }
+        }
+        PA2D_CHECK(atlas.regionCount() == valid);
+        PA2D_CHECK_LE(std::abs(atlas.occupancy() - static_cast<double>(area) / (atlas.width() * atlas.height())), 1e-6);
+    }
+
+    std::vector<Buffer> images(int count, unsigned seed) {
+        std::vector<Buffer> out;
+        for (int i = 0; i < count; ++i) {
+            out.push_back(pa2d_test::pattern(3 + (i * 7 + seed) % 29, 2 + (i * 13 + seed) % 23, seed + i));
+        }
+        return out;
+    }
+
+    // 逐个插入直到装满：之后的插入返回无效区域，已有区域的像素不变
+    void testIncrementalInsert() {
+        const std::vector<Buffer> sources = images(200, 40);
+        Atlas atlas(160, 128, 2);
+        std::vector<AtlasRegion> regions;
+        bool filled = false;
+        for (const Buffer& image : sources) {
+            regions.push_back(atlas.insert(image));
+            if (!regions.back()) filled = true;
+        }
+        PA2D_CHECK(filled);
+        PA2D_CHECK(atlas.regionCount() > 20);
+        PA2D_CHECK(!atlas.insert(Buffer(161, 1)));
+        PA2D_CHECK(!atlas.insert(Buffer()));
+        checkRegions(atlas, sources, regions);
+    }
+
+    // 批量插入按高度装箱，结果按输入顺序返回，空指针对应无效区域
+    void testBatchInsert() {
+        const std::vector<Buffer> sources = images(60, 41);
+        std::vector<const Buffer*> pointers;
+        for (const Buffer& image : sources) pointers.push_back(&image);
+        pointers.push_back(nullptr);
+
+        Atlas atlas(256, 256, 1);
+        const std::vector<AtlasRegion> regions = atlas.insert(pointers);
+        PA2D_CHECK(regions.size() == pointers.size());
+        PA2D_CHECK(!regions.back());
+        std::vector<AtlasRegion> imageRegions(regions.begin(), regions.end() - 1);
+        for (const AtlasRegion& r : imageRegions) PA2D_CHECK(r.isValid());
+        checkRegions(atlas, sources, imageRegions);
+    }
+
+    // 尺寸相同、无间隔的方块恰好铺满页面，再插入一块即失败
+    void testTightPacking() {
+        Atlas atlas(64, 48, 0);
+        const Buffer tile(16, 16, Color(255, 10, 20, 30));
+        int placed = 0;
+        while (atlas.insert(tile)) ++placed;
+        PA2D_CHECK(placed == 12);
+        PA2D_CHECK(atlas.occupancy() == 1.0f);
+
+        // clear 后整页重新可用
+        atlas.clear();
+        PA2D_CHECK(atlas.regionCount() == 0 && atlas.occupancy() == 0.0f);
+        PA2D_CHECK(atlas.insert(Buffer(64, 48, Color(255, 1, 2, 3))).isValid());
+    }
+
+    // allocate 的区域为透明像素，经视图写入后出现在页面上；预乘页面插入直通图时转换格式
+    void testAllocateAndFormat() {
+        Atlas atlas(64, 64, 1);
+        const AtlasRegion a = atlas.insert(Buffer(10, 10, Color(255, 200, 0, 0)));
+        const AtlasRegion b = atlas.allocate(20, 12);
+        PA2D_CHECK(b.isValid() && separated(a, b, 1));
+        PA2D_CHECK(samePixels(atlas.view(b), Buffer(20, 12, Color(0))));
+        BufferView target = atlas.view(b);
+        circle(target, 10.0f, 6.0f, 5.0f, Color(255, 0, 200, 0), Color(0), 0.0f);
+        PA2D_CHECK(atlas.buffer().at(b.x + 10, b.y + 6).data == Color(255, 0, 200, 0).data);
+        PA2D_CHECK(!atlas.allocate(0, 5) && !atlas.allocate(65, 1));
+
+        Atlas premultipliedAtlas(64, 64, 1, PixelFormat::Premultiplied);
+        const Buffer image = pa2d_test::pattern(17, 9, 42);
+        const AtlasRegion r = premultipliedAtlas.insert(image);
+        Buffer expected = image;
+        premultiply(expected);
+        PA2D_CHECK(premultipliedAtlas.buffer().isPremultiplied());
+        PA2D_CHECK(samePixels(premultipliedAtlas.view(r), expected));
+    }
+}
+
+int main() {
+    testIncrementalInsert();
+    testBatchInsert();
+    testTightPacking();
+    testAllocateAndFormat();
+    return pa2d_test::finish("test_atlas");
+}
@@ -0,0 +1,326 @@
+// test_blend.cpp
+// 合成：与按公式逐像素计算的标量结果比较
+#include"test_utils.h"
+#include<cmath>
+#include<cstdio>
+#include<functional>
+using namespace pa2d;
+
+namespace {
+    uint8_t toByte(double value) {
+        return static_cast<uint8_t>(std::min(255L, std::max(0L, std::lround(value))));
+    }
+
+    Color premultiplied(Color c) {
+        return Color(c.a, toByte(c.r * c.a / 255.0), toByte(c.g * c.a / 255.0), toByte(c.b * c.a / 255.0));
+    }
+
+    // 预乘格式的 SrcOver：D' = S + D * (1 - As)，四个通道相同
+    Color referencePremultipliedOver(Color s, Color d, int opacity) {
+        const double k = opacity / 255.0;
+        const double inv = 1.0 - s.a * k / 255.0;
+        return Color(toByte(s.a * k + d.a * inv), toByte(s.r * k + d.r * inv), toByte(s.g * k + d.g * inv), toByte(s.b * k + d.b * inv));
+    }
+
+    // 可分离模式的 B(s, d)，颜色为直通 0-1
+    double separable(BlendMode mode, double s, double d) {
+        switch (mode) {
+        case BlendMode::Add: return std::min(1.0, s + d);
+        case BlendMode::Subtract: return std::max(0.0, d - s);
+        case BlendMode::Multiply: return s * d;
+        case BlendMode::Screen: return s + d - s * d;
+        case BlendMode::Darken: return std::min(s, d);
+        case BlendMode::Lighten: return std::max(s, d);
+        case BlendMode::Difference: return std::fabs(s - d);
+        case BlendMode::Exclusion: return s + d - 2 * s * d;
+        case BlendMode::HardLight: return s <= 0.5 ? 2 * s * d : 1 - (1 - d) * (2 - 2 * s);
+        case BlendMode::Overlay: return separable(BlendMode::HardLight, d, s);
+        case BlendMode::ColorDodge: return d <= 0 ? 0 : s >= 1 ? 1 : std::min(1.0, d / (1 - s));
+        case BlendMode::ColorBurn: return d >= 1 ? 1 : s <= 0 ? 0 : 1 - std::min(1.0, (1 - d) / s);
+        case BlendMode::SoftLight: {
+            if (s <= 0.5) return d - (1 - 2 * s) * d * (1 - d);
+            const double dd = d <= 0.25 ? ((16 * d - 12) * d + 4) * d : std::sqrt(d);
+            return d + (2 * s - 1) * (dd - d);
+        }
+        default: return s;
+        }
+    }
+
+    // 按 W3C 合成公式以 double 计算一个像素，输入输出都是 0-1 的直通颜色，结果为预乘 { r, g, b, a }
+    void referenceBlend(BlendMode mode, const double s[4], const double d[4], double opacity, double out[4]) {
+        const double as = s[3] * opacity, ad = d[3];
+        double fa = 1, fb = 1 - as;
+        switch (mode) {
+        case BlendMode::Clear: fa = 0; fb = 0; break;
+        case BlendMode::Src: fa = 1; fb = 0; break;
+        case BlendMode::Dst: fa = 0; fb = 1; break;
+        case BlendMode::DstOver: fa = 1 - ad; fb = 1; break;
+        case BlendMode::SrcIn: fa = ad; fb = 0; break;
+        case BlendMode::DstIn: fa = 0; fb = as; break;
+        case BlendMode::SrcOut: fa = 1 - ad; fb = 0; break;
+        case BlendMode::DstOut: fa = 0; fb = 1 - as; break;
+        case BlendMode::SrcAtop: fa = ad; fb = 1 - as; break;
+        case BlendMode::DstAtop: fa = 1 - ad; fb = as; break;
+        case BlendMode::Xor: fa = 1 - ad; fb = 1 - as; break;
+        case BlendMode::DestAlpha: fa = ad; fb = 1 - as * ad; break;
+        default: break;
+        }
+        for (int c = 0; c < 3; ++c) {
+            const double cs = (1 - ad) * s[c] + ad * separable(mode, s[c], d[c]);
+            out[c] = as * fa * cs + fb * ad * d[c];
+        }
+        out[3] = as * fa + fb * ad;
+    }
+
+    // 源完全透明时仍会改写目标的模式
+    bool rewritesOnTransparent(BlendMode mode) {
+        return mode == BlendMode::Clear || mode == BlendMode::Src || mode == BlendMode::SrcIn ||
+               mode == BlendMode::DstIn || mode == BlendMode::SrcOut || mode == BlendMode::DstAtop;
+    }
+
+    // 像素转为 0-1 的直通颜色 { r, g, b, a }
+    void toUnit(Color c, bool isPremultiplied, double out[4]) {
+        const double a = c.a / 255.0;
+        const double k = isPremultiplied ? (c.a ? 1.0 / c.a : 0.0) : 1.0 / 255.0;
+        out[0] = c.r * k; out[1] = c.g * k; out[2] = c.b * k; out[3] = a;
+    }
+
+    void testConvert() {
+        const Buffer straight = pa2d_test::pattern(67, 13, 9);
+        Buffer converted = straight;
+        premultiply(converted);
+        PA2D_CHECK(converted.isPremultiplied());
+        int diff = 0;
+        for (int y = 0; y < straight.height; ++y) {
+            for (int x = 0; x < straight.width; ++x) {
+                diff = std::max(diff, pa2d_test::channelDiff(converted.at(x, y), premultiplied(straight.at(x, y))));
+            }
+        }
+        PA2D_CHECK_LE(diff, 1);
+
+        // alpha 不低于一半时往返误差不超过 1；alpha 为 0 时颜色归零
+        unpremultiply(converted);
+        PA2D_CHECK(!converted.isPremultiplied());
+        int roundTrip = 0;
+        for (int y = 0; y < straight.height; ++y) {
+            for (int x = 0; x < straight.width; ++x) {
+                const Color c = straight.at(x, y);
+                if (c.a >= 128) roundTrip = std::max(roundTrip, pa2d_test::channelDiff(converted.at(x, y), c));
+            }
+        }
+        PA2D_CHECK_LE(roundTrip, 1);
+
+        Buffer transparent(9, 1, Color(0, 200, 100, 50));
+        premultiply(transparent);
+        PA2D_CHECK(transparent.at(4, 0).data == 0);
+    }
+
+    // 源与目标都是预乘格式时不做除法，结果与公式逐像素相差不超过 1
+    void testPremultipliedOver() {
+        Buffer src = pa2d_test::pattern(45, 17, 10);
+        Buffer dst = pa2d_test::pattern(60, 30, 11);
+        premultiply(src);
+        premultiply(dst);
+        for (int opacity : { 255, 100 }) {
+            Buffer result = dst;
+            alphaBlend(src, result, 7, 5, opacity);
+            PA2D_CHECK(result.isPremultiplied());
+            int diff = 0;
+            for (int y = 0; y < dst.height; ++y) {
+                for (int x = 0; x < dst.width; ++x) {
+                    const bool inside = x >= 7 && x < 7 + src.width && y >= 5 && y < 5 + src.height;
+                    const Color expected = inside ? referencePremultipliedOver(src.at(x - 7, y - 5), dst.at(x, y), opacity) : dst.at(x, y);
+                    diff = std::max(diff, pa2d_test::channelDiff(result.at(x, y), expected));
+                }
+            }
+            PA2D_CHECK_LE(diff, 1);
+        }
+    }
+
+    // 同一组像素分别以直通与预乘格式合成到不透明目标，都与公式一致
+    // 直通格式的 alphaBlend 按源 alpha 插值颜色，只在不透明目标上与 Porter-Duff 相同
+    void testFormatsAgree() {
+        const Buffer srcStraight = pa2d_test::pattern(40, 40, 12);
+        Buffer opaqueStraight = pa2d_test::pattern(40, 40, 13);
+        for (int y = 0; y < opaqueStraight.height; ++y) {
+            for (int x = 0; x < opaqueStraight.width; ++x) opaqueStraight.at(x, y).a = 255;
+        }
+        Buffer srcPremultiplied = srcStraight, opaquePremultiplied = opaqueStraight;
+        premultiply(srcPremultiplied);
+        premultiply(opaquePremultiplied);
+
+        Buffer straightResult = opaqueStraight;
+        alphaBlend(srcStraight, straightResult, 0, 0, 255);
+        Buffer premultipliedResult = opaquePremultiplied;
+        alphaBlend(srcPremultiplied, premultipliedResult, 0, 0, 255);
+        int straightDiff = 0, premultipliedDiff = 0;
+        for (int y = 0; y < opaqueStraight.height; ++y) {
+            for (int x = 0; x < opaqueStraight.width; ++x) {
+                const Color s = srcStraight.at(x, y), d = opaqueStraight.at(x, y);
+                const double k = s.a / 255.0;
+                const Color expected(255, toByte(s.r * k + d.r * (1 - k)), toByte(s.g * k + d.g * (1 - k)), toByte(s.b * k + d.b * (1 - k)));
+                straightDiff = std::max(straightDiff, pa2d_test::channelDiff(straightResult.at(x, y), expected));
+                premultipliedDiff = std::max(premultipliedDiff, pa2d_test::channelDiff(premultipliedResult.at(x, y), expected));
+            }
+        }
+        // 直通内核沿用原有的 >> 8 近似 /255（有效 alpha 与插值各一次），误差放宽到 3
+        PA2D_CHECK_LE(straightDiff, 3);
+        PA2D_CHECK_LE(premultipliedDiff, 1);
+
+        // 直通源合成到半透明的预乘目标：按各自的格式解释像素，与两边都预乘时一致
+        Buffer translucent = pa2d_test::pattern(40, 40, 14);
+        premultiply(translucent);
+        Buffer mixedResult = translucent;
+        alphaBlend(srcStraight, mixedResult, 0, 0, 255);
+        PA2D_CHECK(mixedResult.isPremultiplied());
+        Buffer bothPremultiplied = translucent;
+        alphaBlend(srcPremultiplied, bothPremultiplied, 0, 0, 255);
+        PA2D_CHECK_LE(pa2d_test::maxDiff(mixedResult, bothPremultiplied), 2);
+
+        // 形状光栅化同样按目标格式写回
+        Buffer shapeStraight(64, 64, Color(120, 30, 200, 90));
+        Buffer shapePremultiplied = shapeStraight;
+        premultiply(shapePremultiplied);
+        for (Buffer* target : { &shapeStraight, &shapePremultiplied }) {
+            circle(*target, 31.5f, 30.2f, 22.7f, Color(150, 250, 120, 10), Color(200, 0, 0, 0), 3.0f);
+        }
+        premultiply(shapeStraight);
+        PA2D_CHECK_LE(pa2d_test::maxDiff(shapePremultiplied, shapeStraight), 2);
+    }
+
+    // 每种混合模式在直通与预乘目标上都与 double 参考一致；结果统一按预乘比较，
+    // 避免直通输出在 alpha 很小时把量化误差放大（SrcOver 的直通路径见 testFormatsAgree）
+    void testBlendModes() {
+        const Buffer srcStraight = pa2d_test::pattern(37, 23, 20);
+        const Buffer dstStraight = pa2d_test::pattern(37, 23, 21);
+        for (int m = 0; m <= static_cast<int>(BlendMode::DestAlpha); ++m) {
+            const BlendMode mode = static_cast<BlendMode>(m);
+            for (int format = 0; format < 2; ++format) {
+                const bool premultipliedFormat = format == 1;
+                if (mode == BlendMode::SrcOver && !premultipliedFormat) continue;
+                for (int opacity : { 255, 140 }) {
+                    Buffer src = srcStraight, dst = dstStraight;
+                    if (premultipliedFormat) {
+                        premultiply(src);
+                        premultiply(dst);
+                    }
+                    Buffer result = dst;
+                    blend(src, result, 0, 0, mode, opacity);
+                    int diff = 0;
+                    for (int y = 0; y < dst.height; ++y) {
+                        for (int x = 0; x < dst.width; ++x) {
+                            double s[4], d[4], expected[4], actual[4];
+                            toUnit(src.at(x, y), premultipliedFormat, s);
+                            toUnit(dst.at(x, y), premultipliedFormat, d);
+                            referenceBlend(mode, s, d, opacity / 255.0, expected);
+                            toUnit(result.at(x, y), premultipliedFormat, actual);
+                            for (int c = 0; c < 3; ++c) actual[c] *= actual[3];
+                            for (int c = 0; c < 4; ++c) {
+                                diff = std::max(diff, static_cast<int>(std::lround(std::fabs(actual[c] - expected[c]) * 255.0)));
+                            }
+                        }
+                    }
+                    if (diff > 1) std::printf("mode %d, format %d, opacity %d: max diff %d\n", m, format, opacity, diff);
+                    PA2D_CHECK_LE(diff, 1);
+                }
+            }
+        }
+    }
+
+    // 抗锯齿边缘：覆盖率取自不透明白色在黑底上以源覆盖绘制的结果。
+    // 透明源会改写目标的模式按完全覆盖混合后在预乘空间与目标插值，其余模式把覆盖率并入源 alpha
+    void testAntialiasedEdges() {
+        const int size = 48;
+        const float cx = 23.3f, cy = 24.6f, radius = 17.8f;
+        Canvas coverageCanvas(size, size, Color(255, 0, 0, 0));
+        coverageCanvas.circle(cx, cy, radius, Style().fill(Color(255, 255, 255, 255)).width(0.0f));
+        const Buffer& coverage = coverageCanvas.getBuffer();
+
+        const Color background(170, 40, 120, 200), fill(200, 230, 60, 30);
+        const BlendMode modes[] = { BlendMode::Clear, BlendMode::Src, BlendMode::SrcIn, BlendMode::DstIn, BlendMode::SrcOut,
+                                    BlendMode::DstAtop, BlendMode::DstOut, BlendMode::Xor, BlendMode::Multiply, BlendMode::ColorBurn };
+        for (BlendMode mode : modes) {
+            for (int format = 0; format < 2; ++format) {
+                const bool premultipliedFormat = format == 1;
+                Buffer target(size, size, background);
+                if (premultipliedFormat) premultiply(target);
+                Canvas canvas(target);
+                canvas.circle(cx, cy, radius, Style().fill(fill).width(0.0f).blend(mode));
+                const Buffer& result = canvas.getBuffer();
+                PA2D_CHECK(result.isPremultiplied() == premultipliedFormat);
+
+                double s[4], d[4], full[4];
+                toUnit(fill, false, s);
+                toUnit(target.at(0, 0), premultipliedFormat, d);
+                referenceBlend(mode, s, d, 1.0, full);
+                int diff = 0;
+                for (int y = 0; y < size; ++y) {
+                    for (int x = 0; x < size; ++x) {
+                        const double c = coverage.at(x, y).r / 255.0;
+                        double expected[4], actual[4];
+                        if (!rewritesOnTransparent(mode)) {
+                            referenceBlend(mode, s, d, c, expected);
+                        }
+                        else {
+                            for (int i = 0; i < 4; ++i) {
+                                const double dp = i < 3 ? d[i] * d[3] : d[3];
+                                expected[i] = dp + (full[i] - dp) * c;
+                            }
+                        }
+                        toUnit(result.at(x, y), premultipliedFormat, actual);
+                        for (int i = 0; i < 3; ++i) actual[i] *= actual[3];
+                        for (int i = 0; i < 4; ++i) {
+                            diff = std::max(diff, static_cast<int>(std::lround(std::fabs(actual[i] - expected[i]) * 255.0)));
+                        }
+                    }
+                }
+                if (diff > 2) std::printf("mode %d, format %d: max edge diff %d\n", static_cast<int>(mode), format, diff);
+                PA2D_CHECK_LE(diff, 2);
+            }
+        }
+    }
+}
+
+namespace {
+    // 定点合成（CompositeMode::Fast）的每次绘制与浮点合成逐通道相差不超过 1（叠加绘制时差值会逐次累积，故逐个形状比较）：
+    // 不透明的直通目标与预乘目标走定点路径，半透明的直通目标退回浮点
+    void testFastComposite() {
+        const Color fill(160, 48, 128, 192), stroke(200, 250, 90, 20);
+        const std::function<void(Buffer&)> shapes[] = {
+            [&](Buffer& b) { rect(b, 10.3f, 12.7f, 150.0f, 90.0f, fill, stroke, 2.5f); },
+            [&](Buffer& b) { rect(b, 120.0f, 110.0f, 140.0f, 70.0f, 0.6f, fill, Color(0), 0.0f); },
+            [&](Buffer& b) { circle(b, 170.4f, 80.6f, 60.2f, fill, Color(0), 0.0f); },
+            [&](Buffer& b) { roundRect(b, 30.5f, 100.5f, 180.0f, 90.0f, fill, stroke, 20.0f, 3.0f); },
+            [&](Buffer& b) { ellipse(b, 200.0f, 150.0f, 100.0f, 60.0f, 0.3f, fill, stroke, 2.0f); },
+            [&](Buffer& b) { polygon(b, { { 20, 20 }, { 230, 40 }, { 200, 190 }, { 40, 170 } }, Color(90, 0, 255, 120), Color(0), 0.0f); },
+            [&](Buffer& b) { line(b, 5.5f, 190.2f, 250.1f, 8.7f, stroke, 4.0f); },
+        };
+        const CompositeMode previous = getCompositeMode();
+        for (int background = 0; background < 3; ++background) {
+            Buffer base(256, 200, Color(255, 240, 235, 220));
+            if (background == 1) base = pa2d_test::pattern(256, 200, 22);
+            if (background == 2) premultiply(base);
+            for (const auto& shape : shapes) {
+                setCompositeMode(CompositeMode::Precise);
+                Buffer precise = base;
+                shape(precise);
+                setCompositeMode(CompositeMode::Fast);
+                Buffer fast = base;
+                shape(fast);
+                PA2D_CHECK(pa2d_test::maxDiff(fast, base) > 0);
+                PA2D_CHECK_LE(pa2d_test::maxDiff(fast, precise), 1);
+            }
+        }
+        setCompositeMode(previous);
+    }
+}
+
+int main() {
+    testConvert();
+    testPremultipliedOver();
+    testFormatsAgree();
+    testBlendModes();
+    testAntialiasedEdges();
+    testFastComposite();
+    return pa2d_test::finish("test_blend");
+}
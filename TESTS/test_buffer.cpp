@@ -0,0 +1,136 @@
+// test_buffer.cpp
+// 缓冲区视图与裁剪：视图裁剪到缓冲区内并与之共用像素，crop 返回独立副本，向视图拷贝只能写入同尺寸区域，Canvas::view 标记脏区域
+#include"test_utils.h"
+using namespace pa2d;
+
+namespace {
+    // region 与 src 中 (x, y) 起的同尺寸区域逐像素相同
+    bool sameRegion(const Buffer& region, const Buffer& src, int x, int y) {
+        for (int j = 0; j < region.height; ++j) {
+            for (int i = 0; i < region.width; ++i) {
+                if (region.at(i, j).data != src.at(x + i, y + j).data) return false;
+            }
+        }
+        return true;
+    }
+
+    // cropView 裁剪到缓冲区内、沿用原行跨度；经视图的写入出现在原缓冲区中，视图的视图仍指向同一存储
+    void testCropView() {
+        Buffer image = pa2d_test::pattern(50, 40, 70);
+        const Buffer original = image;
+
+        BufferView inner = cropView(image, 10, 5, 20, 15);
+        PA2D_CHECK(inner && inner.width == 20 && inner.height == 15);
+        PA2D_CHECK(inner.stride == image.stride && inner.allocator == nullptr);
+        PA2D_CHECK(&inner.at(0, 0) == &image.at(10, 5));
+        PA2D_CHECK(sameRegion(inner, original, 10, 5));
+
+        BufferView clipped = image.view(-5, 30, 100, 100);
+        PA2D_CHECK(clipped.width == 50 && clipped.height == 10 && &clipped.at(0, 0) == &image.at(0, 30));
+        PA2D_CHECK(!image.view(50, 0, 10, 10));
+        PA2D_CHECK(!image.view(10, 10, 0, 5));
+
+        BufferView nested = inner.view(4, 3, 6, 6);
+        PA2D_CHECK(&nested.at(0, 0) == &image.at(14, 8) && nested.stride == image.stride);
+
+        nested.clear(Color(255, 1, 2, 3));
+        int changed = 0;
+        for (int y = 0; y < image.height; ++y) {
+            for (int x = 0; x < image.width; ++x) {
+                const bool insideNested = x >= 14 && x < 20 && y >= 8 && y < 14;
+                if (image.at(x, y).data != original.at(x, y).data) ++changed;
+                if (insideNested) PA2D_CHECK(image.at(x, y).data == Color(255, 1, 2, 3).data);
+            }
+        }
+        PA2D_CHECK(changed <= 36);
+
+        // 视图之间赋值只复制指针
+        BufferView alias;
+        alias = nested;
+        PA2D_CHECK(alias.color == nested.color && alias.width == 6);
+    }
+
+    // crop 复制区域得到独立缓冲区，同样裁剪到 src 内；以左值视图构造 Buffer 也复制像素
+    void testCrop() {
+        Buffer image = pa2d_test::pattern(33, 27, 71);
+        premultiply(image);
+        const Buffer original = image;
+
+        Buffer part = crop(image, 20, 10, 30, 8);
+        PA2D_CHECK(part.width == 13 && part.height == 8 && part.allocator != nullptr);
+        PA2D_CHECK(part.isPremultiplied());
+        PA2D_CHECK(sameRegion(part, original, 20, 10));
+        part.clear(Color(0));
+        PA2D_CHECK(pa2d_test::maxDiff(image, original) == 0);
+        PA2D_CHECK(!crop(image, 40, 0, 5, 5));
+
+        BufferView region = image.view(3, 4, 10, 9);
+        Buffer owned = region;
+        PA2D_CHECK(owned.allocator != nullptr && owned.color != region.color);
+        PA2D_CHECK(sameRegion(owned, original, 3, 4));
+        owned.clear(Color(255, 9, 9, 9));
+        PA2D_CHECK(pa2d_test::maxDiff(image, original) == 0);
+    }
+
+    // 向视图拷贝：同尺寸时写入引用的区域；尺寸不同或源无效时失败且视图与原缓冲区都不变
+    // 自有缓冲区则按源尺寸重新分配
+    void testCopyIntoView() {
+        Buffer image = pa2d_test::pattern(40, 30, 72);
+        const Buffer original = image;
+        const Buffer patch = pa2d_test::pattern(12, 7, 73);
+
+        BufferView region = image.view(5, 6, 12, 7);
+        PA2D_CHECK(copy(region, patch));
+        PA2D_CHECK(sameRegion(patch, image, 5, 6));
+        PA2D_CHECK(region.color == &image.at(5, 6));
+
+        const Buffer written = image;
+        BufferView smaller = image.view(20, 20, 8, 8);
+        Color* const pixels = smaller.color;
+        PA2D_CHECK(!copy(smaller, patch));
+        PA2D_CHECK(!copy(smaller, Buffer()));
+        PA2D_CHECK(smaller.color == pixels && smaller.width == 8 && smaller.height == 8 && smaller.allocator == nullptr);
+        Buffer& asBuffer = smaller;
+        asBuffer = patch;
+        PA2D_CHECK(smaller.color == pixels && smaller.width == 8);
+        PA2D_CHECK(pa2d_test::maxDiff(image, written) == 0);
+        PA2D_CHECK(pa2d_test::maxDiff(image, original) > 0);
+
+        Buffer owned(3, 3);
+        PA2D_CHECK(copy(owned, patch));
+        PA2D_CHECK(owned.width == 12 && owned.height == 7 && pa2d_test::maxDiff(owned, patch) == 0);
+        PA2D_CHECK(copy(owned, Buffer()) && !owned);
+    }
+
+    // Canvas::view 在取得视图时把裁剪后的区域标记为脏；crop 后整块为脏
+    void testCanvasView() {
+        Canvas canvas(64, 48, Color(255, 0, 0, 0));
+        canvas.clearDirty();
+        BufferView region = canvas.view(50, 10, 30, 12);
+        PA2D_CHECK(region.width == 14 && region.height == 12);
+        PA2D_CHECK(canvas.isDirty() && canvas.getDirtyRegion().rects().size() == 1);
+        const RectInt dirty = canvas.getDirtyRegion().bounds();
+        PA2D_CHECK(dirty.x == 50 && dirty.y == 10 && dirty.width == 14 && dirty.height == 12);
+        circle(region, 7.0f, 6.0f, 4.0f, Color(255, 255, 255, 255), Color(0), 0.0f);
+        PA2D_CHECK(canvas.at(57, 16).data == Color(255, 255, 255, 255).data);
+
+        canvas.clearDirty();
+        PA2D_CHECK(!canvas.view(70, 0, 5, 5));
+        PA2D_CHECK(!canvas.isDirty());
+
+        canvas.clearDirty();
+        canvas.crop(40, 8, 20, 20);
+        PA2D_CHECK(canvas.width() == 20 && canvas.height() == 20);
+        PA2D_CHECK(canvas.at(17, 8).data == Color(255, 255, 255, 255).data);
+        const RectInt all = canvas.getDirtyRegion().bounds();
+        PA2D_CHECK(all.x == 0 && all.y == 0 && all.width == 20 && all.height == 20);
+    }
+}
+
+int main() {
+    testCropView();
+    testCrop();
+    testCopyIntoView();
+    testCanvasView();
+    return pa2d_test::finish("test_buffer");
+}
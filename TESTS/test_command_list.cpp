@@ -0,0 +1,119 @@
+// test_command_list.cpp
+// 命令列表与分块渲染：回放与直接在 Canvas 上绘制逐位一致；分块回放与 CommandList::replay 逐位一致（图块大小、线程数、合成模式、目标格式、内核等级均不影响结果）
+#include"test_utils.h"
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    // 覆盖全部命令类型的场景：半透明填充与描边、非源覆盖混合模式、图层不透明度，部分图形越过目标边界、跨越多个图块
+    // CommandList 与 Canvas 的绘制方法同名同参，同一段代码既可录制也可直接绘制
+    template<typename Target>
+    void record(Target& list) {
+        const Color fills[] = { Color(160, 48, 128, 192), Color(255, 20, 200, 90), Color(90, 0, 255, 120), Color(30, 250, 250, 10) };
+        const Color strokes[] = { Color(200, 250, 90, 20), Color(255, 10, 10, 10), Color(120, 0, 60, 255) };
+        for (int i = 0; i < 60; ++i) {
+            const float x = static_cast<float>(i * 37 % 300) - 15.0f + i * 0.13f;
+            const float y = static_cast<float>(i * 53 % 220) - 12.0f + i * 0.29f;
+            Style style(fills[i % 4], i % 3 == 0 ? Color(0) : strokes[i % 3], 1.0f + (i % 5) * 0.7f, static_cast<float>(i % 4) * 3.0f);
+            if (i % 7 == 3) style.blend(static_cast<BlendMode>(i % (static_cast<int>(BlendMode::DestAlpha) + 1)));
+            if (i % 6 == 5) style.opacity(0.6f);
+            switch (i % 10) {
+            case 0: list.rect(x, y, 40.0f + i % 50, 30.0f + i % 40, style); break;
+            case 1: list.rect(x, y, 70.0f, 35.0f, i * 0.31f, style); break;
+            case 2: list.circle(x, y, 8.0f + i % 45, style); break;
+            case 3: list.ellipse(x, y, 60.0f, 30.0f + i % 20, style); break;
+            case 4: list.ellipse(x, y, 80.0f, 26.0f, i * 0.57f, style); break;
+            case 5: list.triangle(x, y, x + 70.0f, y + 15.0f, x + 20.0f, y + 60.0f, style); break;
+            case 6: list.sector(x, y, 30.0f + i % 30, i * 17.0f, i * 17.0f + 130.0f, style); break;
+            case 7: list.line(x, y, x + 90.0f - i, y + 50.0f, style); break;
+            case 8: list.polyline({ { x, y }, { x + 40.0f, y + 30.0f }, { x + 80.0f, y - 10.0f }, { x + 120.0f, y + 45.0f } }, style, i % 4 == 0); break;
+            case 9: list.polygon({ { x, y }, { x + 90.0f, y + 20.0f }, { x + 10.0f, y + 70.0f }, { x + 70.0f, y + 75.0f }, { x + 40.0f, y - 20.0f } }, style); break;
+            }
+        }
+
+        // 经 draw(Shape) 分派的各类几何；点集按个数分别对应折线、线段、单点
+        const Style shapeStyle(Color(140, 30, 160, 90), Color(220, 250, 120, 0), 2.5f);
+        list.draw(Rect(150.0f, 110.0f, 70.0f, 40.0f, 20.0f), shapeStyle);
+        list.draw(Circle(40.0f, 180.0f, 25.0f), shapeStyle);
+        list.draw(Elliptic(250.0f, 40.0f, 60.0f, 30.0f, 35.0f), shapeStyle);
+        list.draw(Triangle(200.0f, 150.0f, 290.0f, 200.0f, 230.0f, 215.0f), shapeStyle);
+        list.draw(Sector(100.0f, 60.0f, 35.0f, 200.0f, 330.0f), shapeStyle);
+        list.draw(Line(10.0f, 10.0f, 120.0f, 200.0f), shapeStyle);
+        list.draw(Ray(Point(280.0f, 10.0f), Point(180.0f, 90.0f)), shapeStyle);
+        list.draw(Polygon({ { 120.0f, 150.0f }, { 190.0f, 170.0f }, { 140.0f, 210.0f } }), shapeStyle);
+        list.draw(Points({ { 20.0f, 100.0f }, { 60.0f, 80.0f }, { 90.0f, 120.0f }, { 130.0f, 90.0f } }), shapeStyle);
+        list.draw(Points({ { 160.0f, 20.0f }, { 220.0f, 60.0f } }), shapeStyle);
+        list.draw(Points({ { 270.0f, 120.0f } }), Style(Color(0), Color(255, 0, 0, 255)));
+    }
+
+    // 录制后回放与直接在 Canvas 上逐条绘制的结果逐位一致；clear 后重新录制（复用样式池与顶点池）结果不变
+    void testReplayMatchesCanvas() {
+        const CompositeMode previousMode = getCompositeMode();
+        CommandList list;
+        for (int mode = 0; mode < 2; ++mode) {
+            setCompositeMode(mode == 0 ? CompositeMode::Precise : CompositeMode::Fast);
+            for (int background = 0; background < 2; ++background) {
+                Buffer base = pa2d_test::pattern(301, 223, 51);
+                if (background == 1) premultiply(base);
+
+                Canvas canvas(base);
+                record(canvas);
+                list.clear();
+                record(list);
+                Buffer replayed = base;
+                list.replay(replayed);
+                PA2D_CHECK(pa2d_test::maxDiff(canvas.getBuffer(), base) > 0);
+                PA2D_CHECK(pa2d_test::maxDiff(replayed, canvas.getBuffer()) == 0);
+            }
+        }
+        PA2D_CHECK(list.size() == 71);
+        setCompositeMode(previousMode);
+    }
+
+    // 当前内核等级下，各合成模式、目标格式、图块大小与线程数的分块渲染都与顺序回放逐位一致
+    void checkTiledMatchesReplay(const CommandList& list) {
+        for (int mode = 0; mode < 2; ++mode) {
+            setCompositeMode(mode == 0 ? CompositeMode::Precise : CompositeMode::Fast);
+            for (int background = 0; background < 3; ++background) {
+                Buffer base(301, 223, Color(255, 240, 235, 220));
+                if (background > 0) base = pa2d_test::pattern(301, 223, 50);
+                if (background == 2) premultiply(base);
+
+                setRenderThreads(1);
+                Buffer expected = base;
+                list.replay(expected);
+                PA2D_CHECK(pa2d_test::maxDiff(expected, base) > 0);
+                for (int tileSize : { 16, 37, 64, 128 }) {
+                    TileRenderer renderer(tileSize);
+                    PA2D_CHECK(renderer.tileSize() % 8 == 0 && renderer.tileSize() >= tileSize);
+                    for (int threads : { 1, 4 }) {
+                        setRenderThreads(threads);
+                        Buffer tiled = base;
+                        renderer.render(list, tiled);
+                        PA2D_CHECK(pa2d_test::maxDiff(tiled, expected) == 0);
+                    }
+                }
+            }
+        }
+        setRenderThreads(1);
+    }
+
+    void testTiledMatchesReplay() {
+        CommandList list;
+        record(list);
+        const CompositeMode previousMode = getCompositeMode();
+        const SimdLevel cpu = getCpuSimdLevel();
+        for (int level = 0; level <= static_cast<int>(cpu); ++level) {
+            setSimdLevel(static_cast<SimdLevel>(level));
+            checkTiledMatchesReplay(list);
+        }
+        setSimdLevel(cpu);
+        setCompositeMode(previousMode);
+    }
+}
+
+int main() {
+    testReplayMatchesCanvas();
+    testTiledMatchesReplay();
+    return pa2d_test::finish("test_command_list");
+}
@@ -0,0 +1,148 @@
+// test_dirty_region.cpp
+// 脏区域：重叠或相邻的矩形合并，超过上限时合并浪费面积最小的一对，整块标记延迟展开；任何时候记录的矩形都覆盖加入过的全部像素
+#include"test_utils.h"
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    bool sameRect(const RectInt& a, const RectInt& b) {
+        return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+    }
+
+    bool contains(const RectInt& outer, const RectInt& inner) {
+        return inner.x >= outer.x && inner.y >= outer.y &&
+               inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+    }
+
+    bool hasRect(const DirtyRegion& region, const RectInt& rect) {
+        for (const RectInt& r : region.rects()) {
+            if (sameRect(r, rect)) return true;
+        }
+        return false;
+    }
+
+    // 两个矩形重叠或共边（含角点相接）
+    bool touching(const RectInt& a, const RectInt& b) {
+        return a.x <= b.x + b.width && b.x <= a.x + a.width && a.y <= b.y + b.height && b.y <= a.y + a.height;
+    }
+
+    // 共边、角点相接与重叠都会合并；隔开 1 像素的保持独立；后加入的矩形把两个已有矩形连起来时三者合为一个
+    void testMerge() {
+        DirtyRegion region;
+        PA2D_CHECK(region.empty() && region.rects().empty());
+        region.add(5, 5, 0, 10);
+        region.add(5, 5, 10, -1);
+        PA2D_CHECK(region.empty());
+
+        region.add(0, 0, 10, 10);
+        region.add(10, 0, 5, 10);
+        PA2D_CHECK(region.rects().size() == 1 && hasRect(region, { 0, 0, 15, 10 }));
+        region.add(15, 10, 5, 5);
+        PA2D_CHECK(region.rects().size() == 1 && hasRect(region, { 0, 0, 20, 15 }));
+        region.add(2, 2, 3, 3);
+        PA2D_CHECK(region.rects().size() == 1 && hasRect(region, { 0, 0, 20, 15 }));
+
+        region.add(21, 0, 4, 4);
+        region.add(0, 16, 4, 4);
+        PA2D_CHECK(region.rects().size() == 3);
+
+        region.add(40, 0, 10, 10);
+        PA2D_CHECK(region.rects().size() == 4);
+        region.add(18, 2, 23, 2);
+        PA2D_CHECK(region.rects().size() == 2 && hasRect(region, { 0, 0, 50, 15 }) && hasRect(region, { 0, 16, 4, 4 }));
+        const RectInt b = region.bounds();
+        PA2D_CHECK(sameRect(b, { 0, 0, 50, 20 }));
+
+        region.clear();
+        PA2D_CHECK(region.empty() && region.rects().empty());
+    }
+
+    // MAX_RECTS 个互不相接的矩形之后再加一个：只合并额外面积最小的一对，其余矩形原样保留
+    void testCapOverflow() {
+        DirtyRegion region;
+        for (int i = 0; i < DirtyRegion::MAX_RECTS; ++i) region.add(i * 100, (i % 3) * 40, 10, 10);
+        PA2D_CHECK(region.rects().size() == static_cast<size_t>(DirtyRegion::MAX_RECTS));
+
+        // 与第 7 个矩形隔开 2 像素：这一对合并只多出 20 像素，其余任意一对至少多出 900 像素
+        region.add(7 * 100 + 12, (7 % 3) * 40, 10, 10);
+        PA2D_CHECK(region.rects().size() == static_cast<size_t>(DirtyRegion::MAX_RECTS));
+        PA2D_CHECK(hasRect(region, { 700, (7 % 3) * 40, 22, 10 }));
+        for (int i = 0; i < DirtyRegion::MAX_RECTS; ++i) {
+            if (i != 7) PA2D_CHECK(hasRect(region, { i * 100, (i % 3) * 40, 10, 10 }));
+        }
+    }
+
+    // 伪随机地加入大量矩形：数量不超过上限、两两不相接，且覆盖加入过的全部像素
+    void testInvariants() {
+        const int size = 256;
+        std::vector<unsigned char> added(size * size, 0);
+        DirtyRegion region;
+        unsigned state = 12345;
+        auto next = [&](int range) {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<int>((state >> 8) % static_cast<unsigned>(range));
+        };
+        for (int step = 0; step < 300; ++step) {
+            const RectInt r = { next(size - 20), next(size - 20), 1 + next(19), 1 + next(19) };
+            region.add(r);
+            for (int y = r.y; y < r.y + r.height; ++y) {
+                for (int x = r.x; x < r.x + r.width; ++x) added[y * size + x] = 1;
+            }
+
+            const std::vector<RectInt>& rects = region.rects();
+            PA2D_CHECK(!rects.empty() && rects.size() <= static_cast<size_t>(DirtyRegion::MAX_RECTS));
+            bool separate = true;
+            for (size_t i = 0; i < rects.size(); ++i) {
+                for (size_t j = i + 1; j < rects.size(); ++j) separate = separate && !touching(rects[i], rects[j]);
+            }
+            PA2D_CHECK(separate);
+            if (step % 30 != 29) continue;
+
+            bool covered = true;
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    if (!added[y * size + x]) continue;
+                    bool inRect = false;
+                    for (const RectInt& rect : rects) inRect = inRect || contains(rect, { x, y, 1, 1 });
+                    covered = covered && inRect;
+                }
+            }
+            PA2D_CHECK(covered);
+        }
+    }
+
+    // markAll 只记录整块，读取 rects() 时才展开；落在整块内的 add 被忽略，越出整块的与之合并
+    void testMarkAll() {
+        static_assert(noexcept(DirtyRegion().markAll(1, 1)), "markAll is used by noexcept moves");
+        DirtyRegion region;
+        region.add(300, 300, 5, 5);
+        region.markAll(200, 100);
+        PA2D_CHECK(!region.empty());
+        PA2D_CHECK(sameRect(region.bounds(), { 0, 0, 200, 100 }));
+        region.add(10, 10, 50, 50);
+        region.add(0, 0, 200, 100);
+        PA2D_CHECK(region.rects().size() == 1 && hasRect(region, { 0, 0, 200, 100 }));
+
+        region.markAll(200, 100);
+        region.add(190, 90, 20, 20);
+        PA2D_CHECK(region.rects().size() == 1 && hasRect(region, { 0, 0, 210, 110 }));
+
+        region.markAll(200, 100);
+        region.add(250, 10, 10, 10);
+        PA2D_CHECK(region.rects().size() == 2 && hasRect(region, { 0, 0, 200, 100 }) && hasRect(region, { 250, 10, 10, 10 }));
+
+        region.markAll(0, 100);
+        PA2D_CHECK(region.empty() && region.rects().empty());
+        region.markAll(64, 32);
+        region.clear();
+        PA2D_CHECK(region.empty() && sameRect(region.bounds(), { 0, 0, 0, 0 }));
+    }
+}
+
+int main() {
+    testMerge();
+    testCapOverflow();
+    testInvariants();
+    testMarkAll();
+    return pa2d_test::finish("test_dirty_region");
+}
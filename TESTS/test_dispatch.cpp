@@ -0,0 +1,81 @@
+// test_dispatch.cpp
+// 运行时分派：处理器支持的各内核等级输出须与 SSE4.1 基线一致（AVX2 的 FMA 舍入允许相差 1）
+#include"test_utils.h"
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    // 覆盖经内核表分派的全部入口：形状光栅化、双线性采样、旋转、减半、Resampler 与精灵
+    std::vector<Buffer> renderAll() {
+        const Buffer source = pa2d_test::pattern(97, 61);
+        std::vector<Buffer> out;
+
+        Buffer shapes(403, 301, Color(255, 30, 40, 50));
+        const Color fill(160, 200, 100, 0), stroke(230, 250, 250, 0);
+        line(shapes, 3.5f, 7.2f, 390.1f, 280.7f, stroke, 3.3f);
+        polyline(shapes, { { 10, 10 }, { 200, 40 }, { 80, 190 }, { 300, 290 } }, stroke, 4.1f, true);
+        polygon(shapes, { { 50, 250 }, { 150, 120 }, { 260, 260 }, { 170, 170 } }, fill, stroke, 2.5f);
+        triangle(shapes, 300, 10, 390, 120, 210, 90, fill, stroke, 1.7f);
+        rect(shapes, 13.3f, 201.7f, 77.1f, 55.5f, fill, stroke, 2.0f);
+        rect(shapes, 200, 150, 120, 60, 0.7f, fill, stroke, 3.0f);
+        roundRect(shapes, 220.5f, 20.2f, 150, 70, fill, stroke, 15, 2.0f);
+        roundRect(shapes, 100, 100, 90, 50, -0.4f, fill, stroke, 12, 2.0f);
+        circle(shapes, 330.3f, 220.8f, 50.2f, fill, stroke, 3.0f);
+        ellipse(shapes, 120, 60, 100, 40, fill, stroke, 2.0f);
+        ellipse(shapes, 250, 250, 100, 40, 1.1f, fill, stroke, 2.0f);
+        sector(shapes, 60, 60, 55, 0.3f, 2.5f, fill, stroke, 2.0f, true, true);
+        out.push_back(shapes);
+
+        Buffer draws(403, 301, Color(255, 30, 40, 50));
+        drawScaled(draws, source, 100, 80, 1.7f, 1.3f);
+        drawResized(draws, source, 300, 80, 131, 45);
+        drawRotated(draws, source, 100, 220, 0.6f);
+        drawRotated(draws, source, 200, 150, 3.14159265f * 0.5f);
+        drawTransformed(draws, source, 300, 220, 1.4f, 0.8f, -0.9f);
+        out.push_back(draws);
+
+        out.push_back(scaled(source, 2.3f, 1.7f));
+        out.push_back(resized(source, 45, 33));
+        out.push_back(rotated(source, 0.35f));
+        out.push_back(halved(source));
+        out.push_back(resized(source, 211, 77, ResampleFilter::Lanczos3));
+        out.push_back(resized(source, 31, 19, ResampleFilter::Bicubic));
+        out.push_back(resized(source, 150, 100, ResampleFilter::Bilinear));
+        out.push_back(resized(source, 150, 100, ResampleFilter::Nearest));
+
+        Buffer sprites(403, 301, Color(200, 30, 40, 50));
+        premultiply(sprites);
+        Buffer premultipliedSource = source;
+        premultiply(premultipliedSource);
+        SpriteBatch batch;
+        for (int i = 0; i < 40; ++i) {
+            batch.add(premultipliedSource, 3, 2, 60, 50, static_cast<float>(i * 9 % 380), static_cast<float>(i * 17 % 280),
+                      0.7f + (i % 4) * 0.4f, i * 0.5f, 0.8f, static_cast<BlendMode>(i % (static_cast<int>(BlendMode::DestAlpha) + 1)));
+        }
+        batch.render(sprites);
+        out.push_back(sprites);
+        return out;
+    }
+}
+
+int main() {
+    const SimdLevel cpu = getCpuSimdLevel();
+    setSimdLevel(SimdLevel::SSE41);
+    PA2D_CHECK(getSimdLevel() == SimdLevel::SSE41);
+    const std::vector<Buffer> baseline = renderAll();
+
+    for (SimdLevel level : { SimdLevel::AVX2, SimdLevel::AVX512 }) {
+        if (static_cast<int>(level) > static_cast<int>(cpu)) continue;
+        setSimdLevel(level);
+        PA2D_CHECK(getSimdLevel() == level);
+        const std::vector<Buffer> result = renderAll();
+        PA2D_CHECK(result.size() == baseline.size());
+        for (size_t i = 0; i < result.size() && i < baseline.size(); ++i) {
+            const int diff = pa2d_test::maxDiff(result[i], baseline[i]);
+            if (diff > 1) std::printf("level %d, case %zu: max diff %d\n", static_cast<int>(level), i, diff);
+            PA2D_CHECK_LE(diff, 1);
+        }
+    }
+    setSimdLevel(cpu);
+    return pa2d_test::finish("test_dispatch");
+}
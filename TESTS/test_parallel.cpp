@@ -0,0 +1,115 @@
+// test_parallel.cpp
+// 条带并行：形状光栅化与图像重采样开启多个渲染线程后，输出须与串行逐位一致
+#include"test_utils.h"
+#include<functional>
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    // 分别以 1 个和 4 个渲染线程执行 render，返回两次的最大像素差
+    int serialVsParallel(const std::function<Buffer()>& render) {
+        setRenderThreads(1);
+        const Buffer serial = render();
+        setRenderThreads(4);
+        PA2D_CHECK(getRenderThreads() == 4);
+        const Buffer parallel = render();
+        setRenderThreads(1);
+        return pa2d_test::maxDiff(serial, parallel);
+    }
+
+    // 包围盒都超过并行阈值，半透明颜色覆盖在图案上，条带边界落在抗锯齿边缘内
+    void testShapes() {
+        const Buffer background = pa2d_test::pattern(400, 300);
+        const Color fill(160, 30, 120, 220), stroke(200, 250, 200, 40);
+        std::vector<std::function<void(Buffer&)>> shapes = {
+            [&](Buffer& b) { line(b, 5.5f, 3.2f, 390.7f, 291.1f, stroke, 7.3f); },
+            [&](Buffer& b) { polyline(b, { { 10, 20 }, { 380, 40 }, { 30, 280 }, { 390, 260 } }, stroke, 5.5f, true); },
+            [&](Buffer& b) { polygon(b, { { 20, 10 }, { 390, 60 }, { 200, 150 }, { 350, 290 }, { 10, 250 } }, fill, stroke, 3.0f); },
+            [&](Buffer& b) { triangle(b, 10.2f, 290.8f, 200.5f, 4.4f, 395.1f, 270.3f, fill, stroke, 2.5f); },
+            [&](Buffer& b) { rect(b, 12.3f, 9.7f, 370.4f, 280.2f, fill, stroke, 4.0f); },
+            [&](Buffer& b) { rect(b, 200.0f, 150.0f, 320.0f, 180.0f, 0.4f, fill, stroke, 4.0f); },
+            [&](Buffer& b) { roundRect(b, 15.5f, 12.5f, 360.0f, 270.0f, fill, stroke, 40.0f, 3.0f); },
+            [&](Buffer& b) { roundRect(b, 200.0f, 150.0f, 300.0f, 160.0f, -0.3f, fill, stroke, 30.0f, 3.0f); },
+            [&](Buffer& b) { circle(b, 200.4f, 150.6f, 140.2f, fill, stroke, 6.0f); },
+            [&](Buffer& b) { ellipse(b, 200.0f, 150.0f, 380.0f, 270.0f, fill, stroke, 3.0f); },
+            [&](Buffer& b) { ellipse(b, 200.0f, 150.0f, 360.0f, 200.0f, 0.7f, fill, stroke, 3.0f); },
+            [&](Buffer& b) { sector(b, 200.0f, 150.0f, 145.0f, 0.4f, 4.9f, fill, stroke, 3.0f, true, true); },
+        };
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            const int diff = serialVsParallel([&] {
+                Buffer target = background;
+                shapes[i](target);
+                return target;
+            });
+            if (diff != 0) std::printf("shape %zu differs\n", i);
+            PA2D_CHECK(diff == 0);
+        }
+    }
+
+    // Canvas 形状绘制经同样的条带路径
+    void testCanvas() {
+        const int diff = serialVsParallel([] {
+            Canvas canvas(400, 300, Color(255, 20, 40, 60));
+            canvas.rect(20.5f, 15.5f, 360.0f, 260.0f, Style().fill(Color(128, 255, 200, 0)).stroke(0xFFFFFFFF).width(3.0f).radius(24.0f));
+            canvas.circle(200.0f, 150.0f, 120.0f, Style().fill(Color(90, 0, 120, 255)).width(0.0f));
+            return canvas.getBuffer();
+        });
+        PA2D_CHECK(diff == 0);
+    }
+
+    // 两次并行任务之间反复改变线程数：新建的工作线程只处理之后提交的任务
+    void testThreadCountChanges() {
+        const Buffer background = pa2d_test::pattern(400, 300, 3);
+        const Color fill(160, 30, 120, 220);
+        auto render = [&] {
+            Buffer target = background;
+            circle(target, 200.4f, 150.6f, 140.2f, fill, fill, 2.0f);
+            return target;
+        };
+        setRenderThreads(1);
+        const Buffer serial = render();
+        for (int i = 0; i < 24; ++i) {
+            setRenderThreads(2 + i % 4);
+            PA2D_CHECK(getRenderThreads() == 2 + i % 4);
+            PA2D_CHECK(pa2d_test::maxDiff(render(), serial) == 0);
+            PA2D_CHECK(pa2d_test::maxDiff(render(), serial) == 0);
+        }
+        setRenderThreads(1);
+    }
+
+    // 缩放、旋转与变换按输出行条带并行，输出都超过并行阈值
+    void testImages() {
+        const Buffer source = pa2d_test::pattern(240, 170);
+        std::vector<std::function<Buffer()>> images = {
+            [&] { return scaled(source, 2.1f, 1.9f); },
+            [&] { return resized(source, 500, 300); },
+            [&] { return resized(source, 70, 40); },
+            [&] { return halved(scaled(source, 3.0f)); },
+            [&] { return rotated(source, 0.45f); },
+            [&] { return transformed(source, 1.6f, 1.3f, -0.8f); },
+            [&] { return resized(source, 450, 310, ResampleFilter::Bicubic); },
+            [&] { return resized(source, 110, 60, ResampleFilter::Lanczos3); },
+            [&] { return resized(source, 480, 340, ResampleFilter::Nearest); },
+            [&] {
+                Buffer target = pa2d_test::pattern(400, 300, 2);
+                drawScaled(target, source, 200.0f, 150.0f, 1.5f, 1.4f);
+                drawRotated(target, source, 180.0f, 140.0f, 2.3f);
+                drawTransformed(target, source, 210.0f, 160.0f, 1.2f, 1.7f, 0.6f);
+                return target;
+            },
+        };
+        for (size_t i = 0; i < images.size(); ++i) {
+            const int diff = serialVsParallel(images[i]);
+            if (diff != 0) std::printf("image %zu differs\n", i);
+            PA2D_CHECK(diff == 0);
+        }
+    }
+}
+
+int main() {
+    testShapes();
+    testCanvas();
+    testImages();
+    testThreadCountChanges();
+    return pa2d_test::finish("test_parallel");
+}
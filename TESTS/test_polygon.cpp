@@ -0,0 +1,105 @@
+// test_polygon.cpp
+// 多边形填充：自相交多边形按奇偶规则判定内外，远离边的像素与参考结果一致（各内核等级、合成模式相同）
+#include"test_utils.h"
+#include<cmath>
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    // 像素中心按奇偶规则是否在多边形内部
+    bool insideEvenOdd(const std::vector<Point>& poly, double x, double y) {
+        bool inside = false;
+        for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+            const double xi = poly[i].x, yi = poly[i].y, xj = poly[j].x, yj = poly[j].y;
+            if ((yi > y) != (yj > y) && x < xi + (y - yi) * (xj - xi) / (yj - yi)) inside = !inside;
+        }
+        return inside;
+    }
+
+    // 像素中心到多边形各边的最小距离
+    double edgeDistance(const std::vector<Point>& poly, double x, double y) {
+        double best = 1e30;
+        for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+            const double ax = poly[j].x, ay = poly[j].y, dx = poly[i].x - ax, dy = poly[i].y - ay;
+            const double lenSq = dx * dx + dy * dy;
+            double t = lenSq > 0.0 ? ((x - ax) * dx + (y - ay) * dy) / lenSq : 0.0;
+            t = std::max(0.0, std::min(1.0, t));
+            const double ex = x - ax - t * dx, ey = y - ay - t * dy;
+            best = std::min(best, std::sqrt(ex * ex + ey * ey));
+        }
+        return best;
+    }
+
+    std::vector<Point> pentagram(float cx, float cy, float radius) {
+        std::vector<Point> points;
+        for (int i = 0; i < 5; ++i) {
+            const float a = (-90.0f + 144.0f * i) * 3.14159265f / 180.0f;
+            points.push_back({ cx + radius * std::cos(a), cy + radius * std::sin(a) });
+        }
+        return points;
+    }
+
+    // 离边超过 2 像素的像素：外部保持背景不变，内部与整块填充的参考一致（不透明填充逐位相同，半透明相差不超过 1）
+    // 返回检查过的内部与外部像素个数
+    void checkPolygon(const std::vector<Point>& poly, const Buffer& base, Color fill, int& insideCount, int& outsideCount) {
+        Buffer result = base;
+        polygon(result, poly, fill, Color(0), 0.0f);
+        Buffer reference = base;
+        rect(reference, -10.0f, -10.0f, base.width + 20.0f, base.height + 20.0f, fill, Color(0), 0.0f);
+
+        int insideDiff = 0;
+        bool outsideUnchanged = true;
+        for (int y = 0; y < base.height; ++y) {
+            for (int x = 0; x < base.width; ++x) {
+                const double fx = x + 0.5, fy = y + 0.5;
+                if (edgeDistance(poly, fx, fy) <= 2.0) continue;
+                if (insideEvenOdd(poly, fx, fy)) {
+                    ++insideCount;
+                    insideDiff = std::max(insideDiff, pa2d_test::channelDiff(result.at(x, y), reference.at(x, y)));
+                }
+                else {
+                    ++outsideCount;
+                    outsideUnchanged = outsideUnchanged && result.at(x, y).data == base.at(x, y).data;
+                }
+            }
+        }
+        PA2D_CHECK(outsideUnchanged);
+        PA2D_CHECK_LE(insideDiff, fill.a == 255 ? 0 : 1);
+    }
+
+    // 五角星中心的五边形、两次绕行的正方形内部、蝴蝶结交叉点两侧在奇偶规则下的判定
+    void testEvenOdd() {
+        const std::vector<Point> shapes[] = {
+            pentagram(100.0f, 104.0f, 92.0f),
+            { { 20, 20 }, { 180, 20 }, { 180, 180 }, { 20, 180 }, { 20, 20 }, { 180, 20 }, { 180, 180 }, { 20, 180 } },
+            { { 15.5f, 30.0f }, { 185.0f, 170.5f }, { 185.0f, 30.0f }, { 15.5f, 170.5f } },
+        };
+        const Color fills[] = { Color(255, 30, 200, 90), Color(140, 220, 40, 160) };
+        const Buffer base = pa2d_test::pattern(203, 207, 60);
+
+        const CompositeMode previousMode = getCompositeMode();
+        const SimdLevel cpu = getCpuSimdLevel();
+        for (int level = 0; level <= static_cast<int>(cpu); ++level) {
+            setSimdLevel(static_cast<SimdLevel>(level));
+            for (int mode = 0; mode < 2; ++mode) {
+                setCompositeMode(mode == 0 ? CompositeMode::Precise : CompositeMode::Fast);
+                for (const Color& fill : fills) {
+                    int inside[3] = {}, outside[3] = {};
+                    for (int i = 0; i < 3; ++i) checkPolygon(shapes[i], base, fill, inside[i], outside[i]);
+                    // 五角星中心五边形在外部，两次绕行的正方形整体在外部，蝴蝶结左右两个三角形在内部
+                    PA2D_CHECK(inside[0] > 4000 && outside[0] > 2000);
+                    PA2D_CHECK(!insideEvenOdd(shapes[0], 100.0, 104.0));
+                    PA2D_CHECK(inside[1] == 0 && outside[1] > 20000);
+                    PA2D_CHECK(inside[2] > 8000 && insideEvenOdd(shapes[2], 30.0, 100.0) && !insideEvenOdd(shapes[2], 100.0, 40.0));
+                }
+            }
+        }
+        setSimdLevel(cpu);
+        setCompositeMode(previousMode);
+    }
+}
+
+int main() {
+    testEvenOdd();
+    return pa2d_test::finish("test_polygon");
+}
@@ -0,0 +1,253 @@
+// test_resample.cpp
+// 缩放与重采样：与按定义逐像素计算的标量结果比较
+#include"test_utils.h"
+#include<cmath>
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    const double PI = 3.14159265358979323846;
+
+    // 滤波核的定义：三角、Keys 三次（a = -0.5）与 Lanczos3，返回 (权重, 半径)
+    double filterWeight(ResampleFilter filter, double x, double& radius) {
+        const double ax = std::fabs(x);
+        switch (filter) {
+        case ResampleFilter::Bilinear:
+            radius = 1.0;
+            return std::max(0.0, 1.0 - ax);
+        case ResampleFilter::Bicubic:
+            radius = 2.0;
+            if (ax < 1.0) return 1.5 * ax * ax * ax - 2.5 * ax * ax + 1.0;
+            if (ax < 2.0) return -0.5 * ax * ax * ax + 2.5 * ax * ax - 4.0 * ax + 2.0;
+            return 0.0;
+        default:
+            radius = 3.0;
+            if (ax < 1e-8) return 1.0;
+            if (ax >= 3.0) return 0.0;
+            return 3.0 * std::sin(PI * x) * std::sin(PI * x / 3.0) / (PI * PI * x * x);
+        }
+    }
+
+    // 一维重采样：输出像素 i 的中心映射到源坐标 (i + 0.5) * scale，缩小时滤波核按比例展宽，权重归一化
+    // 每一遍的结果四舍五入并截断到 0..255，与两遍之间以 8 位存放中间结果一致
+    std::vector<Color> resampleLine(const std::vector<Color>& src, int dstSize, ResampleFilter filter) {
+        const int srcSize = static_cast<int>(src.size());
+        const double scale = static_cast<double>(srcSize) / dstSize;
+        std::vector<Color> out(dstSize);
+        for (int i = 0; i < dstSize; ++i) {
+            const double center = (i + 0.5) * scale;
+            if (filter == ResampleFilter::Nearest) {
+                out[i] = src[std::min(srcSize - 1, static_cast<int>(center))];
+                continue;
+            }
+            const double filterScale = std::max(1.0, scale);
+            double sum[4] = { 0, 0, 0, 0 }, total = 0.0, radius = 0.0;
+            for (int x = 0; x < srcSize; ++x) {
+                const double w = filterWeight(filter, (x + 0.5 - center) / filterScale, radius);
+                if (w == 0.0) continue;
+                sum[0] += w * src[x].a; sum[1] += w * src[x].r; sum[2] += w * src[x].g; sum[3] += w * src[x].b;
+                total += w;
+            }
+            uint8_t channel[4];
+            for (int c = 0; c < 4; ++c) {
+                channel[c] = static_cast<uint8_t>(std::min(255L, std::max(0L, std::lround(sum[c] / total))));
+            }
+            out[i] = Color(channel[0], channel[1], channel[2], channel[3]);
+        }
+        return out;
+    }
+
+    // 先横向后纵向的可分离重采样
+    Buffer referenceResample(const Buffer& src, int width, int height, ResampleFilter filter) {
+        Buffer horizontal(width, src.height);
+        for (int y = 0; y < src.height; ++y) {
+            std::vector<Color> row(src.width);
+            for (int x = 0; x < src.width; ++x) row[x] = src.at(x, y);
+            if (width != src.width) row = resampleLine(row, width, filter);
+            for (int x = 0; x < width; ++x) horizontal.at(x, y) = row[x];
+        }
+        Buffer out(width, height);
+        for (int x = 0; x < width; ++x) {
+            std::vector<Color> column(src.height);
+            for (int y = 0; y < src.height; ++y) column[y] = horizontal.at(x, y);
+            if (height != src.height) column = resampleLine(column, height, filter);
+            for (int y = 0; y < height; ++y) out.at(x, y) = column[y];
+        }
+        return out;
+    }
+
+    // 2:1 盒式滤波的定义：四个源像素之和四舍五入，奇数边的末列/末行与自身平均
+    Buffer referenceHalved(const Buffer& src) {
+        Buffer out((src.width + 1) / 2, (src.height + 1) / 2);
+        for (int y = 0; y < out.height; ++y) {
+            for (int x = 0; x < out.width; ++x) {
+                const int x0 = 2 * x, x1 = std::min(2 * x + 1, src.width - 1);
+                const int y0 = 2 * y, y1 = std::min(2 * y + 1, src.height - 1);
+                const Color a = src.at(x0, y0), b = src.at(x1, y0), c = src.at(x0, y1), d = src.at(x1, y1);
+                out.at(x, y) = Color(
+                    static_cast<uint8_t>((a.a + b.a + c.a + d.a + 2) >> 2),
+                    static_cast<uint8_t>((a.r + b.r + c.r + d.r + 2) >> 2),
+                    static_cast<uint8_t>((a.g + b.g + c.g + d.g + 2) >> 2),
+                    static_cast<uint8_t>((a.b + b.b + c.b + d.b + 2) >> 2));
+            }
+        }
+        return out;
+    }
+
+    // factor x factor 源像素块的平均值
+    Buffer referenceAreaAverage(const Buffer& src, int factor) {
+        Buffer out(src.width / factor, src.height / factor);
+        for (int y = 0; y < out.height; ++y) {
+            for (int x = 0; x < out.width; ++x) {
+                double sum[4] = { 0, 0, 0, 0 };
+                for (int j = 0; j < factor; ++j) {
+                    for (int i = 0; i < factor; ++i) {
+                        const Color c = src.at(x * factor + i, y * factor + j);
+                        sum[0] += c.a; sum[1] += c.r; sum[2] += c.g; sum[3] += c.b;
+                    }
+                }
+                const double n = static_cast<double>(factor) * factor;
+                out.at(x, y) = Color(
+                    static_cast<uint8_t>(std::lround(sum[0] / n)), static_cast<uint8_t>(std::lround(sum[1] / n)),
+                    static_cast<uint8_t>(std::lround(sum[2] / n)), static_cast<uint8_t>(std::lround(sum[3] / n)));
+            }
+        }
+        return out;
+    }
+
+    // 轴对齐双线性的定义：输出像素 x 取源坐标 x * srcWidth / width（末列留出余量），取左上 2x2 源像素按距离插值
+    Buffer referenceBilinear(const Buffer& src, int width, int height) {
+        Buffer out(width, height);
+        const float invScaleX = static_cast<float>(src.width) / width;
+        const float invScaleY = static_cast<float>(src.height) / height;
+        for (int y = 0; y < height; ++y) {
+            const float sy = y * invScaleY;
+            const int y0 = static_cast<int>(sy), y1 = std::min(y0 + 1, src.height - 1);
+            const float dy = sy - y0;
+            for (int x = 0; x < width; ++x) {
+                const float sx = std::min(x * invScaleX, src.width - 1.05f);
+                const int x0 = static_cast<int>(std::floor(sx)), x1 = std::min(x0 + 1, src.width - 1);
+                const float dx = sx - x0;
+                const Color c00 = src.at(x0, y0), c10 = src.at(x1, y0), c01 = src.at(x0, y1), c11 = src.at(x1, y1);
+                auto lerp = [&](int v00, int v10, int v01, int v11) {
+                    const float top = v00 + (v10 - v00) * dx, bottom = v01 + (v11 - v01) * dx;
+                    return static_cast<uint8_t>(std::lround(top + (bottom - top) * dy));
+                };
+                out.at(x, y) = Color(lerp(c00.a, c10.a, c01.a, c11.a), lerp(c00.r, c10.r, c01.r, c11.r),
+                                     lerp(c00.g, c10.g, c01.g, c11.g), lerp(c00.b, c10.b, c01.b, c11.b));
+            }
+        }
+        return out;
+    }
+
+    void testHalved() {
+        // 偶数与奇数尺寸，宽度覆盖向量主循环与标量尾部
+        const int sizes[][2] = { { 64, 48 }, { 37, 23 }, { 5, 3 }, { 1, 9 } };
+        for (const auto& size : sizes) {
+            const Buffer source = pa2d_test::pattern(size[0], size[1], 3);
+            const Buffer result = halved(source);
+            PA2D_CHECK(result.width == (size[0] + 1) / 2 && result.height == (size[1] + 1) / 2);
+            PA2D_CHECK_LE(pa2d_test::maxDiff(result, referenceHalved(source)), 1);
+        }
+    }
+
+    // 缩小到一半以下时逐级盒式滤波，每个源像素都参与平均
+    void testLargeReduction() {
+        const Buffer source = pa2d_test::pattern(256, 160, 4);
+        PA2D_CHECK_LE(pa2d_test::maxDiff(resized(source, 32, 20), referenceAreaAverage(source, 8)), 2);
+        PA2D_CHECK_LE(pa2d_test::maxDiff(scaled(source, 0.25f), referenceAreaAverage(source, 4)), 1);
+    }
+
+    void testMipChain() {
+        const Buffer source = pa2d_test::pattern(100, 37, 5);
+        MipChain chain(source);
+        PA2D_CHECK(chain.isValid());
+        PA2D_CHECK(pa2d_test::maxDiff(chain.level(0), source) == 0);
+        for (int i = 1; i < chain.levels(); ++i) {
+            const Buffer& previous = chain.level(i - 1);
+            PA2D_CHECK(chain.level(i).width == (previous.width + 1) / 2);
+            PA2D_CHECK(chain.level(i).height == (previous.height + 1) / 2);
+            PA2D_CHECK_LE(pa2d_test::maxDiff(chain.level(i), referenceHalved(previous)), 1);
+        }
+        const Buffer& last = chain.level(chain.levels() - 1);
+        PA2D_CHECK(last.width == 1 && last.height == 1);
+
+        MipChain limited(source, 3);
+        PA2D_CHECK(limited.levels() == 3);
+
+        // 目标尺寸使 resized 逐级减半后落在同一级时，从该级缩放与直接从源图缩放结果相同
+        PA2D_CHECK(chain.levelFor(30, 10) == 1);
+        const int targets[][2] = { { 60, 22 }, { 30, 10 }, { 12, 5 }, { 6, 2 }, { 100, 37 } };
+        for (const auto& target : targets) {
+            const Buffer direct = resized(source, target[0], target[1]);
+            const Buffer viaChain = chain.resized(target[0], target[1]);
+            PA2D_CHECK(viaChain.width == target[0] && viaChain.height == target[1]);
+            PA2D_CHECK_LE(pa2d_test::maxDiff(viaChain, direct), 0);
+        }
+    }
+
+    // 无旋转缩放的列采样表：放大时每 8 列的源跨度小于 8，缩小到 0.5 以上时跨度在 8 到 16 之间，
+    // 两种连续读取与回退的 gather 都与逐像素双线性一致；源为带行跨度的视图时同样如此
+    void testBilinearScale() {
+        Buffer page = pa2d_test::pattern(181, 97, 8);
+        const BufferView view = cropView(page, 13, 7, 150, 80);
+        PA2D_CHECK(view.stride != view.width);
+        const Buffer copied = crop(page, 13, 7, 150, 80);
+        const int targets[][2] = { { 413, 177 }, { 151, 80 }, { 150, 211 }, { 97, 53 }, { 76, 41 }, { 149, 79 } };
+        for (const Buffer* source : { static_cast<const Buffer*>(&view), &copied }) {
+            for (const auto& target : targets) {
+                const Buffer result = resized(*source, target[0], target[1]);
+                PA2D_CHECK(result.width == target[0] && result.height == target[1]);
+                PA2D_CHECK_LE(pa2d_test::maxDiff(result, referenceBilinear(*source, target[0], target[1])), 1);
+            }
+        }
+        PA2D_CHECK_LE(pa2d_test::maxDiff(scaled(copied, 1.37f, 0.81f), referenceBilinear(copied, 205, 64)), 1);
+        PA2D_CHECK(pa2d_test::maxDiff(resized(view, 76, 41), resized(copied, 76, 41)) == 0);
+    }
+
+    void testResampler() {
+        const Buffer source = pa2d_test::pattern(53, 41, 6);
+        const ResampleFilter filters[] = { ResampleFilter::Nearest, ResampleFilter::Bilinear, ResampleFilter::Bicubic, ResampleFilter::Lanczos3 };
+        // 放大、缩小、单方向缩放，以及比抽头数还窄的输出
+        const int targets[][2] = { { 131, 97 }, { 29, 17 }, { 53, 80 }, { 90, 41 }, { 7, 3 }, { 1, 1 } };
+        for (ResampleFilter filter : filters) {
+            for (const auto& target : targets) {
+                const Buffer result = resized(source, target[0], target[1], filter);
+                PA2D_CHECK(result.width == target[0] && result.height == target[1]);
+                const int diff = pa2d_test::maxDiff(result, referenceResample(source, target[0], target[1], filter));
+                if (diff > 2) std::printf("filter %d, %dx%d\n", static_cast<int>(filter), target[0], target[1]);
+                // 14 位定点权重：每一遍与精确结果相差不超过 1
+                PA2D_CHECK_LE(diff, filter == ResampleFilter::Nearest ? 0 : 2);
+            }
+        }
+    }
+
+    // 权重和恰为 1：纯色图缩放后保持不变；尺寸相同时原样复制
+    void testResamplerInvariants() {
+        const Buffer solid(37, 29, Color(200, 13, 128, 250));
+        for (ResampleFilter filter : { ResampleFilter::Bilinear, ResampleFilter::Bicubic, ResampleFilter::Lanczos3 }) {
+            PA2D_CHECK(pa2d_test::maxDiff(resized(solid, 101, 11, filter), Buffer(101, 11, Color(200, 13, 128, 250))) == 0);
+        }
+        const Buffer source = pa2d_test::pattern(40, 30, 7);
+        PA2D_CHECK(pa2d_test::maxDiff(resized(source, 40, 30, ResampleFilter::Lanczos3), source) == 0);
+
+        // 预先构建的 Resampler 可反复用于同尺寸的图，写入已有的目标
+        const Resampler resampler(40, 30, 64, 20, ResampleFilter::Bicubic);
+        PA2D_CHECK(resampler.matches(40, 30, 64, 20, ResampleFilter::Bicubic));
+        PA2D_CHECK(!resampler.matches(40, 30, 64, 20, ResampleFilter::Lanczos3));
+        Buffer dest(64, 20);
+        PA2D_CHECK(resampler.apply(source, dest));
+        PA2D_CHECK(pa2d_test::maxDiff(dest, resized(source, 64, 20, ResampleFilter::Bicubic)) == 0);
+        PA2D_CHECK(!resampler.apply(pa2d_test::pattern(41, 30), dest));
+    }
+}
+
+int main() {
+    testHalved();
+    testLargeReduction();
+    testMipChain();
+    testBilinearScale();
+    testResampler();
+    testResamplerInvariants();
+    return pa2d_test::finish("test_resample");
+}
@@ -0,0 +1,154 @@
+// test_sprite_batch.cpp
+// 精灵批量渲染：图块分箱与并行不改变结果，采样与 drawTransformed 一致，重叠时保持录制顺序
+#include"test_utils.h"
+#include<vector>
+using namespace pa2d;
+
+namespace {
+    // 以 (x, y) 为中心、半径 radius 的方形邻域内 alpha 都为 255
+    bool opaqueNeighbourhood(const Buffer& image, int x, int y, int radius) {
+        if (x < radius || y < radius || x >= image.width - radius || y >= image.height - radius) return false;
+        for (int dy = -radius; dy <= radius; ++dy) {
+            for (int dx = -radius; dx <= radius; ++dx) {
+                if (image.at(x + dx, y + dy).a != 255) return false;
+            }
+        }
+        return true;
+    }
+
+    Buffer opaque(Buffer image) {
+        for (int y = 0; y < image.height; ++y) {
+            for (int x = 0; x < image.width; ++x) image.at(x, y).a = 255;
+        }
+        return image;
+    }
+
+    // 大小、位置、旋转、模式各异的一批精灵，部分越过目标边界、部分跨越多个图块
+    void record(SpriteBatch& batch, const Buffer& source) {
+        for (int i = 0; i < 120; ++i) {
+            const float x = static_cast<float>(i * 37 % 340) - 20.0f;
+            const float y = static_cast<float>(i * 53 % 250) - 25.0f;
+            const BlendMode mode = i % 5 == 4 ? static_cast<BlendMode>(i % (static_cast<int>(BlendMode::DestAlpha) + 1)) : BlendMode::SrcOver;
+            if (i % 3 == 0) batch.add(source, x, y, 0.5f + (i % 7) * 0.3f, i * 0.37f, 0.6f + (i % 4) * 0.1f, mode);
+            else batch.add(source, i % 11, i % 9, 20 + i % 13, 15 + i % 17, x, y, 0.8f + (i % 5) * 0.4f, -i * 0.21f, 1.0f, mode);
+        }
+    }
+
+    Buffer renderBatch(const Buffer& source, const Buffer& background, int tileSize) {
+        SpriteBatch batch(tileSize);
+        record(batch, source);
+        Buffer target = background;
+        batch.render(target);
+        return target;
+    }
+
+    // 图块大小只影响分箱，不同图块大小、串行与并行的输出逐位一致
+    void testTileBinning() {
+        const Buffer source = pa2d_test::pattern(41, 33, 30);
+        for (int format = 0; format < 2; ++format) {
+            Buffer background = pa2d_test::pattern(300, 200, 31);
+            Buffer premultipliedSource = source;
+            if (format == 1) {
+                premultiply(background);
+                premultiply(premultipliedSource);
+            }
+            const Buffer& src = format == 1 ? premultipliedSource : source;
+            setRenderThreads(1);
+            const Buffer reference = renderBatch(src, background, 1024);
+            PA2D_CHECK(pa2d_test::maxDiff(renderBatch(src, background, 16), reference) == 0);
+            PA2D_CHECK(pa2d_test::maxDiff(renderBatch(src, background, 64), reference) == 0);
+            PA2D_CHECK(pa2d_test::maxDiff(renderBatch(src, background, 37), reference) == 0);
+            setRenderThreads(4);
+            PA2D_CHECK(pa2d_test::maxDiff(renderBatch(src, background, 16), reference) == 0);
+            PA2D_CHECK(pa2d_test::maxDiff(renderBatch(src, background, 64), reference) == 0);
+            setRenderThreads(1);
+            PA2D_CHECK(pa2d_test::maxDiff(reference, background) > 0);
+        }
+    }
+
+    // 单个源覆盖精灵与 drawTransformed 的采样位置相同
+    // 只比较 drawTransformed 完全不透明写入、且两像素内的邻域也完全写入的内部像素（放大时外缘的插值方式不同），
+    // 并要求它们不少于精灵写入像素的三分之一；
+    // 角度取正且避开 drawTransformed 按 0/90/180/270 分派的快速路径，这些路径使用另一套采样
+    void testMatchesDrawTransformed() {
+        const Buffer source = opaque(pa2d_test::pattern(45, 29, 32));
+        const Buffer background = opaque(pa2d_test::pattern(160, 120, 33));
+        const float cases[][4] = {
+            { 80.0f, 60.0f, 1.0f, 0.4f },
+            { 70.3f, 55.8f, 1.7f, 0.4f },
+            { 90.5f, 61.2f, 0.6f, 2.3f },
+            { 60.0f, 70.0f, 1.3f, 4.0f },
+            { 10.0f, 110.0f, 2.2f, 1.1f },
+        };
+        for (const auto& c : cases) {
+            Buffer expected = background, mask(background.width, background.height, Color(0, 0, 0, 0));
+            drawTransformed(expected, source, c[0], c[1], c[2], c[3]);
+            drawTransformed(mask, source, c[0], c[1], c[2], c[3]);
+            SpriteBatch batch(32);
+            batch.add(source, c[0], c[1], c[2], c[3]);
+            Buffer result = background;
+            batch.render(result);
+
+            int diff = 0, compared = 0, changed = 0;
+            for (int y = 0; y < background.height; ++y) {
+                for (int x = 0; x < background.width; ++x) {
+                    if (result.at(x, y).data != background.at(x, y).data) ++changed;
+                    if (!opaqueNeighbourhood(mask, x, y, 2)) continue;
+                    ++compared;
+                    diff = std::max(diff, pa2d_test::channelDiff(result.at(x, y), expected.at(x, y)));
+                }
+            }
+            PA2D_CHECK_LE(diff, 1);
+            PA2D_CHECK(compared * 3 > changed);
+        }
+    }
+
+    // 缩放 1、无旋转、中心在整数 + 源尺寸一半时，不透明源逐像素落到目标上；源矩形与裁剪出的子图等价
+    void testIdentityPlacement() {
+        const Buffer source = opaque(pa2d_test::pattern(30, 20, 34));
+        Buffer target(100, 80, Color(255, 0, 0, 0));
+        SpriteBatch batch(16);
+        batch.add(source, 17.0f + 15.0f, 9.0f + 10.0f);
+        batch.add(source, 4, 3, 12, 10, 60.0f + 6.0f, 50.0f + 5.0f);
+        batch.render(target);
+        int diff = 0;
+        for (int y = 0; y < source.height; ++y) {
+            for (int x = 0; x < source.width; ++x) diff = std::max(diff, pa2d_test::channelDiff(target.at(17 + x, 9 + y), source.at(x, y)));
+        }
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 12; ++x) diff = std::max(diff, pa2d_test::channelDiff(target.at(60 + x, 50 + y), source.at(4 + x, 3 + y)));
+        }
+        PA2D_CHECK(diff == 0);
+        PA2D_CHECK(target.at(16, 9).data == Color(255, 0, 0, 0).data);
+        PA2D_CHECK(target.at(72, 50).data == Color(255, 0, 0, 0).data);
+    }
+
+    // 重叠的不透明精灵跨越图块边界，后录制的覆盖先录制的
+    void testRecordingOrder() {
+        const Buffer red(20, 20, Color(255, 255, 0, 0)), blue(20, 20, Color(255, 0, 0, 255));
+        Buffer target(64, 64, Color(255, 0, 0, 0));
+        SpriteBatch batch(8);
+        batch.add(red, 20.0f, 20.0f).add(blue, 30.0f, 30.0f).add(red, 40.0f, 40.0f);
+        batch.render(target);
+        PA2D_CHECK(target.at(15, 15).data == red.at(0, 0).data);
+        PA2D_CHECK(target.at(25, 25).data == blue.at(0, 0).data);
+        PA2D_CHECK(target.at(35, 35).data == red.at(0, 0).data);
+        PA2D_CHECK(target.at(45, 45).data == red.at(0, 0).data);
+        PA2D_CHECK(target.at(5, 5).data == Color(255, 0, 0, 0).data);
+
+        // clear 后重新录制只包含新的实例
+        batch.clear().add(blue, 40.0f, 40.0f);
+        PA2D_CHECK(batch.size() == 1);
+        batch.render(target);
+        PA2D_CHECK(target.at(35, 35).data == blue.at(0, 0).data);
+        PA2D_CHECK(target.at(25, 25).data == blue.at(0, 0).data);
+    }
+}
+
+int main() {
+    testTileBinning();
+    testMatchesDrawTransformed();
+    testIdentityPlacement();
+    testRecordingOrder();
+    return pa2d_test::finish("test_sprite_batch");
+}
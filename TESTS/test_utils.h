@@ -0,0 +1,70 @@
+// test_utils.h
+// 单元测试共用工具：不依赖测试框架，每个 test_*.cpp 是独立的可执行文件，
+// main 依次调用各用例，最后由 finish() 汇总，有失败时返回非零（ctest 据此判定）
+#pragma once
+#include"pa2d.h"
+#include<algorithm>
+#include<cstdio>
+#include<cstdlib>
+
+namespace pa2d_test {
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    inline void check(bool ok, const char* expr, const char* file, int line) {
+        if (ok) return;
+        ++failures();
+        std::printf("%s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+
+    // value <= limit，失败时打印实际值（像素差、误差等）
+    inline void checkLe(double value, double limit, const char* expr, const char* file, int line) {
+        if (value <= limit) return;
+        ++failures();
+        std::printf("%s:%d: %s = %g, expected <= %g\n", file, line, expr, value, limit);
+    }
+
+    // 两个像素四个通道差的最大值
+    inline int channelDiff(pa2d::Color a, pa2d::Color b) {
+        return std::max(std::max(std::abs(a.r - b.r), std::abs(a.g - b.g)),
+                        std::max(std::abs(a.b - b.b), std::abs(a.a - b.a)));
+    }
+
+    // 两幅图逐像素的最大通道差；尺寸不同时返回 256
+    inline int maxDiff(const pa2d::Buffer& a, const pa2d::Buffer& b) {
+        if (a.width != b.width || a.height != b.height) return 256;
+        int diff = 0;
+        for (int y = 0; y < a.height; ++y) {
+            for (int x = 0; x < a.width; ++x) diff = std::max(diff, channelDiff(a.at(x, y), b.at(x, y)));
+        }
+        return diff;
+    }
+
+    // 确定性的测试图：平滑渐变叠加伪随机噪声，alpha 覆盖 0..255
+    inline pa2d::Buffer pattern(int width, int height, unsigned seed = 1) {
+        pa2d::Buffer image(width, height);
+        unsigned state = seed * 2654435761u + 1;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                state = state * 1664525u + 1013904223u;
+                const int noise = static_cast<int>(state >> 27);
+                image.at(x, y) = pa2d::Color(
+                    static_cast<uint8_t>((state >> 8) & 0xFF),
+                    static_cast<uint8_t>((x * 255 / std::max(1, width - 1) + noise) & 0xFF),
+                    static_cast<uint8_t>((y * 255 / std::max(1, height - 1)) ^ (noise << 2)),
+                    static_cast<uint8_t>(((x + y) * 7 + noise * 3) & 0xFF));
+            }
+        }
+        return image;
+    }
+
+    inline int finish(const char* name) {
+        std::printf("%s: %s\n", name, failures() ? "FAILED" : "passed");
+        return failures() ? 1 : 0;
+    }
+}
+
+#define PA2D_CHECK(expr) pa2d_test::check((expr), #expr, __FILE__, __LINE__)
+#define PA2D_CHECK_LE(value, limit) pa2d_test::checkLe((value), (limit), #value, __FILE__, __LINE__)
@@ -0,0 +1,161 @@
+// test_vec_math.cpp
+// 向量超越函数的精度：标量、SSE 与 AVX2 版本对随机输入与双精度 std 函数比较，误差不超过 vec_math.h 中标注的上限
+#include"test_utils.h"
+#include"vec_math.h"
+#include<cmath>
+#include<vector>
+using namespace pa2d;
+
+namespace vec_math_avx2 {
+    void atan2(const float* y, const float* x, float* out, size_t count);
+    void sincos(const float* x, float* s, float* c, size_t count);
+    void rsqrt(const float* x, float* out, size_t count);
+    void exp(const float* x, float* out, size_t count);
+}
+
+namespace {
+    namespace vmath = utils::vmath;
+    const size_t SAMPLES = size_t(1) << 20;
+
+    // [lo, hi) 内的确定性伪随机浮点数
+    std::vector<float> uniform(unsigned seed, float lo, float hi) {
+        std::vector<float> values(SAMPLES);
+        unsigned state = seed * 2654435761u + 1;
+        for (float& v : values) {
+            state = state * 1664525u + 1013904223u;
+            v = lo + (hi - lo) * static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+        }
+        return values;
+    }
+
+    bool hasAvx2() {
+        return getCpuSimdLevel() >= SimdLevel::AVX2;
+    }
+
+    // atan2：|x|、|y| 跨多个数量级，覆盖四个象限与 |y| > |x| 的一侧；绝对误差 3e-7 弧度
+    void testAtan2() {
+        const std::vector<float> ly = uniform(1, -20.0f, 20.0f), lx = uniform(2, -20.0f, 20.0f);
+        const std::vector<float> ry = uniform(3, -1.0f, 1.0f), rx = uniform(4, -1.0f, 1.0f);
+        std::vector<float> y(SAMPLES), x(SAMPLES);
+        for (size_t i = 0; i < SAMPLES; ++i) {
+            y[i] = std::ldexp(ry[i], static_cast<int>(ly[i]));
+            x[i] = std::ldexp(rx[i], static_cast<int>(lx[i]));
+        }
+
+        double scalarErr = 0.0, sseErr = 0.0;
+        for (size_t i = 0; i < SAMPLES; ++i) {
+            const double ref = std::atan2(static_cast<double>(y[i]), static_cast<double>(x[i]));
+            scalarErr = std::max(scalarErr, std::abs(vmath::atan2_scalar(y[i], x[i]) - ref));
+        }
+        for (size_t i = 0; i < SAMPLES; i += 4) {
+            float out[4];
+            _mm_storeu_ps(out, vmath::atan2_sse(_mm_loadu_ps(&y[i]), _mm_loadu_ps(&x[i])));
+            for (size_t k = 0; k < 4; ++k) {
+                sseErr = std::max(sseErr, std::abs(out[k] - std::atan2(static_cast<double>(y[i + k]), static_cast<double>(x[i + k]))));
+            }
+        }
+        PA2D_CHECK_LE(scalarErr, 3e-7);
+        PA2D_CHECK_LE(sseErr, 3e-7);
+
+        // 坐标轴与原点
+        PA2D_CHECK(vmath::atan2_scalar(0.0f, 0.0f) == 0.0f);
+        PA2D_CHECK_LE(std::abs(vmath::atan2_scalar(1.0f, 0.0f) - 1.5707963267948966), 3e-7);
+        PA2D_CHECK_LE(std::abs(vmath::atan2_scalar(0.0f, -1.0f) - 3.1415926535897931), 3e-7);
+        PA2D_CHECK_LE(std::abs(vmath::atan2_scalar(-2.0f, -2.0f) + 2.3561944901923448), 3e-7);
+
+        if (!hasAvx2()) return;
+        std::vector<float> out(SAMPLES);
+        vec_math_avx2::atan2(y.data(), x.data(), out.data(), SAMPLES);
+        double avxErr = 0.0;
+        for (size_t i = 0; i < SAMPLES; ++i) {
+            avxErr = std::max(avxErr, std::abs(out[i] - std::atan2(static_cast<double>(y[i]), static_cast<double>(x[i]))));
+        }
+        PA2D_CHECK_LE(avxErr, 3e-7);
+    }
+
+    // sin / cos：|x| <= 8192 时绝对误差 1e-7
+    void testSinCos() {
+        const std::vector<float> x = uniform(5, -8192.0f, 8192.0f);
+        const std::vector<float> near = uniform(6, -7.0f, 7.0f);
+        double scalarErr = 0.0;
+        for (const std::vector<float>* input : { &x, &near }) {
+            for (float v : *input) {
+                float s, c;
+                vmath::sincos_scalar(v, s, c);
+                scalarErr = std::max(scalarErr, std::abs(s - std::sin(static_cast<double>(v))));
+                scalarErr = std::max(scalarErr, std::abs(c - std::cos(static_cast<double>(v))));
+            }
+        }
+        PA2D_CHECK_LE(scalarErr, 1e-7);
+        PA2D_CHECK(vmath::sin_scalar(0.0f) == 0.0f && vmath::cos_scalar(0.0f) == 1.0f);
+
+        if (!hasAvx2()) return;
+        std::vector<float> s(SAMPLES), c(SAMPLES);
+        double avxErr = 0.0;
+        for (const std::vector<float>* input : { &x, &near }) {
+            vec_math_avx2::sincos(input->data(), s.data(), c.data(), SAMPLES);
+            for (size_t i = 0; i < SAMPLES; ++i) {
+                const double v = (*input)[i];
+                avxErr = std::max(avxErr, std::max(std::abs(s[i] - std::sin(v)), std::abs(c[i] - std::cos(v))));
+            }
+        }
+        PA2D_CHECK_LE(avxErr, 1e-7);
+    }
+
+    // rsqrt：x 取 2^-60 到 2^60，相对误差 3e-7
+    void testRsqrt() {
+        const std::vector<float> mantissa = uniform(7, 1.0f, 2.0f), exponent = uniform(8, -60.0f, 60.0f);
+        std::vector<float> x(SAMPLES);
+        for (size_t i = 0; i < SAMPLES; ++i) x[i] = std::ldexp(mantissa[i], static_cast<int>(std::floor(exponent[i])));
+
+        auto relErr = [](float value, float input) {
+            const double ref = 1.0 / std::sqrt(static_cast<double>(input));
+            return std::abs(value - ref) / ref;
+        };
+        double scalarErr = 0.0, sseErr = 0.0;
+        for (size_t i = 0; i < SAMPLES; ++i) scalarErr = std::max(scalarErr, relErr(vmath::rsqrt_scalar(x[i]), x[i]));
+        for (size_t i = 0; i < SAMPLES; i += 4) {
+            float out[4];
+            _mm_storeu_ps(out, vmath::rsqrt_sse(_mm_loadu_ps(&x[i])));
+            for (size_t k = 0; k < 4; ++k) sseErr = std::max(sseErr, relErr(out[k], x[i + k]));
+        }
+        PA2D_CHECK_LE(scalarErr, 3e-7);
+        PA2D_CHECK_LE(sseErr, 3e-7);
+
+        if (!hasAvx2()) return;
+        std::vector<float> out(SAMPLES);
+        vec_math_avx2::rsqrt(x.data(), out.data(), SAMPLES);
+        double avxErr = 0.0;
+        for (size_t i = 0; i < SAMPLES; ++i) avxErr = std::max(avxErr, relErr(out[i], x[i]));
+        PA2D_CHECK_LE(avxErr, 3e-7);
+    }
+
+    // exp：截断区间内相对误差 1.5e-7，区间外饱和到端点的值
+    void testExp() {
+        const std::vector<float> x = uniform(9, -87.0f, 88.0f);
+        auto relErr = [](float value, float input) {
+            const double ref = std::exp(static_cast<double>(input));
+            return std::abs(value - ref) / ref;
+        };
+        double scalarErr = 0.0;
+        for (float v : x) scalarErr = std::max(scalarErr, relErr(vmath::exp_scalar(v), v));
+        PA2D_CHECK_LE(scalarErr, 1.5e-7);
+        PA2D_CHECK(vmath::exp_scalar(0.0f) == 1.0f);
+        PA2D_CHECK(vmath::exp_scalar(-200.0f) == vmath::exp_scalar(vmath::EXP_LO) && vmath::exp_scalar(-200.0f) > 0.0f);
+
+        if (!hasAvx2()) return;
+        std::vector<float> out(SAMPLES);
+        vec_math_avx2::exp(x.data(), out.data(), SAMPLES);
+        double avxErr = 0.0;
+        for (size_t i = 0; i < SAMPLES; ++i) avxErr = std::max(avxErr, relErr(out[i], x[i]));
+        PA2D_CHECK_LE(avxErr, 1.5e-7);
+    }
+}
+
+int main() {
+    testAtan2();
+    testSinCos();
+    testRsqrt();
+    testExp();
+    return pa2d_test::finish("test_vec_math");
+}
@@ -0,0 +1,34 @@
+// test_vec_math_avx2.cpp
+// test_vec_math 的 AVX2 部分：按 AVX2 编译，只在处理器支持时由 test_vec_math.cpp 调用；count 为 8 的倍数
+#define PA2D_ISA avx2
+#define PA2D_AVX2
+#include "kernel_prelude.h"
+#include "vec_math.h"
+#include <cstddef>
+
+namespace vec_math_avx2 {
+    using namespace pa2d::utils;
+
+    void atan2(const float* y, const float* x, float* out, size_t count) {
+        for (size_t i = 0; i < count; i += 8) {
+            _mm256_storeu_ps(out + i, vmath::atan2_avx(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+        }
+    }
+
+    void sincos(const float* x, float* s, float* c, size_t count) {
+        for (size_t i = 0; i < count; i += 8) {
+            __m256 vs, vc;
+            vmath::sincos_avx(_mm256_loadu_ps(x + i), vs, vc);
+            _mm256_storeu_ps(s + i, vs);
+            _mm256_storeu_ps(c + i, vc);
+        }
+    }
+
+    void rsqrt(const float* x, float* out, size_t count) {
+        for (size_t i = 0; i < count; i += 8) _mm256_storeu_ps(out + i, vmath::rsqrt_avx(_mm256_loadu_ps(x + i)));
+    }
+
+    void exp(const float* x, float* out, size_t count) {
+        for (size_t i = 0; i < count; i += 8) _mm256_storeu_ps(out + i, vmath::exp_avx(_mm256_loadu_ps(x + i)));
+    }
+}